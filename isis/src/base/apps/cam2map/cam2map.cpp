@@ -1,12 +1,23 @@
 #include "cam2map.h"
 
+#include <functional>
+#include <sstream>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QSharedPointer>
+#include <QStringList>
+
 #include "Camera.h"
 #include "CubeAttribute.h"
+#include "FileName.h"
+#include "GeometryGrid.h"
 #include "IException.h"
 #include "IString.h"
 #include "ProjectionFactory.h"
 #include "PushFrameCameraDetectorMap.h"
 #include "Pvl.h"
+#include "Table.h"
 #include "Target.h"
 #include "TProjection.h"
 
@@ -19,6 +30,46 @@ namespace Isis {
   Cube *icube;
   Camera *incam;
 
+  /**
+   * A hash of the SPICE of a cube: its Kernels group and the contents of its
+   *   SPICE tables. Kernel files are identified by name only.
+   *
+   * @param cube The cube
+   * @return The hash as hexadecimal digits
+   */
+  static QString spiceFingerprint(Cube &cube) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    std::stringstream kernels;
+    kernels << cube.label()->findGroup("Kernels", Pvl::Traverse);
+    hash.addData(kernels.str().c_str(), kernels.str().size());
+
+    QStringList tableNames;
+    tableNames << "InstrumentPointing" << "InstrumentPosition" << "BodyRotation"
+               << "SunPosition";
+
+    foreach (QString tableName, tableNames) {
+      if (!cube.hasTable(tableName)) {
+        continue;
+      }
+
+      Table table(tableName);
+      cube.read(table);
+
+      std::stringstream label;
+      label << table.Label();
+      hash.addData(label.str().c_str(), label.str().size());
+
+      for (int i = 0; i < table.Records(); i++) {
+        QByteArray record(table[i].RecordSize(), 0);
+        table[i].Pack(record.data());
+        hash.addData(record);
+      }
+    }
+
+    return QString(hash.result().toHex());
+  }
+
   void cam2map(UserInterface &ui, Pvl *log) {
     // Open the input cube
     Cube icube;
@@ -276,6 +327,11 @@ namespace Isis {
 
     // See if we need to deal with band dependent camera models
     if (!incam->IsBandIndependent()) {
+      if (ui.WasEntered("GRIDSPACING")) {
+        QString msg = "A geometry grid can not be used with the band dependent camera model "
+                      "of [" + icube->fileName() + "]";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
       p.BandChange(bandChange);
     }
 
@@ -307,6 +363,51 @@ namespace Isis {
     // We will need a transform class
     Transform *transform = 0;
 
+    // The warp runs on one thread. The camera models call CSPICE, which is
+    // not thread safe, for every transform, so threads would only take turns.
+
+    // The reverse transforms can interpolate most output pixels from a grid
+    // of exactly transformed ones
+    QSharedPointer<GeometryGrid> grid;
+    std::function<Transform *(Transform *)> useGrid = [&](Transform *exact) -> Transform * {
+      if (!ui.WasEntered("GRIDSPACING")) {
+        return exact;
+      }
+
+      int spacing = ui.GetInteger("GRIDSPACING");
+      double tolerance = ui.GetDouble("GRIDTOLERANCE");
+      QString gridFile;
+      if (ui.WasEntered("GRIDFILE")) {
+        gridFile = ui.GetFileName("GRIDFILE");
+      }
+
+      // A grid file is only used for the same input, SPICE and output map
+      PvlObject source("Source");
+      source += PvlKeyword("InputFile", FileName(icube->fileName()).expanded());
+      source += PvlKeyword("SpiceFingerprint", spiceFingerprint(*icube));
+      source += PvlKeyword("Trim", trim ? "Yes" : "No");
+      source += PvlKeyword("Occlusion", occlusion ? "Yes" : "No");
+      source.addGroup(cleanMapping);
+
+      if (!gridFile.isEmpty() && FileName(gridFile).fileExists()) {
+        grid = QSharedPointer<GeometryGrid>(new GeometryGrid(gridFile));
+        if (!grid->matches(samples, lines, spacing, tolerance, source)) {
+          grid.clear();
+        }
+      }
+
+      if (!grid) {
+        grid = QSharedPointer<GeometryGrid>(
+                   new GeometryGrid(*exact, samples, lines, spacing, tolerance));
+        grid->setSource(source);
+        if (!gridFile.isEmpty()) {
+          grid->write(gridFile);
+        }
+      }
+
+      return new GeometryGridTransform(grid, exact);
+    };
+
     // Okay we need to decide how to apply the rubbersheeting for the transform
     // Does the user want to define how it is done?
     if (ui.GetString("WARPALGORITHM") == "FORWARDPATCH") {
@@ -331,6 +432,7 @@ namespace Isis {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
                                      outmap, trim, occlusion);
+      transform = useGrid(transform);
 
       int patchSize = ui.GetInteger("PATCHSIZE");
       int minPatchSize = 4;
@@ -349,6 +451,7 @@ namespace Isis {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
                                      outmap, trim, occlusion);
+      transform = useGrid(transform);
       p.SetTiling(4, 4);
       p.StartProcess(*transform, *interp);
     }
@@ -420,6 +523,7 @@ namespace Isis {
       transform = new cam2mapReverse(icube->sampleCount(),
                                      icube->lineCount(), incam, samples,lines,
                                      outmap, trim, occlusion);
+      transform = useGrid(transform);
 
       int tileStart, tileEnd;
       incam->GetGeometricTilingHint(tileStart, tileEnd);
@@ -0,0 +1,51 @@
+#include "cubeatt.h"
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "ProcessByLine.h"
+
+using namespace std;
+
+namespace Isis {
+
+  static void copyLine(Buffer &in, Buffer &out);
+
+  /**
+   * Copy the input cube to the output cube with the output attributes. This
+   * is the programmatic interface to the ISIS3 cubeatt application.
+   *
+   * @param ui The User Interface to parse the parameters from
+   */
+  void cubeatt(UserInterface &ui) {
+    // We will be processing by line
+    ProcessByLine p;
+
+    // Should we propagate tables
+    if (!ui.GetBoolean("PROPTABLES")) {
+      p.PropagateTables(false);
+    }
+
+    // Setup the input and output cubes
+    CubeAttributeInput &inAtt = ui.GetInputAttribute("FROM");
+    p.SetInputCube(ui.GetFileName("FROM"), inAtt);
+    Cube *outCube = p.SetOutputCube(ui.GetFileName("TO"), ui.GetOutputAttribute("TO"));
+
+    p.StartProcess(copyLine);
+
+    // Store reduced resolution copies for zoomed out views
+    if (ui.GetBoolean("OVERVIEWS")) {
+      outCube->createOverviews(ui.GetInteger("OVERVIEWLEVELS"));
+    }
+
+    p.EndProcess();
+  }
+
+
+  // Line processing routine
+  static void copyLine(Buffer &in, Buffer &out) {
+    // Loop and copy pixels in the line.
+    for (int i = 0; i < in.size(); i++) {
+      out[i] = in[i];
+    }
+  }
+}
@@ -0,0 +1,10 @@
+#ifndef cubeatt_h
+#define cubeatt_h
+
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void cubeatt(UserInterface &ui);
+}
+
+#endif
@@ -1,6 +1,9 @@
 #define GUIHELPERS
 
 #include "Isis.h"
+
+#include <QList>
+
 #include "ProcessRubberSheet.h"
 #include "ProjectionFactory.h"
 #include "TProjection.h"
@@ -368,6 +371,21 @@ void IsisMain() {
     throw IException(IException::Programmer, msg, _FILEINFO_);
   }
 
+  // Projections are only math, so the warp can run on the global threads
+  //   with a pair of projections for each thread
+  QList<TProjection *> threadProjections;
+  p.setTransformFactory([&]() -> Transform * {
+    threadProjections.append((TProjection *) ProjectionFactory::CreateFromCube(*icube));
+    threadProjections.append((TProjection *) ProjectionFactory::CreateFromCube(*ocube));
+    return new map2map(icube->sampleCount(),
+                       icube->lineCount(),
+                       threadProjections.at(threadProjections.size() - 2),
+                       samples,
+                       lines,
+                       threadProjections.last(),
+                       ui.GetBoolean("TRIM"));
+  });
+
   // Warp the cube
   p.StartProcess(*transform, *interp);
   p.EndProcess();
@@ -377,6 +395,7 @@ void IsisMain() {
   // Cleanup
   delete transform;
   delete interp;
+  qDeleteAll(threadProjections);
 }
 
 // Transform object constructor
@@ -0,0 +1,152 @@
+#include "mask.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "CubeAttribute.h"
+#include "IException.h"
+#include "ProcessByLine.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  static void maskLine(vector<Buffer *> &in,
+                       vector<Buffer *> &out);
+
+  namespace {
+    enum which_special {NONE, NULLP, ALL};
+    enum range_preserve {INSIDE, OUTSIDE};
+  }
+
+  // The settings are only read while the lines are processed. The lines are
+  // masked on several threads, so the counts are added under g_countMutex.
+  static which_special spixels;
+  static range_preserve preserve;
+  static double g_minimum, g_maximum;
+  static QMutex g_countMutex;
+  static bool g_masked;
+  static double g_pixelsMasked;
+
+  /**
+   * Mask a cube with the DNs of a mask cube. This is the programmatic
+   * interface to the ISIS3 mask application.
+   *
+   * @param ui The User Interface to parse the parameters from
+   * @param log The Pvl that the PixelsMasked results are added to
+   */
+  void mask(UserInterface &ui, Pvl *log) {
+    // We will be processing by line
+    ProcessByLine p;
+
+    g_masked = false;
+    g_pixelsMasked = 0;
+
+    // Setup the input and output cubes
+    CubeAttributeInput &inAtt = ui.GetInputAttribute("FROM");
+    p.SetInputCube(ui.GetFileName("FROM"), inAtt);
+    if(!ui.WasEntered("MASK")) {
+      p.SetInputCube(ui.GetFileName("FROM"), inAtt);
+    }
+    else {
+      try {
+        CubeAttributeInput &maskAtt = ui.GetInputAttribute("MASK");
+        p.SetInputCube(ui.GetFileName("MASK"), maskAtt, OneBand);
+      }
+      catch (IException &e) {
+        QString msg = "The MASK input must be a single band.";
+        throw IException(e, IException::User, msg, _FILEINFO_);
+      }
+    }
+    p.SetOutputCube(ui.GetFileName("TO"), ui.GetOutputAttribute("TO"));
+
+    //  Get min/max info
+    g_minimum = VALID_MIN8;
+    g_maximum = VALID_MAX8;
+    if(ui.WasEntered("MINIMUM")) g_minimum = ui.GetDouble("MINIMUM");
+    if(ui.WasEntered("MAXIMUM")) g_maximum = ui.GetDouble("MAXIMUM");
+
+    //  Will we preserve inside or outside of min/max range
+    preserve = INSIDE;
+    QString Preserve;
+    if(ui.WasEntered("PRESERVE")) Preserve = ui.GetString("PRESERVE");
+    if(Preserve == "OUTSIDE") preserve = OUTSIDE;
+
+    //  How are special pixels handled?
+    spixels = NULLP;
+    QString Spixels;
+    if(ui.WasEntered("SPIXELS")) Spixels = ui.GetString("SPIXELS");
+    if(Spixels == "NONE") spixels = NONE;
+    if(Spixels == "ALL") spixels = ALL;
+
+    // Start the processing
+    p.SetThreadedStartProcess(true);
+    p.StartProcess(maskLine);
+    p.EndProcess();
+
+    // Add an entry to print.prt to indicate whether this file was masked.
+    PvlGroup results("Results");
+
+    if(g_masked == true) {
+        results += PvlKeyword("PixelsMasked", toString(g_pixelsMasked));
+    }
+    else {
+        PvlKeyword pm("PixelsMasked", toString(g_pixelsMasked));
+        pm.addComment( "No pixels were masked for this image");
+        results += pm;
+    }
+
+    if (log) {
+      log->addGroup(results);
+    }
+  }
+
+
+  // Line processing routine
+  static void maskLine(vector<Buffer *> &in,
+                       vector<Buffer *> &out) {
+
+    Buffer &inp = *in[0];
+    Buffer &mask = *in[1];
+    Buffer &outp = *out[0];
+
+    int pixelsMasked = 0;
+
+    // Loop for each pixel in the line.
+    for(int i = 0; i < inp.size(); i++) {
+      if(IsSpecial(mask[i])) {
+        if(spixels == ALL) {
+          outp[i] = NULL8;
+          pixelsMasked++;
+        }
+        else if(spixels == NULLP && mask[i] == NULL8) {
+          outp[i] = NULL8;
+          pixelsMasked++;
+        }
+        else {
+          outp[i] = inp[i];
+        }
+      }
+
+      else {
+        if(preserve == INSIDE && (mask[i] >= g_minimum && mask[i] <= g_maximum))
+          outp[i] = inp[i];
+        else if(preserve == OUTSIDE && (mask[i] < g_minimum || mask[i] > g_maximum))
+          outp[i] = inp[i];
+        else {
+          outp[i] = NULL8;
+          pixelsMasked++;
+        }
+      }
+    }
+
+    if (pixelsMasked > 0) {
+      QMutexLocker locker(&g_countMutex);
+      g_masked = true;
+      g_pixelsMasked += pixelsMasked;
+    }
+  }
+}
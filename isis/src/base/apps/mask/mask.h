@@ -0,0 +1,11 @@
+#ifndef mask_h
+#define mask_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void mask(UserInterface &ui, Pvl *log);
+}
+
+#endif
@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
+#include "RankFilter.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -17,9 +16,11 @@ double high;
 bool propagate;
 unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+bool FilterCenter(double centerPixel);
+double Median(double centerPixel, int index, RankFilter &filter);
+void FilterAll(Buffer &in, Buffer &out, RankFilter &filter);
+void FilterValid(Buffer &in, Buffer &out, RankFilter &filter);
+void FilterInvalid(Buffer &in, Buffer &out, RankFilter &filter);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -58,6 +59,7 @@ void IsisMain() {
   if(ui.WasEntered("HIGH")) {
     high = ui.GetDouble("HIGH");
   }
+  p.SetValidRange(low, high);
 
   //Determine what to do if there are too few
   //non-Special pixels
@@ -78,188 +80,87 @@ void IsisMain() {
   }
 }
 
-//Function which loops through every pixel in the boxcar,
-//and outputs the median value to the center pixel, if
-//the center pixel is valid.
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
+//Checks whether a special center pixel is one of the
+//types to be filtered
+bool FilterCenter(double centerPixel) {
+  if((IsNullPixel(centerPixel)) && (!filterNull)) return false;
+  if((IsLisPixel(centerPixel)) && (!filterLis)) return false;
+  if((IsLrsPixel(centerPixel)) && (!filterLrs)) return false;
+  if((IsHisPixel(centerPixel)) && (!filterHis)) return false;
+  if((IsHrsPixel(centerPixel)) && (!filterHrs)) return false;
+  return true;
+}
 
-  //Check if the center pixel is a Special Pixel type to be
-  //filtered. If not, ignore the pixel and move on
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
-  }
-  else if(centerPixel < low || centerPixel > high) {
-    v = centerPixel;
-    return;
+//Finds the median of the valid pixels in the boxcar around
+//a sample. If there are not enough to meet the minimum
+//requirements, returns a user-selected value instead.
+double Median(double centerPixel, int index, RankFilter &filter) {
+  if((unsigned int) filter.Count(index) < minimum) {
+    return (propagate) ? centerPixel : Isis::Null;
   }
+  return filter.Median(index);
+}
 
-  //Build a vector containing the non-Special pixel values
-  //from the input buffer. If there are not enough to meet
-  //the minimum requirements, write a user-selected value
-  //to the center. If there are, sort the vector and write
-  //the median value to the center.
-  std::vector<double> boxdata(0);
+//Function which writes the median value of the boxcar to
+//each pixel of the line, if the pixel is valid.
+void FilterValid(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
+    double centerPixel = in[i];
+
+    //Check if the center pixel is a Special Pixel type to be
+    //filtered. If not, ignore the pixel and move on
+    if(IsSpecial(centerPixel)) {
+      if(!FilterCenter(centerPixel)) {
+        out[i] = centerPixel;
+        continue;
+      }
+    }
+    else if(centerPixel < low || centerPixel > high) {
+      out[i] = centerPixel;
       continue;
     }
-  }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
-}
 
-//Function to loop through the boxcar and find and write
-//the median value to the center pixel, but only if the
-//center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check for Special Pixels and handle according to user
-  //input.
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
+    out[i] = Median(centerPixel, i, filter);
   }
-  else if(centerPixel >= low && centerPixel <= high) {
-    v = centerPixel;
-    return;
-  }
-
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
+}
 
+//Function which writes the median value of the boxcar to
+//each pixel of the line, but only if the pixel is invalid
+void FilterInvalid(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
+    double centerPixel = in[i];
+
+    //Check for Special Pixels and handle according to user
+    //input.
+    if(IsSpecial(centerPixel)) {
+      if(!FilterCenter(centerPixel)) {
+        out[i] = centerPixel;
+        continue;
+      }
+    }
+    else if(centerPixel >= low && centerPixel <= high) {
+      out[i] = centerPixel;
       continue;
     }
-  }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
-}
-
-//Function to find the median value of the boxcar and
-//write it to the center, regardless of the validity
-//of the center pixel value
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
 
-  //Check for Special Pixels and handle according to user
-  //input.
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
+    out[i] = Median(centerPixel, i, filter);
   }
+}
 
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
+//Function which writes the median value of the boxcar to
+//each pixel of the line, regardless of the validity of
+//the pixel
+void FilterAll(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
+    double centerPixel = in[i];
+
+    //Check for Special Pixels and handle according to user
+    //input.
+    if(IsSpecial(centerPixel) && !FilterCenter(centerPixel)) {
+      out[i] = centerPixel;
       continue;
     }
+
+    out[i] = Median(centerPixel, i, filter);
   }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
 }
-
@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
+#include "RankFilter.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -17,9 +16,11 @@ double low;
 double high;
 unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+bool FilterCenter(double centerPixel);
+double Mode(double centerPixel, int index, RankFilter &filter);
+void FilterAll(Buffer &in, Buffer &out, RankFilter &filter);
+void FilterValid(Buffer &in, Buffer &out, RankFilter &filter);
+void FilterInvalid(Buffer &in, Buffer &out, RankFilter &filter);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -58,6 +59,7 @@ void IsisMain() {
   if(ui.WasEntered("HIGH")) {
     high = ui.GetDouble("HIGH");
   }
+  p.SetValidRange(low, high);
 
   //Determine what to do if there are too few
   //non-Special pixels
@@ -79,241 +81,100 @@ void IsisMain() {
   }
 }
 
-//Function which loops through every pixel int the boxcar,
-//and outputs the mode value to the center pixel, if
-//the center pixel is valid
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
+//Checks whether a special center pixel is one of the
+//types to be filtered
+bool FilterCenter(double centerPixel) {
+  if((IsNullPixel(centerPixel)) && (!filterNull)) return false;
+  if((IsLisPixel(centerPixel)) && (!filterLis)) return false;
+  if((IsLrsPixel(centerPixel)) && (!filterLrs)) return false;
+  if((IsHisPixel(centerPixel)) && (!filterHis)) return false;
+  if((IsHrsPixel(centerPixel)) && (!filterHrs)) return false;
+  return true;
+}
 
-  //Check if the center pixel is valid
-  //Valid is defined as a Special Pixel declared as a
-  //valid type, or a normal value between low and high.
-  //If the center pixel does not meet these requirements,
-  //write the original value to the center and move on
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
+//Finds the most common(mode) value of the valid pixels in
+//the boxcar around a sample. If there are not enough to meet
+//the minimum requirements, returns a user-selected value
+//instead. If no value occurs more than once, returns the
+//center pixel.
+double Mode(double centerPixel, int index, RankFilter &filter) {
+  if((unsigned int) filter.Count(index) < minimum) {
+    return (propagate) ? centerPixel : Isis::Null;
   }
-  else if(centerPixel < low || centerPixel > high) {
-    v = centerPixel;
+  if(filter.ModeCount(index) <= 1) {
+    return centerPixel;
   }
+  return filter.Mode(index);
+}
 
-  //Gather all non-special pixels into a vector and determine
-  //the mode, provided there are enough for filtering
-  std::vector<double> boxdata(0);
-
+//Function which loops through every pixel in the line,
+//and outputs the mode value of its boxcar, if the
+//pixel is valid
+void FilterValid(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
+    double centerPixel = in[i];
+
+    //Check if the center pixel is valid
+    //Valid is defined as a Special Pixel declared as a
+    //valid type, or a normal value between low and high.
+    //If the center pixel does not meet these requirements,
+    //write the original value and move on
+    if(IsSpecial(centerPixel)) {
+      if(!FilterCenter(centerPixel)) {
+        out[i] = centerPixel;
+        continue;
+      }
     }
-    else {
+    else if(centerPixel < low || centerPixel > high) {
+      out[i] = centerPixel;
       continue;
     }
-  }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
 
-  //Determine the most common(mode) pixel value
-  double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
-  int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
+    out[i] = Mode(centerPixel, i, filter);
   }
-  v = modeVal;
 }
 
 
-//Function to loop through the boxcar and find and write
-//the mode value to the center pixel, but only if the
-//center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check if the center pixel is valid
-  //Valid is defined as a Special Pixel declared as a
-  //valid type, or a normal value between low and high.
-  //If the center is valid, write the original value to the
-  //center, and move the boxcar
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
-  }
-  else if(centerPixel >= low && centerPixel <= high) {
-    v = centerPixel;
-  }
-
-  //Now, build a vector containing non-Special pixels,
-  //and, if there are enough, process the vector to
-  //determine the mode. If there aren't enough, write
-  //a user selected value to the center.
-  std::vector<double> boxdata(0);
-
+//Function to loop through the line and write the mode
+//value of the boxcar to each pixel, but only if the
+//pixel is invalid
+void FilterInvalid(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
+    double centerPixel = in[i];
+
+    //Check if the center pixel is valid
+    //Valid is defined as a Special Pixel declared as a
+    //valid type, or a normal value between low and high.
+    //If the center is valid, write the original value and
+    //move on
+    if(IsSpecial(centerPixel)) {
+      if(!FilterCenter(centerPixel)) {
+        out[i] = centerPixel;
+        continue;
+      }
     }
-    else {
+    else if(centerPixel >= low && centerPixel <= high) {
+      out[i] = centerPixel;
       continue;
     }
-  }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  //Sort the vector, and determine the mode pixel value
-  double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
-  int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
-  }
-  v = modeVal;
-}
 
-//Function to process the boxcar and determine the mode,
-//regardless of validity of the center pixel
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
-  //Check if the center pixel is valid
-  //Valid is defined as a Special Pixel declared as a
-  //valid type, or a normal value between low and high.
-  //If the center is valid, write the original value to the
-  //center, and move the boxcar
-  if(IsSpecial(centerPixel)) {
-    if((IsNullPixel(centerPixel)) && (!filterNull)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLisPixel(centerPixel)) && (!filterLis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsLrsPixel(centerPixel)) && (!filterLrs)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHisPixel(centerPixel)) && (!filterHis)) {
-      v = centerPixel;
-      return;
-    }
-    else if((IsHrsPixel(centerPixel)) && (!filterHrs)) {
-      v = centerPixel;
-      return;
-    }
+    out[i] = Mode(centerPixel, i, filter);
   }
+}
 
-  //Now, build a vector containing non-Special pixels,
-  //and, if there are enough, process the vector to
-  //determine the mode. If there aren't enough, write
-  //a user selected value to the center.
-  std::vector<double> boxdata(0);
-
+//Function to process the line and determine the mode of
+//the boxcar, regardless of validity of the center pixel
+void FilterAll(Buffer &in, Buffer &out, RankFilter &filter) {
   for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
+    double centerPixel = in[i];
+
+    //Check for Special Pixels and handle according to user
+    //input.
+    if(IsSpecial(centerPixel) && !FilterCenter(centerPixel)) {
+      out[i] = centerPixel;
       continue;
     }
+
+    out[i] = Mode(centerPixel, i, filter);
   }
-  if(boxdata.size() < minimum) {
-    if(propagate) {
-      v = centerPixel;
-      return;
-    }
-    else {
-      v = Isis::Null;
-      return;
-    }
-  }
-  //Sort the vector, and determine the mode pixel value
-  double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
-  int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
-  }
-  v = modeVal;
 }
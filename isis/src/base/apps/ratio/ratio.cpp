@@ -0,0 +1,61 @@
+#include "ratio.h"
+
+#include "CubeAttribute.h"
+#include "ProcessByLine.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  static void doRatio(vector<Buffer *> &in,
+                      vector<Buffer *> &out);
+
+  /**
+   * Divide the numerator cube by the denominator cube. This is the
+   * programmatic interface to the ISIS3 ratio application.
+   *
+   * @param ui The User Interface to parse the parameters from
+   */
+  void ratio(UserInterface &ui) {
+    ProcessByLine p;
+
+    CubeAttributeInput &numeratorAtt = ui.GetInputAttribute("NUMERATOR");
+    p.SetInputCube(ui.GetFileName("NUMERATOR"), numeratorAtt);
+    CubeAttributeInput &denominatorAtt = ui.GetInputAttribute("DENOMINATOR");
+    p.SetInputCube(ui.GetFileName("DENOMINATOR"), denominatorAtt);
+    p.SetOutputCube(ui.GetFileName("TO"), ui.GetOutputAttribute("TO"));
+
+    // doRatio only touches the buffers it is given
+    p.SetThreadedStartProcess(true);
+    p.StartProcess(doRatio);
+    p.EndProcess();
+  }
+
+
+  // Line processing routine
+  static void doRatio(vector<Buffer *> &in,
+                      vector<Buffer *> &out) {
+    Buffer &num = *in[0];
+    Buffer &den = *in[1];
+    Buffer &rat = *out[0];
+
+    // Loop for each pixel in the line. Check
+    // for special pixels and if any are found the
+    // output will be set to NULL.
+    for (int i = 0; i < num.size(); i++) {
+      if ( IsSpecial(num[i]) ) {
+        rat[i] = NULL8;
+      }
+      else if ( IsSpecial(den[i]) ) {
+        rat[i] = NULL8;
+      }
+      else if ( den[i] == 0.0 ) {
+        rat[i] = NULL8;
+      }
+      else {
+        rat[i] = num[i] / den[i];
+      }
+    }
+  }
+}
@@ -0,0 +1,10 @@
+#ifndef ratio_h
+#define ratio_h
+
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void ratio(UserInterface &ui);
+}
+
+#endif
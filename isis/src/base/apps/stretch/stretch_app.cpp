@@ -0,0 +1,99 @@
+#include "stretch_app.h"
+
+#include "CubeAttribute.h"
+#include "FileName.h"
+#include "ProcessByLine.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpecialPixel.h"
+#include "Stretch.h"
+#include "TextFile.h"
+
+using namespace std;
+
+namespace Isis {
+
+  static void stretchLine(Buffer &in, Buffer &out);
+
+  // Only read while the lines are processed, so the threads can share it
+  static Stretch str;
+
+  /**
+   * Stretch the pixels of a cube through a set of pairs. This is the
+   * programmatic interface to the ISIS3 stretch application.
+   *
+   * @param ui The User Interface to parse the parameters from
+   * @param log The Pvl that the StretchPairs results are added to
+   */
+  void stretch(UserInterface &ui, Pvl *log) {
+    ProcessByLine p;
+    CubeAttributeInput &inAtt = ui.GetInputAttribute("FROM");
+    Cube *inCube = p.SetInputCube(ui.GetFileName("FROM"), inAtt);
+
+    QString pairs;
+
+    // first just get the pairs from where ever and worry about
+    // whether they are dn values or %'s later
+    if(ui.GetBoolean("READFILE")) {
+      FileName pairsFileName = ui.GetFileName("INPUTFILE");
+      TextFile pairsFile;
+      pairsFile.SetComment("#");
+      pairsFile.Open(pairsFileName.expanded());
+
+      // concat all non-comment lines into one string (pairs)
+      QString line = "";
+      while(pairsFile.GetLine(line, true)) {
+        pairs += " " + line;
+      }
+      pairs += line;
+    }
+    else {
+      if(ui.WasEntered("PAIRS"))
+        pairs = ui.GetString("PAIRS");
+    }
+
+    str = Stretch();
+    if(ui.GetBoolean("USEPERCENTAGES"))
+      str.Parse(pairs, inCube->histogram());
+    else
+      str.Parse(pairs);
+
+    // Setup new mappings for special pixels if necessary
+    if(ui.WasEntered("NULL"))
+      str.SetNull(StringToPixel(ui.GetString("NULL")));
+    if(ui.WasEntered("LIS"))
+      str.SetLis(StringToPixel(ui.GetString("LIS")));
+    if(ui.WasEntered("LRS"))
+      str.SetLrs(StringToPixel(ui.GetString("LRS")));
+    if(ui.WasEntered("HIS"))
+      str.SetHis(StringToPixel(ui.GetString("HIS")));
+    if(ui.WasEntered("HRS"))
+      str.SetHrs(StringToPixel(ui.GetString("HRS")));
+
+    p.SetOutputCube(ui.GetFileName("TO"), ui.GetOutputAttribute("TO"));
+
+    // Start the processing. Stretch::Map() is const, so the lines can be
+    // stretched on several threads.
+    p.SetThreadedStartProcess(true);
+    p.StartProcess(stretchLine);
+    p.EndProcess();
+
+    PvlKeyword dnPairs = PvlKeyword("StretchPairs");
+    dnPairs.addValue(str.Text());
+
+    PvlGroup results = PvlGroup("Results");
+    results.addKeyword(dnPairs);
+
+    if (log) {
+      log->addGroup(results);
+    }
+  }
+
+
+  // Line processing routine
+  static void stretchLine(Buffer &in, Buffer &out) {
+    for(int i = 0; i < in.size(); i++) {
+      out[i] = str.Map(in[i]);
+    }
+  }
+}
@@ -0,0 +1,11 @@
+#ifndef stretch_app_h
+#define stretch_app_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void stretch(UserInterface &ui, Pvl *log);
+}
+
+#endif
@@ -1059,6 +1059,24 @@ namespace Isis {
       }
     }
 
+    // Let the algorithm fill the whole fit chip at once if it can, then
+    // look for the best fit in the same order as the walk below
+    if(ComputeFitChip(sChip, pChip, fChip, startSamp, endSamp, startLine, endLine)) {
+      for(int line = startLine; line <= endLine; line++) {
+        for(int samp = startSamp; samp <= endSamp; samp++) {
+          double fit = fChip.GetValue(samp, line);
+          if(fit != Isis::Null) {
+            if((p_bestFit == Isis::Null) || CompareFits(fit, p_bestFit)) {
+              p_bestFit = fit;
+              p_bestSamp = samp;
+              p_bestLine = line;
+            }
+          }
+        }
+      }
+      return;
+    }
+
     // Create a chip the same size as the pattern chip.
     Chip subsearch(pChip.Samples(), pChip.Lines());
 
@@ -1087,6 +1105,35 @@ namespace Isis {
   }
 
 
+  /**
+   * Fills the fit chip with the goodness of fit of every position from start
+   * sample to end sample and start line to end line in one pass, instead of
+   * extracting a subsearch chip and calling MatchAlgorithm at each position.
+   * Positions without a fit must be left Null, and the subsearch valid percent
+   * must be honored just like the walk in Match() does.
+   *
+   * Algorithms that can compute the whole fit surface faster than one
+   * position at a time override this. The default has no such shortcut and
+   * returns false, so Match() walks the search chip.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param fChip Fit chip, already sized like the search chip and filled with
+   *              Nulls
+   * @param startSamp Start sample
+   * @param endSamp End sample
+   * @param startLine Start line
+   * @param endLine End line
+   *
+   * @return @b bool Whether the fit chip was filled
+   */
+  bool AutoReg::ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                               int startSamp, int endSamp,
+                               int startLine, int endLine) {
+    return false;
+  }
+
+
   /**
    * Set the search chip sample and line to subpixel values if possible.  This
    * method uses a centroiding method to gravitate the whole pixel best fit to a
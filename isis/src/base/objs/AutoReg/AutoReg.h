@@ -462,6 +462,10 @@ namespace Isis {
        */
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch) = 0;
 
+      virtual bool ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                  int startSamp, int endSamp,
+                                  int startLine, int endLine);
+
       PvlObject p_template; //!< AutoRegistration object that created this projection
 
       /**
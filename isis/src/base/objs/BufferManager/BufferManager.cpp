@@ -236,50 +236,95 @@ namespace Isis {
     if(map >= 0) {
       p_currentMap = map;
 
-      if(!p_reverse) {
-        int sampDimension = (p_maxSamps / p_sinc);
-        if (p_maxSamps % p_sinc)
-          sampDimension++;
+      basePosition(map, p_currentSample, p_currentLine, p_currentBand);
 
-        p_currentSample = (map % sampDimension) * p_sinc + 1;
-        map /= sampDimension;
+      SetBasePosition(p_currentSample + p_soff,
+                      p_currentLine + p_loff,
+                      p_currentBand + p_boff);
+    }
+    else {
+      string message = "Invalid value for argument [map]";
+      throw IException(IException::Programmer, message, _FILEINFO_);
+    }
 
-        int lineDimension = (p_maxLines / p_linc);
-        if (p_maxLines % p_linc)
-          lineDimension++;
+    return !end();
+  }
 
-        p_currentLine = (map % lineDimension) * p_linc + 1;
-        map /= lineDimension;
 
-        p_currentBand = map * p_binc + 1;
-      }
-      else {
-        int bandDimension = (p_maxBands / p_binc);
-        if (p_maxBands % p_binc)
-          bandDimension++;
+  /**
+   * Computes where the shape buffer would be placed at the given position
+   * without moving it. This is what setpos() uses to position the buffer and
+   * lets callers, such as the cube read ahead, look at upcoming positions in
+   * the traversal order.
+   *
+   * @param map Shape buffer position value (see setpos())
+   * @param sample (output) The starting sample of the shape buffer
+   * @param line (output) The starting line of the shape buffer
+   * @param band (output) The starting band of the shape buffer
+   *
+   * @return bool True if the position is inside of the cube (map is less than
+   *              the total number of positions)
+   */
+  bool BufferManager::positionOf(BigInt map, int &sample, int &line,
+                                 int &band) const {
+    if (map < 0 || map >= p_nmaps) {
+      return false;
+    }
 
-        p_currentBand = (map % bandDimension) * p_binc + 1;
-        map /= bandDimension;
+    basePosition(map, sample, line, band);
 
-        int lineDimension = (p_maxLines / p_linc);
-        if (p_maxLines % p_linc)
-          lineDimension++;
+    sample += p_soff;
+    line += p_loff;
+    band += p_boff;
 
-        p_currentLine = (map % lineDimension) * p_linc + 1;
-        map /= lineDimension;
+    return true;
+  }
 
-        p_currentSample = map * p_sinc + 1;
-      }
 
-      SetBasePosition(p_currentSample + p_soff,
-                      p_currentLine + p_loff,
-                      p_currentBand + p_boff);
+  /**
+   * Computes the position of the shape buffer, ignoring the offsets, for
+   * the given map.
+   *
+   * @param map Shape buffer position value (see setpos())
+   * @param sample (output) The starting sample without the sample offset
+   * @param line (output) The starting line without the line offset
+   * @param band (output) The starting band without the band offset
+   */
+  void BufferManager::basePosition(BigInt map, int &sample, int &line,
+                                   int &band) const {
+    if(!p_reverse) {
+      int sampDimension = (p_maxSamps / p_sinc);
+      if (p_maxSamps % p_sinc)
+        sampDimension++;
+
+      sample = (map % sampDimension) * p_sinc + 1;
+      map /= sampDimension;
+
+      int lineDimension = (p_maxLines / p_linc);
+      if (p_maxLines % p_linc)
+        lineDimension++;
+
+      line = (map % lineDimension) * p_linc + 1;
+      map /= lineDimension;
+
+      band = map * p_binc + 1;
     }
     else {
-      string message = "Invalid value for argument [map]";
-      throw IException(IException::Programmer, message, _FILEINFO_);
-    }
+      int bandDimension = (p_maxBands / p_binc);
+      if (p_maxBands % p_binc)
+        bandDimension++;
 
-    return !end();
+      band = (map % bandDimension) * p_binc + 1;
+      map /= bandDimension;
+
+      int lineDimension = (p_maxLines / p_linc);
+      if (p_maxLines % p_linc)
+        lineDimension++;
+
+      line = (map % lineDimension) * p_linc + 1;
+      map /= lineDimension;
+
+      sample = map * p_sinc + 1;
+    }
   }
 } // end namespace isis
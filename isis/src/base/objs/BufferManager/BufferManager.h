@@ -134,6 +134,18 @@ namespace Isis {
 
       bool setpos(BigInt map);
 
+      /**
+       * Returns the current position of the shape buffer in the traversal
+       * (see setpos method for more info).
+       *
+       * @return BigInt
+       */
+      BigInt currentMap() const {
+        return (p_currentMap);
+      }
+
+      bool positionOf(BigInt map, int &sample, int &line, int &band) const;
+
       void swap(BufferManager &other);
 
       BufferManager &operator=(const BufferManager &rhs);
@@ -183,6 +195,8 @@ namespace Isis {
       void SetOffsets(const int soff, const int loff, const int boff);
 
     private:
+      void basePosition(BigInt map, int &sample, int &line, int &band) const;
+
       int p_maxSamps;  //!<  Maximum samples to map
       int p_maxLines;  //!<  Maximum lines to map
       int p_maxBands;  //!<  Maximum bands to map
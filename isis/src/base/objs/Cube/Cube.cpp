@@ -37,6 +37,8 @@
 #include "CameraFactory.h"
 #include "CubeAttribute.h"
 #include "CubeBsqHandler.h"
+#include "CubeCompressedTileHandler.h"
+#include "CubeOverview.h"
 #include "CubeTileHandler.h"
 #include "Endian.h"
 #include "FileName.h"
@@ -157,6 +159,9 @@ namespace Isis {
     delete m_projection;
     m_projection = NULL;
 
+    delete m_overviews;
+    m_overviews = NULL;
+
     delete m_formatTemplateFile;
     m_formatTemplateFile = NULL;
   }
@@ -245,8 +250,16 @@ namespace Isis {
    * removed/deleted.
    */
   void Cube::close(bool removeIt) {
-    if (isOpen() && isReadWrite())
+    if (isOpen() && isReadWrite()) {
+      // Write the DN data here, where errors can be reported, rather than
+      //   when the I/O handler is deleted
+      {
+        QMutexLocker locker(m_mutex);
+        m_ioHandler->flush();
+      }
+
       writeLabels();
+    }
 
     cleanUp(removeIt);
   }
@@ -554,6 +567,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                        dataAlreadyOnDisk);
     }
+    else if (m_format == Compressed) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+                                                  realDataFileLabel(), dataAlreadyOnDisk);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList, realDataFileLabel(),
                                         dataAlreadyOnDisk);
@@ -736,6 +753,10 @@ namespace Isis {
       m_ioHandler = new CubeBsqHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
     }
+    else if (m_format == Compressed) {
+      m_ioHandler = new CubeCompressedTileHandler(dataFile(), m_virtualBandList,
+          realDataFileLabel(), true);
+    }
     else {
       m_ioHandler = new CubeTileHandler(dataFile(), m_virtualBandList,
           realDataFileLabel(), true);
@@ -747,6 +768,8 @@ namespace Isis {
     }
 
     applyVirtualBandsToLabel();
+
+    m_overviewsStored.storeRelease(access == "rw" && overviewCount() > 0);
   }
 
 
@@ -824,6 +847,81 @@ namespace Isis {
   }
 
 
+  /**
+   * This method lets the cube start reading the data for the next few
+   * positions of a traversal in the background (see the CubeReadAhead
+   * Performance preference). It is only a hint; it does nothing if read ahead
+   * is turned off or the cube isn't opened read-only.
+   *
+   * @param upcoming The buffer manager that is walking the cube. The positions
+   *                 after its current position are read ahead.
+   */
+  void Cube::prefetch(const BufferManager &upcoming) const {
+    if (isOpen() && isReadOnly()) {
+      QMutexLocker locker(m_mutex);
+      m_ioHandler->prefetch(upcoming);
+    }
+  }
+
+
+  /**
+   * This method will read a buffer of data from one of the cube's overview
+   *   levels (see createOverviews()). The buffer's positions are in the
+   *   overview's coordinates, so the buffer should be set up with
+   *   overviewSampleCount() and overviewLineCount() as the cube size.
+   *   Positions outside of the overview are Null. Only the overview tiles
+   *   the buffer covers are read from the file, and a few recently used
+   *   tiles are kept until the cube is closed; the full resolution data is
+   *   never touched.
+   *
+   * @param bufferToFill Buffer to be loaded
+   * @param level The overview level to read, 1 is reduced by 2, 2 by 4 and
+   *              so on
+   */
+  void Cube::readOverview(Buffer &bufferToFill, int level) const {
+    if (!isOpen()) {
+      string msg = "Try opening a file before you read it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (level < 1 || level > overviewCount()) {
+      QString msg = "The cube [" + QFileInfo(fileName()).fileName() +
+          "] does not have overview level [" + toString(level) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QMutexLocker locker(m_mutex);
+
+    CubeOverview *overview = m_overviews->value(level);
+    if (!overview) {
+      FileName cubeFile = *m_labelFileName;
+      if (m_tempCube)
+        cubeFile = *m_tempCube;
+
+      overview = new CubeOverview(cubeFile.expanded(), *label(), level);
+      m_overviews->insert(level, overview);
+    }
+
+    double *buffer = bufferToFill.DoubleBuffer();
+    int index = 0;
+
+    for (int band = 0; band < bufferToFill.BandDimension(); band++) {
+      int virtualBand = bufferToFill.Band() + band;
+      int overviewBand = 0;
+
+      if (virtualBand >= 1 && virtualBand <= bandCount())
+        overviewBand = physicalBand(virtualBand);
+
+      for (int line = 0; line < bufferToFill.LineDimension(); line++) {
+        overview->readLine(bufferToFill.Sample(), bufferToFill.SampleDimension(),
+                           bufferToFill.Line() + line, overviewBand,
+                           buffer + index);
+        index += bufferToFill.SampleDimension();
+      }
+    }
+  }
+
+
   /**
    * This method will write a blob of data (e.g. History, Table, etc)
    * to the cube as specified by the contents of the Blob object.
@@ -896,7 +994,9 @@ namespace Isis {
 
   /**
    * This method will write a buffer of data from the cube as specified by the
-   * contents of the Buffer object.
+   * contents of the Buffer object. Several threads may write at once; the I/O
+   * handler locks the cube data itself, so threads writing different parts of
+   * the cube don't wait on each other.
    *
    * @param bufferToWrite Buffer to be written.
    */
@@ -918,11 +1018,88 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
-    QMutexLocker locker(m_mutex);
+    // The overviews would no longer match the DN data
+    if (m_overviewsStored.loadAcquire()) {
+      removeOverviews();
+    }
+
     m_ioHandler->write(bufferToWrite);
   }
 
 
+  /**
+   * This method creates reduced resolution copies of the cube's DN data and
+   *   stores them in the cube as Overview blobs, so that zoomed out views can
+   *   be read with readOverview() without reading the full resolution data.
+   *   Level 1 is reduced by 2 in samples and lines, level 2 by 4 and so on;
+   *   each level is made by averaging the valid pixels of the level before
+   *   it. The levels are stored in tiles and written a tile row at a time
+   *   (see CubeOverview), so they never have to fit in memory. Writing DN
+   *   data afterwards removes the overviews, so call this again after
+   *   writing to the cube.
+   *
+   * @param levelCount The number of levels to create. If this is 0, levels
+   *                   are added until the coarsest one fits in 256x256
+   *                   pixels.
+   */
+  void Cube::createOverviews(int levelCount) {
+    if (!isOpen()) {
+      string msg = "The cube is not opened so you can't create overviews for it";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (isReadOnly()) {
+      QString msg = "Cannot create overviews for the cube [" +
+          QFileInfo(fileName()).fileName() + "] because it is opened read-only";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (levelCount <= 0) {
+      levelCount = 0;
+      while (overviewSampleCount(levelCount) > 256 ||
+             overviewLineCount(levelCount) > 256) {
+        levelCount++;
+      }
+    }
+
+    {
+      QMutexLocker locker(m_mutex);
+      qDeleteAll(*m_overviews);
+      m_overviews->clear();
+    }
+
+    CubeOverview::create(*this, levelCount);
+    m_overviewsStored.storeRelease(1);
+  }
+
+
+  /**
+   * Removes the Overview blobs from the labels, so the overviews are gone once
+   *   the cube is closed. Their data stays in the file but is no longer
+   *   referenced. This is called when DN data is written to a cube with
+   *   overviews, because they no longer match it.
+   */
+  void Cube::removeOverviews() {
+    QMutexLocker locker(m_mutex);
+
+    // Another thread may have removed them while we waited
+    if (!m_overviewsStored.loadAcquire()) {
+      return;
+    }
+
+    for (int i = m_label->objects() - 1; i >= 0; i--) {
+      if (m_label->object(i).isNamed("Overview")) {
+        m_label->deleteObject(i);
+      }
+    }
+
+    qDeleteAll(*m_overviews);
+    m_overviews->clear();
+
+    m_overviewsStored.storeRelease(0);
+  }
+
+
   /**
    * Used prior to the Create method, this will specify the base and multiplier
    * for converting 8-bit/16-bit back and forth between 32-bit:
@@ -1043,10 +1220,10 @@ namespace Isis {
 
   /**
    * Used prior to the Create method, this will specify the format of the cube,
-   * either band, sequential or tiled.
+   * either band, sequential, tiled or compressed tiles.
    * If not invoked, a tiled file will be created.
    *
-   * @param format An enumeration of either Bsq or Tile.
+   * @param format An enumeration of either Bsq, Tile or Compressed.
    */
   void Cube::setFormat(Format format) {
     openCheck();
@@ -1488,6 +1665,36 @@ namespace Isis {
   }
 
 
+  /**
+   * @return The number of overview levels stored in the cube, see
+   *   createOverviews()
+   */
+  int Cube::overviewCount() const {
+    if (!m_label)
+      return 0;
+
+    return CubeOverview::levelCount(*m_label);
+  }
+
+
+  /**
+   * @param level The overview level, 0 is the full resolution cube
+   * @return The number of samples in the given overview level
+   */
+  int Cube::overviewSampleCount(int level) const {
+    return CubeOverview::reducedSize(sampleCount(), level);
+  }
+
+
+  /**
+   * @param level The overview level, 0 is the full resolution cube
+   * @return The number of lines in the given overview level
+   */
+  int Cube::overviewLineCount(int level) const {
+    return CubeOverview::reducedSize(lineCount(), level);
+  }
+
+
   /**
    * Returns the number of bytes used by the label.
    *
@@ -1915,6 +2122,9 @@ namespace Isis {
     delete m_virtualBandList;
     m_virtualBandList = NULL;
 
+    qDeleteAll(*m_overviews);
+    m_overviews->clear();
+
     initialize();
   }
 
@@ -1941,6 +2151,7 @@ namespace Isis {
     m_virtualBandList = NULL;
 
     m_mutex = new QMutex();
+    m_overviews = new QMap<int, CubeOverview *>;
     m_formatTemplateFile =
          new FileName("$ISISROOT/appdata/templates/labels/CubeFormatTemplate.pft");
 
@@ -2051,6 +2262,8 @@ namespace Isis {
 
     m_base = 0.0;
     m_multiplier = 1.0;
+
+    m_overviewsStored.storeRelease(0);
   }
 
 
@@ -2080,6 +2293,9 @@ namespace Isis {
       if ((QString) core["Format"] == "BandSequential") {
         m_format = Bsq;
       }
+      else if ((QString) core["Format"] == "Compressed") {
+        m_format = Compressed;
+      }
       else {
         m_format = Tile;
       }
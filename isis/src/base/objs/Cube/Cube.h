@@ -26,6 +26,8 @@
 #include <vector>
 
 // This is needed for the QVariant macro
+#include <QAtomicInt>
+#include <QMap>
 #include <QMetaType>
 
 #include <nlohmann/json.hpp>
@@ -40,9 +42,11 @@ class QString;
 namespace Isis {
   class Blob;
   class Buffer;
+  class BufferManager;
   class Camera;
   class CubeAttributeOutput;
   class CubeCachingAlgorithm;
+  class CubeOverview;
   class CubeIoHandler;
   class FileName;
   class Projection;
@@ -234,7 +238,14 @@ namespace Isis {
          * The symbol '*' denotes tile boundaries.
          * The symbols '-' and '|' denote cube boundaries.
          */
-        Tile
+        Tile,
+        /**
+         * Cubes are stored in tiles like the Tile format, but each tile is
+         *   compressed on its own. The data area starts with an index giving
+         *   the position and size of every tile, so any tile can be read
+         *   without decompressing the others. See CubeCompressedTileHandler.
+         */
+        Compressed
       };
 
       void fromIsd(const FileName &fileName, Pvl &label, nlohmann::json &isd, QString access);
@@ -259,8 +270,11 @@ namespace Isis {
 
       void read(Blob &blob) const;
       void read(Buffer &rbuf) const;
+      void prefetch(const BufferManager &upcoming) const;
+      void readOverview(Buffer &rbuf, int level) const;
       void write(Blob &blob);
       void write(Buffer &wbuf);
+      void createOverviews(int levelCount = 0);
 
       void setBaseMultiplier(double base, double mult);
       void setMinMax(double min, double max);
@@ -290,6 +304,9 @@ namespace Isis {
                                    const double &validMax,
                                    QString msg = "Gathering histogram");
       Pvl *label() const;
+      int overviewCount() const;
+      int overviewSampleCount(int level) const;
+      int overviewLineCount(int level) const;
       int labelSize(bool actual = false) const;
       int lineCount() const;
       double multiplier() const;
@@ -329,6 +346,7 @@ namespace Isis {
       void openCheck();
       Pvl realDataFileLabel() const;
       void reformatOldIsisLabel(const QString &oldCube);
+      void removeOverviews();
       void writeLabels();
 
     private:
@@ -439,6 +457,15 @@ namespace Isis {
 
       //! If allocated, converts from physical on-disk band # to virtual band #
       QList<int> *m_virtualBandList;
+
+      //! The overview levels that have been opened by readOverview(), by level
+      mutable QMap<int, CubeOverview *> *m_overviews;
+
+      /**
+       * Non-zero if the cube is open read-write and stores overviews, which
+       *   have to be removed once the DN data is written.
+       */
+      QAtomicInt m_overviewsStored;
   };
 }
 
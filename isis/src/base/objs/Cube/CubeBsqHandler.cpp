@@ -91,10 +91,10 @@ namespace Isis {
   void CubeBsqHandler::readRaw(RawCubeChunk &chunkToFill) {
     BigInt startByte = getChunkStartByte(chunkToFill);
 
-    bool success = false;
+    bool success = readMappedRaw(chunkToFill, startByte);
 
     QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
+    if(!success && dataFile->seek(startByte)) {
       QByteArray binaryData = dataFile->read(chunkToFill.getByteCount());
 
       if(binaryData.size() == chunkToFill.getByteCount()) {
@@ -0,0 +1,528 @@
+/**
+ * @file
+ * $Revision: 1.4 $
+ * $Date: 2007/09/14 16:44:07 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "CubeCompressedTileHandler.h"
+
+#include <algorithm>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QMap>
+
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlObject.h"
+#include "PvlKeyword.h"
+#include "RawCubeChunk.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Construct a compressed tile handler. This determines the tile size the
+   *   same way the Tile format does and then reads the tile index if the cube
+   *   is already on disk.
+   *
+   * @param dataFile The file with cube DN data in it
+   * @param virtualBandList The mapping from virtual band to physical band, see
+   *          CubeIoHandler's description.
+   * @param labels The Pvl labels for the cube
+   * @param alreadyOnDisk True if the cube is allocated on the disk, false
+   *          otherwise
+   */
+  CubeCompressedTileHandler::CubeCompressedTileHandler(QFile * dataFile,
+      const QList<int> *virtualBandList, const Pvl &labels, bool alreadyOnDisk)
+      : CubeIoHandler(dataFile, virtualBandList, labels, alreadyOnDisk) {
+    m_tileOffsets = new QVector<BigInt>;
+    m_tileSizes = new QVector<BigInt>;
+    m_tileCapacities = new QVector<BigInt>;
+    m_freeSpace = new QMap<BigInt, BigInt>;
+    m_dataExtent = 0;
+    m_indexChanged = false;
+
+    const PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+
+    if(core.hasKeyword("Format")) {
+      if(core.hasKeyword("Compression") &&
+         (QString)core["Compression"] != "Zlib") {
+        QString msg = "The compression [" + (QString)core["Compression"] +
+            "] of the cube data in [" + dataFile->fileName() + "] is not "
+            "supported";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      setChunkSizes(core["TileSamples"], core["TileLines"], 1);
+    }
+    else {
+      // up to 1MB chunks
+      int sampleChunkSize =
+          findGoodSize(512 * 4 / SizeOf(pixelType()), sampleCount());
+      int lineChunkSize =
+          findGoodSize(512 * 4 / SizeOf(pixelType()), lineCount());
+
+      setChunkSizes(sampleChunkSize, lineChunkSize, 1);
+    }
+
+    int tileCount = getIndexSize() / (3 * sizeof(qint64));
+    m_tileOffsets->fill(0, tileCount);
+    m_tileSizes->fill(0, tileCount);
+    m_tileCapacities->fill(0, tileCount);
+
+    if(alreadyOnDisk) {
+      readIndex();
+    }
+    else {
+      m_indexChanged = true;
+    }
+  }
+
+
+  /**
+   * Writes any data still in memory to disk, followed by the tile index.
+   *   Cube::close() flushes before deleting the handler and reports any
+   *   errors, so this only writes anything when the cube wasn't closed. A
+   *   destructor can't throw, so a failure here is printed.
+   */
+  CubeCompressedTileHandler::~CubeCompressedTileHandler() {
+    try {
+      flush();
+    }
+    catch (IException &e) {
+      QString msg = "Writing the compressed cube data to the file [" +
+          getDataFile()->fileName() + "] failed; the cube is incomplete";
+      IException(e, IException::Io, msg, _FILEINFO_).print();
+    }
+
+    delete m_tileOffsets;
+    m_tileOffsets = NULL;
+
+    delete m_tileSizes;
+    m_tileSizes = NULL;
+
+    delete m_tileCapacities;
+    m_tileCapacities = NULL;
+
+    delete m_freeSpace;
+    m_freeSpace = NULL;
+  }
+
+
+  /**
+   * Write all data from memory to disk, followed by the tile index.
+   */
+  void CubeCompressedTileHandler::flush() {
+    CubeIoHandler::flush();
+    writeIndex();
+  }
+
+
+  /**
+   * @return the number of bytes the tile index and every stored tile take up,
+   *   including any space left behind by tiles that were moved.
+   */
+  BigInt CubeCompressedTileHandler::getDataSize() const {
+    return max(getIndexSize(), m_dataExtent);
+  }
+
+
+  /**
+   * Update the cube labels so that this cube indicates what tile size and
+   *   compression it used.
+   *
+   * @param labels The "Core" object in this Pvl will be updated
+   */
+  void CubeCompressedTileHandler::updateLabels(Pvl &labels) {
+    PvlObject &core = labels.findObject("IsisCube").findObject("Core");
+    core.addKeyword(PvlKeyword("Format", "Compressed"),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileSamples", toString(getSampleCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("TileLines", toString(getLineCountInChunk())),
+                    PvlContainer::Replace);
+    core.addKeyword(PvlKeyword("Compression", "Zlib"),
+                    PvlContainer::Replace);
+  }
+
+
+  void CubeCompressedTileHandler::readRaw(RawCubeChunk &chunkToFill) {
+    int tileIndex = getChunkIndex(chunkToFill);
+    BigInt startByte = getDataStartByte() + (*m_tileOffsets)[tileIndex];
+    BigInt storedSize = (*m_tileSizes)[tileIndex];
+    bool success = false;
+
+    QFile * dataFile = getDataFile();
+    if(storedSize > 0 && dataFile->seek(startByte)) {
+      QByteArray storedData = dataFile->read(storedSize);
+
+      if(storedData.size() == storedSize) {
+        QByteArray rawData = decodeTile(storedData,
+                                        chunkToFill.getByteCount());
+
+        if(rawData.size() == chunkToFill.getByteCount()) {
+          chunkToFill.setRawData(rawData);
+          success = true;
+        }
+      }
+    }
+
+    if(!success) {
+      QString msg = "Reading from the file [" + dataFile->fileName() + "] "
+          "failed with reading compressed tile [" + QString::number(tileIndex) +
+          "] of [" + QString::number(storedSize) + "] bytes at position [" +
+          QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  void CubeCompressedTileHandler::writeRaw(const RawCubeChunk &chunkToWrite) {
+    int tileIndex = getChunkIndex(chunkToWrite);
+    QByteArray storedData = encodeTile(chunkToWrite.getRawData());
+
+    QFile * dataFile = getDataFile();
+    BigInt offset = allocateTile(tileIndex, storedData.size());
+    BigInt startByte = getDataStartByte() + offset;
+    bool success = false;
+
+    if(dataFile->seek(startByte)) {
+      BigInt dataWritten = dataFile->write(storedData);
+
+      if(dataWritten == storedData.size()) {
+        success = true;
+      }
+    }
+
+    if(!success) {
+      QString msg = "Writing to the file [" + dataFile->fileName() + "] "
+          "failed with writing [" + QString::number(storedData.size()) +
+          "] bytes at position [" + QString::number(startByte) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    (*m_tileSizes)[tileIndex] = storedData.size();
+    m_dataExtent = max(m_dataExtent, offset + (*m_tileCapacities)[tileIndex]);
+    m_indexChanged = true;
+  }
+
+
+  /**
+   * Find a place for a tile of the given size. The tile stays where it is if
+   *   it fits in the space it holds. Otherwise that space is released and the
+   *   tile is given the first released space that is big enough, or new space
+   *   at the end of the file so we never write over anything else stored
+   *   there. The tile's offset and capacity are updated.
+   *
+   * @param tileIndex The tile being written
+   * @param storedSize The number of bytes the encoded tile takes up
+   * @return The position of the tile relative to the start of the cube data
+   */
+  BigInt CubeCompressedTileHandler::allocateTile(int tileIndex,
+                                                 BigInt storedSize) {
+    BigInt capacity = (*m_tileCapacities)[tileIndex];
+    if(storedSize <= capacity) {
+      return (*m_tileOffsets)[tileIndex];
+    }
+
+    if(capacity > 0) {
+      releaseSpace((*m_tileOffsets)[tileIndex], capacity);
+    }
+
+    BigInt offset = -1;
+    QMap<BigInt, BigInt>::iterator space = m_freeSpace->begin();
+    while(space != m_freeSpace->end() && offset < 0) {
+      if(space.value() >= storedSize) {
+        offset = space.key();
+        BigInt remaining = space.value() - storedSize;
+        m_freeSpace->erase(space);
+
+        if(remaining > 0) {
+          m_freeSpace->insert(offset + storedSize, remaining);
+        }
+      }
+      else {
+        space++;
+      }
+    }
+
+    if(offset < 0) {
+      offset = max((BigInt)getDataFile()->size() - getDataStartByte(),
+                   getDataSize());
+    }
+
+    (*m_tileOffsets)[tileIndex] = offset;
+    (*m_tileCapacities)[tileIndex] = storedSize;
+    return offset;
+  }
+
+
+  /**
+   * Give space held by a tile back so other tiles can use it. Neighbouring
+   *   released spaces are joined.
+   *
+   * @param offset The start of the space relative to the start of the cube
+   *     data
+   * @param size The number of bytes in the space
+   */
+  void CubeCompressedTileHandler::releaseSpace(BigInt offset, BigInt size) {
+    QMap<BigInt, BigInt>::iterator next = m_freeSpace->lowerBound(offset);
+
+    if(next != m_freeSpace->end() && next.key() == offset + size) {
+      size += next.value();
+      next = m_freeSpace->erase(next);
+    }
+
+    if(next != m_freeSpace->begin()) {
+      QMap<BigInt, BigInt>::iterator previous = next - 1;
+      if(previous.key() + previous.value() == offset) {
+        previous.value() += size;
+        return;
+      }
+    }
+
+    m_freeSpace->insert(offset, size);
+  }
+
+
+  /**
+   * This is a helper method that tries to compute a good tile size for
+   *   one of the cube's dimensions (sample or line). Band tile size is always
+   *   1 for this format currently.
+   *
+   * @param maxSize The largest allowed size
+   * @param dimensionSize The cube's size in the dimension we're figuring out
+   *     (that is, number of samples or number of lines).
+   * @return The tile size that should be used for the dimension
+   */
+  int CubeCompressedTileHandler::findGoodSize(int maxSize,
+                                              int dimensionSize) const {
+    int ideal = 128;
+
+    if(dimensionSize <= maxSize) {
+      ideal = dimensionSize;
+    }
+    else {
+      int greatestDividend = maxSize;
+
+      while(greatestDividend > ideal) {
+        if(dimensionSize % greatestDividend == 0) {
+          ideal = greatestDividend;
+        }
+
+        greatestDividend --;
+      }
+    }
+
+    return ideal;
+  }
+
+
+  /**
+   * @return The number of bytes the tile index takes up at the start of the
+   *   cube data
+   */
+  BigInt CubeCompressedTileHandler::getIndexSize() const {
+    return (BigInt)getChunkCountInSampleDimension() *
+           (BigInt)getChunkCountInLineDimension() *
+           (BigInt)getChunkCountInBandDimension() *
+           (BigInt)(3 * sizeof(qint64));
+  }
+
+
+  /**
+   * Read the position, size and capacity of every tile from the start of the
+   *   cube data. Any space between the stored tiles was left behind by tiles
+   *   that moved, so it is released for reuse.
+   */
+  void CubeCompressedTileHandler::readIndex() {
+    QFile * dataFile = getDataFile();
+    QByteArray indexData;
+
+    if(dataFile->seek(getDataStartByte())) {
+      indexData = dataFile->read(getIndexSize());
+    }
+
+    if(indexData.size() != getIndexSize()) {
+      QString msg = "Reading the compressed tile index from the file [" +
+          dataFile->fileName() + "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    QDataStream indexStream(indexData);
+    indexStream.setByteOrder(QDataStream::LittleEndian);
+
+    QMap<BigInt, BigInt> tileSpaces;
+    for(int i = 0; i < m_tileOffsets->size(); i++) {
+      qint64 offset;
+      qint64 size;
+      qint64 capacity;
+      indexStream >> offset >> size >> capacity;
+
+      (*m_tileOffsets)[i] = offset;
+      (*m_tileSizes)[i] = size;
+      (*m_tileCapacities)[i] = max(size, capacity);
+      m_dataExtent = max(m_dataExtent, (BigInt)offset + (*m_tileCapacities)[i]);
+
+      if(size > 0) {
+        tileSpaces.insert(offset, (*m_tileCapacities)[i]);
+      }
+    }
+
+    // Only the space after the first tile is known to hold nothing but tiles
+    BigInt spaceStart = -1;
+    QMapIterator<BigInt, BigInt> space(tileSpaces);
+    while(space.hasNext()) {
+      space.next();
+
+      if(spaceStart >= 0 && space.key() > spaceStart) {
+        releaseSpace(spaceStart, space.key() - spaceStart);
+      }
+
+      spaceStart = max(spaceStart, space.key() + space.value());
+    }
+  }
+
+
+  /**
+   * Write the position, size and capacity of every tile to the start of the
+   *   cube data if any tile has been written since the index was last read.
+   */
+  void CubeCompressedTileHandler::writeIndex() {
+    if(!m_indexChanged) {
+      return;
+    }
+
+    QByteArray indexData;
+    QDataStream indexStream(&indexData, QIODevice::WriteOnly);
+    indexStream.setByteOrder(QDataStream::LittleEndian);
+
+    for(int i = 0; i < m_tileOffsets->size(); i++) {
+      indexStream << (qint64)(*m_tileOffsets)[i] << (qint64)(*m_tileSizes)[i]
+                  << (qint64)(*m_tileCapacities)[i];
+    }
+
+    QFile * dataFile = getDataFile();
+    if(!dataFile->seek(getDataStartByte()) ||
+       dataFile->write(indexData) != indexData.size()) {
+      QString msg = "Writing the compressed tile index to the file [" +
+          dataFile->fileName() + "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    m_indexChanged = false;
+  }
+
+
+  /**
+   * Compress a tile for writing to disk. Pixels wider than one byte are
+   *   shuffled first, so that the more predictable high order bytes of
+   *   neighbouring pixels end up next to each other. If compression doesn't
+   *   make the tile smaller, the tile is stored raw.
+   *
+   * @param rawData The tile in its on disk pixel format
+   * @return The tile as it should be stored, including the encoding byte
+   */
+  QByteArray CubeCompressedTileHandler::encodeTile(
+      const QByteArray &rawData) const {
+    int pixelSize = SizeOf(pixelType());
+    int pixelCount = rawData.size() / pixelSize;
+
+    char encoding = ZlibTile;
+    QByteArray compressed;
+
+    if(pixelSize > 1) {
+      QByteArray shuffled(rawData.size(), 0);
+      const char *raw = rawData.constData();
+      char *shuffledData = shuffled.data();
+
+      for(int byte = 0; byte < pixelSize; byte++) {
+        char *destination = shuffledData + byte * pixelCount;
+        for(int pixel = 0; pixel < pixelCount; pixel++) {
+          destination[pixel] = raw[pixel * pixelSize + byte];
+        }
+      }
+
+      encoding = ShuffledZlibTile;
+      compressed = qCompress(shuffled, 1);
+    }
+    else {
+      compressed = qCompress(rawData, 1);
+    }
+
+    if(compressed.size() >= rawData.size()) {
+      encoding = RawTile;
+      compressed = rawData;
+    }
+
+    return compressed.prepend(encoding);
+  }
+
+
+  /**
+   * Undo encodeTile().
+   *
+   * @param storedData The tile as it was stored, including the encoding byte
+   * @param expectedSize The number of bytes in the raw tile
+   * @return The tile in its on disk pixel format, or an empty array if the
+   *     stored data is not valid
+   */
+  QByteArray CubeCompressedTileHandler::decodeTile(
+      const QByteArray &storedData, int expectedSize) const {
+    QByteArray rawData;
+
+    if(storedData.isEmpty()) {
+      return rawData;
+    }
+
+    char encoding = storedData[0];
+    QByteArray payload = QByteArray::fromRawData(storedData.constData() + 1,
+                                                 storedData.size() - 1);
+
+    if(encoding == RawTile) {
+      rawData = QByteArray(payload.constData(), payload.size());
+    }
+    else if(encoding == ZlibTile) {
+      rawData = qUncompress(payload);
+    }
+    else if(encoding == ShuffledZlibTile) {
+      QByteArray shuffled = qUncompress(payload);
+      int pixelSize = SizeOf(pixelType());
+
+      if(shuffled.size() == expectedSize) {
+        int pixelCount = expectedSize / pixelSize;
+        rawData.resize(expectedSize);
+        const char *shuffledData = shuffled.constData();
+        char *raw = rawData.data();
+
+        for(int byte = 0; byte < pixelSize; byte++) {
+          const char *source = shuffledData + byte * pixelCount;
+          for(int pixel = 0; pixel < pixelCount; pixel++) {
+            raw[pixel * pixelSize + byte] = source[pixel];
+          }
+        }
+      }
+    }
+
+    return rawData;
+  }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#ifndef CubeCompressedTileHandler_h
+#define CubeCompressedTileHandler_h
+
+#include "CubeIoHandler.h"
+
+#include <QMap>
+#include <QVector>
+
+namespace Isis {
+
+  /**
+   * @brief IO Handler for Isis Cubes using the compressed tile format.
+   *
+   * Cubes in this format are split into tiles the same way as the Tile
+   *   format, but every tile is compressed separately before it is written.
+   *   Tiles are independent of each other, so reading a small area of a large
+   *   cube only decompresses the tiles that overlap it.
+   *
+   * The data area of the cube starts with an index of every tile's position
+   *   (relative to the start of the data area), stored size and the space
+   *   held for it, written as triples of little endian 64 bit integers in
+   *   tile order. The compressed
+   *   tiles follow the index in no particular order. Each stored tile starts
+   *   with a single byte naming how it was encoded:
+   *   <ul>
+   *     <li>0 - the raw tile, used when compression does not shrink it</li>
+   *     <li>1 - the tile compressed with zlib</li>
+   *     <li>2 - the bytes of each pixel grouped by significance (shuffled)
+   *           and then compressed with zlib</li>
+   *   </ul>
+   *
+   * A rewritten tile is put back in its old place when it fits in the space
+   *   that place has held so far. Otherwise the old place is released and the
+   *   tile goes in the first released space it fits in, or at the end of the
+   *   file. Tiles are never written over anything else in the file (such as
+   *   attached blobs). Space between the tiles is released again when the cube
+   *   is opened.
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   *   @history 2026-10-16 Isis Development Team - Track the space each tile
+   *                           holds separately from its stored size and reuse
+   *                           the space of moved tiles. A flush failure in the
+   *                           destructor is printed instead of ignored.
+   */
+  class CubeCompressedTileHandler : public CubeIoHandler {
+    public:
+      CubeCompressedTileHandler(QFile * dataFile,
+          const QList<int> *virtualBandList, const Pvl &label,
+          bool alreadyOnDisk);
+      ~CubeCompressedTileHandler();
+
+      void flush();
+      BigInt getDataSize() const;
+      void updateLabels(Pvl &label);
+
+    protected:
+      virtual void readRaw(RawCubeChunk &chunkToFill);
+      virtual void writeRaw(const RawCubeChunk &chunkToWrite);
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeCompressedTileHandler(const CubeCompressedTileHandler &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeCompressedTileHandler on the right-hand side of
+       *              the assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeCompressedTileHandler &operator=(
+          const CubeCompressedTileHandler &other);
+
+      /**
+       * How a tile is stored on disk. This is the first byte of every stored
+       *   tile.
+       */
+      enum TileEncoding {
+        //! The tile is stored as is.
+        RawTile = 0,
+        //! The tile is compressed with zlib.
+        ZlibTile = 1,
+        //! The tile's bytes are shuffled and then compressed with zlib.
+        ShuffledZlibTile = 2
+      };
+
+      int findGoodSize(int maxSize, int dimensionSize) const;
+      BigInt getIndexSize() const;
+      void readIndex();
+      void writeIndex();
+      BigInt allocateTile(int tileIndex, BigInt storedSize);
+      void releaseSpace(BigInt offset, BigInt size);
+
+      QByteArray encodeTile(const QByteArray &rawData) const;
+      QByteArray decodeTile(const QByteArray &storedData,
+                            int expectedSize) const;
+
+      //! Position of each tile relative to the start of the cube data.
+      QVector<BigInt> *m_tileOffsets;
+      //! Number of bytes each tile takes up on disk, 0 if not written yet.
+      QVector<BigInt> *m_tileSizes;
+      //! Number of bytes each tile may grow to in its current place.
+      QVector<BigInt> *m_tileCapacities;
+      //! Space left by moved tiles, by position relative to the cube data.
+      QMap<BigInt, BigInt> *m_freeSpace;
+      //! The end of the last tile relative to the start of the cube data.
+      BigInt m_dataExtent;
+      //! True if the index on disk needs to be rewritten.
+      bool m_indexChanged;
+  };
+}
+
+#endif
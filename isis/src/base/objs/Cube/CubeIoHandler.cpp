@@ -36,10 +36,12 @@
 #include <QMutex>
 #include <QPair>
 #include <QRect>
+#include <QSet>
 #include <QTime>
 
 #include "Area3D.h"
 #include "Brick.h"
+#include "BufferManager.h"
 #include "CubeCachingAlgorithm.h"
 #include "Displacement.h"
 #include "Distance.h"
@@ -53,6 +55,7 @@
 #include "PvlGroup.h"
 #include "PvlObject.h"
 #include "RawCubeChunk.h"
+#include "RawPixelConverter.h"
 #include "RegionalCachingAlgorithm.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
@@ -80,14 +83,26 @@ namespace Isis {
       const QList<int> *virtualBandList, const Pvl &label, bool alreadyOnDisk) {
     m_byteSwapper = NULL;
     m_cachingAlgorithms = NULL;
+    m_mappedData = NULL;
+    m_useMemoryMapping = false;
+    m_pixelConverter = NULL;
     m_dataIsOnDiskMap = NULL;
     m_rawData = NULL;
     m_virtualBands = NULL;
     m_nullChunkData = NULL;
     m_lastProcessByLineChunks = NULL;
     m_writeCache = NULL;
+    m_writeCacheMutex = NULL;
     m_ioThreadPool = NULL;
     m_writeThreadMutex = NULL;
+    m_chunkCacheMutex = NULL;
+    m_chunkMutexes = NULL;
+    m_chunksBeingWritten = NULL;
+    m_readAheadCount = 0;
+    m_readAheadPosition = -1;
+    m_readAheadLastMap = -1;
+    m_prefetchingChunks = NULL;
+    m_prefetchedChunks = NULL;
 
     try {
       if (!dataFile) {
@@ -107,14 +122,29 @@ namespace Isis {
         m_ioThreadPool->setMaxThreadCount(1);
       }
 
-      m_consecutiveOverflowCount = 0;
-      m_lastOperationWasWrite = false;
+      if (performancePrefs.hasKeyword("CubeMemoryMapping")) {
+        IString memoryMappingPerfOpt = performancePrefs["CubeMemoryMapping"][0];
+        m_useMemoryMapping = (memoryMappingPerfOpt.DownCase() == "always");
+      }
+
+      if (performancePrefs.hasKeyword("CubeReadAhead")) {
+        m_readAheadCount = max(0, (int)performancePrefs["CubeReadAhead"]);
+      }
+
+      m_consecutiveOverflowCount.storeRelease(0);
+      m_lastOperationWasWrite.storeRelease(0);
+      m_useWriteThread.storeRelease(1);
       m_rawData = new QMap<int, RawCubeChunk *>;
-      m_writeCache = new QPair< QMutex *, QList<Buffer *> >;
-      m_writeCache->first = new QMutex;
+      m_writeCache = new WriteCache;
+      m_writeCacheMutex = new QMutex;
       m_writeThreadMutex = new QMutex;
+      m_chunkCacheMutex = new QMutex;
+      m_chunkMutexes = new QMutex[ChunkMutexCount];
+      m_chunksBeingWritten = new QMap<int, int>;
+      m_prefetchingChunks = new QSet<int>;
+      m_prefetchedChunks = new QSet<int>;
 
-      m_idealFlushSize = 32;
+      m_idealFlushSize.storeRelease(32);
 
       m_cachingAlgorithms->append(new RegionalCachingAlgorithm);
 
@@ -130,6 +160,9 @@ namespace Isis {
       m_multiplier = pixelGroup.findKeyword("Multiplier");
       m_pixelType = PixelTypeEnumeration(pixelGroup.findKeyword("Type"));
 
+      m_pixelConverter = new RawPixelConverter(m_pixelType,
+          m_byteSwapper->willSwap(), m_base, m_multiplier);
+
       // If the byte swapper isn't going to do anything, then get rid of it
       //   because it's quicker to check for a NULL byte swapper member than to
       //   call a swap that won't do anything.
@@ -176,6 +209,13 @@ namespace Isis {
     if (m_ioThreadPool)
       m_ioThreadPool->waitForDone();
 
+    // The cached chunks are gone (clearCache()), so nothing references the
+    //   mapped data anymore.
+    if (m_mappedData) {
+      m_dataFile->unmap(m_mappedData);
+      m_mappedData = NULL;
+    }
+
     delete m_ioThreadPool;
     m_ioThreadPool = NULL;
 
@@ -205,22 +245,27 @@ namespace Isis {
       m_rawData = NULL;
     }
 
-    if (m_writeCache) {
-      delete m_writeCache->first;
-      m_writeCache->first = NULL;
+    delete m_writeCache;
+    m_writeCache = NULL;
+
+    delete m_writeCacheMutex;
+    m_writeCacheMutex = NULL;
 
-      for (int i = 0; i < m_writeCache->second.size(); i++) {
-        delete m_writeCache->second[i];
-      }
-      m_writeCache->second.clear();
+    delete m_chunkCacheMutex;
+    m_chunkCacheMutex = NULL;
 
-      delete m_writeCache;
-      m_writeCache = NULL;
-    }
+    delete [] m_chunkMutexes;
+    m_chunkMutexes = NULL;
+
+    delete m_chunksBeingWritten;
+    m_chunksBeingWritten = NULL;
 
     delete m_byteSwapper;
     m_byteSwapper = NULL;
 
+    delete m_pixelConverter;
+    m_pixelConverter = NULL;
+
     delete m_virtualBands;
     m_virtualBands = NULL;
 
@@ -230,6 +275,12 @@ namespace Isis {
     delete m_lastProcessByLineChunks;
     m_lastProcessByLineChunks = NULL;
 
+    delete m_prefetchingChunks;
+    m_prefetchingChunks = NULL;
+
+    delete m_prefetchedChunks;
+    m_prefetchedChunks = NULL;
+
     delete m_writeThreadMutex;
     m_writeThreadMutex = NULL;
   }
@@ -244,25 +295,27 @@ namespace Isis {
    * @param bufferToFill The buffer to populate with cube data.
    */
   void CubeIoHandler::read(Buffer &bufferToFill) const {
-    // We need to record the current chunk count size so we can use
-    // it to evaluate if the cache should be minimized
-    int lastChunkCount = m_rawData->size();
+    if (m_lastOperationWasWrite.loadAcquire()) {
+      // Stop backgrounding writes now, we don't want to keep incurring this
+      //   penalty. The thread pool is kept because other threads may be
+      //   writing.
+      if (m_useOptimizedCubeWrite) {
+        m_useWriteThread.storeRelease(0);
+      }
 
-    if (m_lastOperationWasWrite) {
       // Do the remaining writes
       flushWriteCache(true);
 
-      m_lastOperationWasWrite = false;
-
-      // Stop backgrounding writes now, we don't want to keep incurring this
-      //   penalty.
-      if (m_useOptimizedCubeWrite) {
-        delete m_ioThreadPool;
-        m_ioThreadPool = NULL;
-      }
+      m_lastOperationWasWrite.storeRelease(0);
     }
 
-    QMutexLocker lock(m_writeThreadMutex);
+    QMutexLocker lock(m_chunkCacheMutex);
+
+    // We need to record the current chunk count size so we can use
+    // it to evaluate if the cache should be minimized. The read ahead
+    // (prefetch()) adds chunks from the I/O thread, so this has to be done
+    // while we hold the lock.
+    int lastChunkCount = m_rawData->size();
 
     // NON-THREADED CUBE READ
     QList<RawCubeChunk *> cubeChunks;
@@ -331,12 +384,26 @@ namespace Isis {
       chunkBands = chunkInfo.second;
     }
 
+    // Writers convert into chunks without the cache lock (see
+    //   synchronousWrite()), so lock each chunk while reading it.
     for (int i = 0; i < cubeChunks.size(); i++) {
+      QMutexLocker chunkLock(chunkMutex(getChunkIndex(*cubeChunks[i])));
       writeIntoDouble(*cubeChunks[i], bufferToFill, chunkBands[i]);
     }
 
+    // Chunks that were read ahead are no longer protected from the caching
+    //   algorithms once they have been used.
+    bool usedPrefetchedChunks = false;
+    if (!m_prefetchedChunks->isEmpty()) {
+      foreach (RawCubeChunk *chunk, cubeChunks) {
+        if (m_prefetchedChunks->remove(getChunkIndex(*chunk))) {
+          usedPrefetchedChunks = true;
+        }
+      }
+    }
+
     // Minimize the cache if it changed in size
-    if (lastChunkCount != m_rawData->size()) {
+    if (lastChunkCount != m_rawData->size() || usedPrefetchedChunks) {
       minimizeCache(cubeChunks, bufferToFill);
     }
   }
@@ -349,25 +416,102 @@ namespace Isis {
    *   and our caching algorithms say to not free any of the cube chunks
    *   afterwards.
    *
+   * This may be called from several threads at once. Buffers queued for the
+   *   write thread are appended to a lock-free queue. Otherwise the buffer is
+   *   converted into its chunks on the calling thread, and threads writing
+   *   different chunks do that at the same time (see synchronousWrite()).
+   *   Writes to the same pixels from different threads land in no particular
+   *   order.
+   *
    * @param bufferToWrite The buffer to get cube data from.
    */
   void CubeIoHandler::write(const Buffer &bufferToWrite) {
-    m_lastOperationWasWrite = true;
+    m_lastOperationWasWrite.storeRelease(1);
 
     if (m_ioThreadPool) {
-      // THREADED CUBE WRITE
-      Buffer * copy = new Buffer(bufferToWrite);
-      {
-        QMutexLocker locker(m_writeCache->first);
-        m_writeCache->second.append(copy);
+      if (m_useWriteThread.loadAcquire()) {
+        // THREADED CUBE WRITE
+        m_writeCache->append(new Buffer(bufferToWrite));
+
+        flushWriteCache();
+        return;
       }
 
-      flushWriteCache();
+      // The write thread was turned off. Anything that was queued before
+      //   that goes first.
+      if (m_writeCache->size() > 0) {
+        flushWriteCache(true);
+      }
     }
-    else {
-      QMutexLocker lock(m_writeThreadMutex);
-      // NON-THREADED CUBE WRITE
-      synchronousWrite(bufferToWrite);
+
+    // NON-THREADED CUBE WRITE
+    synchronousWrite(bufferToWrite);
+  }
+
+
+  /**
+   * Start reading the cube data for the next few positions of the given
+   *   traversal into the cache on the I/O thread, so that it is (hopefully)
+   *   already in memory when read() asks for it. The number of positions is
+   *   the CubeReadAhead Performance preference; nothing happens if it is 0.
+   *
+   * Call this with the buffer manager that is about to be read, before or
+   *   after reading it. Only read-only cubes are read ahead.
+   *
+   * @param upcoming The traversal that will be read. Positions after its
+   *                 current position are read ahead; it isn't modified.
+   */
+  void CubeIoHandler::prefetch(const BufferManager &upcoming) const {
+    if (m_readAheadCount <= 0 || m_dataIsOnDiskMap ||
+        m_lastOperationWasWrite.loadAcquire() ||
+        (m_dataFile->openMode() & QIODevice::WriteOnly)) {
+      return;
+    }
+
+    QMutexLocker lock(m_chunkCacheMutex);
+
+    // Start over if this is a new traversal, the traversal changed direction
+    //   or we were left behind. The chunks read ahead for the old positions
+    //   won't be used in order anymore, so stop protecting them.
+    BigInt currentMap = upcoming.currentMap();
+    if (currentMap < m_readAheadLastMap ||
+        m_readAheadPosition < currentMap ||
+        m_readAheadPosition > currentMap + m_readAheadCount) {
+      expirePrefetchedChunks();
+      m_readAheadPosition = currentMap;
+    }
+    m_readAheadLastMap = currentMap;
+
+    QList<int> chunkIndices;
+    QList<int> chunkBands;
+    int sample;
+    int line;
+    int band;
+    while (m_readAheadPosition < currentMap + m_readAheadCount &&
+           upcoming.positionOf(m_readAheadPosition + 1, sample, line, band)) {
+      findChunkIndices(sample, upcoming.SampleDimension(),
+                       line, upcoming.LineDimension(),
+                       band, upcoming.BandDimension(),
+                       chunkIndices, chunkBands);
+      m_readAheadPosition++;
+    }
+
+    QList<int> chunksToRead;
+    foreach (int chunkIndex, chunkIndices) {
+      if (!m_rawData->contains(chunkIndex) &&
+          !m_prefetchingChunks->contains(chunkIndex)) {
+        m_prefetchingChunks->insert(chunkIndex);
+        chunksToRead.append(chunkIndex);
+      }
+    }
+
+    if (!chunksToRead.isEmpty()) {
+      if (!m_ioThreadPool) {
+        m_ioThreadPool = new QThreadPool;
+        m_ioThreadPool->setMaxThreadCount(1);
+      }
+
+      m_ioThreadPool->start(new ChunkPrefetcher(this, chunksToRead));
     }
   }
 
@@ -400,8 +544,22 @@ namespace Isis {
     if (blockForWriteCache) {
       // Start the rest of the writes
       flushWriteCache(true);
+
+      // Cancel any read ahead that hasn't happened yet and wait for the
+      //   chunk currently being read
+      if (m_ioThreadPool) {
+        {
+          QMutexLocker lock(m_chunkCacheMutex);
+          m_prefetchingChunks->clear();
+        }
+
+        m_ioThreadPool->waitForDone();
+      }
     }
 
+    // When we aren't blocking we already hold the cache lock
+    QMutexLocker lock(blockForWriteCache ? m_chunkCacheMutex : NULL);
+
     // If this map is allocated, then this is a brand new cube and we need to
     //   make sure it's filled with data or NULLs.
     if(m_dataIsOnDiskMap) {
@@ -409,13 +567,19 @@ namespace Isis {
     }
 
     // This should be allocated. This is a list of the cached cube data.
-    //   Write it all to disk.
+    //   Write it all to disk. Chunks that another thread is converting a
+    //   buffer into stay; that write frees them later.
     if (m_rawData) {
+      QMap<int, RawCubeChunk *> chunksBeingWritten;
+
       QMapIterator<int, RawCubeChunk *> it(*m_rawData);
       while (it.hasNext()) {
         it.next();
 
-        if(it.value()) {
+        if (m_chunksBeingWritten && m_chunksBeingWritten->contains(it.key())) {
+          chunksBeingWritten.insert(it.key(), it.value());
+        }
+        else if(it.value()) {
           if(it.value()->isDirty()) {
             (const_cast<CubeIoHandler *>(this))->writeRaw(*it.value());
           }
@@ -424,9 +588,18 @@ namespace Isis {
         }
       }
 
-      m_rawData->clear();
+      *m_rawData = chunksBeingWritten;
     }
 
+    // When we aren't blocking we're on the I/O thread or already hold the
+    //   lock, so this cancels the remaining read ahead too.
+    if (m_prefetchingChunks) {
+      m_prefetchingChunks->clear();
+      m_prefetchedChunks->clear();
+    }
+    m_readAheadPosition = -1;
+    m_readAheadLastMap = -1;
+
     if(m_lastProcessByLineChunks) {
       delete m_lastProcessByLineChunks;
       m_lastProcessByLineChunks = NULL;
@@ -434,6 +607,17 @@ namespace Isis {
   }
 
 
+  /**
+   * Write everything this handler is holding in memory to disk: the cached
+   *   cube data and anything else the format keeps track of. Cube::close()
+   *   calls this before deleting the handler so that write errors are
+   *   reported to the caller instead of being lost in a destructor.
+   */
+  void CubeIoHandler::flush() {
+    clearCache();
+  }
+
+
   /**
    * @return the number of bytes that the cube DNs will take up. This includes
    *   padding caused by the cube chunks not aligning with the cube dimensions.
@@ -465,6 +649,25 @@ namespace Isis {
       m_virtualBands = new QList<int>(*virtualBandList);
   }
 
+  /**
+   * @return True if chunks are read as views into the memory mapped cube data
+   *     (see readMappedRaw()), false if they are read from the data file
+   */
+  bool CubeIoHandler::isMemoryMapped() const {
+    return m_mappedData != NULL;
+  }
+
+
+  /**
+   * @return The number of chunks that were read ahead (see prefetch()) and
+   *   are still protected from the caching algorithms
+   */
+  int CubeIoHandler::prefetchedChunkCount() const {
+    QMutexLocker lock(m_chunkCacheMutex);
+    return m_prefetchedChunks->size();
+  }
+
+
   /**
    * Get the mutex that this IO handler is using around I/Os on the given
    *   data file. A lock should be acquired before doing any reads/writes on
@@ -473,7 +676,7 @@ namespace Isis {
    * @return A mutex that can guarantee exclusive access to the data file
    */
   QMutex *CubeIoHandler::dataFileMutex() {
-    return m_writeThreadMutex;
+    return m_chunkCacheMutex;
   }
 
   /**
@@ -674,6 +877,9 @@ namespace Isis {
             "offset to the cube data is [" + IString(getDataStartByte()) +
             " bytes]";
       }
+      else if (m_useMemoryMapping) {
+        mapDataFile();
+      }
     }
     else {
       throw IException(IException::Programmer, msg, _FILEINFO_);
@@ -681,6 +887,35 @@ namespace Isis {
   }
 
 
+  /**
+   * Fill the chunk with a view into the memory mapped cube data instead of
+   *   reading it from the data file. No data is copied; the chunk shares the
+   *   mapped pages until it is written to. Children should try this in their
+   *   readRaw() before falling back to reading the data file.
+   *
+   * @param chunkToFill The container that needs to be filled with cube data
+   * @param startByte The position of the chunk's data in the data file
+   * @return True if the chunk was filled from the memory mapped data, false if
+   *     the cube data is not memory mapped
+   */
+  bool CubeIoHandler::readMappedRaw(RawCubeChunk &chunkToFill,
+                                    BigInt startByte) const {
+    bool success = false;
+
+    if (m_mappedData) {
+      BigInt offset = startByte - getDataStartByte();
+
+      if (offset >= 0 && offset + chunkToFill.getByteCount() <= getDataSize()) {
+        chunkToFill.setRawData(QByteArray::fromRawData(
+            (const char *)(m_mappedData + offset), chunkToFill.getByteCount()));
+        success = true;
+      }
+    }
+
+    return success;
+  }
+
+
   /**
    * This blocks (doesn't return) until the number of active runnables in the
    *   thread pool goes to 0. This uses the m_writeThreadMutex, because the
@@ -694,6 +929,18 @@ namespace Isis {
   }
 
 
+  /**
+   * Get the mutex to hold while converting data into or out of a chunk.
+   *   Several chunks share each mutex.
+   *
+   * @param chunkIndex The index of the chunk (see getChunkIndex())
+   * @return The mutex for the chunk
+   */
+  QMutex *CubeIoHandler::chunkMutex(int chunkIndex) const {
+    return &m_chunkMutexes[chunkIndex % ChunkMutexCount];
+  }
+
+
   /**
    * This is used for sorting buffers into the most efficient write order.
    *
@@ -754,7 +1001,40 @@ namespace Isis {
       int numSamples, int startLine, int numLines, int startBand,
       int numBands) const {
     QList<RawCubeChunk *> results;
+    QList<int> chunkIndices;
     QList<int> resultBands;
+
+    findChunkIndices(startSample, numSamples, startLine, numLines,
+                     startBand, numBands, chunkIndices, resultBands);
+
+    foreach (int chunkIndex, chunkIndices) {
+      results.append(getChunk(chunkIndex, true));
+    }
+
+    return QPair< QList<RawCubeChunk *>, QList<int> >(results, resultBands);
+  }
+
+
+  /**
+   * Get the indices of the cube chunks that correspond to the given cube
+   *   area, and the (virtual) band each one is needed for. This does not
+   *   read or allocate any chunks. The results are appended to chunkIndices
+   *   and chunkBands.
+   *
+   * @param startSample The starting sample of the cube data
+   * @param numSamples The number of samples of cube data
+   * @param startLine The starting line of the cube data
+   * @param numLines The number of lines of cube data
+   * @param startBand The starting band of the cube data
+   * @param numBands The number of bands of cube data
+   * @param chunkIndices (output) The chunk indices that correspond to the
+   *                     given cube area
+   * @param chunkBands (output) The band in the given cube area that each
+   *                   chunk is for
+   */
+  void CubeIoHandler::findChunkIndices(int startSample, int numSamples,
+      int startLine, int numLines, int startBand, int numBands,
+      QList<int> &chunkIndices, QList<int> &chunkBands) const {
 /************************************************************************CHANGED THIS!!!!!!!!******/
     int lastBand = startBand + numBands - 1;
 //     int lastBand = min(startBand + numBands - 1,
@@ -862,10 +1142,8 @@ namespace Isis {
               (chunkZPos * getChunkCountInSampleDimension() *
                           getChunkCountInLineDimension());
 
-          RawCubeChunk * newChunk = getChunk(chunkIndex, true);
-
-          results.append(newChunk);
-          resultBands.append(band);
+          chunkIndices.append(chunkIndex);
+          chunkBands.append(band);
 
           chunkRect.moveLeft(chunkRect.right() + 1);
         }
@@ -873,8 +1151,6 @@ namespace Isis {
         areaLeftInBand.setTop(chunkRect.bottom() + 1);
       }
     }
-
-    return QPair< QList<RawCubeChunk *>, QList<int> >(results, resultBands);
   }
 
 
@@ -958,14 +1234,44 @@ namespace Isis {
    *   there is a runnable and will block if the write cache grows to
    *   be too large.
    *
+   * Several threads may be writing. One of them at a time does the
+   *   bookkeeping and starts the BufferToChunkWriter; when another thread
+   *   already is, a write that doesn't need to wait leaves its buffer queued
+   *   for it. Once the write thread is turned off, the queued buffers are
+   *   written here, in order, before this returns.
+   *
    * @param force Set to true to force start a flush
    */
   void CubeIoHandler::flushWriteCache(bool force) const {
-    if (m_ioThreadPool) {
-      bool shouldFlush = m_writeCache->second.size() >= m_idealFlushSize ||
-                         force;
-      bool cacheOverflowing =
-          (m_writeCache->second.size() > m_idealFlushSize * 10);
+    if (!m_ioThreadPool) {
+      return;
+    }
+
+    bool mustWait = force || !m_useWriteThread.loadAcquire();
+    if (mustWait) {
+      m_writeCacheMutex->lock();
+    }
+    else if (!m_writeCacheMutex->tryLock()) {
+      return;
+    }
+
+    try {
+      if (!m_useWriteThread.loadAcquire()) {
+        blockUntilThreadPoolEmpty();
+
+        foreach (Buffer *bufferToWrite, m_writeCache->takeAll()) {
+          const_cast<CubeIoHandler *>(this)->synchronousWrite(*bufferToWrite);
+          delete bufferToWrite;
+        }
+
+        m_writeCacheMutex->unlock();
+        return;
+      }
+
+      int cacheSize = m_writeCache->size();
+      int idealFlushSize = m_idealFlushSize.loadAcquire();
+      bool shouldFlush = cacheSize >= idealFlushSize || force;
+      bool cacheOverflowing = (cacheSize > idealFlushSize * 10);
       bool shouldAndCanFlush = false;
       bool forceStart = force;
 
@@ -978,20 +1284,21 @@ namespace Isis {
 
       if (cacheOverflowing && !shouldAndCanFlush) {
         forceStart = true;
-        m_consecutiveOverflowCount++;
+        m_consecutiveOverflowCount.fetchAndAddOrdered(1);
       }
 
       if (forceStart) {
         blockUntilThreadPoolEmpty();
 
-        if (m_writeCache->second.size() != 0) {
-          m_idealFlushSize = m_writeCache->second.size();
+        cacheSize = m_writeCache->size();
+        if (cacheSize != 0) {
+          m_idealFlushSize.storeRelease(cacheSize);
           shouldFlush = true;
           shouldAndCanFlush = true;
         }
       }
       else if (!cacheOverflowing && shouldAndCanFlush) {
-        m_consecutiveOverflowCount = 0;
+        m_consecutiveOverflowCount.storeRelease(0);
       }
 
       if (cacheOverflowing && m_useOptimizedCubeWrite) {
@@ -999,35 +1306,52 @@ namespace Isis {
 
         // If the process is very I/O bound, then write caching isn't helping
         //   anything. In fact, it hurts, so turn it off.
-        if (m_consecutiveOverflowCount > 10) {
-          delete m_ioThreadPool;
-          m_ioThreadPool = NULL;
+        if (m_consecutiveOverflowCount.loadAcquire() > 10) {
+          m_useWriteThread.storeRelease(0);
         }
 
         // Write it all synchronously.
-        foreach (Buffer *bufferToWrite, m_writeCache->second) {
+        foreach (Buffer *bufferToWrite, m_writeCache->takeAll()) {
           const_cast<CubeIoHandler *>(this)->synchronousWrite(*bufferToWrite);
           delete bufferToWrite;
         }
-
-        m_writeCache->second.clear();
       }
 
-      if (shouldAndCanFlush && m_ioThreadPool) {
-        QMutexLocker locker(m_writeCache->first);
+      if (shouldAndCanFlush && m_useWriteThread.loadAcquire()) {
         QRunnable *writer = new BufferToChunkWriter(
-            const_cast<CubeIoHandler *>(this), m_writeCache->second);
+            const_cast<CubeIoHandler *>(this), m_writeCache->takeAll());
 
         m_ioThreadPool->start(writer);
 
-        m_writeCache->second.clear();
-        m_lastOperationWasWrite = true;
+        m_lastOperationWasWrite.storeRelease(1);
       }
 
       if (force) {
         blockUntilThreadPoolEmpty();
       }
     }
+    catch (...) {
+      m_writeCacheMutex->unlock();
+      throw;
+    }
+
+    m_writeCacheMutex->unlock();
+  }
+
+
+  /**
+   * Memory map the cube data so that cube chunks can be read as views into
+   *   the data file (see readMappedRaw()). Only cubes whose data is already
+   *   on disk and whose data file is opened read-only are mapped; anything
+   *   that may be written goes through the QFile so the mapping never sees
+   *   stale or partially written data. If the mapping fails (for example, the
+   *   address space is exhausted) we silently fall back to normal reads.
+   */
+  void CubeIoHandler::mapDataFile() {
+    if (!m_mappedData && !m_dataIsOnDiskMap &&
+        !(m_dataFile->openMode() & QIODevice::WriteOnly)) {
+      m_mappedData = m_dataFile->map(getDataStartByte(), getDataSize());
+    }
   }
 
 
@@ -1042,6 +1366,7 @@ namespace Isis {
       int chunkIndex = getChunkIndex(*chunkToFree);
 
       m_rawData->erase(m_rawData->find(chunkIndex));
+      m_prefetchedChunks->remove(chunkIndex);
 
       if(chunkToFree->isDirty())
         (const_cast<CubeIoHandler *>(this))->writeRaw(*chunkToFree);
@@ -1204,6 +1529,12 @@ namespace Isis {
    * Apply the caching algorithms and get rid of excess cube data in memory.
    *   This is intended to be called after every IO operation.
    *
+   * Chunks that were read ahead (see prefetch()) but haven't been used yet
+   *   are treated as if they were just used so they aren't freed before
+   *   read() gets to them. Once the cache holds more than
+   *   MaxCachedChunksWithReadAhead chunks they lose that protection, so read
+   *   ahead can't grow the cache without bound.
+   *
    * @param justUsed The cube chunks that were used in the IO operation that
    *     is calling this method.
    * @param justRequested The buffer that was used in the IO operation that
@@ -1211,6 +1542,28 @@ namespace Isis {
    */
   void CubeIoHandler::minimizeCache(const QList<RawCubeChunk *> &justUsed,
                                     const Buffer &justRequested) const {
+    if (m_rawData->size() > MaxCachedChunksWithReadAhead) {
+      expirePrefetchedChunks();
+    }
+
+    QList<RawCubeChunk *> chunksToKeep(justUsed);
+    foreach (int chunkIndex, *m_prefetchedChunks) {
+      RawCubeChunk *prefetchedChunk = m_rawData->value(chunkIndex);
+
+      if (prefetchedChunk) {
+        chunksToKeep.append(prefetchedChunk);
+      }
+    }
+
+    // Other threads are converting buffers into these
+    foreach (int chunkIndex, m_chunksBeingWritten->keys()) {
+      RawCubeChunk *chunkBeingWritten = m_rawData->value(chunkIndex);
+
+      if (chunkBeingWritten) {
+        chunksToKeep.append(chunkBeingWritten);
+      }
+    }
+
     // Since we have a lock on the cache, no newly created threads can utilize
     //   or access any cache data until we're done.
     if (m_rawData->size() * getBytesPerChunk() > 1 * 1024 * 1024 ||
@@ -1223,7 +1576,7 @@ namespace Isis {
         CubeCachingAlgorithm *algorithm = (*m_cachingAlgorithms)[algorithmIndex];
 
         CubeCachingAlgorithm::CacheResult result =
-            algorithm->recommendChunksToFree(m_rawData->values(), justUsed,
+            algorithm->recommendChunksToFree(m_rawData->values(), chunksToKeep,
                                              justRequested);
 
         algorithmAccepted = result.algorithmUnderstoodData();
@@ -1233,7 +1586,9 @@ namespace Isis {
 
           RawCubeChunk *chunkToFree;
           foreach(chunkToFree, chunksToFree) {
-            freeChunk(chunkToFree);
+            if (!m_chunksBeingWritten->contains(getChunkIndex(*chunkToFree))) {
+              freeChunk(chunkToFree);
+            }
           }
         }
 
@@ -1250,17 +1605,39 @@ namespace Isis {
   }
 
 
+  /**
+   * Stop protecting the chunks that were read ahead from the caching
+   *   algorithms and cancel the read ahead that hasn't happened yet. The
+   *   chunks already read stay in the cache until the caching algorithms
+   *   free them. The caller must hold m_chunkCacheMutex.
+   */
+  void CubeIoHandler::expirePrefetchedChunks() const {
+    m_prefetchingChunks->clear();
+    m_prefetchedChunks->clear();
+  }
+
+
   /**
    * This method takes the given buffer and synchronously puts it into the
    *   Cube's cache. This includes reading missing cache areas and freeing
    *   extra cache areas. This is what the non-threaded CubeIoHandler::write
    *   used to do.
    *
+   * This is safe to call from several threads at once. The chunks are found
+   *   (and read if necessary) while holding m_chunkCacheMutex and marked as
+   *   being written so nothing frees them. The buffer is then converted into
+   *   each chunk holding only that chunk's mutex, so threads writing
+   *   different chunks do the conversion at the same time. Last, the cache
+   *   lock is taken again to let the caching algorithms free chunks.
+   *
    * @param bufferToWrite The buffer we're writing into this cube, synchronously
    */
   void CubeIoHandler::synchronousWrite(const Buffer &bufferToWrite) {
     QList<RawCubeChunk *> cubeChunks;
     QList<int> cubeChunkBands;
+    QList<int> cubeChunkIndices;
+
+    QMutexLocker lock(m_chunkCacheMutex);
 
     int bufferSampleCount = bufferToWrite.SampleDimension();
     int bufferLineCount = bufferToWrite.LineDimension();
@@ -1358,10 +1735,29 @@ namespace Isis {
         *m_lastProcessByLineChunks = cubeChunks;
     }
 
+    for (int i = 0; i < cubeChunks.size(); i++) {
+      int chunkIndex = getChunkIndex(*cubeChunks[i]);
+      cubeChunkIndices.append(chunkIndex);
+      (*m_chunksBeingWritten)[chunkIndex]++;
+    }
+
+    lock.unlock();
+
     for(int i = 0; i < cubeChunks.size(); i++) {
+      QMutexLocker chunkLock(chunkMutex(cubeChunkIndices[i]));
       writeIntoRaw(bufferToWrite, *cubeChunks[i], cubeChunkBands[i]);
     }
 
+    lock.relock();
+
+    foreach (int chunkIndex, cubeChunkIndices) {
+      int &writeCount = (*m_chunksBeingWritten)[chunkIndex];
+      writeCount--;
+      if (writeCount == 0) {
+        m_chunksBeingWritten->remove(chunkIndex);
+      }
+    }
+
     minimizeCache(cubeChunks, bufferToWrite);
   }
 
@@ -1375,12 +1771,9 @@ namespace Isis {
    */
   void CubeIoHandler::writeIntoDouble(const RawCubeChunk &chunk,
                                       Buffer &output, int index) const {
-    // The code in this method is highly optimized. Even the order of the if
-    //   statements will have a significant impact on performance if changed.
-    //   Also, there is a lot of duplicate code in both writeIntoDouble(...) and
-    //   writeIntoRaw(...). This is needed for performance gain. Any function
-    //   or method calls from within the x loop cause significant performance
-    //   decreases.
+    // The per-pixel conversion (byte swapping, base/multiplier and special
+    //   pixel mapping) is done a line at a time by m_pixelConverter, which
+    //   uses vector instructions when it can. Don't add per-pixel work here.
     int startX = 0;
     int startY = 0;
     int startZ = 0;
@@ -1398,9 +1791,11 @@ namespace Isis {
     int chunkStartBand = chunk.getStartBand();
     int chunkLineSize = chunk.sampleCount();
     int chunkBandSize = chunkLineSize * chunk.lineCount();
-    //double *buffersDoubleBuf = output.p_buf;
+    int pixelSize = SizeOf(m_pixelType);
+    int samplesToConvert = endX - startX + 1;
     double *buffersDoubleBuf = output.DoubleBuffer();
-    const char *chunkBuf = chunk.getRawData().data();
+    // Use constData() so that memory mapped chunks are never detached (copied)
+    const char *chunkBuf = chunk.getRawData().constData();
     char *buffersRawBuf = (char *)output.RawBuffer();
 
     for(int z = startZ; z <= endZ; z++) {
@@ -1416,150 +1811,14 @@ namespace Isis {
           const int &lineIntoChunk = y - chunkStartLine;
           int bufferIndex = output.Index(startX, y, virtualBand);
 
-          for(int x = startX; x <= endX; x++) {
-            const int &sampleIntoChunk = x - chunkStartSample;
-
-            const int &chunkIndex = sampleIntoChunk +
-                (chunkLineSize * lineIntoChunk) +
-                (chunkBandSize * bandIntoChunk);
-
-            double &bufferVal = buffersDoubleBuf[bufferIndex];
-
-            if(m_pixelType == Real) {
-              float raw = ((float *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->Float(&raw);
-
-              if(raw >= VALID_MIN4) {
-                bufferVal = (double) raw;
-              }
-              else {
-                if(raw == NULL4)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SAT4)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SAT4)
-                  bufferVal = LOW_REPR_SAT8;
-                else if(raw == HIGH_INSTR_SAT4)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SAT4)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((float *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            else if(m_pixelType == SignedWord) {
-              short raw = ((short *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->ShortInt(&raw);
-
-              if(raw >= VALID_MIN2) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else {
-                if(raw == NULL2)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SAT2)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SAT2)
-                  bufferVal = LOW_REPR_SAT8;
-                else if(raw == HIGH_INSTR_SAT2)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SAT2)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((short *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
+          const int &chunkIndex = (startX - chunkStartSample) +
+              (chunkLineSize * lineIntoChunk) +
+              (chunkBandSize * bandIntoChunk);
 
-            else if(m_pixelType == UnsignedWord) {
-              unsigned short raw = ((unsigned short *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->UnsignedShortInt(&raw);
-
-              if(raw >= VALID_MINU2) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else if (raw > VALID_MAXU2) {
-                if(raw == HIGH_INSTR_SATU2)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SATU2)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-              else {
-                if(raw == NULLU2)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SATU2)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SATU2)
-                  bufferVal = LOW_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((unsigned short *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            else if(m_pixelType == UnsignedInteger) {
-
-              unsigned int raw = ((unsigned int *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->Uint32_t(&raw);
-
-              if(raw >= VALID_MINUI4) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else if (raw > VALID_MAXUI4) {
-                if(raw == HIGH_INSTR_SATUI4)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SATUI4)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-              else {
-                if(raw == NULLUI4)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SATUI4)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SATUI4)
-                  bufferVal = LOW_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((unsigned int *)buffersRawBuf)[bufferIndex] = raw;
-
-
-
-            }
-
-            else if(m_pixelType == UnsignedByte) {
-              unsigned char raw = ((unsigned char *)chunkBuf)[chunkIndex];
-
-              if(raw == NULL1) {
-                bufferVal = NULL8;
-              }
-              else if(raw == HIGH_REPR_SAT1) {
-                bufferVal = HIGH_REPR_SAT8;
-              }
-              else {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-
-              ((unsigned char *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            bufferIndex ++;
-          }
+          m_pixelConverter->toDouble(chunkBuf + chunkIndex * pixelSize,
+                                     buffersDoubleBuf + bufferIndex,
+                                     buffersRawBuf + bufferIndex * pixelSize,
+                                     samplesToConvert);
         }
       }
     }
@@ -1575,12 +1834,8 @@ namespace Isis {
    */
   void CubeIoHandler::writeIntoRaw(const Buffer &buffer, RawCubeChunk &output, int index)
       const {
-    // The code in this method is highly optimized. Even the order of the if
-    //   statements will have a significant impact on performance if changed.
-    //   Also, there is a lot of duplicate code in both writeIntoDouble(...) and
-    //   writeIntoRaw(...). This is needed for performance gain. Any function
-    //   or method calls from within the x loop cause significant performance
-    //   decreases.
+    // See writeIntoDouble(...), the conversion is done a line at a time by
+    //   m_pixelConverter.
     int startX = 0;
     int startY = 0;
     int startZ = 0;
@@ -1599,6 +1854,8 @@ namespace Isis {
     int outputStartBand = output.getStartBand();
     int lineSize = output.sampleCount();
     int bandSize = lineSize * output.lineCount();
+    int pixelSize = SizeOf(m_pixelType);
+    int samplesToConvert = endX - startX + 1;
     double *buffersDoubleBuf = buffer.DoubleBuffer();
     char *chunkBuf = output.getRawData().data();
 
@@ -1618,231 +1875,12 @@ namespace Isis {
           const int &lineIntoChunk = y - outputStartLine;
           int bufferIndex = buffer.Index(startX, y, virtualBand);
 
-          for(int x = startX; x <= endX; x++) {
-            const int &sampleIntoChunk = x - outputStartSample;
-
-            const int &chunkIndex = sampleIntoChunk +
-                (lineSize * lineIntoChunk) + (bandSize * bandIntoChunk);
-
-            double bufferVal = buffersDoubleBuf[bufferIndex];
-
-            if(m_pixelType == Real) {
-              float raw = 0;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-
-                if(filePixelValueDbl < (double) VALID_MIN4) {
-                  raw = LOW_REPR_SAT4;
-                }
-                else if(filePixelValueDbl > (double) VALID_MAX4) {
-                  raw = HIGH_REPR_SAT4;
-                }
-                else {
-                  raw = (float) filePixelValueDbl;
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL4;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT4;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT4;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT4;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT4;
-                else
-                  raw = LOW_REPR_SAT4;
-              }
-              ((float *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->Float(&raw) : raw;
-            }
-
-            else if(m_pixelType == SignedWord) {
-              short raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MIN2 - 0.5) {
-                  raw = LOW_REPR_SAT2;
-                }
-                if(filePixelValueDbl > VALID_MAX2 + 0.5) {
-                  raw = HIGH_REPR_SAT2;
-                }
-                else {
-                  int filePixelValue = (int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MIN2) {
-                    raw = LOW_REPR_SAT2;
-                  }
-                  else if(filePixelValue > VALID_MAX2) {
-                    raw = HIGH_REPR_SAT2;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL2;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT2;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT2;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT2;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT2;
-                else
-                  raw = LOW_REPR_SAT2;
-              }
-
-              ((short *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->ShortInt(&raw) : raw;
-            }
-
-            else if(m_pixelType == UnsignedInteger) {
-
-              unsigned int raw;
-
-              if(bufferVal >= VALID_MINUI4) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MINUI4 - 0.5) {
-                  raw = LOW_REPR_SATUI4;
-                }
-                if(filePixelValueDbl > VALID_MAXUI4) {
-                  raw = HIGH_REPR_SATUI4;
-                }
-                else {
-                  unsigned int filePixelValue = (unsigned int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MINUI4) {
-                    raw = LOW_REPR_SATUI4;
-                  }
-                  else if(filePixelValue > VALID_MAXUI4) {
-                    raw = HIGH_REPR_SATUI4;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULLUI4;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SATUI4;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SATUI4;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SATUI4;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SATUI4;
-                else
-                  raw = LOW_REPR_SATUI4;
-              }
-
-              ((unsigned int *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->Uint32_t(&raw) : raw;
-
-            }
-
+          const int &chunkIndex = (startX - outputStartSample) +
+              (lineSize * lineIntoChunk) + (bandSize * bandIntoChunk);
 
-            else if(m_pixelType == UnsignedWord) {
-              unsigned short raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MINU2 - 0.5) {
-                  raw = LOW_REPR_SATU2;
-                }
-                if(filePixelValueDbl > VALID_MAXU2 + 0.5) {
-                  raw = HIGH_REPR_SATU2;
-                }
-                else {
-                  int filePixelValue = (int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MINU2) {
-                    raw = LOW_REPR_SATU2;
-                  }
-                  else if(filePixelValue > VALID_MAXU2) {
-                    raw = HIGH_REPR_SATU2;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULLU2;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SATU2;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SATU2;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SATU2;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SATU2;
-                else
-                  raw = LOW_REPR_SATU2;
-              }
-
-              ((unsigned short *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->UnsignedShortInt(&raw) : raw;
-            }
-            else if(m_pixelType == UnsignedByte) {
-              unsigned char raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MIN1 - 0.5) {
-                  raw = LOW_REPR_SAT1;
-                }
-                else if(filePixelValueDbl > VALID_MAX1 + 0.5) {
-                  raw = HIGH_REPR_SAT1;
-                }
-                else {
-                  int filePixelValue = (int)(filePixelValueDbl + 0.5);
-                  if(filePixelValue < VALID_MIN1) {
-                    raw = LOW_REPR_SAT1;
-                  }
-                  else if(filePixelValue > VALID_MAX1) {
-                    raw = HIGH_REPR_SAT1;
-                  }
-                  else {
-                    raw = (unsigned char)(filePixelValue);
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL1;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT1;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT1;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT1;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT1;
-                else
-                  raw = LOW_REPR_SAT1;
-              }
-
-              ((unsigned char *)chunkBuf)[chunkIndex] = raw;
-            }
-
-            bufferIndex ++;
-          }
+          m_pixelConverter->toRaw(buffersDoubleBuf + bufferIndex,
+                                  chunkBuf + chunkIndex * pixelSize,
+                                  samplesToConvert);
         }
       }
     }
@@ -1919,11 +1957,11 @@ namespace Isis {
     double percentOffIdeal = msOffIdeal / (double)idealFlushElapsedTime;
 
     // flush size is bounded to [32, 5000]
-    int currentCacheSize = m_ioHandler->m_idealFlushSize;
+    int currentCacheSize = m_ioHandler->m_idealFlushSize.loadAcquire();
     int desiredAdjustment = -1 * currentCacheSize * percentOffIdeal;
     int desiredCacheSize = (int)(currentCacheSize + desiredAdjustment);
-    m_ioHandler->m_idealFlushSize = (int)(qMin(5000,
-                                               qMax(32, desiredCacheSize)));
+    m_ioHandler->m_idealFlushSize.storeRelease(
+        (int)(qMin(5000, qMax(32, desiredCacheSize))));
 
     delete m_timer;
     m_timer = NULL;
@@ -1968,6 +2006,138 @@ namespace Isis {
     }
 
     m_buffersToWrite->clear();
+
+    QMutexLocker lock(m_ioHandler->m_chunkCacheMutex);
     m_ioHandler->m_dataFile->flush();
   }
+
+
+  /**
+   * Create a ChunkPrefetcher for the given chunks. The chunks must already be
+   *   in ioHandler->m_prefetchingChunks.
+   *
+   * @param ioHandler The IO handler to read the chunks into
+   * @param chunksToRead The indices of the chunks to read, in the order they
+   *                     will be needed
+   */
+  CubeIoHandler::ChunkPrefetcher::ChunkPrefetcher(
+      const CubeIoHandler * ioHandler, QList<int> chunksToRead) {
+    m_ioHandler = ioHandler;
+    m_chunksToRead = new QList<int>(chunksToRead);
+  }
+
+
+  /**
+   * Clean up.
+   */
+  CubeIoHandler::ChunkPrefetcher::~ChunkPrefetcher() {
+    m_ioHandler = NULL;
+
+    delete m_chunksToRead;
+    m_chunksToRead = NULL;
+  }
+
+
+  /**
+   * This is the asynchronous read. Read each chunk that is still wanted into
+   *   the cache, locking the I/O mutex for one chunk at a time. Read failures
+   *   are ignored here; read() will try again and report them.
+   */
+  void CubeIoHandler::ChunkPrefetcher::run() {
+    foreach (int chunkIndex, *m_chunksToRead) {
+      QMutexLocker lock(m_ioHandler->m_chunkCacheMutex);
+
+      // The chunk isn't wanted anymore if clearCache() cancelled it or read()
+      //   got to it first.
+      if (m_ioHandler->m_prefetchingChunks->remove(chunkIndex) &&
+          !m_ioHandler->m_rawData->contains(chunkIndex)) {
+        try {
+          m_ioHandler->getChunk(chunkIndex, true);
+          m_ioHandler->m_prefetchedChunks->insert(chunkIndex);
+        }
+        catch (IException &) {
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Create an empty write cache.
+   */
+  CubeIoHandler::WriteCache::WriteCache() : m_head(NULL), m_size(0) {
+  }
+
+
+  /**
+   * Delete the write cache and any buffers that are still in it. Nothing
+   *   may be appending when this is called.
+   */
+  CubeIoHandler::WriteCache::~WriteCache() {
+    foreach (Buffer *unwrittenBuffer, takeAll()) {
+      delete unwrittenBuffer;
+    }
+  }
+
+
+  /**
+   * Add a buffer to the end of the cache. This is safe to call from any
+   *   number of threads at once and never blocks.
+   *
+   * @param buffer The buffer to write later; the cache takes ownership of it
+   *               until it is taken out with takeAll()
+   */
+  void CubeIoHandler::WriteCache::append(Buffer *buffer) {
+    Node *newNode = new Node;
+    newNode->buffer = buffer;
+
+    // Count the node before it can be taken, so takeAll() never subtracts a
+    //   node that hasn't been counted yet
+    m_size.fetchAndAddOrdered(1);
+
+    Node *oldHead = NULL;
+    do {
+      oldHead = m_head.loadAcquire();
+      newNode->next = oldHead;
+    } while (!m_head.testAndSetOrdered(oldHead, newNode));
+  }
+
+
+  /**
+   * Remove every buffer from the cache. Only one thread may take buffers out
+   *   at a time (flushWriteCache() holds m_writeCacheMutex), but appends may
+   *   happen at the same time; those either make it into this list or stay
+   *   in the cache for the next call.
+   *
+   * @return The buffers in the order they were appended. Ownership is given
+   *     to the caller.
+   */
+  QList<Buffer *> CubeIoHandler::WriteCache::takeAll() {
+    // Nodes are pushed onto the front, so walking the detached list and
+    //   prepending gives us back the append order.
+    Node *node = m_head.fetchAndStoreOrdered(NULL);
+
+    QList<Buffer *> buffers;
+    while (node) {
+      buffers.prepend(node->buffer);
+
+      Node *nextNode = node->next;
+      delete node;
+      node = nextNode;
+    }
+
+    m_size.fetchAndAddOrdered(-buffers.size());
+
+    return buffers;
+  }
+
+
+  /**
+   * @return The number of buffers waiting in the cache. With concurrent
+   *     appends this is only a snapshot, and it may count a buffer that is
+   *     about to be appended.
+   */
+  int CubeIoHandler::WriteCache::size() const {
+    return m_size.loadAcquire();
+  }
 }
@@ -24,6 +24,8 @@
 #ifndef CubeIoHandler_h
 #define CubeIoHandler_h
 
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QRunnable>
 #include <QThreadPool>
 
@@ -37,13 +39,16 @@ class QTime;
 template <typename A> class QList;
 template <typename A, typename B> class QMap;
 template <typename A, typename B> struct QPair;
+template <typename A> class QSet;
 
 namespace Isis {
   class Buffer;
+  class BufferManager;
   class CubeCachingAlgorithm;
   class EndianSwapper;
   class Pvl;
   class RawCubeChunk;
+  class RawPixelConverter;
 
   /**
    * @ingroup Low Level Cube IO
@@ -121,6 +126,9 @@ namespace Isis {
    *                            References #971.
    *   @history 2018-08-13 Summer Stapleton - Fixed incoming buffer comparison values for 
    *                            unsigned int type in writeIntoRaw(...). 
+   *   @history 2026-10-16 Isis Development Team - Made m_idealFlushSize and
+   *                           m_consecutiveOverflowCount atomic. The write thread
+   *                           updates the flush size without m_writeCacheMutex.
    */
   class CubeIoHandler {
     public:
@@ -130,10 +138,12 @@ namespace Isis {
 
       void read(Buffer &bufferToFill) const;
       void write(const Buffer &bufferToWrite);
+      void prefetch(const BufferManager &upcoming) const;
 
       void addCachingAlgorithm(CubeCachingAlgorithm *algorithm);
       void clearCache(bool blockForWriteCache = true) const;
-      BigInt getDataSize() const;
+      virtual void flush();
+      virtual BigInt getDataSize() const;
       void setVirtualBands(const QList<int> *virtualBandList);
       /**
        * Function to update the labels with a Pvl object
@@ -144,6 +154,9 @@ namespace Isis {
 
       QMutex *dataFileMutex();
 
+      bool isMemoryMapped() const;
+      int prefetchedChunkCount() const;
+
     protected:
       int bandCount() const;
       int getBandCountInChunk() const;
@@ -162,6 +175,8 @@ namespace Isis {
 
       void setChunkSizes(int numSamples, int numLines, int numBands);
 
+      bool readMappedRaw(RawCubeChunk &chunkToFill, BigInt startByte) const;
+
       /**
        * This needs to populate the chunkToFill with unswapped raw bytes from
        *   the disk.
@@ -229,6 +244,101 @@ namespace Isis {
       };
 
 
+      /**
+       * This class reads cube chunks into the cache ahead of time.
+       *
+       * prefetch() figures out which chunks the next few buffers of a
+       *   traversal will need and hands them to one of these to be read on
+       *   the I/O thread. Each chunk is read while holding the
+       *   ioHandler->m_chunkCacheMutex, so a read() is never blocked for
+       *   longer than one chunk read. Chunks that are no longer wanted by
+       *   the time we get to them (see clearCache()) are skipped.
+       *
+       * @author 2026-10-16 Isis Development Team
+       *
+       * @internal
+       */
+      class ChunkPrefetcher : public QRunnable {
+        public:
+          ChunkPrefetcher(const CubeIoHandler * ioHandler,
+                          QList<int> chunksToRead);
+          ~ChunkPrefetcher();
+
+          void run();
+
+        private:
+          /**
+           * This is disabled.
+           * @param other Nothing.
+           */
+          ChunkPrefetcher(const ChunkPrefetcher & other);
+          /**
+           * This is disabled.
+           * @param rhs Nothing.
+           * @return Nothing.
+           */
+          ChunkPrefetcher & operator=(const ChunkPrefetcher & rhs);
+
+        private:
+          //! The IO Handler instance to read the chunks into
+          const CubeIoHandler * m_ioHandler;
+          //! The indices of the chunks to read
+          QList<int> * m_chunksToRead;
+      };
+
+
+      /**
+       * The buffers that have been given to write() but not yet handed to a
+       *   BufferToChunkWriter.
+       *
+       * This is a lock-free multiple producer, single consumer queue. Buffers
+       *   are pushed onto a singly linked list with compare-and-swap and the
+       *   consumer (flushWriteCache(), one thread at a time) detaches the
+       *   whole list at once, so appending never waits on a mutex and there
+       *   is no ABA problem. The size is counted before a node is pushed, so
+       *   it is never less than the number of buffers takeAll() can find.
+       *
+       * @author 2026-10-16 Isis Development Team
+       *
+       * @internal
+       */
+      class WriteCache {
+        public:
+          WriteCache();
+          ~WriteCache();
+
+          void append(Buffer *buffer);
+          QList<Buffer *> takeAll();
+          int size() const;
+
+        private:
+          /**
+           * This is disabled.
+           * @param other Nothing.
+           */
+          WriteCache(const WriteCache &other);
+          /**
+           * This is disabled.
+           * @param rhs Nothing.
+           * @return Nothing.
+           */
+          WriteCache &operator=(const WriteCache &rhs);
+
+          //! One buffer in the linked list
+          struct Node {
+            //! The buffer to write; owned by the cache
+            Buffer *buffer;
+            //! The node appended before this one
+            Node *next;
+          };
+
+          //! The most recently appended node
+          QAtomicPointer<Node> m_head;
+          //! The number of buffers appended and not yet taken
+          QAtomicInt m_size;
+      };
+
+
       /**
        * Disallow copying of this object.
        *
@@ -247,18 +357,30 @@ namespace Isis {
 
       void blockUntilThreadPoolEmpty() const;
 
+      QMutex *chunkMutex(int chunkIndex) const;
+
       static bool bufferLessThan(Buffer * const &lhs, Buffer * const &rhs);
 
       QPair< QList<RawCubeChunk *>, QList<int> > findCubeChunks(int startSample, int numSamples,
                                                                 int startLine, int numLines,
                                                                 int startBand, int numBands) const;
 
+      void findChunkIndices(int startSample, int numSamples,
+                            int startLine, int numLines,
+                            int startBand, int numBands,
+                            QList<int> &chunkIndices,
+                            QList<int> &chunkBands) const;
+
       void findIntersection(const RawCubeChunk &cube1,
           const Buffer &cube2, int &startX, int &startY, int &startZ,
           int &endX, int &endY, int &endZ) const;
 
       void flushWriteCache(bool force = false) const;
 
+      void mapDataFile();
+
+      void expirePrefetchedChunks() const;
+
       void freeChunk(RawCubeChunk *chunkToFree) const;
 
       RawCubeChunk *getChunk(int chunkIndex, bool allocateIfNecessary) const;
@@ -286,6 +408,15 @@ namespace Isis {
       //! The file containing cube data.
       QFile * m_dataFile;
 
+      /**
+       * The memory mapped cube data, starting at m_startByte. This is NULL
+       *   unless memory mapped reads are enabled and the mapping succeeded.
+       */
+      uchar *m_mappedData;
+
+      //! This is true if the Isis preference for cube memory mapping is Always.
+      bool m_useMemoryMapping;
+
       /**
        * The start byte of the cube data. This is 0-based (i.e. a value of 0
        *   means write data into the first byte of the file). Usually the label
@@ -308,6 +439,9 @@ namespace Isis {
       //! A helper that swaps byte order to and from file order.
       EndianSwapper * m_byteSwapper;
 
+      //! Converts lines of raw DNs to and from doubles.
+      RawPixelConverter * m_pixelConverter;
+
       //! The number of samples in the cube.
       int m_numSamples;
 
@@ -348,7 +482,48 @@ namespace Isis {
       mutable QByteArray *m_nullChunkData;
 
       //! These are the buffers we need to write to raw cube chunks
-      QPair< QMutex *, QList<Buffer *> > *m_writeCache;
+      WriteCache *m_writeCache;
+
+      /**
+       * Only one thread at a time decides when to flush the write cache and
+       *   starts BufferToChunkWriters (see flushWriteCache()).
+       */
+      QMutex *m_writeCacheMutex;
+
+      /**
+       * This is 1 while write() queues buffers for the write thread, and 0
+       *   once writing on the write thread has been turned off because it
+       *   wasn't helping (or a read() happened). The thread pool itself is
+       *   kept until the handler is destroyed, since other threads may still
+       *   be writing.
+       */
+      mutable QAtomicInt m_useWriteThread;
+
+      /**
+       * This guards the chunk cache (m_rawData and everything that says which
+       *   chunks are in it), the caching algorithms and the data file. It is
+       *   not held while buffers are converted into chunks (see
+       *   synchronousWrite()), so threads writing different chunks only wait
+       *   on it to find their chunks.
+       */
+      QMutex *m_chunkCacheMutex;
+
+      /**
+       * The chunk data is converted to and from buffers while holding one of
+       *   these, picked by chunk index (see chunkMutex()). Striping the locks
+       *   lets writers of different chunks convert at the same time without a
+       *   mutex per chunk.
+       */
+      QMutex *m_chunkMutexes;
+
+      //! The number of mutexes in m_chunkMutexes
+      static const int ChunkMutexCount = 64;
+
+      /**
+       * The number of writes converting into each chunk outside of
+       *   m_chunkCacheMutex. These chunks are never freed.
+       */
+      mutable QMap<int, int> *m_chunksBeingWritten;
 
       /**
        * This contains threads for doing cube writes (and later maybe cube
@@ -361,21 +536,56 @@ namespace Isis {
        * If the last operation was a write then we need to flush the cache when
        *   reading. Keep track of this.
        */
-      mutable bool m_lastOperationWasWrite;
+      mutable QAtomicInt m_lastOperationWasWrite;
       /**
        * This is true if the Isis preference for the cube write thread is
        *   optimized.
        */
       bool m_useOptimizedCubeWrite;
 
-      //! This enables us to block while the write thread is working
+      /**
+       * This is held by the BufferToChunkWriter while it exists, so it
+       *   enables us to block while the write thread is working.
+       */
       QMutex *m_writeThreadMutex;
 
-      //! Ideal write cache flush size
-      mutable volatile int m_idealFlushSize;
+      /**
+       * Ideal write cache flush size. This is adjusted by flushWriteCache()
+       *   under m_writeCacheMutex and by the BufferToChunkWriter destructor
+       *   on the write thread, which can't take that mutex.
+       */
+      mutable QAtomicInt m_idealFlushSize;
 
       //! How many times the write cache has overflown in a row
-      mutable int m_consecutiveOverflowCount;
+      mutable QAtomicInt m_consecutiveOverflowCount;
+
+      /**
+       * The number of upcoming buffers to read ahead of the traversal in
+       *   prefetch(). Read ahead is disabled if this is 0.
+       */
+      int m_readAheadCount;
+
+      /**
+       * The last buffer position (in the traversal given to prefetch()) that
+       *   has been handed to the I/O thread.
+       */
+      mutable BigInt m_readAheadPosition;
+
+      /**
+       * Chunks that were read ahead stop being protected from the caching
+       *   algorithms once the cache holds more chunks than this. This is the
+       *   size at which minimizeCache() falls back to clearing the cache.
+       */
+      static const int MaxCachedChunksWithReadAhead = 100;
+
+      //! The traversal position prefetch() was last called with
+      mutable BigInt m_readAheadLastMap;
+
+      //! Chunks waiting to be read by a ChunkPrefetcher
+      mutable QSet<int> * m_prefetchingChunks;
+
+      //! Chunks read by a ChunkPrefetcher that haven't been used by read() yet
+      mutable QSet<int> * m_prefetchedChunks;
   };
 }
 
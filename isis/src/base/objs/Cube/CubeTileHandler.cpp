@@ -93,10 +93,10 @@ namespace Isis {
   void CubeTileHandler::readRaw(RawCubeChunk &chunkToFill) {
     BigInt startByte = getTileStartByte(chunkToFill);
 
-    bool success = false;
+    bool success = readMappedRaw(chunkToFill, startByte);
 
     QFile * dataFile = getDataFile();
-    if(dataFile->seek(startByte)) {
+    if(!success && dataFile->seek(startByte)) {
       QByteArray binaryData = dataFile->read(chunkToFill.getByteCount());
 
       if(binaryData.size() == chunkToFill.getByteCount()) {
@@ -88,7 +88,8 @@ namespace Isis {
 
   /**
    * Sets the chunk's raw data. This size of the new raw data must match that
-   *   of the chunk's current raw data buffer.
+   *   of the chunk's current raw data buffer. The raw data is implicitly
+   *   shared, so it is not copied until the chunk is modified.
    *
    * @param rawData the raw data
    */
@@ -101,7 +102,11 @@ namespace Isis {
 
     m_dirty = true;
     *m_rawBuffer = rawData;
-    m_rawBufferInternalPtr = m_rawBuffer->data();
+
+    // Don't ask for a writable pointer here; the raw data may be a view into
+    //   a memory mapped file (see QByteArray::fromRawData()) and asking for
+    //   write access would force a deep copy that is usually never needed.
+    m_rawBufferInternalPtr = NULL;
   }
 
 
@@ -164,7 +169,7 @@ namespace Isis {
     ASSERT(offset < getByteCount());
 
     m_dirty = true;
-    m_rawBufferInternalPtr[offset] = value;
+    writableRawData()[offset] = value;
   }
 
 
@@ -179,7 +184,7 @@ namespace Isis {
     ASSERT((int)(offset * sizeof(short)) < getByteCount());
 
     m_dirty = true;
-    ((short *)m_rawBufferInternalPtr)[offset] = value;
+    ((short *)writableRawData())[offset] = value;
   }
 
 
@@ -194,7 +199,7 @@ namespace Isis {
     ASSERT((int)(offset * sizeof(float)) < getByteCount());
 
     m_dirty = true;
-    ((float *)m_rawBufferInternalPtr)[offset] = value;
+    ((float *)writableRawData())[offset] = value;
   }
 
 
@@ -207,5 +212,19 @@ namespace Isis {
   void RawCubeChunk::setDirty(bool dirty) {
     m_dirty = dirty;
   }
-}
 
+
+  /**
+   * Get a writable pointer to the raw data buffer, detaching it from any data
+   *   it shares first.
+   *
+   * @returns a writable pointer to the raw data in this cube chunk
+   */
+  char *RawCubeChunk::writableRawData() {
+    if (!m_rawBufferInternalPtr) {
+      m_rawBufferInternalPtr = m_rawBuffer->data();
+    }
+
+    return m_rawBufferInternalPtr;
+  }
+}
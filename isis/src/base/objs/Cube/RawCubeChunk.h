@@ -127,13 +127,18 @@ namespace Isis {
        */
       RawCubeChunk& operator=(const RawCubeChunk &other);
 
+      char *writableRawData();
+
     private:
       //! True if the data does not match what is on disk.
       bool m_dirty;
 
       //! This is the raw data to be put on disk.
       QByteArray *m_rawBuffer;
-      //! This is the internal pointer to the raw buffer for performance.
+      /**
+       * This is the internal pointer to the raw buffer for performance. This
+       *   is NULL until the raw buffer has been detached for writing.
+       */
       char *m_rawBufferInternalPtr;
 
       //! The number of samples in the cube chunk.
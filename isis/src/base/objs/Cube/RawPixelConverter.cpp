@@ -0,0 +1,846 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "RawPixelConverter.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "SpecialPixel.h"
+
+// The vectorized kernels are compiled for AVX2 with a function attribute and
+//   are only called after checking the CPU at run time, so the rest of Isis
+//   does not need to be built with -mavx2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RAW_PIXEL_CONVERTER_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace Isis {
+
+  namespace {
+    /**
+     * @param value A 2 byte value in the wrong byte order
+     * @return The value with its bytes swapped
+     */
+    inline unsigned short swap2(unsigned short value) {
+      return (unsigned short)((value >> 8) | (value << 8));
+    }
+
+
+    /**
+     * @param value A 4 byte value in the wrong byte order
+     * @return The value with its bytes swapped
+     */
+    inline unsigned int swap4(unsigned int value) {
+      return ((value >> 24) & 0x000000FF) | ((value >> 8) & 0x0000FF00) |
+             ((value << 8) & 0x00FF0000) | ((value << 24) & 0xFF000000);
+    }
+
+
+    /**
+     * @param value A float in the wrong byte order
+     * @return The float with its bytes swapped
+     */
+    inline float swapFloat(float value) {
+      unsigned int bits;
+      memcpy(&bits, &value, sizeof(bits));
+      bits = swap4(bits);
+      memcpy(&value, &bits, sizeof(bits));
+      return value;
+    }
+
+
+#if defined(RAW_PIXEL_CONVERTER_AVX2)
+    /**
+     * @return True if the CPU we're running on supports AVX2
+     */
+    bool cpuSupportsAvx2() {
+      static const bool supported = __builtin_cpu_supports("avx2");
+      return supported;
+    }
+
+
+    /**
+     * Round half away from zero, exactly like round(), for each element.
+     *
+     * @param x The values to round
+     * @return The rounded values
+     */
+    __attribute__((target("avx2")))
+    inline __m256d roundHalfAway(__m256d x) {
+      const __m256d signMask = _mm256_set1_pd(-0.0);
+      const __m256d half = _mm256_set1_pd(0.5);
+
+      __m256d absX = _mm256_andnot_pd(signMask, x);
+      __m256d rounded = _mm256_floor_pd(_mm256_add_pd(absX, half));
+
+      // absX + 0.5 can round up when absX is just below a half, correct that
+      __m256d tooFar = _mm256_cmp_pd(_mm256_sub_pd(rounded, absX), half,
+                                     _CMP_GT_OQ);
+      rounded = _mm256_sub_pd(rounded,
+                              _mm256_and_pd(tooFar, _mm256_set1_pd(1.0)));
+
+      return _mm256_or_pd(rounded, _mm256_and_pd(x, signMask));
+    }
+
+
+    /**
+     * @param mask The result of a vector comparison
+     * @return True if the comparison was true for all 4 elements
+     */
+    __attribute__((target("avx2")))
+    inline bool allTrue(__m256d mask) {
+      return _mm256_movemask_pd(mask) == 0xF;
+    }
+#endif
+  }
+
+
+  /**
+   * Create a converter for one cube's on-disk pixel format.
+   *
+   * @param pixelType The format of each DN on disk
+   * @param swapBytes True if the DNs on disk are not in the native byte order
+   * @param base The additive offset of the data on disk
+   * @param multiplier The multiplicative factor of the data on disk
+   */
+  RawPixelConverter::RawPixelConverter(PixelType pixelType, bool swapBytes,
+                                       double base, double multiplier) {
+    m_pixelType = pixelType;
+    m_swapBytes = swapBytes;
+    m_base = base;
+    m_multiplier = multiplier;
+  }
+
+
+  /**
+   * Destructor
+   */
+  RawPixelConverter::~RawPixelConverter() {
+  }
+
+
+  /**
+   * @return True if the vectorized conversions are used on this machine
+   */
+  bool RawPixelConverter::isVectorized() {
+#if defined(RAW_PIXEL_CONVERTER_AVX2)
+    return cpuSupportsAvx2();
+#else
+    return false;
+#endif
+  }
+
+
+  /**
+   * Convert a run of raw DNs into doubles, mapping special pixels.
+   *
+   * @param raw The DNs in the on-disk format
+   * @param output The double values (count elements)
+   * @param nativeRaw The DNs in the on-disk pixel type but in the native byte
+   *     order (count elements of the on-disk pixel type)
+   * @param count The number of pixels to convert
+   */
+  void RawPixelConverter::toDouble(const char *raw, double *output,
+                                   char *nativeRaw, int count) const {
+    int i = 0;
+
+#if defined(RAW_PIXEL_CONVERTER_AVX2)
+    if (cpuSupportsAvx2()) {
+      i = avx2ToDouble(raw, output, nativeRaw, count);
+    }
+#endif
+
+    if (i < count) {
+      int pixelSize = SizeOf(m_pixelType);
+      scalarToDouble(raw + i * pixelSize, output + i, nativeRaw + i * pixelSize,
+                     count - i);
+    }
+  }
+
+
+  /**
+   * Convert a run of doubles into raw DNs, mapping special pixels and
+   *   saturating values that can't be represented.
+   *
+   * @param input The double values
+   * @param raw The DNs in the on-disk format (count elements)
+   * @param count The number of pixels to convert
+   */
+  void RawPixelConverter::toRaw(const double *input, char *raw,
+                                int count) const {
+    int i = 0;
+
+#if defined(RAW_PIXEL_CONVERTER_AVX2)
+    if (cpuSupportsAvx2()) {
+      i = avx2ToRaw(input, raw, count);
+    }
+#endif
+
+    if (i < count) {
+      scalarToRaw(input + i, raw + i * SizeOf(m_pixelType), count - i);
+    }
+  }
+
+
+  /**
+   * The reference conversion from raw DNs to doubles, one pixel at a time.
+   *
+   * @see toDouble()
+   */
+  void RawPixelConverter::scalarToDouble(const char *raw, double *output,
+                                         char *nativeRaw, int count) const {
+    if (m_pixelType == Real) {
+      for (int i = 0; i < count; i++) {
+        float rawVal = ((const float *)raw)[i];
+        if (m_swapBytes)
+          rawVal = swapFloat(rawVal);
+
+        double &bufferVal = output[i];
+        if (rawVal >= VALID_MIN4) {
+          bufferVal = (double) rawVal;
+        }
+        else {
+          if (rawVal == NULL4)
+            bufferVal = NULL8;
+          else if (rawVal == LOW_INSTR_SAT4)
+            bufferVal = LOW_INSTR_SAT8;
+          else if (rawVal == LOW_REPR_SAT4)
+            bufferVal = LOW_REPR_SAT8;
+          else if (rawVal == HIGH_INSTR_SAT4)
+            bufferVal = HIGH_INSTR_SAT8;
+          else if (rawVal == HIGH_REPR_SAT4)
+            bufferVal = HIGH_REPR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+
+        ((float *)nativeRaw)[i] = rawVal;
+      }
+    }
+
+    else if (m_pixelType == SignedWord) {
+      for (int i = 0; i < count; i++) {
+        short rawVal = ((const short *)raw)[i];
+        if (m_swapBytes)
+          rawVal = (short)swap2((unsigned short)rawVal);
+
+        double &bufferVal = output[i];
+        if (rawVal >= VALID_MIN2) {
+          bufferVal = (double) rawVal * m_multiplier + m_base;
+        }
+        else {
+          if (rawVal == NULL2)
+            bufferVal = NULL8;
+          else if (rawVal == LOW_INSTR_SAT2)
+            bufferVal = LOW_INSTR_SAT8;
+          else if (rawVal == LOW_REPR_SAT2)
+            bufferVal = LOW_REPR_SAT8;
+          else if (rawVal == HIGH_INSTR_SAT2)
+            bufferVal = HIGH_INSTR_SAT8;
+          else if (rawVal == HIGH_REPR_SAT2)
+            bufferVal = HIGH_REPR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+
+        ((short *)nativeRaw)[i] = rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedWord) {
+      for (int i = 0; i < count; i++) {
+        unsigned short rawVal = ((const unsigned short *)raw)[i];
+        if (m_swapBytes)
+          rawVal = swap2(rawVal);
+
+        double &bufferVal = output[i];
+        if (rawVal >= VALID_MINU2) {
+          bufferVal = (double) rawVal * m_multiplier + m_base;
+        }
+        else if (rawVal > VALID_MAXU2) {
+          if (rawVal == HIGH_INSTR_SATU2)
+            bufferVal = HIGH_INSTR_SAT8;
+          else if (rawVal == HIGH_REPR_SATU2)
+            bufferVal = HIGH_REPR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+        else {
+          if (rawVal == NULLU2)
+            bufferVal = NULL8;
+          else if (rawVal == LOW_INSTR_SATU2)
+            bufferVal = LOW_INSTR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+
+        ((unsigned short *)nativeRaw)[i] = rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedInteger) {
+      for (int i = 0; i < count; i++) {
+        unsigned int rawVal = ((const unsigned int *)raw)[i];
+        if (m_swapBytes)
+          rawVal = swap4(rawVal);
+
+        double &bufferVal = output[i];
+        if (rawVal >= VALID_MINUI4) {
+          bufferVal = (double) rawVal * m_multiplier + m_base;
+        }
+        else if (rawVal > VALID_MAXUI4) {
+          if (rawVal == HIGH_INSTR_SATUI4)
+            bufferVal = HIGH_INSTR_SAT8;
+          else if (rawVal == HIGH_REPR_SATUI4)
+            bufferVal = HIGH_REPR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+        else {
+          if (rawVal == NULLUI4)
+            bufferVal = NULL8;
+          else if (rawVal == LOW_INSTR_SATUI4)
+            bufferVal = LOW_INSTR_SAT8;
+          else
+            bufferVal = LOW_REPR_SAT8;
+        }
+
+        ((unsigned int *)nativeRaw)[i] = rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedByte) {
+      for (int i = 0; i < count; i++) {
+        unsigned char rawVal = ((const unsigned char *)raw)[i];
+
+        if (rawVal == NULL1) {
+          output[i] = NULL8;
+        }
+        else if (rawVal == HIGH_REPR_SAT1) {
+          output[i] = HIGH_REPR_SAT8;
+        }
+        else {
+          output[i] = (double) rawVal * m_multiplier + m_base;
+        }
+
+        ((unsigned char *)nativeRaw)[i] = rawVal;
+      }
+    }
+  }
+
+
+  /**
+   * The reference conversion from doubles to raw DNs, one pixel at a time.
+   *
+   * @see toRaw()
+   */
+  void RawPixelConverter::scalarToRaw(const double *input, char *raw,
+                                      int count) const {
+    if (m_pixelType == Real) {
+      for (int i = 0; i < count; i++) {
+        double bufferVal = input[i];
+        float rawVal = 0;
+
+        if (bufferVal >= VALID_MIN8) {
+          double filePixelValueDbl = (bufferVal - m_base) / m_multiplier;
+
+          if (filePixelValueDbl < (double) VALID_MIN4) {
+            rawVal = LOW_REPR_SAT4;
+          }
+          else if (filePixelValueDbl > (double) VALID_MAX4) {
+            rawVal = HIGH_REPR_SAT4;
+          }
+          else {
+            rawVal = (float) filePixelValueDbl;
+          }
+        }
+        else {
+          if (bufferVal == NULL8)
+            rawVal = NULL4;
+          else if (bufferVal == LOW_INSTR_SAT8)
+            rawVal = LOW_INSTR_SAT4;
+          else if (bufferVal == LOW_REPR_SAT8)
+            rawVal = LOW_REPR_SAT4;
+          else if (bufferVal == HIGH_INSTR_SAT8)
+            rawVal = HIGH_INSTR_SAT4;
+          else if (bufferVal == HIGH_REPR_SAT8)
+            rawVal = HIGH_REPR_SAT4;
+          else
+            rawVal = LOW_REPR_SAT4;
+        }
+
+        ((float *)raw)[i] = m_swapBytes ? swapFloat(rawVal) : rawVal;
+      }
+    }
+
+    else if (m_pixelType == SignedWord) {
+      for (int i = 0; i < count; i++) {
+        double bufferVal = input[i];
+        short rawVal;
+
+        if (bufferVal >= VALID_MIN8) {
+          double filePixelValueDbl = (bufferVal - m_base) / m_multiplier;
+
+          if (filePixelValueDbl > VALID_MAX2 + 0.5) {
+            rawVal = HIGH_REPR_SAT2;
+          }
+          else if (filePixelValueDbl < VALID_MIN2 - 0.5) {
+            rawVal = LOW_REPR_SAT2;
+          }
+          else {
+            int filePixelValue = (int)round(filePixelValueDbl);
+
+            if (filePixelValue < VALID_MIN2) {
+              rawVal = LOW_REPR_SAT2;
+            }
+            else if (filePixelValue > VALID_MAX2) {
+              rawVal = HIGH_REPR_SAT2;
+            }
+            else {
+              rawVal = filePixelValue;
+            }
+          }
+        }
+        else {
+          if (bufferVal == NULL8)
+            rawVal = NULL2;
+          else if (bufferVal == LOW_INSTR_SAT8)
+            rawVal = LOW_INSTR_SAT2;
+          else if (bufferVal == LOW_REPR_SAT8)
+            rawVal = LOW_REPR_SAT2;
+          else if (bufferVal == HIGH_INSTR_SAT8)
+            rawVal = HIGH_INSTR_SAT2;
+          else if (bufferVal == HIGH_REPR_SAT8)
+            rawVal = HIGH_REPR_SAT2;
+          else
+            rawVal = LOW_REPR_SAT2;
+        }
+
+        ((short *)raw)[i] = m_swapBytes ?
+            (short)swap2((unsigned short)rawVal) : rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedInteger) {
+      for (int i = 0; i < count; i++) {
+        double bufferVal = input[i];
+        unsigned int rawVal;
+
+        if (bufferVal >= VALID_MINUI4) {
+          double filePixelValueDbl = (bufferVal - m_base) / m_multiplier;
+
+          if (filePixelValueDbl > VALID_MAXUI4) {
+            rawVal = HIGH_REPR_SATUI4;
+          }
+          else if (filePixelValueDbl < VALID_MINUI4 - 0.5) {
+            rawVal = LOW_REPR_SATUI4;
+          }
+          else {
+            unsigned int filePixelValue = (unsigned int)round(filePixelValueDbl);
+
+            if (filePixelValue < VALID_MINUI4) {
+              rawVal = LOW_REPR_SATUI4;
+            }
+            else if (filePixelValue > VALID_MAXUI4) {
+              rawVal = HIGH_REPR_SATUI4;
+            }
+            else {
+              rawVal = filePixelValue;
+            }
+          }
+        }
+        else {
+          if (bufferVal == NULL8)
+            rawVal = NULLUI4;
+          else if (bufferVal == LOW_INSTR_SAT8)
+            rawVal = LOW_INSTR_SATUI4;
+          else if (bufferVal == LOW_REPR_SAT8)
+            rawVal = LOW_REPR_SATUI4;
+          else if (bufferVal == HIGH_INSTR_SAT8)
+            rawVal = HIGH_INSTR_SATUI4;
+          else if (bufferVal == HIGH_REPR_SAT8)
+            rawVal = HIGH_REPR_SATUI4;
+          else
+            rawVal = LOW_REPR_SATUI4;
+        }
+
+        ((unsigned int *)raw)[i] = m_swapBytes ? swap4(rawVal) : rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedWord) {
+      for (int i = 0; i < count; i++) {
+        double bufferVal = input[i];
+        unsigned short rawVal;
+
+        if (bufferVal >= VALID_MIN8) {
+          double filePixelValueDbl = (bufferVal - m_base) / m_multiplier;
+
+          if (filePixelValueDbl > VALID_MAXU2 + 0.5) {
+            rawVal = HIGH_REPR_SATU2;
+          }
+          else if (filePixelValueDbl < VALID_MINU2 - 0.5) {
+            rawVal = LOW_REPR_SATU2;
+          }
+          else {
+            int filePixelValue = (int)round(filePixelValueDbl);
+
+            if (filePixelValue < VALID_MINU2) {
+              rawVal = LOW_REPR_SATU2;
+            }
+            else if (filePixelValue > VALID_MAXU2) {
+              rawVal = HIGH_REPR_SATU2;
+            }
+            else {
+              rawVal = filePixelValue;
+            }
+          }
+        }
+        else {
+          if (bufferVal == NULL8)
+            rawVal = NULLU2;
+          else if (bufferVal == LOW_INSTR_SAT8)
+            rawVal = LOW_INSTR_SATU2;
+          else if (bufferVal == LOW_REPR_SAT8)
+            rawVal = LOW_REPR_SATU2;
+          else if (bufferVal == HIGH_INSTR_SAT8)
+            rawVal = HIGH_INSTR_SATU2;
+          else if (bufferVal == HIGH_REPR_SAT8)
+            rawVal = HIGH_REPR_SATU2;
+          else
+            rawVal = LOW_REPR_SATU2;
+        }
+
+        ((unsigned short *)raw)[i] = m_swapBytes ? swap2(rawVal) : rawVal;
+      }
+    }
+
+    else if (m_pixelType == UnsignedByte) {
+      for (int i = 0; i < count; i++) {
+        double bufferVal = input[i];
+        unsigned char rawVal;
+
+        if (bufferVal >= VALID_MIN8) {
+          double filePixelValueDbl = (bufferVal - m_base) / m_multiplier;
+
+          if (filePixelValueDbl < VALID_MIN1 - 0.5) {
+            rawVal = LOW_REPR_SAT1;
+          }
+          else if (filePixelValueDbl > VALID_MAX1 + 0.5) {
+            rawVal = HIGH_REPR_SAT1;
+          }
+          else {
+            int filePixelValue = (int)(filePixelValueDbl + 0.5);
+
+            if (filePixelValue < VALID_MIN1) {
+              rawVal = LOW_REPR_SAT1;
+            }
+            else if (filePixelValue > VALID_MAX1) {
+              rawVal = HIGH_REPR_SAT1;
+            }
+            else {
+              rawVal = (unsigned char)(filePixelValue);
+            }
+          }
+        }
+        else {
+          if (bufferVal == NULL8)
+            rawVal = NULL1;
+          else if (bufferVal == LOW_INSTR_SAT8)
+            rawVal = LOW_INSTR_SAT1;
+          else if (bufferVal == LOW_REPR_SAT8)
+            rawVal = LOW_REPR_SAT1;
+          else if (bufferVal == HIGH_INSTR_SAT8)
+            rawVal = HIGH_INSTR_SAT1;
+          else if (bufferVal == HIGH_REPR_SAT8)
+            rawVal = HIGH_REPR_SAT1;
+          else
+            rawVal = LOW_REPR_SAT1;
+        }
+
+        ((unsigned char *)raw)[i] = rawVal;
+      }
+    }
+  }
+
+
+#if defined(RAW_PIXEL_CONVERTER_AVX2)
+  /**
+   * The AVX2 conversion from raw DNs to doubles. Groups of 8 pixels that are
+   *   all valid are converted with vector instructions; any other group is
+   *   converted by scalarToDouble().
+   *
+   * @see toDouble()
+   * @return The number of pixels converted, the rest need converted by
+   *     scalarToDouble().
+   */
+  __attribute__((target("avx2")))
+  int RawPixelConverter::avx2ToDouble(const char *raw, double *output,
+                                      char *nativeRaw, int count) const {
+    const __m256i swap2Mask = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m256i swap4Mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256d multiplier = _mm256_set1_pd(m_multiplier);
+    const __m256d base = _mm256_set1_pd(m_base);
+
+    int pixelSize = SizeOf(m_pixelType);
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+      const char *rawIn = raw + i * pixelSize;
+      char *nativeOut = nativeRaw + i * pixelSize;
+      double *out = output + i;
+      bool allValid = false;
+
+      if (m_pixelType == Real) {
+        __m256i bits = _mm256_loadu_si256((const __m256i *)rawIn);
+        if (m_swapBytes)
+          bits = _mm256_shuffle_epi8(bits, swap4Mask);
+
+        __m256 values = _mm256_castsi256_ps(bits);
+        __m256 valid = _mm256_cmp_ps(values, _mm256_set1_ps(VALID_MIN4),
+                                     _CMP_GE_OQ);
+        allValid = (_mm256_movemask_ps(valid) == 0xFF);
+
+        if (allValid) {
+          _mm256_storeu_si256((__m256i *)nativeOut, bits);
+          _mm256_storeu_pd(out, _mm256_cvtps_pd(_mm256_castps256_ps128(values)));
+          _mm256_storeu_pd(out + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)));
+        }
+      }
+      else if (m_pixelType == SignedWord || m_pixelType == UnsignedWord) {
+        __m128i bits = _mm_loadu_si128((const __m128i *)rawIn);
+        if (m_swapBytes)
+          bits = _mm_shuffle_epi8(bits, _mm256_castsi256_si128(swap2Mask));
+
+        __m256i ints;
+        if (m_pixelType == SignedWord) {
+          __m128i valid = _mm_cmpgt_epi16(bits, _mm_set1_epi16(VALID_MIN2 - 1));
+          allValid = (_mm_movemask_epi8(valid) == 0xFFFF);
+          ints = _mm256_cvtepi16_epi32(bits);
+        }
+        else {
+          __m128i valid = _mm_cmpeq_epi16(
+              _mm_max_epu16(bits, _mm_set1_epi16(VALID_MINU2)), bits);
+          allValid = (_mm_movemask_epi8(valid) == 0xFFFF);
+          ints = _mm256_cvtepu16_epi32(bits);
+        }
+
+        if (allValid) {
+          _mm_storeu_si128((__m128i *)nativeOut, bits);
+
+          __m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ints));
+          __m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ints, 1));
+          _mm256_storeu_pd(out, _mm256_add_pd(_mm256_mul_pd(low, multiplier), base));
+          _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_mul_pd(high, multiplier), base));
+        }
+      }
+      else if (m_pixelType == UnsignedInteger) {
+        __m256i bits = _mm256_loadu_si256((const __m256i *)rawIn);
+        if (m_swapBytes)
+          bits = _mm256_shuffle_epi8(bits, swap4Mask);
+
+        __m256i valid = _mm256_cmpeq_epi32(
+            _mm256_max_epu32(bits, _mm256_set1_epi32(VALID_MINUI4)), bits);
+        allValid = (_mm256_movemask_epi8(valid) == -1);
+
+        if (allValid) {
+          _mm256_storeu_si256((__m256i *)nativeOut, bits);
+
+          // There is no unsigned conversion to double, so convert the signed
+          //   value offset by 2^31 (exact) and add 2^31 back.
+          __m256i offsetBits = _mm256_xor_si256(bits,
+              _mm256_set1_epi32((int)0x80000000));
+          const __m256d offset = _mm256_set1_pd(2147483648.0);
+          __m256d low = _mm256_add_pd(
+              _mm256_cvtepi32_pd(_mm256_castsi256_si128(offsetBits)), offset);
+          __m256d high = _mm256_add_pd(
+              _mm256_cvtepi32_pd(_mm256_extracti128_si256(offsetBits, 1)), offset);
+          _mm256_storeu_pd(out, _mm256_add_pd(_mm256_mul_pd(low, multiplier), base));
+          _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_mul_pd(high, multiplier), base));
+        }
+      }
+      else if (m_pixelType == UnsignedByte) {
+        __m128i bits = _mm_loadl_epi64((const __m128i *)rawIn);
+        __m128i special = _mm_or_si128(
+            _mm_cmpeq_epi8(bits, _mm_set1_epi8((char)NULL1)),
+            _mm_cmpeq_epi8(bits, _mm_set1_epi8((char)HIGH_REPR_SAT1)));
+        allValid = ((_mm_movemask_epi8(special) & 0xFF) == 0);
+
+        if (allValid) {
+          _mm_storel_epi64((__m128i *)nativeOut, bits);
+
+          __m256i ints = _mm256_cvtepu8_epi32(bits);
+          __m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ints));
+          __m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ints, 1));
+          _mm256_storeu_pd(out, _mm256_add_pd(_mm256_mul_pd(low, multiplier), base));
+          _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_mul_pd(high, multiplier), base));
+        }
+      }
+      else {
+        // Not a pixel type we convert
+        break;
+      }
+
+      if (!allValid) {
+        scalarToDouble(rawIn, out, nativeOut, 8);
+      }
+    }
+
+    return i;
+  }
+
+
+  /**
+   * The AVX2 conversion from doubles to raw DNs. Groups of 4 pixels that are
+   *   all valid and in the range of the pixel type are converted with vector
+   *   instructions; any other group is converted by scalarToRaw().
+   *
+   * @see toRaw()
+   * @return The number of pixels converted, the rest need converted by
+   *     scalarToRaw().
+   */
+  __attribute__((target("avx2")))
+  int RawPixelConverter::avx2ToRaw(const double *input, char *raw,
+                                   int count) const {
+    const __m128i swap2Mask = _mm_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128i swap4Mask = _mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256d multiplier = _mm256_set1_pd(m_multiplier);
+    const __m256d base = _mm256_set1_pd(m_base);
+
+    int pixelSize = SizeOf(m_pixelType);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+      const double *in = input + i;
+      char *rawOut = raw + i * pixelSize;
+
+      __m256d bufferVals = _mm256_loadu_pd(in);
+      __m256d valid = _mm256_cmp_pd(bufferVals, _mm256_set1_pd(VALID_MIN8),
+                                    _CMP_GE_OQ);
+      __m256d filePixelValues = _mm256_div_pd(
+          _mm256_sub_pd(bufferVals, base), multiplier);
+      bool allValid = false;
+
+      if (m_pixelType == Real) {
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(filePixelValues,
+            _mm256_set1_pd((double) VALID_MIN4), _CMP_GE_OQ));
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(filePixelValues,
+            _mm256_set1_pd((double) VALID_MAX4), _CMP_LE_OQ));
+        allValid = allTrue(valid);
+
+        if (allValid) {
+          __m128i bits = _mm_castps_si128(_mm256_cvtpd_ps(filePixelValues));
+          if (m_swapBytes)
+            bits = _mm_shuffle_epi8(bits, swap4Mask);
+          _mm_storeu_si128((__m128i *)rawOut, bits);
+        }
+      }
+      else if (m_pixelType == SignedWord || m_pixelType == UnsignedWord) {
+        __m256d rounded = roundHalfAway(filePixelValues);
+        double minimum = (m_pixelType == SignedWord) ? VALID_MIN2 : VALID_MINU2;
+        double maximum = (m_pixelType == SignedWord) ? VALID_MAX2 : VALID_MAXU2;
+
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(rounded,
+            _mm256_set1_pd(minimum), _CMP_GE_OQ));
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(rounded,
+            _mm256_set1_pd(maximum), _CMP_LE_OQ));
+        allValid = allTrue(valid);
+
+        if (allValid) {
+          __m128i ints = _mm256_cvtpd_epi32(rounded);
+          __m128i bits = (m_pixelType == SignedWord) ?
+              _mm_packs_epi32(ints, ints) : _mm_packus_epi32(ints, ints);
+          if (m_swapBytes)
+            bits = _mm_shuffle_epi8(bits, swap2Mask);
+          _mm_storel_epi64((__m128i *)rawOut, bits);
+        }
+      }
+      else if (m_pixelType == UnsignedInteger) {
+        __m256d rounded = roundHalfAway(filePixelValues);
+
+        // The scalar conversion tests the double against VALID_MINUI4 before
+        //   scaling it, do the same.
+        valid = _mm256_cmp_pd(bufferVals, _mm256_set1_pd(VALID_MINUI4),
+                              _CMP_GE_OQ);
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(filePixelValues,
+            _mm256_set1_pd(VALID_MAXUI4), _CMP_LE_OQ));
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(rounded,
+            _mm256_set1_pd(VALID_MINUI4), _CMP_GE_OQ));
+        allValid = allTrue(valid);
+
+        if (allValid) {
+          // Convert through the signed range, see avx2ToDouble()
+          __m128i bits = _mm_xor_si128(
+              _mm256_cvtpd_epi32(_mm256_sub_pd(rounded,
+                                               _mm256_set1_pd(2147483648.0))),
+              _mm_set1_epi32((int)0x80000000));
+          if (m_swapBytes)
+            bits = _mm_shuffle_epi8(bits, swap4Mask);
+          _mm_storeu_si128((__m128i *)rawOut, bits);
+        }
+      }
+      else if (m_pixelType == UnsignedByte) {
+        // The scalar conversion truncates x + 0.5, which is floor() for the
+        //   values we accept here.
+        __m256d rounded = _mm256_floor_pd(
+            _mm256_add_pd(filePixelValues, _mm256_set1_pd(0.5)));
+
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(filePixelValues,
+            _mm256_set1_pd(VALID_MIN1 - 0.5), _CMP_GE_OQ));
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(rounded,
+            _mm256_set1_pd(VALID_MIN1), _CMP_GE_OQ));
+        valid = _mm256_and_pd(valid, _mm256_cmp_pd(rounded,
+            _mm256_set1_pd(VALID_MAX1), _CMP_LE_OQ));
+        allValid = allTrue(valid);
+
+        if (allValid) {
+          __m128i ints = _mm256_cvtpd_epi32(rounded);
+          __m128i bits = _mm_packus_epi16(_mm_packs_epi32(ints, ints),
+                                          _mm_setzero_si128());
+          int packed = _mm_cvtsi128_si32(bits);
+          memcpy(rawOut, &packed, 4);
+        }
+      }
+      else {
+        // Not a pixel type we convert
+        break;
+      }
+
+      if (!allValid) {
+        scalarToRaw(in, rawOut, 4);
+      }
+    }
+
+    return i;
+  }
+#endif
+}
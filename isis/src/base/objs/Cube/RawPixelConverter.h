@@ -0,0 +1,82 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef RawPixelConverter_h
+#define RawPixelConverter_h
+
+#include "PixelType.h"
+
+namespace Isis {
+  /**
+   * @ingroup LowLevelCubeIO
+   * @brief Converts runs of raw cube DNs to and from doubles
+   *
+   * This converts contiguous runs of pixels between the on-disk
+   *   representation of a cube (byte order, pixel type, base and multiplier)
+   *   and the double precision values used by Buffer, including the special
+   *   pixel mapping. It is used by CubeIoHandler to move one line of a chunk
+   *   at a time.
+   *
+   * When the CPU supports AVX2 (checked once at run time), runs of pixels are
+   *   converted several at a time with vector instructions. Any group of
+   *   pixels that contains special pixels or values that need to be clamped
+   *   is handed to the scalar code, so the results are identical to the
+   *   scalar conversion for every input.
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class RawPixelConverter {
+    public:
+      RawPixelConverter(PixelType pixelType, bool swapBytes, double base,
+                        double multiplier);
+      ~RawPixelConverter();
+
+      void toDouble(const char *raw, double *output, char *nativeRaw,
+                    int count) const;
+      void toRaw(const double *input, char *raw, int count) const;
+
+      static bool isVectorized();
+
+    protected:
+      void scalarToDouble(const char *raw, double *output, char *nativeRaw,
+                          int count) const;
+      void scalarToRaw(const double *input, char *raw, int count) const;
+
+      int avx2ToDouble(const char *raw, double *output, char *nativeRaw,
+                       int count) const;
+      int avx2ToRaw(const double *input, char *raw, int count) const;
+
+    private:
+      //! The format of each DN on disk.
+      PixelType m_pixelType;
+      //! True if the DNs on disk are not in the native byte order.
+      bool m_swapBytes;
+      //! The additive offset of the data on disk.
+      double m_base;
+      //! The multiplicative factor of the data on disk.
+      double m_multiplier;
+  };
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "FileName.h"
 #include "IException.h"
 #include "IString.h"
+#include "SpecialPixel.h"
 #include "UniversalGroundMap.h"
 
 namespace Isis {
@@ -31,11 +32,13 @@ namespace Isis {
     p_managedData = NULL;
     p_threadSafeMutex = NULL;
     p_managedDataSources = NULL;
+    p_managedDataLevels = NULL;
 
     p_managedCubes = new QMap< int, QPair< bool, Cube * > > ;
     p_managedData = new QList< QPair< QReadWriteLock *, Brick * > > ;
     p_threadSafeMutex = new QMutex();
     p_managedDataSources = new QList< int > ;
+    p_managedDataLevels = new QList< int > ;
 
     p_numChangeListeners = 0;
     p_currentLocksWaiting = 0;
@@ -99,6 +102,11 @@ namespace Isis {
       delete p_managedDataSources;
       p_managedDataSources = NULL;
     }
+
+    if (p_managedDataLevels) {
+      delete p_managedDataLevels;
+      p_managedDataLevels = NULL;
+    }
   }
 
   /**
@@ -248,9 +256,13 @@ namespace Isis {
    *               the data when they receive either the ReadReady or the
    *               ReadWriteReady signal
    * @param sharedLock True if read-only, false if read-write
+   * @param overviewLevel The overview level to read from, 0 for the full
+   *                      resolution data. The brick is still in full
+   *                      resolution coordinates.
    */
   void CubeDataThread::GetCubeData(int cubeId, int ss, int sl, int es, int el,
-                                   int band, void *caller, bool sharedLock) {
+                                   int band, void *caller, bool sharedLock,
+                                   int overviewLevel) {
 
     Brick *requestedBrick = NULL;
 
@@ -264,7 +276,8 @@ namespace Isis {
     int instance = 0;
     int exactIndex = -1;
     bool exactMatch = false;
-    int index = OverlapIndex(requestedBrick, cubeId, instance, exactMatch);
+    int index = OverlapIndex(requestedBrick, cubeId, overviewLevel, instance,
+                             exactMatch);
 
     // while overlaps are found
     while (index != -1) {
@@ -295,7 +308,8 @@ namespace Isis {
       }
 
       instance++;
-      index = OverlapIndex(requestedBrick, cubeId, instance, exactMatch);
+      index = OverlapIndex(requestedBrick, cubeId, overviewLevel, instance,
+                           exactMatch);
     }
 
     if(p_stopping) return;
@@ -303,7 +317,13 @@ namespace Isis {
     if (exactIndex == -1) {
       p_threadSafeMutex->lock();
 
-      p_managedCubes->value(cubeId).second->read(*requestedBrick);
+      if (overviewLevel > 0) {
+        ReadOverview(p_managedCubes->value(cubeId).second, *requestedBrick,
+                     overviewLevel);
+      }
+      else {
+        p_managedCubes->value(cubeId).second->read(*requestedBrick);
+      }
 
       QPair< QReadWriteLock *, Brick * > managedDataEntry;
 
@@ -315,6 +335,7 @@ namespace Isis {
 
       p_managedData->append(managedDataEntry);
       p_managedDataSources->append(cubeId);
+      p_managedDataLevels->append(overviewLevel);
 
       exactIndex = p_managedData->size() - 1;
 
@@ -430,7 +451,95 @@ namespace Isis {
     }
 
     GetCubeData(cubeId, startSample, startLine, endSample, endLine, band,
-                caller, true);
+                caller, true, 0);
+  }
+
+
+  /**
+   * This slot works like ReadCube, but the data is read from one of the
+   * cube's overview levels (see Cube::createOverviews()) instead of its full
+   * resolution data. The brick given with ReadReady still covers the
+   * requested full resolution samples and lines; each of its pixels is the
+   * overview pixel that covers it. This lets zoomed out views read a fraction
+   * of the cube.
+   *
+   * @param cubeId Cube to read from
+   * @param startSample Starting Sample Position
+   * @param startLine Starting Line Position
+   * @param endSample Ending Sample Position
+   * @param endLine Ending Line Position
+   * @param band Band Number To Read From (multi-band bricks not supported at this
+   *             time)
+   * @param overviewLevel The overview level to read from
+   * @param caller A pointer to the calling class, used to identify who requested
+   *               the data when they receive the ReadReady signal
+   */
+  void CubeDataThread::ReadCubeOverview(int cubeId, int startSample,
+                                        int startLine, int endSample,
+                                        int endLine, int band,
+                                        int overviewLevel, void *caller) {
+
+    if(!p_managedCubes->contains(cubeId)) {
+      IString msg = "cube ID [";
+      msg += IString(cubeId);
+      msg += "] is not a valid cube ID";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    GetCubeData(cubeId, startSample, startLine, endSample, endLine, band,
+                caller, true, overviewLevel);
+  }
+
+
+  /**
+   * This fills a full resolution brick from an overview level of the cube.
+   * Each line of the brick is read from the overview line that covers it
+   * and every pixel gets the value of the overview pixel that covers it.
+   * Pixels outside of the cube are Null, like Cube::read() gives.
+   *
+   * @param cube The cube to read from
+   * @param brick The brick to fill, in full resolution coordinates
+   * @param overviewLevel The overview level to read from
+   */
+  void CubeDataThread::ReadOverview(const Cube *cube, Brick &brick,
+                                    int overviewLevel) {
+    int reduction = 1 << overviewLevel;
+    int startSample = brick.Sample(0);
+    int sampleCount = brick.SampleDimension();
+
+    // The overview samples covering the cube's part of the brick
+    int firstSample = qMax(startSample, 1);
+    int lastSample = qMin(startSample + sampleCount - 1, cube->sampleCount());
+    int overviewStart = (firstSample - 1) / reduction + 1;
+    int overviewEnd = (lastSample - 1) / reduction + 1;
+
+    Brick overviewLine(qMax(overviewEnd - overviewStart + 1, 1), 1, 1,
+                       cube->pixelType());
+
+    for (int line = 0; line < brick.LineDimension(); line++) {
+      int cubeLine = brick.Line(line * sampleCount);
+      bool lineInCube = cubeLine >= 1 && cubeLine <= cube->lineCount() &&
+                        firstSample <= lastSample;
+
+      if (lineInCube) {
+        overviewLine.SetBasePosition(overviewStart,
+                                     (cubeLine - 1) / reduction + 1,
+                                     brick.Band(0));
+        cube->readOverview(overviewLine, overviewLevel);
+      }
+
+      for (int i = 0; i < sampleCount; i++) {
+        int sample = startSample + i;
+        double &pixel = brick[line * sampleCount + i];
+
+        if (lineInCube && sample >= firstSample && sample <= lastSample) {
+          pixel = overviewLine[(sample - 1) / reduction + 1 - overviewStart];
+        }
+        else {
+          pixel = Null;
+        }
+      }
+    }
   }
 
   /**
@@ -464,7 +573,7 @@ namespace Isis {
     }
 
     GetCubeData(cubeId, startSample, startLine, endSample, endLine, band,
-                caller, false);
+                caller, false, 0);
   }
 
   /**
@@ -473,6 +582,7 @@ namespace Isis {
    *
    * @param overlapping Brick to check for overlaps with
    * @param cubeId Cube ID asssociated with this brick
+   * @param overviewLevel The overview level the brick is read from
    * @param instanceNum Which instance of overlap to return
    * @param exact This is set to false if the match found is not exactly
    *   the overlapping brick.
@@ -481,7 +591,8 @@ namespace Isis {
    *   p_managedDataSources that an overlap was found at
    */
   int CubeDataThread::OverlapIndex(const Brick *overlapping, int cubeId,
-                                   int instanceNum, bool &exact) {
+                                   int overviewLevel, int instanceNum,
+                                   bool &exact) {
     exact = false;
 
     // Start with extracting the range of the input (search) brick
@@ -497,8 +608,9 @@ namespace Isis {
     for (int knownBrick = 0; knownBrick < p_managedData->size(); knownBrick++) {
       int sourceCube = (*p_managedDataSources)[knownBrick];
 
-      // Ignore other cubes; they can't overlap
-      if (sourceCube != cubeId)
+      // Ignore other cubes and overview levels; they can't overlap
+      if (sourceCube != cubeId ||
+          (*p_managedDataLevels)[knownBrick] != overviewLevel)
         continue;
 
       QPair< QReadWriteLock *, Brick * > &managedBrick =
@@ -584,13 +696,25 @@ namespace Isis {
     bool exactMatch = false;
     bool writeLock = false;
 
-    int index = OverlapIndex(brickDone, cubeId, instance, exactMatch);
+    // Find the level of the brick, bricks equivalent to an overview brick are
+    //   not looked for
+    int overviewLevel = 0;
+    for (int i = 0; i < p_managedData->size(); i++) {
+      if ((*p_managedData)[i].second == brickDone) {
+        overviewLevel = (*p_managedDataLevels)[i];
+        break;
+      }
+    }
+
+    int index = OverlapIndex(brickDone, cubeId, overviewLevel, instance,
+                             exactMatch);
     ASSERT(p_managedData->size() == p_managedDataSources->size());
     while (index != -1) {
       // If this isn't the data they're finished with, we don't care about it
       if (!exactMatch) {
         instance++;
-        index = OverlapIndex(brickDone, cubeId, instance, exactMatch);
+        index = OverlapIndex(brickDone, cubeId, overviewLevel, instance,
+                             exactMatch);
         continue;
       }
 
@@ -662,7 +786,8 @@ namespace Isis {
       }
 
       instance++;
-      index = OverlapIndex(brickDone, cubeId, instance, exactMatch);
+      index = OverlapIndex(brickDone, cubeId, overviewLevel, instance,
+                           exactMatch);
     }
 
     ASSERT(p_managedData->size() == p_managedDataSources->size());
@@ -697,6 +822,7 @@ namespace Isis {
 
       p_managedData->removeAt(brickIndex);
       p_managedDataSources->removeAt(brickIndex);
+      p_managedDataLevels->removeAt(brickIndex);
 
       // Try to free any leftover bricks too
       for (int i = 0; i < p_managedData->size(); i++) {
@@ -705,6 +831,7 @@ namespace Isis {
           delete (*p_managedData)[i].second;
           p_managedData->removeAt(i);
           p_managedDataSources->removeAt(i);
+          p_managedDataLevels->removeAt(i);
           i--;
         }
       }
@@ -46,6 +46,9 @@ namespace Isis {
    *   @history 2012-02-27 Jai Rideout and Steven Lambright - Made
    *                           BricksInMemory() thread-safe. Fixes #733.
    *   @history 2016-06-21 Kris Becker - Properly forward declare QPair as struct not class
+   *   @history 2026-10-16 Isis Development Team - Added ReadCubeOverview so
+   *                           zoomed out views can be read from a cube's
+   *                           overview levels.
    *
    *   @todo Add state recording/reverting functionality
    *
@@ -78,6 +81,9 @@ namespace Isis {
                     int endSample, int endLine, int band, void *caller);
       void ReadWriteCube(int cubeId, int startSample, int startLine,
                          int endSample, int endLine, int band, void *caller);
+      void ReadCubeOverview(int cubeId, int startSample, int startLine,
+                            int endSample, int endLine, int band,
+                            int overviewLevel, void *caller);
 
       void DoneWithData(int, const Isis::Brick *);
 
@@ -145,11 +151,13 @@ namespace Isis {
        */
       const CubeDataThread &operator=(CubeDataThread rhs);
 
-      int OverlapIndex(const Brick *initial, int cubeId,
+      int OverlapIndex(const Brick *initial, int cubeId, int overviewLevel,
                        int instanceNum, bool &exact);
 
       void GetCubeData(int cubeId, int ss, int sl, int es, int el, int band,
-                       void *caller, bool sharedLock);
+                       void *caller, bool sharedLock, int overviewLevel);
+
+      void ReadOverview(const Cube *cube, Brick &brick, int overviewLevel);
 
       void AcquireLock(QReadWriteLock *lockObject, bool readLock);
 
@@ -195,6 +203,12 @@ namespace Isis {
       //! This is the associated cube ID with each brick
       QList< int > * p_managedDataSources;
 
+      /**
+       * This is the overview level each brick was read from, 0 for the full
+       * resolution data. Bricks of different levels never overlap.
+       */
+      QList< int > * p_managedDataLevels;
+
       //! This is the number of shaded locks to put on a brick when changes made
       int p_numChangeListeners;
 
@@ -0,0 +1,621 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "CubeOverview.h"
+
+#include <algorithm>
+#include <climits>
+
+#include <QByteArray>
+#include <QCache>
+#include <QFile>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QVector>
+
+#include "Cube.h"
+#include "Endian.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "PvlObject.h"
+#include "RawPixelConverter.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Open one overview level of a cube for reading. Only the labels are read
+   *   here; tiles are read from the file when readLine() needs them.
+   *
+   * @param cubeFile The file the cube's labels are in
+   * @param label The cube's labels
+   * @param level The overview level; the cube is reduced by 2^level
+   */
+  CubeOverview::CubeOverview(const QString &cubeFile, const Pvl &label,
+                             int level) {
+    m_level = level;
+    m_samples = 0;
+    m_lines = 0;
+    m_bands = 0;
+    m_tileSamples = 0;
+    m_tileLines = 0;
+    m_tileColumns = 0;
+    m_tileRows = 0;
+    m_tileCache = new QCache<int, QByteArray>(64);
+    m_converter = NULL;
+
+    FileName labelFile(cubeFile);
+    ByteOrder byteOrder = Lsb;
+
+    try {
+      for (int i = 0; i < label.objects(); i++) {
+        const PvlObject &blob = label.object(i);
+        if (!blob.isNamed("Overview") || (int)blob["Level"] != level) {
+          continue;
+        }
+
+        m_samples = blob["Samples"];
+        m_lines = blob["Lines"];
+        m_bands = blob["Bands"];
+        m_tileSamples = blob["TileSamples"];
+        m_tileLines = blob["TileLines"];
+        byteOrder = ByteOrderEnumeration(blob["ByteOrder"]);
+
+        Part part;
+        part.fileName = labelFile.expanded();
+        if (blob.hasKeyword("^Overview")) {
+          part.fileName = labelFile.path() + "/" + (QString)blob["^Overview"];
+        }
+        part.startByte = blob["StartByte"];
+        part.firstTile = blob["FirstTile"];
+        part.tileCount = blob["Tiles"];
+
+        if ((BigInt)part.tileCount * m_tileSamples * m_tileLines * sizeof(float) !=
+            (BigInt)blob["Bytes"]) {
+          QString msg = "The size of overview [" + (QString)blob["Name"] +
+                        "] does not match its tiles";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        int position = 0;
+        while (position < m_parts.size() &&
+               m_parts[position].firstTile < part.firstTile) {
+          position++;
+        }
+        m_parts.insert(position, part);
+      }
+
+      if (m_parts.isEmpty()) {
+        QString msg = "The cube [" + labelFile.name() +
+                      "] does not have overview level [" + toString(level) + "]";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+
+      m_tileColumns = tileCount(m_samples, m_tileSamples);
+      m_tileRows = tileCount(m_lines, m_tileLines);
+
+      // The blobs have to hold every tile of the level exactly once
+      int nextTile = 0;
+      foreach (const Part &part, m_parts) {
+        if (part.firstTile != nextTile) {
+          break;
+        }
+        nextTile += part.tileCount;
+      }
+
+      if (nextTile != m_tileColumns * m_tileRows * m_bands) {
+        QString msg = "The overview level [" + toString(level) + "] of the cube [" +
+                      labelFile.name() + "] is missing tiles";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+    catch (IException &e) {
+      delete m_tileCache;
+      m_tileCache = NULL;
+
+      QString msg = "Unable to read overview level [" + toString(level) + "]";
+      throw IException(e, IException::Io, msg, _FILEINFO_);
+    }
+
+    m_converter = new RawPixelConverter(Real, byteOrder != (IsLsb() ? Lsb : Msb),
+                                        0.0, 1.0);
+  }
+
+
+  //! Destroys the CubeOverview object.
+  CubeOverview::~CubeOverview() {
+    qDeleteAll(m_files);
+    m_files.clear();
+
+    delete m_tileCache;
+    m_tileCache = NULL;
+
+    delete m_converter;
+    m_converter = NULL;
+  }
+
+
+  /**
+   * @return The overview level; the cube is reduced by 2^level
+   */
+  int CubeOverview::level() const {
+    return m_level;
+  }
+
+
+  /**
+   * @return The number of samples in the overview
+   */
+  int CubeOverview::sampleCount() const {
+    return m_samples;
+  }
+
+
+  /**
+   * @return The number of lines in the overview
+   */
+  int CubeOverview::lineCount() const {
+    return m_lines;
+  }
+
+
+  /**
+   * @return The number of bands in the overview
+   */
+  int CubeOverview::bandCount() const {
+    return m_bands;
+  }
+
+
+  /**
+   * Read part of a line of the overview. Positions outside of the overview
+   *   are Null.
+   *
+   * @param startSample The first sample to read (1-based)
+   * @param count The number of samples to read
+   * @param line The line to read (1-based)
+   * @param band The physical band to read (1-based)
+   * @param output Filled with count pixel values
+   */
+  void CubeOverview::readLine(int startSample, int count, int line, int band,
+                              double *output) const {
+    for (int i = 0; i < count; i++) {
+      output[i] = Null;
+    }
+
+    int first = max(startSample, 1);
+    int last = min(startSample + count - 1, m_samples);
+
+    if (band < 1 || band > m_bands || line < 1 || line > m_lines ||
+        first > last) {
+      return;
+    }
+
+    int tileRow = (line - 1) / m_tileLines;
+    int tileLine = (line - 1) % m_tileLines;
+    QVector<float> nativeRaw(m_tileSamples);
+
+    for (int sample = first; sample <= last; ) {
+      int tileColumn = (sample - 1) / m_tileSamples;
+      int tileStartSample = tileColumn * m_tileSamples + 1;
+      int samplesInTile = min(last, tileStartSample + m_tileSamples - 1) - sample + 1;
+
+      const char *tileData =
+          tile(((band - 1) * m_tileRows + tileRow) * m_tileColumns + tileColumn);
+      BigInt offset = (BigInt)tileLine * m_tileSamples + (sample - tileStartSample);
+
+      m_converter->toDouble(tileData + offset * sizeof(float),
+                            output + (sample - startSample),
+                            (char *)nativeRaw.data(), samplesInTile);
+
+      sample += samplesInTile;
+    }
+  }
+
+
+  /**
+   * Create the overview levels of a cube and write them into the cube as
+   *   Overview blobs, replacing any it already has. Each level is made by
+   *   reducing the one before it, which is kept in a temporary file next to
+   *   the cube, so only a few lines of each level are in memory at a time.
+   *
+   * @param cube The open cube, it must be writable
+   * @param levelCount The number of levels to create, 0 removes them all
+   * @param tileSize The number of samples and lines in each tile
+   * @param tilesPerPart The maximum number of tiles in each Overview blob
+   */
+  void CubeOverview::create(Cube &cube, int levelCount, int tileSize,
+                            int tilesPerPart) {
+    BigInt tileBytes = (BigInt)tileSize * tileSize * sizeof(float);
+    if (tileSize < 1 || tilesPerPart < 1 ||
+        tilesPerPart * tileBytes > (BigInt)INT_MAX) {
+      QString msg = "Overview tiles of [" + toString(tileSize) + "] pixels in "
+                    "blobs of [" + toString(tilesPerPart) + "] tiles are not "
+                    "supported";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Levels that are rewritten reuse their old space in the file, remove the
+    //   blobs that won't be rewritten.
+    QStringList names;
+    for (int level = 1; level <= levelCount; level++) {
+      int tiles = tileCount(reducedSize(cube.sampleCount(), level), tileSize) *
+                  tileCount(reducedSize(cube.lineCount(), level), tileSize) *
+                  cube.bandCount();
+      for (int part = 1; (part - 1) * (BigInt)tilesPerPart < tiles; part++) {
+        names.append(overviewName(level, part));
+      }
+    }
+
+    QStringList staleNames;
+    Pvl &label = *cube.label();
+    for (int i = 0; i < label.objects(); i++) {
+      if (label.object(i).isNamed("Overview") &&
+          !names.contains((QString)label.object(i)["Name"])) {
+        staleNames.append((QString)label.object(i)["Name"]);
+      }
+    }
+
+    foreach (QString name, staleNames) {
+      cube.deleteBlob("Overview", name);
+    }
+
+    RawPixelConverter converter(Real, false, 0.0, 1.0);
+    LineManager cubeLine(cube);
+    QScopedPointer<QTemporaryFile> finerLevel;
+
+    for (int level = 1; level <= levelCount; level++) {
+      int finerSamples = reducedSize(cube.sampleCount(), level - 1);
+      int finerLines = reducedSize(cube.lineCount(), level - 1);
+      int samples = reducedSize(cube.sampleCount(), level);
+      int lines = reducedSize(cube.lineCount(), level);
+      int bands = cube.bandCount();
+
+      QScopedPointer<QTemporaryFile> levelData(
+          new QTemporaryFile(FileName(cube.fileName()).expanded() + ".XXXXXX"));
+      if (!levelData->open()) {
+        QString msg = "Unable to create a temporary file for overview level [" +
+                      toString(level) + "] next to [" + cube.fileName() + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      QVector<double> top(finerSamples);
+      QVector<double> bottom(finerSamples);
+      QVector<double> reduced(samples);
+      QVector<float> raw(max(finerSamples, samples));
+      QVector<float> nativeRaw(finerSamples);
+
+      // Read a line of the level before this one
+      auto readFinerLine = [&](int line, int band, double *output) {
+        if (level == 1) {
+          cubeLine.SetLine(line, band);
+          cube.read(cubeLine);
+          copy(cubeLine.DoubleBuffer(), cubeLine.DoubleBuffer() + finerSamples,
+               output);
+          return;
+        }
+
+        BigInt lineBytes = (BigInt)finerSamples * sizeof(float);
+        if (!finerLevel->seek(((BigInt)(band - 1) * finerLines + (line - 1)) * lineBytes) ||
+            finerLevel->read((char *)raw.data(), lineBytes) != lineBytes) {
+          QString msg = "Reading overview level [" + toString(level - 1) +
+                        "] back from its temporary file failed";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        converter.toDouble((const char *)raw.data(), output,
+                           (char *)nativeRaw.data(), finerSamples);
+      };
+
+      for (int band = 1; band <= bands; band++) {
+        for (int line = 1; line <= lines; line++) {
+          readFinerLine(2 * line - 1, band, top.data());
+
+          const double *bottomData = NULL;
+          if (2 * line <= finerLines) {
+            readFinerLine(2 * line, band, bottom.data());
+            bottomData = bottom.data();
+          }
+
+          reduceLines(top.data(), bottomData, finerSamples, reduced.data());
+          converter.toRaw(reduced.data(), (char *)raw.data(), samples);
+
+          BigInt lineBytes = (BigInt)samples * sizeof(float);
+          if (levelData->write((const char *)raw.data(), lineBytes) != lineBytes) {
+            QString msg = "Writing overview level [" + toString(level) +
+                          "] to its temporary file failed";
+            throw IException(IException::Io, msg, _FILEINFO_);
+          }
+        }
+      }
+
+      levelData->flush();
+
+      int tiles = tileCount(samples, tileSize) * tileCount(lines, tileSize) * bands;
+      for (int firstTile = 0, part = 1; firstTile < tiles;
+           firstTile += tilesPerPart, part++) {
+        PartWriter writer(level, part, samples, lines, bands, tileSize, firstTile,
+                          min(tilesPerPart, tiles - firstTile), levelData.data());
+        cube.write(writer);
+      }
+
+      finerLevel.reset(levelData.take());
+    }
+  }
+
+
+  /**
+   * @param label The labels of a cube
+   * @return The number of overview levels stored in the cube
+   */
+  int CubeOverview::levelCount(const Pvl &label) {
+    int count = 0;
+
+    for (int i = 0; i < label.objects(); i++) {
+      const PvlObject &blob = label.object(i);
+      if (blob.isNamed("Overview") && blob.hasKeyword("Level")) {
+        count = max(count, (int)blob["Level"]);
+      }
+    }
+
+    return count;
+  }
+
+
+  /**
+   * @param level The overview level
+   * @param part The blob's position in the level (1-based)
+   * @return The blob name of part of an overview level
+   */
+  QString CubeOverview::overviewName(int level, int part) {
+    return "Level" + QString::number(level) + "Part" + QString::number(part);
+  }
+
+
+  /**
+   * @param size The number of samples or lines in the cube
+   * @param level The overview level
+   * @return The number of samples or lines at the given overview level
+   */
+  int CubeOverview::reducedSize(int size, int level) {
+    return max(1, (int)(((BigInt)size + (1 << level) - 1) >> level));
+  }
+
+
+  /**
+   * Get a tile of the overview, reading it from the file if it isn't one of
+   *   the recently used tiles. The pointer is only good until the next call.
+   *
+   * @param tileIndex The index of the tile in the level
+   * @return The tile's pixels in their stored byte order
+   */
+  const char *CubeOverview::tile(int tileIndex) const {
+    QByteArray *tileData = m_tileCache->object(tileIndex);
+    if (tileData) {
+      return tileData->constData();
+    }
+
+    const Part *part = NULL;
+    foreach (const Part &candidate, m_parts) {
+      if (tileIndex >= candidate.firstTile &&
+          tileIndex < candidate.firstTile + candidate.tileCount) {
+        part = &candidate;
+        break;
+      }
+    }
+
+    QFile *file = m_files.value(part->fileName);
+    if (!file) {
+      file = new QFile(part->fileName);
+      m_files.insert(part->fileName, file);
+    }
+
+    if (!file->isOpen() && !file->open(QIODevice::ReadOnly)) {
+      QString msg = "Unable to open [" + part->fileName + "] to read overview "
+                    "level [" + toString(m_level) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    BigInt tileBytes = (BigInt)m_tileSamples * m_tileLines * sizeof(float);
+    tileData = new QByteArray;
+
+    if (!file->seek(part->startByte - 1 + (tileIndex - part->firstTile) * tileBytes) ||
+        (*tileData = file->read(tileBytes)).size() != tileBytes) {
+      delete tileData;
+
+      QString msg = "Reading a tile of overview level [" + toString(m_level) +
+                    "] from [" + part->fileName + "] failed";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    m_tileCache->insert(tileIndex, tileData);
+    return tileData->constData();
+  }
+
+
+  /**
+   * @param size The number of samples or lines in a level
+   * @param tileSize The number of samples or lines in a tile
+   * @return The number of tiles it takes to cover size pixels
+   */
+  int CubeOverview::tileCount(int size, int tileSize) {
+    return (size + tileSize - 1) / tileSize;
+  }
+
+
+  /**
+   * Reduce two lines by 2 in the sample direction and average them together.
+   *   Only valid pixels are averaged; if a 2x2 block has no valid pixels, its
+   *   first pixel is used.
+   *
+   * @param top The upper line
+   * @param bottom The lower line, or NULL if there isn't one
+   * @param inputSamples The number of samples in the input lines
+   * @param output Filled with reducedSize(inputSamples, 1) pixel values
+   */
+  void CubeOverview::reduceLines(const double *top, const double *bottom,
+                                 int inputSamples, double *output) {
+    int outputSamples = reducedSize(inputSamples, 1);
+
+    for (int i = 0; i < outputSamples; i++) {
+      int first = 2 * i;
+      int last = min(first + 1, inputSamples - 1);
+
+      double sum = 0.0;
+      int validCount = 0;
+
+      for (int sample = first; sample <= last; sample++) {
+        if (IsValidPixel(top[sample])) {
+          sum += top[sample];
+          validCount++;
+        }
+
+        if (bottom && IsValidPixel(bottom[sample])) {
+          sum += bottom[sample];
+          validCount++;
+        }
+      }
+
+      output[i] = (validCount > 0) ? sum / validCount : top[first];
+    }
+  }
+
+
+  /**
+   * Construct the writer for one Overview blob of a level.
+   *
+   * @param level The overview level
+   * @param part The blob's position in the level (1-based)
+   * @param samples The number of samples in the level
+   * @param lines The number of lines in the level
+   * @param bands The number of bands in the level
+   * @param tileSize The number of samples and lines in a tile
+   * @param firstTile The index of the first tile in this blob
+   * @param tileCount The number of tiles in this blob
+   * @param levelData The level's pixels as native floats in band sequential
+   *                  order. This doesn't take ownership.
+   */
+  CubeOverview::PartWriter::PartWriter(int level, int part, int samples,
+      int lines, int bands, int tileSize, int firstTile, int tileCount,
+      QFile *levelData) : Blob(overviewName(level, part), "Overview") {
+    m_level = level;
+    m_part = part;
+    m_samples = samples;
+    m_lines = lines;
+    m_bands = bands;
+    m_tileSize = tileSize;
+    m_firstTile = firstTile;
+    m_tileCount = tileCount;
+    m_levelData = levelData;
+
+    p_nbytes = tileCount * tileSize * tileSize * sizeof(float);
+  }
+
+
+  /**
+   * Put the overview's dimensions and tiling into its label before it is
+   *   written.
+   */
+  void CubeOverview::PartWriter::WriteInit() {
+    p_blobPvl.addKeyword(PvlKeyword("Level", toString(m_level)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Part", toString(m_part)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Samples", toString(m_samples)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Lines", toString(m_lines)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Bands", toString(m_bands)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("TileSamples", toString(m_tileSize)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("TileLines", toString(m_tileSize)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("FirstTile", toString(m_firstTile)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("Tiles", toString(m_tileCount)),
+                         PvlContainer::Replace);
+    p_blobPvl.addKeyword(PvlKeyword("ByteOrder", ByteOrderName(IsLsb() ? Lsb : Msb)),
+                         PvlContainer::Replace);
+  }
+
+
+  /**
+   * Write this blob's tiles. The lines of one tile row are read from the
+   *   level's temporary file at a time and cut into tiles; tiles that go past
+   *   the edge of the level are padded with Null.
+   *
+   * @param os The stream to write to
+   */
+  void CubeOverview::PartWriter::WriteData(std::fstream &os) {
+    int tileColumns = tileCount(m_samples, m_tileSize);
+    int tileRows = tileCount(m_lines, m_tileSize);
+
+    QVector<float> rowData(m_tileSize * m_samples);
+    QVector<float> tileData(m_tileSize * m_tileSize);
+    int loadedRow = -1;
+
+    for (int tileIndex = m_firstTile; tileIndex < m_firstTile + m_tileCount;
+         tileIndex++) {
+      // Tile rows are counted across all bands
+      int row = tileIndex / tileColumns;
+      int column = tileIndex % tileColumns;
+      int firstLine = (row % tileRows) * m_tileSize;
+      int lineCount = min(m_tileSize, m_lines - firstLine);
+
+      if (row != loadedRow) {
+        BigInt rowBytes = (BigInt)lineCount * m_samples * sizeof(float);
+        BigInt offset = ((BigInt)(row / tileRows) * m_lines + firstLine) *
+                        m_samples * sizeof(float);
+
+        if (!m_levelData->seek(offset) ||
+            m_levelData->read((char *)rowData.data(), rowBytes) != rowBytes) {
+          QString msg = "Reading overview level [" + toString(m_level) +
+                        "] from its temporary file failed";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        loadedRow = row;
+      }
+
+      int firstSample = column * m_tileSize;
+      for (int y = 0; y < m_tileSize; y++) {
+        for (int x = 0; x < m_tileSize; x++) {
+          bool inside = (y < lineCount && firstSample + x < m_samples);
+          tileData[y * m_tileSize + x] =
+              inside ? rowData[(BigInt)y * m_samples + firstSample + x] : NULL4;
+        }
+      }
+
+      os.write((const char *)tileData.data(), tileData.size() * sizeof(float));
+      if (!os.good()) {
+        QString msg = "Error writing data to " + p_type + " [" + p_blobName + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+    }
+  }
+}
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef CubeOverview_h
+#define CubeOverview_h
+
+#include <fstream>
+
+#include <QList>
+#include <QMap>
+#include <QString>
+
+#include "Blob.h"
+#include "Constants.h"
+
+template <class Key, class T> class QCache;
+class QByteArray;
+class QFile;
+
+namespace Isis {
+  class Cube;
+  class Pvl;
+  class RawPixelConverter;
+
+  /**
+   * @brief A reduced resolution copy of a cube's DN data
+   *
+   * This reads one overview level of a cube. Level 1 is the cube reduced by
+   *   2 in the sample and line dimensions, level 2 is reduced by 4 and so on.
+   *   Every band is kept. Each overview pixel is the average of the valid
+   *   pixels in the 2x2 block of the next finer level that it covers; if none
+   *   of them are valid, the block's first pixel is used so special pixels
+   *   carry through to the coarser levels.
+   *
+   * An overview is stored as 32 bit floats, so the cube's special pixels are
+   *   kept, in square tiles of one band. The tiles are ordered by band, then
+   *   tile row, then tile column, and split over Overview blobs of at most a
+   *   set number of tiles each, so a level can be larger than one blob can
+   *   hold. create() writes a level a tile row at a time and readLine() reads
+   *   a tile at a time (keeping a few recently used tiles), so a level never
+   *   has to fit in memory.
+   *
+   * Overviews are created with Cube::createOverviews() (cubeatt does this
+   *   with OVERVIEWS=yes) and read with Cube::readOverview(); CubeViewport
+   *   reads them through CubeDataThread when zoomed out. Writing DN data to
+   *   the cube afterwards removes them (see Cube::write()).
+   *
+   * @ingroup LowLevelCubeIO
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class CubeOverview {
+    public:
+      CubeOverview(const QString &cubeFile, const Pvl &label, int level);
+      ~CubeOverview();
+
+      int level() const;
+      int sampleCount() const;
+      int lineCount() const;
+      int bandCount() const;
+
+      void readLine(int startSample, int count, int line, int band,
+                    double *output) const;
+
+      static void create(Cube &cube, int levelCount,
+                         int tileSize = DefaultTileSize,
+                         int tilesPerPart = DefaultTilesPerPart);
+      static int levelCount(const Pvl &label);
+      static QString overviewName(int level, int part);
+      static int reducedSize(int size, int level);
+
+      //! The number of samples and lines in each tile that create() uses
+      static const int DefaultTileSize = 256;
+      //! The number of tiles in each Overview blob that create() uses (1GB)
+      static const int DefaultTilesPerPart = 4096;
+
+    private:
+      /**
+       * Disallow copying of this object.
+       *
+       * @param other The object to copy.
+       */
+      CubeOverview(const CubeOverview &other);
+
+      /**
+       * Disallow assignments of this object
+       *
+       * @param other The CubeOverview on the right-hand side of the
+       *              assignment that we are copying into *this.
+       * @return A reference to *this.
+       */
+      CubeOverview &operator=(const CubeOverview &other);
+
+      const char *tile(int tileIndex) const;
+
+      static int tileCount(int size, int tileSize);
+      static void reduceLines(const double *top, const double *bottom,
+                              int inputSamples, double *output);
+
+      /**
+       * Where one Overview blob's tiles are stored.
+       */
+      struct Part {
+        QString fileName; //!< The file the blob is stored in
+        BigInt startByte; //!< The first byte of the blob (1-based)
+        int firstTile;    //!< The index of the first tile in the blob
+        int tileCount;    //!< The number of tiles in the blob
+      };
+
+
+      /**
+       * @brief Writes one Overview blob of a level
+       *
+       * The tiles are cut from the level's pixels, which create() keeps in a
+       *   temporary file in band sequential order, one tile row at a time as
+       *   they are written.
+       *
+       * @author 2026-10-16 Isis Development Team
+       *
+       * @internal
+       */
+      class PartWriter : public Blob {
+        public:
+          PartWriter(int level, int part, int samples, int lines, int bands,
+                     int tileSize, int firstTile, int tileCount,
+                     QFile *levelData);
+
+        protected:
+          void WriteInit();
+          void WriteData(std::fstream &os);
+
+        private:
+          /**
+           * Disallow copying of this object.
+           *
+           * @param other The object to copy.
+           */
+          PartWriter(const PartWriter &other);
+
+          /**
+           * Disallow assignments of this object
+           *
+           * @param other The PartWriter on the right-hand side of the
+           *              assignment that we are copying into *this.
+           * @return A reference to *this.
+           */
+          PartWriter &operator=(const PartWriter &other);
+
+          int m_level;     //!< The overview level
+          int m_part;      //!< The blob's position in the level (1-based)
+          int m_samples;   //!< The number of samples in the level
+          int m_lines;     //!< The number of lines in the level
+          int m_bands;     //!< The number of bands in the level
+          int m_tileSize;  //!< The number of samples and lines in a tile
+          int m_firstTile; //!< The index of the first tile in this blob
+          int m_tileCount; //!< The number of tiles in this blob
+          //! The level's pixels as native floats in band sequential order
+          QFile *m_levelData;
+      };
+
+      int m_level;        //!< The overview level, the cube is reduced by 2^level
+      int m_samples;      //!< The number of samples in the overview
+      int m_lines;        //!< The number of lines in the overview
+      int m_bands;        //!< The number of bands in the overview
+      int m_tileSamples;  //!< The number of samples in a tile
+      int m_tileLines;    //!< The number of lines in a tile
+      int m_tileColumns;  //!< The number of tiles across a band
+      int m_tileRows;     //!< The number of tiles down a band
+
+      //! The Overview blobs of this level, in tile order
+      QList<Part> m_parts;
+      //! The files the tiles are read from, by name
+      mutable QMap<QString, QFile *> m_files;
+      //! Recently read tiles in their stored byte order, by tile index
+      QCache<int, QByteArray> *m_tileCache;
+      //! Converts between the stored floats and doubles
+      RawPixelConverter *m_converter;
+  };
+}
+
+#endif
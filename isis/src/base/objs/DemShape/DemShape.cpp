@@ -19,23 +19,21 @@
 
 #include "Cube.h"
 #include "CubeManager.h"
+#include "DemTileCache.h"
 #include "Distance.h"
 #include "EllipsoidShape.h"
 //#include "Geometry3D.h"
 #include "IException.h"
-#include "Interpolator.h"
 #include "Latitude.h"
 //#include "LinearAlgebra.h"
 #include "Longitude.h"
 #include "NaifStatus.h"
-#include "Portal.h"
 #include "Projection.h"
 #include "Pvl.h"
 #include "Spice.h"
 #include "SurfacePoint.h"
 #include "Table.h"
 #include "Target.h"
-#include "UniqueIOCachingAlgorithm.h"
 
 using namespace std;
 
@@ -49,8 +47,6 @@ namespace Isis {
     setName("DemShape");
     m_demProj = NULL;
     m_demCube = NULL;
-    m_interp = NULL;
-    m_portal = NULL;
   }
 
 
@@ -66,8 +62,6 @@ namespace Isis {
     setName("DemShape");
     m_demProj = NULL;
     m_demCube = NULL;
-    m_interp = NULL;
-    m_portal = NULL;
 
     PvlGroup &kernels = pvl.findGroup("Kernels", Pvl::Traverse);
 
@@ -81,18 +75,10 @@ namespace Isis {
 
     m_demCube = CubeManager::Open(demCubeFile);
 
-    // This caching algorithm works much better for DEMs than the default,
-    //   regional. This is because the uniqueIOCachingAlgorithm keeps track
-    //   of a history, which for something that isn't linearly processing a
-    //   cube is worth it. The regional caching algorithm tosses out results
-    //   from iteration 1 of setlookdirection (first algorithm) at iteration
-    //   4 and the next setimage has to re-read the data.
-    m_demCube->addCachingAlgorithm(new UniqueIOCachingAlgorithm(5));
+    // Radii are interpolated from DEM tiles kept in memory and shared by every
+    //   DemShape using this DEM, instead of reading the cube for each lookup.
+    m_demCache = DemTileCache::cache(m_demCube);
     m_demProj = m_demCube->projection();
-    m_interp = new Interpolator(Interpolator::BiLinearType);
-    m_portal = new Portal(m_interp->Samples(), m_interp->Lines(),
-                            m_demCube->pixelType(),
-                            m_interp->HotSample(), m_interp->HotLine());
 
     // Read in the Scale of the DEM file in pixels/degree
     const PvlGroup &mapgrp = m_demCube->label()->findGroup("Mapping", Pvl::Traverse);
@@ -108,12 +94,6 @@ namespace Isis {
 
     // We do not have ownership of p_demCube
     m_demCube = NULL;
-
-    delete m_interp;
-    m_interp = NULL;
-
-    delete m_portal;
-    m_portal = NULL;
   }
 
 
@@ -267,14 +247,8 @@ namespace Isis {
       // if (!m_demProj->IsGood())
       //   return Distance();
 
-      m_portal->SetPosition(m_demProj->WorldX(), m_demProj->WorldY(), 1);
-
-      m_demCube->read(*m_portal);
-
-      distance = Distance(m_interp->Interpolate(m_demProj->WorldX(),
-                                                m_demProj->WorldY(),
-                                                m_portal->DoubleBuffer()),
-                                                Distance::Meters);
+      distance = Distance(m_demCache->interpolate(m_demProj->WorldX(), m_demProj->WorldY()),
+                          Distance::Meters);
     }
 
     return distance;
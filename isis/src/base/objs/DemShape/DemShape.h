@@ -24,12 +24,13 @@
 
 #include "ShapeModel.h"
 
+#include <QSharedPointer>
+
 template<class T> class QVector;
 
 namespace Isis {
   class Cube;
-  class Interpolator;
-  class Portal;
+  class DemTileCache;
   class Projection;
 
   /**
@@ -110,8 +111,7 @@ namespace Isis {
       Cube *m_demCube;        //!< The cube containing the model
       Projection *m_demProj;  //!< The projection of the model
       double m_pixPerDegree;  //!< Scale of DEM file in pixels per degree
-      Portal *m_portal;       //!< Buffer used to read from the model
-      Interpolator *m_interp; //!< Use bilinear interpolation from dem
+      QSharedPointer<DemTileCache> m_demCache; //!< Cached DEM tiles shared by every DemShape
   };
 }
 
@@ -0,0 +1,259 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "DemTileCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QMutexLocker>
+#include <QWeakPointer>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "IString.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Create a cache of a DEM cube. Use DemTileCache::cache() so that the cache is shared.
+   *
+   * @param demCube The DEM. It must stay open for the lifetime of the cache.
+   */
+  DemTileCache::DemTileCache(Cube *demCube) {
+    m_demCube = demCube;
+    m_samples = demCube->sampleCount();
+    m_lines = demCube->lineCount();
+    m_tileColumns = (m_samples + TileSize - 1) / TileSize;
+    m_useCount = 0;
+
+    int tileRows = (m_lines + TileSize - 1) / TileSize;
+    int totalTiles = m_tileColumns * tileRows;
+
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+
+    double cacheMegabytes = 512.0;
+    if (performance.hasKeyword("DemCacheSize")) {
+      cacheMegabytes = max(0.0, toDouble(performance["DemCacheSize"][0]));
+    }
+
+    bool resident = false;
+    if (performance.hasKeyword("DemCacheResident")) {
+      resident = (IString(performance["DemCacheResident"][0]).DownCase() == "always");
+    }
+
+    // Bilinear lookups can need up to 4 tiles at once
+    double tileMegabytes = TileSize * TileSize * sizeof(double) / (1024.0 * 1024.0);
+    m_maxTiles = max(4, (int) min((double) totalTiles, cacheMegabytes / tileMegabytes));
+
+    if (resident) {
+      m_maxTiles = totalTiles;
+
+      for (int tileIndex = 0; tileIndex < totalTiles; tileIndex++) {
+        CachedTile &cachedTile = m_tiles[tileIndex];
+        cachedTile.data = readTile(tileIndex);
+        cachedTile.lastUsed = 0;
+      }
+    }
+  }
+
+
+  /**
+   * Destroys the cache. The DEM cube is not closed.
+   */
+  DemTileCache::~DemTileCache() {
+    m_demCube = NULL;
+  }
+
+
+  /**
+   * Returns the cache for a DEM cube, creating it if no shape model is using the DEM yet.
+   *   Caches are shared by file name and freed when the last user releases them.
+   *
+   * @param demCube The DEM. It must stay open while the cache is in use.
+   *
+   * @return @b QSharedPointer<DemTileCache> The cache of the DEM.
+   */
+  QSharedPointer<DemTileCache> DemTileCache::cache(Cube *demCube) {
+    static QMutex registryMutex;
+    static QHash< QString, QWeakPointer<DemTileCache> > registry;
+
+    QMutexLocker locker(&registryMutex);
+
+    QSharedPointer<DemTileCache> demCache = registry.value(demCube->fileName()).toStrongRef();
+
+    // A cube that was closed and opened again by the CubeManager needs a new cache
+    if (!demCache || demCache->m_demCube != demCube) {
+      demCache = QSharedPointer<DemTileCache>(new DemTileCache(demCube));
+      registry[demCube->fileName()] = demCache;
+    }
+
+    return demCache;
+  }
+
+
+  /**
+   * Returns a DN of the first band of the DEM.
+   *
+   * @param sample The sample of the pixel, starting at 1.
+   * @param line The line of the pixel, starting at 1.
+   *
+   * @return @b double The DN, or Null outside of the DEM.
+   */
+  double DemTileCache::value(int sample, int line) {
+    if (sample < 1 || line < 1 || sample > m_samples || line > m_lines) {
+      return Null;
+    }
+
+    int tileIndex = ((line - 1) / TileSize) * m_tileColumns + (sample - 1) / TileSize;
+    QSharedPointer< QVector<double> > data = tile(tileIndex);
+
+    return data->at(((line - 1) % TileSize) * TileSize + (sample - 1) % TileSize);
+  }
+
+
+  /**
+   * Bilinearly interpolates the first band of the DEM. This gives the same result as reading
+   *   a Portal positioned for an Interpolator of type Interpolator::BiLinearType and calling
+   *   Interpolator::Interpolate, including the nearest neighbor fallback at special pixels.
+   *
+   * @param sample The sample to interpolate at.
+   * @param line The line to interpolate at.
+   *
+   * @return @b double The interpolated DN.
+   */
+  double DemTileCache::interpolate(double sample, double line) {
+    int startSample = (int) floor(sample);
+    int startLine = (int) floor(line);
+
+    double buf[4];
+
+    int tileColumn = (startSample - 1) / TileSize;
+    int tileRow = (startLine - 1) / TileSize;
+
+    // Most lookups fall inside of one tile
+    if (startSample >= 1 && startLine >= 1 &&
+        startSample < m_samples && startLine < m_lines &&
+        startSample / TileSize == tileColumn && startLine / TileSize == tileRow) {
+      QSharedPointer< QVector<double> > data = tile(tileRow * m_tileColumns + tileColumn);
+
+      const double *topLeft = data->constData() +
+                              ((startLine - 1) % TileSize) * TileSize + (startSample - 1) % TileSize;
+      buf[0] = topLeft[0];
+      buf[1] = topLeft[1];
+      buf[2] = topLeft[TileSize];
+      buf[3] = topLeft[TileSize + 1];
+    }
+    else {
+      buf[0] = value(startSample, startLine);
+      buf[1] = value(startSample + 1, startLine);
+      buf[2] = value(startSample, startLine + 1);
+      buf[3] = value(startSample + 1, startLine + 1);
+    }
+
+    double a = sample - (int) sample;
+    double b = line - (int) line;
+
+    // If any of the 4 pixels are special pixels, drop down to a nearest neighbor
+    for (int i = 0; i < 4; i++) {
+      if (IsSpecial(buf[i])) {
+        return buf[(int)(a + 0.5) + 2 * (int)(b + 0.5)];
+      }
+    }
+
+    return (1.0 - a) * (1.0 - b) * buf[0] +
+           a * (1.0 - b) * buf[1] +
+           (1.0 - a) * b * buf[2] +
+           a * b * buf[3];
+  }
+
+
+  /**
+   * @return @b int The number of tiles currently in memory.
+   */
+  int DemTileCache::tileCount() {
+    QMutexLocker locker(&m_mutex);
+    return m_tiles.size();
+  }
+
+
+  /**
+   * Returns a tile, reading it if it is not in memory. The least recently used tile is dropped
+   *   when the cache is full. The returned data stays valid even if the tile is dropped.
+   *
+   * @param tileIndex The index of the tile, across then down the DEM.
+   *
+   * @return @b QSharedPointer<QVector<double>> The DNs of the tile.
+   */
+  QSharedPointer< QVector<double> > DemTileCache::tile(int tileIndex) {
+    QMutexLocker locker(&m_mutex);
+
+    m_useCount++;
+
+    QHash<int, CachedTile>::iterator found = m_tiles.find(tileIndex);
+    if (found != m_tiles.end()) {
+      found->lastUsed = m_useCount;
+      return found->data;
+    }
+
+    if (m_tiles.size() >= m_maxTiles) {
+      QHash<int, CachedTile>::iterator oldest = m_tiles.begin();
+      for (QHash<int, CachedTile>::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        if (it->lastUsed < oldest->lastUsed) {
+          oldest = it;
+        }
+      }
+      m_tiles.erase(oldest);
+    }
+
+    CachedTile &cachedTile = m_tiles[tileIndex];
+    cachedTile.data = readTile(tileIndex);
+    cachedTile.lastUsed = m_useCount;
+
+    return cachedTile.data;
+  }
+
+
+  /**
+   * Reads a tile of the first band of the DEM. Pixels past the edge of the DEM are Null.
+   *
+   * @param tileIndex The index of the tile, across then down the DEM.
+   *
+   * @return @b QSharedPointer<QVector<double>> The DNs of the tile.
+   */
+  QSharedPointer< QVector<double> > DemTileCache::readTile(int tileIndex) {
+    Brick brick(TileSize, TileSize, 1, m_demCube->pixelType());
+    brick.SetBasePosition((tileIndex % m_tileColumns) * TileSize + 1,
+                          (tileIndex / m_tileColumns) * TileSize + 1, 1);
+    m_demCube->read(brick);
+
+    QSharedPointer< QVector<double> > data(new QVector<double>(brick.size()));
+    copy(brick.DoubleBuffer(), brick.DoubleBuffer() + brick.size(), data->begin());
+
+    return data;
+  }
+}
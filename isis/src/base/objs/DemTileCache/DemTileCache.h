@@ -0,0 +1,104 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef DemTileCache_h
+#define DemTileCache_h
+
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace Isis {
+  class Cube;
+
+  /**
+   * @brief A shared, read-only cache of the first band of a DEM cube
+   *
+   * This keeps tiles of a DEM cube in memory as doubles so that radius lookups
+   *   can be interpolated without repositioning a Portal and going through
+   *   Cube::read. There is one cache per DEM file in a process, shared by every
+   *   shape model that uses the DEM; get it with DemTileCache::cache().
+   *
+   * Tiles are read on first use and the least recently used tiles are dropped
+   *   when the cache is larger than the DemCacheSize Performance preference.
+   *   When the DemCacheResident preference is Always, the entire DEM is read
+   *   the first time the cache is created and is never dropped.
+   *
+   * Lookups are thread safe.
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class DemTileCache {
+    public:
+      ~DemTileCache();
+
+      static QSharedPointer<DemTileCache> cache(Cube *demCube);
+
+      double value(int sample, int line);
+      double interpolate(double sample, double line);
+
+      int tileCount();
+
+    private:
+      DemTileCache(Cube *demCube);
+
+      // Disallow copying
+      DemTileCache(const DemTileCache &other);
+      DemTileCache &operator=(const DemTileCache &other);
+
+      QSharedPointer< QVector<double> > tile(int tileIndex);
+      QSharedPointer< QVector<double> > readTile(int tileIndex);
+
+      //! A tile of the DEM and when it was last used.
+      struct CachedTile {
+        QSharedPointer< QVector<double> > data; //!< The DNs of the tile.
+        qint64 lastUsed;                        //!< The use count at the last lookup.
+      };
+
+      //! The DEM. The cache does not own it.
+      Cube *m_demCube;
+      //! The number of samples in the DEM.
+      int m_samples;
+      //! The number of lines in the DEM.
+      int m_lines;
+      //! The number of tiles across the DEM.
+      int m_tileColumns;
+      //! The maximum number of tiles to keep in memory.
+      int m_maxTiles;
+
+      //! Guards m_tiles, m_useCount and reads of m_demCube.
+      QMutex m_mutex;
+      //! The tiles in memory, by tile index.
+      QHash<int, CachedTile> m_tiles;
+      //! Incremented for every tile lookup to order the tiles by use.
+      qint64 m_useCount;
+
+      //! The number of samples and lines in each tile.
+      static const int TileSize = 128;
+  };
+}
+
+#endif
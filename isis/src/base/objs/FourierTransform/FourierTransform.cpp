@@ -49,12 +49,17 @@ namespace Isis {
 
     // rearrange the data to fit the iterative algorithm
     // which will apply the transform from the bottom up
-    for(int i = 0; i < n; i++) {
-      if(output[i] == 0.0) {
-        int j = BitReverse(n, i);
-        output[i] = input[j];
-        output[j] = input[i];
+    for(int i = 0, j = 0; i < n; i++) {
+      output[i] = input[j];
+
+      // j = BitReverse(n, i + 1), found by adding one to j with the bits
+      // in reverse order
+      int bit = n / 2;
+      while(bit > 0 && (j & bit)) {
+        j ^= bit;
+        bit /= 2;
       }
+      j |= bit;
     }
 
     // do the iterative fft calculation by first combining
@@ -63,13 +68,20 @@ namespace Isis {
       complex<double> Wm(polar(1.0, -1.0 * PI / m)); // Wm = e^(-PI/m *i)
       for(int k = 0; k < n; k += 2 * m) {
         // W = Wm^j, the roots of unity for x^m=1
-        complex<double> W(1.0);
+        // The products are written out because std::complex multiplication
+        // checks for infinities and NaNs, which makes it several times slower
+        double Wr = 1.0;
+        double Wi = 0.0;
         for(int j = 0; j < m; j++) {
-          complex<double> t = W * output[k+j+m]; // the "twiddle" factor
+          complex<double> a = output[k+j+m];
+          complex<double> t(Wr * a.real() - Wi * a.imag(),
+                            Wr * a.imag() + Wi * a.real()); // the "twiddle" factor
           complex<double> u = output[k+j];
           output[k+j] = u + t; // a[k+j]+Wm^j*a[k+j+m]
           output[k+j+m] = u - t; // a[k+j]+Wm^(j+m)*[k+j+m] = a[k+j]-Wm^j*[k+j+m]
-          W = W * Wm;
+          double r = Wr * Wm.real() - Wi * Wm.imag();
+          Wi = Wr * Wm.imag() + Wi * Wm.real();
+          Wr = r;
         }
       }
     }
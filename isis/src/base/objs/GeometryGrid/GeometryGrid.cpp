@@ -0,0 +1,482 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "GeometryGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "IException.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Builds a grid by running the exact transform at every node and at the
+   *   check points of every cell. The check points are a lattice every quarter
+   *   of the spacing, rounded to whole output pixels, so there are at most 5x5
+   *   of them (including the corners) whatever the spacing.
+   *
+   * @param trans The exact reverse transform, from output to input pixels.
+   * @param outputSamples The number of samples in the output cube.
+   * @param outputLines The number of lines in the output cube.
+   * @param spacing The number of output pixels between grid nodes.
+   * @param tolerance The largest difference, in input pixels, between the
+   *                  interpolated and exact positions for a cell to be
+   *                  interpolated.
+   */
+  GeometryGrid::GeometryGrid(Transform &trans, int outputSamples, int outputLines,
+                             int spacing, double tolerance) {
+    init(outputSamples, outputLines, spacing, tolerance);
+
+    for (int nodeLine = 0; nodeLine < m_nodeLines; nodeLine++) {
+      for (int nodeSample = 0; nodeSample < m_nodeSamples; nodeSample++) {
+        int node = nodeLine * m_nodeSamples + nodeSample;
+        double inSample, inLine;
+
+        if (trans.Xform(inSample, inLine,
+                        1.0 + nodeSample * m_spacing, 1.0 + nodeLine * m_spacing)) {
+          m_inputSamples[node] = inSample;
+          m_inputLines[node] = inLine;
+        }
+      }
+    }
+
+    // A lattice of points across each cell, including its edges; a cell is
+    // only interpolated if the transform succeeds at all of them
+    QVector<double> checkFractions;
+    int lastOffset = -1;
+    for (int quarter = 0; quarter <= 4; quarter++) {
+      int offset = (quarter * m_spacing + 2) / 4;
+      if (offset > lastOffset) {
+        checkFractions.append((double) offset / m_spacing);
+        lastOffset = offset;
+      }
+    }
+
+    for (int cellLine = 0; cellLine < m_nodeLines - 1; cellLine++) {
+      for (int cellSample = 0; cellSample < m_nodeSamples - 1; cellSample++) {
+        int cell = cellLine * (m_nodeSamples - 1) + cellSample;
+        int node = cellLine * m_nodeSamples + cellSample;
+
+        if (IsNullPixel(m_inputSamples[node]) ||
+            IsNullPixel(m_inputSamples[node + 1]) ||
+            IsNullPixel(m_inputSamples[node + m_nodeSamples]) ||
+            IsNullPixel(m_inputSamples[node + m_nodeSamples + 1])) {
+          m_exactCells[cell] = true;
+          continue;
+        }
+
+        for (int i = 0; i < checkFractions.size() && !m_exactCells[cell]; i++) {
+          for (int j = 0; j < checkFractions.size() && !m_exactCells[cell]; j++) {
+            double lineFraction = checkFractions[i];
+            double sampleFraction = checkFractions[j];
+
+            // The corners are the nodes
+            if ((lineFraction == 0.0 || lineFraction == 1.0) &&
+                (sampleFraction == 0.0 || sampleFraction == 1.0)) {
+              continue;
+            }
+
+            double exactSample, exactLine;
+            double outSample = 1.0 + (cellSample + sampleFraction) * m_spacing;
+            double outLine = 1.0 + (cellLine + lineFraction) * m_spacing;
+
+            if (!trans.Xform(exactSample, exactLine, outSample, outLine)) {
+              m_exactCells[cell] = true;
+              break;
+            }
+
+            double inSample, inLine;
+            interpolate(inSample, inLine, cellSample, cellLine, sampleFraction, lineFraction);
+
+            if (fabs(inSample - exactSample) > m_tolerance ||
+                fabs(inLine - exactLine) > m_tolerance) {
+              m_exactCells[cell] = true;
+            }
+          }
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Reads a grid written by write().
+   *
+   * @param file The grid file.
+   *
+   * @throws IException::Io "The geometry grid file is not valid"
+   */
+  GeometryGrid::GeometryGrid(const QString &file) {
+    Table table("GeometryGrid", file);
+    PvlObject &label = table.Label();
+
+    try {
+      init(toInt(label["OutputSamples"][0]), toInt(label["OutputLines"][0]),
+           toInt(label["Spacing"][0]), toDouble(label["Tolerance"][0]));
+    }
+    catch (IException &e) {
+      QString msg = "The geometry grid file [" + file + "] is not valid";
+      throw IException(e, IException::Io, msg, _FILEINFO_);
+    }
+
+    if (label.hasObject("Source")) {
+      m_source = label.findObject("Source");
+    }
+
+    if (table.Records() != m_nodeSamples * m_nodeLines) {
+      QString msg = "The geometry grid file [" + file + "] is not valid. It has [" +
+                    toString(table.Records()) + "] nodes instead of [" +
+                    toString(m_nodeSamples * m_nodeLines) + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    for (int node = 0; node < table.Records(); node++) {
+      TableRecord &record = table[node];
+      m_inputSamples[node] = (double) record["InputSample"];
+      m_inputLines[node] = (double) record["InputLine"];
+
+      int nodeSample = node % m_nodeSamples;
+      int nodeLine = node / m_nodeSamples;
+      if (nodeSample < m_nodeSamples - 1 && nodeLine < m_nodeLines - 1) {
+        m_exactCells[nodeLine * (m_nodeSamples - 1) + nodeSample] =
+            ((int) record["ExactCell"] != 0);
+      }
+    }
+  }
+
+
+  //! Destroys the grid.
+  GeometryGrid::~GeometryGrid() {
+  }
+
+
+  /**
+   * Writes the grid to a file as a table with one record per node. Each record
+   *   also flags whether the cell below and to the right of the node uses the
+   *   exact transform.
+   *
+   * @param file The file to write.
+   */
+  void GeometryGrid::write(const QString &file) const {
+    TableField inputSample("InputSample", TableField::Double);
+    TableField inputLine("InputLine", TableField::Double);
+    TableField exactCell("ExactCell", TableField::Integer);
+
+    TableRecord record;
+    record += inputSample;
+    record += inputLine;
+    record += exactCell;
+
+    Table table("GeometryGrid", record);
+    table.Label() += PvlKeyword("OutputSamples", toString(m_outputSamples));
+    table.Label() += PvlKeyword("OutputLines", toString(m_outputLines));
+    table.Label() += PvlKeyword("Spacing", toString(m_spacing));
+    table.Label() += PvlKeyword("Tolerance", toString(m_tolerance));
+    table.Label().addObject(m_source);
+
+    for (int nodeLine = 0; nodeLine < m_nodeLines; nodeLine++) {
+      for (int nodeSample = 0; nodeSample < m_nodeSamples; nodeSample++) {
+        int node = nodeLine * m_nodeSamples + nodeSample;
+
+        bool exact = false;
+        if (nodeSample < m_nodeSamples - 1 && nodeLine < m_nodeLines - 1) {
+          exact = m_exactCells[nodeLine * (m_nodeSamples - 1) + nodeSample];
+        }
+
+        record["InputSample"] = m_inputSamples[node];
+        record["InputLine"] = m_inputLines[node];
+        record["ExactCell"] = exact ? 1 : 0;
+        table += record;
+      }
+    }
+
+    table.Write(file);
+  }
+
+
+  /**
+   * Describe what the exact transform was built from, for example the input
+   *   cube, its SPICE and the output map. It is written with the grid, and
+   *   matches() compares it so a grid file is not used for other geometry.
+   *
+   * @param source An object named Source with any keywords and groups.
+   */
+  void GeometryGrid::setSource(const PvlObject &source) {
+    m_source = source;
+    m_source.setName("Source");
+  }
+
+
+  //! @return @b const PvlObject& What the exact transform was built from, see setSource().
+  const PvlObject &GeometryGrid::source() const {
+    return m_source;
+  }
+
+
+  /**
+   * @param outputSamples The number of samples in the output cube.
+   * @param outputLines The number of lines in the output cube.
+   * @param spacing The number of output pixels between grid nodes.
+   * @param tolerance The tolerance of the interpolated cells.
+   * @param source What the transform the grid is for was built from.
+   *
+   * @return @b bool Whether this grid was built for the same output size,
+   *     spacing, tolerance and source. Comments in the source are ignored.
+   */
+  bool GeometryGrid::matches(int outputSamples, int outputLines, int spacing,
+                             double tolerance, const PvlObject &source) const {
+    return m_outputSamples == outputSamples && m_outputLines == outputLines &&
+           m_spacing == spacing && m_tolerance == tolerance &&
+           sameContents(m_source, source);
+  }
+
+
+  /**
+   * Finds the input pixel of an output pixel. Positions in interpolated cells
+   *   are interpolated and all others are passed to the exact transform.
+   *
+   * @param inSample The input sample
+   * @param inLine The input line
+   * @param outSample The output sample
+   * @param outLine The output line
+   * @param exact The transform the grid was built from
+   *
+   * @return @b bool Whether the output pixel has an input pixel.
+   */
+  bool GeometryGrid::Xform(double &inSample, double &inLine,
+                           const double outSample, const double outLine,
+                           Transform &exact) const {
+    double gridSample = (outSample - 1.0) / m_spacing;
+    double gridLine = (outLine - 1.0) / m_spacing;
+
+    if (gridSample < 0.0 || gridLine < 0.0 ||
+        gridSample > m_nodeSamples - 1 || gridLine > m_nodeLines - 1) {
+      return exact.Xform(inSample, inLine, outSample, outLine);
+    }
+
+    int cellSample = min((int) gridSample, m_nodeSamples - 2);
+    int cellLine = min((int) gridLine, m_nodeLines - 2);
+
+    if (m_exactCells[cellLine * (m_nodeSamples - 1) + cellSample]) {
+      return exact.Xform(inSample, inLine, outSample, outLine);
+    }
+
+    interpolate(inSample, inLine, cellSample, cellLine,
+                gridSample - cellSample, gridLine - cellLine);
+    return true;
+  }
+
+
+  //! @return @b int The number of output pixels between grid nodes.
+  int GeometryGrid::spacing() const {
+    return m_spacing;
+  }
+
+
+  //! @return @b double The largest error allowed in an interpolated cell, in pixels.
+  double GeometryGrid::tolerance() const {
+    return m_tolerance;
+  }
+
+
+  //! @return @b int The number of cells that use the exact transform.
+  int GeometryGrid::exactCells() const {
+    return m_exactCells.count(true);
+  }
+
+
+  /**
+   * Sizes the grid, with every node Null and every cell interpolated.
+   *
+   * @param outputSamples The number of samples in the output cube.
+   * @param outputLines The number of lines in the output cube.
+   * @param spacing The number of output pixels between grid nodes.
+   * @param tolerance The tolerance of the interpolated cells.
+   *
+   * @throws IException::Programmer "The geometry grid spacing must be positive"
+   */
+  void GeometryGrid::init(int outputSamples, int outputLines, int spacing, double tolerance) {
+    if (spacing < 1) {
+      QString msg = "The geometry grid spacing must be positive, not [" + toString(spacing) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_outputSamples = outputSamples;
+    m_outputLines = outputLines;
+    m_spacing = spacing;
+    m_tolerance = tolerance;
+
+    // The last nodes are on or past the last output pixel
+    m_nodeSamples = max(2, (outputSamples - 1 + spacing - 1) / spacing + 1);
+    m_nodeLines = max(2, (outputLines - 1 + spacing - 1) / spacing + 1);
+
+    m_inputSamples.fill(Null, m_nodeSamples * m_nodeLines);
+    m_inputLines.fill(Null, m_nodeSamples * m_nodeLines);
+    m_exactCells.fill(false, (m_nodeSamples - 1) * (m_nodeLines - 1));
+  }
+
+
+  /**
+   * @param first An object
+   * @param second Another object
+   *
+   * @return @b bool Whether the objects have the same keywords, groups and
+   *     objects, in the same order. Names are compared without case, values
+   *     and units exactly.
+   */
+  bool GeometryGrid::sameContents(const PvlObject &first, const PvlObject &second) {
+    if (!sameKeywords(first, second) ||
+        first.groups() != second.groups() || first.objects() != second.objects()) {
+      return false;
+    }
+
+    for (int i = 0; i < first.groups(); i++) {
+      if (!sameKeywords(first.group(i), second.group(i))) {
+        return false;
+      }
+    }
+
+    for (int i = 0; i < first.objects(); i++) {
+      if (!sameContents(first.object(i), second.object(i))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * @param first A container
+   * @param second Another container
+   *
+   * @return @b bool Whether the containers have the same name and keywords.
+   */
+  bool GeometryGrid::sameKeywords(const PvlContainer &first, const PvlContainer &second) {
+    if (!first.isNamed(second.name()) || first.keywords() != second.keywords()) {
+      return false;
+    }
+
+    for (int i = 0; i < first.keywords(); i++) {
+      const PvlKeyword &firstKeyword = first[i];
+      const PvlKeyword &secondKeyword = second[i];
+
+      if (!firstKeyword.isNamed(secondKeyword.name()) ||
+          firstKeyword.size() != secondKeyword.size()) {
+        return false;
+      }
+
+      for (int value = 0; value < firstKeyword.size(); value++) {
+        if (firstKeyword[value] != secondKeyword[value] ||
+            firstKeyword.unit(value) != secondKeyword.unit(value)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Bilinearly interpolates the input pixel inside of a cell.
+   *
+   * @param inSample The interpolated input sample
+   * @param inLine The interpolated input line
+   * @param cellSample The node sample of the upper left corner of the cell
+   * @param cellLine The node line of the upper left corner of the cell
+   * @param sampleFraction The position across the cell, from 0 to 1
+   * @param lineFraction The position down the cell, from 0 to 1
+   */
+  void GeometryGrid::interpolate(double &inSample, double &inLine,
+                                 int cellSample, int cellLine,
+                                 double sampleFraction, double lineFraction) const {
+    int node = cellLine * m_nodeSamples + cellSample;
+
+    double upperLeft = (1.0 - sampleFraction) * (1.0 - lineFraction);
+    double upperRight = sampleFraction * (1.0 - lineFraction);
+    double lowerLeft = (1.0 - sampleFraction) * lineFraction;
+    double lowerRight = sampleFraction * lineFraction;
+
+    inSample = upperLeft * m_inputSamples[node] +
+               upperRight * m_inputSamples[node + 1] +
+               lowerLeft * m_inputSamples[node + m_nodeSamples] +
+               lowerRight * m_inputSamples[node + m_nodeSamples + 1];
+
+    inLine = upperLeft * m_inputLines[node] +
+             upperRight * m_inputLines[node + 1] +
+             lowerLeft * m_inputLines[node + m_nodeSamples] +
+             lowerRight * m_inputLines[node + m_nodeSamples + 1];
+  }
+
+
+  /**
+   * Creates a transform that interpolates a grid.
+   *
+   * @param grid The grid, which may be shared with other transforms.
+   * @param exact The transform the grid was built from. This object takes
+   *              ownership of it.
+   */
+  GeometryGridTransform::GeometryGridTransform(QSharedPointer<GeometryGrid> grid,
+                                               Transform *exact) {
+    m_grid = grid;
+    m_exact = exact;
+  }
+
+
+  //! Destroys the transform and the exact transform.
+  GeometryGridTransform::~GeometryGridTransform() {
+    delete m_exact;
+    m_exact = NULL;
+  }
+
+
+  /**
+   * @see GeometryGrid::Xform
+   */
+  bool GeometryGridTransform::Xform(double &inSample, double &inLine,
+                                    const double outSample, const double outLine) {
+    return m_grid->Xform(inSample, inLine, outSample, outLine, *m_exact);
+  }
+
+
+  //! @return @b int The number of samples in the output cube.
+  int GeometryGridTransform::OutputSamples() const {
+    return m_exact->OutputSamples();
+  }
+
+
+  //! @return @b int The number of lines in the output cube.
+  int GeometryGridTransform::OutputLines() const {
+    return m_exact->OutputLines();
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:06 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are
+ *   public domain. See individual third-party library and package descriptions
+ *   for intellectual property information, user agreements, and related
+ *   information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or
+ *   implied, is made by the USGS as to the accuracy and functioning of such
+ *   software and related material nor shall the fact of distribution
+ *   constitute any such warranty, and no responsibility is assumed by the
+ *   USGS in connection therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html
+ *   in a browser or see the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#ifndef GeometryGrid_h
+#define GeometryGrid_h
+
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "PvlObject.h"
+#include "Transform.h"
+
+namespace Isis {
+
+  /**
+   * @brief A precomputed grid of input pixel positions for a reverse Transform
+   *
+   * This samples a reverse transform (output sample/line to input sample/line)
+   *   every few output pixels and bilinearly interpolates between the grid
+   *   nodes instead of running the transform for every output pixel. For
+   *   camera models this replaces the ground to image iteration of most pixels
+   *   with a few multiplications.
+   *
+   * Each grid cell is checked against the exact transform on a lattice of
+   *   points every quarter of the cell (every pixel for small spacings) when
+   *   the grid is built. Cells where the interpolated position is off by more
+   *   than the tolerance, or where the transform fails at a corner or any of the
+   *   checked points, use the exact transform for all of their pixels.
+   *
+   * Building a grid runs the exact transform at most 22 times per cell (one
+   *   node and 21 check points), so it runs for about 22 / spacing^2 of the
+   *   output pixels: a third at a spacing of 8, 9% at 16 and 2% at 32, plus
+   *   every pixel of the cells that fail the check. Below a spacing of 5 that
+   *   is more than transforming every pixel.
+   *
+   * A grid can be written to a file and read back for later runs with the same
+   *   geometry, for example with another interpolator or other bands of a band
+   *   independent camera. The application describes what the transform was
+   *   built from with setSource(), and a grid read from a file is only used if
+   *   its source matches.
+   *
+   * Once built, a grid is read only and can be shared by the transforms of
+   *   several threads through GeometryGridTransform.
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class GeometryGrid {
+    public:
+      GeometryGrid(Transform &trans, int outputSamples, int outputLines,
+                   int spacing, double tolerance = 0.1);
+      GeometryGrid(const QString &file);
+      ~GeometryGrid();
+
+      void write(const QString &file) const;
+
+      void setSource(const PvlObject &source);
+      const PvlObject &source() const;
+      bool matches(int outputSamples, int outputLines, int spacing, double tolerance,
+                   const PvlObject &source = PvlObject("Source")) const;
+
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine,
+                 Transform &exact) const;
+
+      int spacing() const;
+      double tolerance() const;
+      int exactCells() const;
+
+    private:
+      void init(int outputSamples, int outputLines, int spacing, double tolerance);
+      void interpolate(double &inSample, double &inLine, int cellSample, int cellLine,
+                       double sampleFraction, double lineFraction) const;
+      static bool sameContents(const PvlObject &first, const PvlObject &second);
+      static bool sameKeywords(const PvlContainer &first, const PvlContainer &second);
+
+      int m_outputSamples;  //!< The number of samples in the output cube
+      int m_outputLines;    //!< The number of lines in the output cube
+      int m_spacing;        //!< The number of output pixels between grid nodes
+      double m_tolerance;   //!< The largest error allowed in an interpolated cell, in pixels
+      int m_nodeSamples;    //!< The number of grid nodes across
+      int m_nodeLines;      //!< The number of grid nodes down
+
+      //! The input sample of each node, across then down; Null where the transform failed
+      QVector<double> m_inputSamples;
+      //! The input line of each node, across then down; Null where the transform failed
+      QVector<double> m_inputLines;
+      //! Whether each cell, across then down, uses the exact transform
+      QVector<bool> m_exactCells;
+      //! What the transform was built from, see setSource()
+      PvlObject m_source;
+  };
+
+
+  /**
+   * @brief A Transform that interpolates a GeometryGrid
+   *
+   * This wraps the exact transform a GeometryGrid was built from. Pixels in
+   *   cells of the grid that passed the tolerance check are interpolated and
+   *   all other pixels are passed to the exact transform.
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class GeometryGridTransform : public Transform {
+    public:
+      GeometryGridTransform(QSharedPointer<GeometryGrid> grid, Transform *exact);
+      ~GeometryGridTransform();
+
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine);
+      int OutputSamples() const;
+      int OutputLines() const;
+
+    private:
+      // Disallow copying
+      GeometryGridTransform(const GeometryGridTransform &other);
+      GeometryGridTransform &operator=(const GeometryGridTransform &other);
+
+      QSharedPointer<GeometryGrid> m_grid; //!< The grid, shared with other threads
+      Transform *m_exact;                  //!< The exact transform, owned by this object
+  };
+}
+
+#endif
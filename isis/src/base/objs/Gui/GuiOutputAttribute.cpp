@@ -152,15 +152,19 @@ namespace Isis {
     p_tiled->setToolTip("Save image data in tiled format");
     p_bsq = new QRadioButton("&BSQ");
     p_bsq->setToolTip("Save image data in band sequential format");
+    p_compressed = new QRadioButton("&Compressed");
+    p_compressed->setToolTip("Save image data in compressed tiles");
 
     buttonGroup = new QButtonGroup();
     buttonGroup->addButton(p_tiled);
     buttonGroup->addButton(p_bsq);
+    buttonGroup->addButton(p_compressed);
     buttonGroup->setExclusive(true);
 
     layout = new QVBoxLayout();
     layout->addWidget(p_tiled);
     layout->addWidget(p_bsq);
+    layout->addWidget(p_compressed);
 
     QGroupBox *cubeFormatBox = new QGroupBox("Cube Format");
     cubeFormatBox->setLayout(layout);
@@ -217,6 +221,7 @@ namespace Isis {
 
     if(p_tiled->isChecked()) att += "+Tile";
     if(p_bsq->isChecked()) att += "+BandSequential";
+    if(p_compressed->isChecked()) att += "+Compressed";
 
     if(p_attached->isChecked()) att += "+Attached";
     if(p_detached->isChecked()) att += "+Detached";
@@ -249,6 +254,9 @@ namespace Isis {
     if(att.fileFormat() == Cube::Tile) {
       p_tiled->setChecked(true);
     }
+    else if(att.fileFormat() == Cube::Compressed) {
+      p_compressed->setChecked(true);
+    }
     else {
       p_bsq->setChecked(true);
     }
@@ -137,7 +137,9 @@ namespace Isis {
     SetBins(bins);
 
     //set the ranges
-    rangesFromNet(net,statFunc);
+    double minimum, maximum;
+    rangesFromNet(net, statFunc, minimum, maximum);
+    initializeRange(minimum, maximum);
 
     //add all the data to the now setup histogram
     addMeasureDataFromNet(net,statFunc);
@@ -156,39 +158,13 @@ namespace Isis {
   Histogram::Histogram(ControlNet &net, double(ControlMeasure::*statFunc)() const,
                        double binWidth) {
 
-    //check to make sure we have a reasonable number of bins
-    if (binWidth <= 0 ) {
-      string msg = "The width of Histogram Bins must be greater than 0";
-      throw IException(IException::Programmer, msg, _FILEINFO_);
-    }
-
-   //get the range of the data
-
-
-   rangesFromNet(net,statFunc);
-
-
-   //stretch the domain so that it is an even multiple of binWidth
-   //for some reason Histogram makes the end points of the bin range be at the center of
-   //bins.  Thus the +/-0.5 forces it to point the bin range at the ends of the bins.
-   //SetBinRange(binWidth*( floor(this->ValidMinimum()/binWidth )+0.5),
-   //            binWidth*(ceil( this->ValidMaximum()/binWidth )-0.5) );
-
-
-   //Keep an eye on this to see if it breaks anything.  Also, I need to create
-   //a dataset to give this constructor for the unit test.
+    //get the range of the data and split it into bins of binWidth
+    double minimum, maximum;
+    rangesFromNet(net, statFunc, minimum, maximum);
+    initializeBinWidth(minimum, maximum, binWidth);
 
-    //tjw:  SetValidRange is moved into SetBinRange
-   //SetValidRange(binWidth*floor(this->ValidMinimum()/binWidth),
-   //              binWidth*ceil(this->ValidMaximum()/binWidth));
-
-   //from the domain of the data and the requested bin width calculate the number of bins
-   double domain = this->ValidMaximum() - this->ValidMinimum();
-   int nBins = int ( ceil(domain/binWidth) );
-   SetBins(nBins);
-
-   //add all the data to the now setup histogram
-   addMeasureDataFromNet(net,statFunc);
+    //add all the data to the now setup histogram
+    addMeasureDataFromNet(net,statFunc);
   }
 
 
@@ -228,12 +204,14 @@ namespace Isis {
    * @param net  reference to a ControlNetwork used to access all the measures
    * @param statFunc  pointer to a ControlMeasure acessor, the returns of this function call
    *        will be used to build up the network
-   * @throw The net file appears to have 1 or fewer measures, thus no histogram can be formed
+   * @param minimum  set to the smallest value found (DBL_MAX if there is none)
+   * @param maximum  set to the largest value found (-DBL_MAX if there is none)
    */
-  void Histogram::rangesFromNet(ControlNet &net, double(ControlMeasure::*statFunc)() const) {
-    double min,max,temp;
-    min =  DBL_MAX;
-    max = -DBL_MAX;
+  void Histogram::rangesFromNet(ControlNet &net, double(ControlMeasure::*statFunc)() const,
+                                double &minimum, double &maximum) {
+    double temp;
+    minimum =  DBL_MAX;
+    maximum = -DBL_MAX;
 
     //get the number of object points
     int nObjPts =  net.GetNumPoints();
@@ -251,22 +229,55 @@ namespace Isis {
         if (measure->IsIgnored())  continue;
 
         temp = (measure->*statFunc)();  //get the data using the passed ControlMeasure acessor function pointer
-        if ( !IsSpecial(temp) && temp > max ) max = temp;
-        if ( !IsSpecial(temp) && temp < min ) min = temp;
+        if ( !IsSpecial(temp) && temp > maximum ) maximum = temp;
+        if ( !IsSpecial(temp) && temp < minimum ) minimum = temp;
       }
     }
+  }
 
+
+  /**
+   * Sets the bin range to the range of the data
+   *
+   * @param minimum  the smallest value of the data
+   * @param maximum  the largest value of the data
+   * @throw The net file appears to have 1 or fewer measures, thus no histogram can be formed
+   */
+  void Histogram::initializeRange(double minimum, double maximum) {
     //if DBL_MAX's weren't changed there's a problem
-    if (max <= min) {
+    if (maximum <= minimum) {
       string msg = "The net file appears to have 1 or fewer measures with residual data, "
                    "thus no histogram for this net file can be created;";
       throw IException(IException::User, msg, _FILEINFO_);
     }
 
     //set up the histogram ranges
+    SetValidRange(minimum, maximum);
+  }
+
+
+  /**
+   * Sets the bin range to the range of the data and splits it into bins of
+   * binWidth
+   *
+   * @param minimum  the smallest value of the data
+   * @param maximum  the largest value of the data
+   * @param binWidth  the width of histogram bins
+   * @throws The width of Histogram Bins must be greater than 0.
+   */
+  void Histogram::initializeBinWidth(double minimum, double maximum, double binWidth) {
+    //check to make sure we have a reasonable number of bins
+    if (binWidth <= 0 ) {
+      string msg = "The width of Histogram Bins must be greater than 0";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
 
-    SetValidRange(min, max);
-    //SetBinRange(min, max);
+    initializeRange(minimum, maximum);
+
+    //from the domain of the data and the requested bin width calculate the number of bins
+    double domain = this->ValidMaximum() - this->ValidMinimum();
+    int nBins = int ( ceil(domain/binWidth) );
+    SetBins(nBins);
   }
 
 
@@ -396,6 +407,29 @@ namespace Isis {
   Histogram::~Histogram() {
   }
 
+
+  /**
+   * Makes a histogram with bins of a given width. The bin range is from the
+   * minimum to the maximum and is split into as many bins of binWidth as are
+   * needed to cover it. This is not a constructor because its arguments would
+   * be the same as those of the constructor that takes a number of bins, with
+   * only the type of the last one to tell them apart.
+   *
+   * @param minimum Minimum value for binning the data into the histogram.
+   * @param maximum Maximum value for binning the data into the histogram.
+   * @param binWidth The width of histogram bins.
+   * @throws The width of Histogram Bins must be greater than 0.
+   * @throws The minimum must be less than the maximum.
+   *
+   * @return Histogram The empty histogram
+   */
+  Histogram Histogram::withBinWidth(double minimum, double maximum, double binWidth) {
+    Histogram histogram(minimum, maximum);
+    histogram.initializeBinWidth(minimum, maximum, binWidth);
+    return histogram;
+  }
+
+
   //2015-08-24,  Tyler Wilson:  Added Statistics::SetValidRange call to SetBinRange
   //So the two functions do not have to be called together when setting
   //up a histogram
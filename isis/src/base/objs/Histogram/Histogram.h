@@ -81,6 +81,10 @@ namespace Isis {
    *                            #1673.
    *   @history 2018-07-27 Jesse Mapel - Added support for initializing a histogram from
    *                           signed and unsigned word cubes. References #971.
+   *   @history 2026-10-16 Isis Development Team - Added withBinWidth(), which makes a
+   *                           histogram from a bin width with a minimum and maximum, so a
+   *                           histogram of a streamed control network is set up the same way
+   *                           as one from a ControlNet.
    */
 
   class Histogram : public Statistics {
@@ -98,6 +102,8 @@ namespace Isis {
 
       ~Histogram();
 
+      static Histogram withBinWidth(double minimum, double maximum, double binWidth);
+
       void SetBins(const int bins);
 
       void Reset();
@@ -133,7 +139,10 @@ namespace Isis {
           double endSample = Null, double endLine = Null);
 
       void addMeasureDataFromNet(ControlNet &net, double(ControlMeasure::*statFunc)() const);
-      void rangesFromNet(ControlNet &net, double(ControlMeasure::*statFunc)() const);
+      void rangesFromNet(ControlNet &net, double(ControlMeasure::*statFunc)() const,
+                         double &minimum, double &maximum);
+      void initializeRange(double minimum, double maximum);
+      void initializeBinWidth(double minimum, double maximum, double binWidth);
 
       //! The array of counts.
       std::vector<BigInt> p_bins;
@@ -5,8 +5,15 @@
 #include <string>
 #include <vector>
 
+#include <QHash>
+#include <QScopedPointer>
+#include <QSet>
+#include <QtConcurrentMap>
+
 #include "Cube.h"
 #include "FileName.h"
+#include "geos/geom/Envelope.h"
+#include "geos/index/strtree/STRtree.h"
 #include "geos/operation/distance/DistanceOp.h"
 #include "geos/util/IllegalArgumentException.h"
 #include "geos/geom/Point.h"
@@ -548,6 +555,21 @@ namespace Isis {
 
     geos::geom::MultiPolygon *emptyPolygon = Isis::globalFactory->createMultiPolygon();
 
+    // Envelope index of the overlaps below the current outside polygon. The
+    // overlaps in it only ever shrink, so their stored envelopes stay valid
+    // bounds. Overlaps inserted after it was built are not in it; it is built
+    // again once there are more of those than it holds.
+    std::vector<geos::geom::Envelope> envelopes;
+    QScopedPointer<geos::index::strtree::STRtree> envelopeTree;
+    QSet<const ImageOverlap *> indexed;
+    int added = 0;
+
+    // For the current outside polygon: the indexed overlaps whose envelopes
+    // touch its envelope, and the polygons found not to intersect it
+    const ImageOverlap *candidatesFor = NULL;
+    QSet<const ImageOverlap *> nearby;
+    QHash<const ImageOverlap *, const geos::geom::MultiPolygon *> separated;
+
     // Compare each polygon with all of the others
     for (int outside = 0; outside < p_lonLatOverlaps.size() - 1; ++outside) {
       p_calculatedSoFar = outside - 1;
@@ -560,9 +582,82 @@ namespace Isis {
         }
       }
 
+      if (envelopeTree.isNull() || added > indexed.size()) {
+        envelopeTree.reset(new geos::index::strtree::STRtree());
+        envelopes.clear();
+        // The tree keeps pointers to the envelopes, so they must not move
+        envelopes.reserve(p_lonLatOverlaps.size() - outside - 1);
+        indexed.clear();
+        added = 0;
+        candidatesFor = NULL;
+
+        for (int i = outside + 1; i < p_lonLatOverlaps.size(); i++) {
+          const geos::geom::MultiPolygon *poly = p_lonLatOverlaps.at(i)->Polygon();
+          if (!poly->isEmpty()) {
+            envelopes.push_back(*poly->getEnvelopeInternal());
+            envelopeTree->insert(&envelopes.back(), p_lonLatOverlaps.at(i));
+            indexed.insert(p_lonLatOverlaps.at(i));
+          }
+        }
+      }
+
       // Intersect the current polygon (from the outside loop) with all others
       // below it
       for (int inside = outside + 1; inside < p_lonLatOverlaps.size(); ++inside) {
+        // Find the overlaps that can intersect the outside polygon and test them
+        // in parallel. Most of them don't intersect it, and those pairs are
+        // skipped below without computing an intersection. The outside polygon
+        // only shrinks while it is compared, so the results stay valid until it is
+        // erased and the next polygon takes its place.
+        if (p_lonLatOverlaps.at(outside) != candidatesFor) {
+          candidatesFor = p_lonLatOverlaps.at(outside);
+          const geos::geom::MultiPolygon *outsidePoly = candidatesFor->Polygon();
+          const geos::geom::Envelope *outsideEnvelope = outsidePoly->getEnvelopeInternal();
+
+          nearby.clear();
+          separated.clear();
+          if (!outsidePoly->isEmpty() && !indexed.isEmpty()) {
+            std::vector<void *> matches;
+            envelopeTree->query(outsideEnvelope, matches);
+            for (unsigned int i = 0; i < matches.size(); i++) {
+              nearby.insert((const ImageOverlap *) matches[i]);
+            }
+          }
+
+          // This also caches the envelopes, so the tests only read the polygons
+          std::vector<const ImageOverlap *> candidates;
+          for (int i = inside; i < p_lonLatOverlaps.size(); i++) {
+            const ImageOverlap *candidate = p_lonLatOverlaps.at(i);
+            const geos::geom::MultiPolygon *poly = candidate->Polygon();
+            if (!poly->isEmpty() &&
+                (nearby.contains(candidate) || !indexed.contains(candidate)) &&
+                outsideEnvelope->intersects(poly->getEnvelopeInternal())) {
+              candidates.push_back(candidate);
+            }
+          }
+
+          std::vector<int> indices(candidates.size());
+          for (unsigned int i = 0; i < indices.size(); i++) {
+            indices[i] = i;
+          }
+
+          std::vector<char> intersects(candidates.size(), true);
+          QtConcurrent::blockingMap(indices.begin(), indices.end(), [&](int i) {
+            try {
+              intersects[i] = outsidePoly->intersects(candidates[i]->Polygon());
+            }
+            catch (...) {
+              // The intersection below reports the failure
+            }
+          });
+
+          for (unsigned int i = 0; i < candidates.size(); i++) {
+            if (!intersects[i]) {
+              separated.insert(candidates[i], candidates[i]->Polygon());
+            }
+          }
+        }
+
         try {
           if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
             continue;
@@ -571,9 +666,17 @@ namespace Isis {
           const geos::geom::MultiPolygon *poly1 = p_lonLatOverlaps.at(outside)->Polygon();
           const geos::geom::MultiPolygon *poly2 = p_lonLatOverlaps.at(inside)->Polygon();
 
+          // Most pairs of a large set are far apart: their envelopes don't touch,
+          // or the test above found that they don't intersect
+          const ImageOverlap *insideOverlap = p_lonLatOverlaps.at(inside);
+          bool apart = (indexed.contains(insideOverlap) && !nearby.contains(insideOverlap)) ||
+                       separated.value(insideOverlap) == poly2 ||
+                       !poly1->getEnvelopeInternal()->intersects(poly2->getEnvelopeInternal());
+
           // Check to see if the two poygons are equivalent.
-          // If they are, then we can get rid of one of them
-          if (PolygonTools::Equal(poly1, poly2)) {
+          // If they are, then we can get rid of one of them. Polygons that are
+          // apart are only equal when both are empty.
+          if ((!apart || poly2->isEmpty()) && PolygonTools::Equal(poly1, poly2)) {
             p_lonLatOverlapsMutex.lock();
             AddSerialNumbers(p_lonLatOverlaps[outside], p_lonLatOverlaps[inside]);
             p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
@@ -582,7 +685,9 @@ namespace Isis {
             continue;
           }
 
-          // We can get empty polygons in our list sometimes; try to avoid extra processing
+          // We can get empty polygons in our list sometimes; try to avoid extra processing.
+          // This stays ahead of the skip below so that which polygons are removed
+          // doesn't depend on where they are.
           if (poly2->isEmpty() || poly2->getArea() < 1.0e-14) {
             p_lonLatOverlapsMutex.lock();
             p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
@@ -591,6 +696,10 @@ namespace Isis {
             continue;
           }
 
+          if (apart) {
+            continue;
+          }
+
           geos::geom::Geometry *intersected = NULL;
           try {
             intersected = PolygonTools::Intersect(poly1, poly2);
@@ -772,7 +881,12 @@ namespace Isis {
               int newSteps = newSize - oldSize;
               p.AddSteps(newSteps);
               foundOverlap = true;
-              if (newSize != oldSize) inside++;
+              if (newSize != oldSize) {
+                inside++;
+                // A new overlap may reuse the address of one written out and deleted
+                indexed.remove(p_lonLatOverlaps.at(inside));
+                added++;
+              }
             }
           } // End of partial overlap else
         }
@@ -97,6 +97,10 @@ namespace Isis {
    *                          undefined behavior caused by unlocking an unlocked mutex.
    *   @history 2017-05-23 Ian Humphrey - Added a tryLock() to FindAllOverlaps to prevent a
    *                           segfault from occuring on OSX with certain data. Fixes #4810.
+   *   @history 2026-10-16 Isis Development Team - FindAllOverlaps() finds the overlaps that
+   *                           can intersect each polygon with an STRtree of their envelopes and
+   *                           tests them for intersection in parallel, skipping the pairs that
+   *                           don't intersect.
    * 
    */
   class ImageOverlapSet : private QThread {
@@ -238,11 +238,11 @@ namespace Isis {
   }
 
 
-  /** Compute undistorted focal plane coordinate from ground position
+  /** Compute undistorted focal plane coordinate from ground position,
+   *  refining the time of a nearby line before searching the whole image
    *
-   * @param lat planetocentric latitude in degrees
-   * @param lon planetocentric longitude in degrees
-   * @param radius local radius in meters
+   * @param surfacePoint 3D point on the surface of the planet
+   * @param approxLine parent line to start the search at
    *
    * @return conversion was successful
    */
@@ -373,7 +373,7 @@ namespace Isis {
 
         // See if we converged on the point so set up the undistorted focal plane values and return
         if (fabs(f) < 1e-2) {
-          p_camera->Sensor::setTime(approxTime);
+          p_camera->Sensor::setTime(etGuess);
           // check to make sure the point isn't behind the planet
           if (!p_camera->Sensor::SetGround(surfacePoint, true)) {
             return Failure;
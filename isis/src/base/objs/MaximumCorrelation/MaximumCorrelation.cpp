@@ -1,8 +1,56 @@
 #include "MaximumCorrelation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
 #include "Chip.h"
+#include "FourierTransform.h"
 #include "MultivariateStatistics.h"
+#include "SpecialPixel.h"
+
+using namespace std;
 
 namespace Isis {
+  namespace {
+    typedef vector< complex<double> > ComplexGrid;
+
+    /**
+     * Applies the Fourier transform, or its inverse, to a grid stored line by
+     * line. Lines past usedLines must be zero, which lets the transform of
+     * the lines skip them.
+     *
+     * @param grid The grid, transformed in place
+     * @param samples Number of samples in the grid, a power of two
+     * @param lines Number of lines in the grid, a power of two
+     * @param usedLines Number of lines that are not all zero
+     * @param inverse Whether to apply the inverse transform
+     */
+    void TransformGrid(ComplexGrid &grid, int samples, int lines, int usedLines, bool inverse) {
+      FourierTransform fft;
+
+      ComplexGrid data(samples);
+      for (int line = 0; line < usedLines; line++) {
+        copy(grid.begin() + line * samples, grid.begin() + (line + 1) * samples, data.begin());
+        data = inverse ? fft.Inverse(data) : fft.Transform(data);
+        copy(data.begin(), data.end(), grid.begin() + line * samples);
+      }
+
+      data.resize(lines);
+      for (int samp = 0; samp < samples; samp++) {
+        for (int line = 0; line < lines; line++) {
+          data[line] = grid[line * samples + samp];
+        }
+        data = inverse ? fft.Inverse(data) : fft.Transform(data);
+        for (int line = 0; line < lines; line++) {
+          grid[line * samples + samp] = data[line];
+        }
+      }
+    }
+  }
+
+
   double MaximumCorrelation::MatchAlgorithm(Chip &pattern, Chip &subsearch) {
     MultivariateStatistics mv;
     std::vector <double> pdn, sdn;
@@ -25,6 +73,208 @@ namespace Isis {
     return fabs(r);
   }
 
+
+  /**
+   * Computes the correlation of every position of the pattern chip in the
+   * search chip at once. The number of pixel pairs where both chips are
+   * valid, and the sums of the values, squared values and products of those
+   * pairs, are the cross correlations of the valid pixel masks, values and
+   * squared values of the two chips. Those are found with Fourier transforms
+   * and the correlation at each position follows from them just like in
+   * MatchAlgorithm().
+   *
+   * The values of each chip are taken relative to their mean to keep the
+   * rounding of the transforms small. A subsearch chip or pattern whose
+   * variance is lost in that rounding is treated as having no variance, which
+   * has no correlation.
+   *
+   * Small searches are left to the walk in AutoReg::Match(), which is faster
+   * than the transforms for them.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param fChip Fit chip, already sized like the search chip and filled with
+   *              Nulls
+   * @param startSamp Start sample
+   * @param endSamp End sample
+   * @param startLine Start line
+   * @param endLine End line
+   *
+   * @return @b bool Whether the fit chip was filled
+   */
+  bool MaximumCorrelation::ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                          int startSamp, int endSamp,
+                                          int startLine, int endLine) {
+    int pSamples = pChip.Samples();
+    int pLines = pChip.Lines();
+    int sSamples = sChip.Samples();
+    int sLines = sChip.Lines();
+
+    // The grids are large enough that the correlation at any position with
+    // overlap does not wrap around
+    FourierTransform fft;
+    int samples = fft.NextPowerOfTwo(sSamples + pSamples);
+    int lines = fft.NextPowerOfTwo(sLines + pLines);
+    int size = samples * lines;
+
+    // Walking the search chip costs about the pattern size at each position,
+    // while the six transforms cost about n log n each
+    double walkCost = (double)(endSamp - startSamp + 1) * (endLine - startLine + 1) *
+                      pSamples * pLines;
+    double transformCost = 6.0 * size * fft.lg(size);
+    if (walkCost < transformCost) return false;
+
+    double pSum = 0.0;
+    int pCount = 0;
+    for (int line = 1; line <= pLines; line++) {
+      for (int samp = 1; samp <= pSamples; samp++) {
+        double value = pChip.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          pSum += value;
+          pCount++;
+        }
+      }
+    }
+
+    double sSum = 0.0;
+    int sCount = 0;
+    for (int line = 1; line <= sLines; line++) {
+      for (int samp = 1; samp <= sSamples; samp++) {
+        double value = sChip.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          sSum += value;
+          sCount++;
+        }
+      }
+    }
+
+    // Nothing can correlate, so every position stays Null
+    if (pCount == 0 || sCount == 0) return true;
+
+    double pMean = pSum / pCount;
+    double sMean = sSum / sCount;
+
+    // Real grids are transformed two at a time as the real and imaginary
+    // parts of one complex grid: the pattern mask and values, the search
+    // mask and values, and the squared values of both
+    const complex<double> i(0.0, 1.0);
+    ComplexGrid pattern(size), search(size), squares(size);
+    double pTotal = 0.0;
+    for (int line = 0; line < pLines; line++) {
+      for (int samp = 0; samp < pSamples; samp++) {
+        double value = pChip.GetValue(samp + 1, line + 1);
+        if (IsValidPixel(value)) {
+          int index = line * samples + samp;
+          double x = value - pMean;
+          pattern[index] = complex<double>(1.0, x);
+          squares[index] = x * x;
+          pTotal += x * x;
+        }
+      }
+    }
+
+    // The summed area table of the pixels in the search chip's valid range is
+    // used for the subsearch valid percent
+    vector<int> sValid((sSamples + 1) * (sLines + 1), 0);
+    double sTotal = 0.0;
+    for (int line = 0; line < sLines; line++) {
+      for (int samp = 0; samp < sSamples; samp++) {
+        double value = sChip.GetValue(samp + 1, line + 1);
+        if (IsValidPixel(value)) {
+          int index = line * samples + samp;
+          double y = value - sMean;
+          search[index] = complex<double>(1.0, y);
+          squares[index] += i * (y * y);
+          sTotal += y * y;
+        }
+
+        int table = (line + 1) * (sSamples + 1) + samp + 1;
+        sValid[table] = sValid[table - 1] + sValid[table - sSamples - 1] -
+                        sValid[table - sSamples - 2] +
+                        (sChip.IsValid(samp + 1, line + 1) ? 1 : 0);
+      }
+    }
+
+    TransformGrid(pattern, samples, lines, pLines, false);
+    TransformGrid(search, samples, lines, sLines, false);
+    TransformGrid(squares, samples, lines, max(pLines, sLines), false);
+
+    // Split each transform into the transforms of its real and imaginary
+    // parts, which are (Z[k] + conj(Z[-k])) / 2 and (Z[k] - conj(Z[-k])) / 2i,
+    // and multiply them into the spectra of the cross correlations. These are
+    // real, so two of them share each inverse transform in the same way.
+    ComplexGrid counts(size), sums(size), sumSquares(size);
+    for (int line = 0; line < lines; line++) {
+      for (int samp = 0; samp < samples; samp++) {
+        int index = line * samples + samp;
+        int mirror = ((lines - line) % lines) * samples + (samples - samp) % samples;
+
+        complex<double> pMask = 0.5 * (pattern[index] + conj(pattern[mirror]));
+        complex<double> pValue = -0.5 * i * (pattern[index] - conj(pattern[mirror]));
+        complex<double> sMask = 0.5 * (search[index] + conj(search[mirror]));
+        complex<double> sValue = -0.5 * i * (search[index] - conj(search[mirror]));
+        complex<double> pSquare = 0.5 * (squares[index] + conj(squares[mirror]));
+        complex<double> sSquare = -0.5 * i * (squares[index] - conj(squares[mirror]));
+
+        counts[index] = conj(pMask) * sMask + i * conj(pValue) * sValue;
+        sums[index] = conj(pValue) * sMask + i * conj(pMask) * sValue;
+        sumSquares[index] = conj(pSquare) * sMask + i * conj(pMask) * sSquare;
+      }
+    }
+
+    TransformGrid(counts, samples, lines, lines, true);
+    TransformGrid(sums, samples, lines, lines, true);
+    TransformGrid(sumSquares, samples, lines, lines, true);
+
+    // The rounding of the transforms is relative to the largest values in them
+    double pTolerance = 1.0e-10 * pTotal;
+    double sTolerance = 1.0e-10 * sTotal;
+
+    // The pattern tack is placed at each position, the same as Chip::Extract()
+    int pTackSamp = (pSamples - 1) / 2 + 1;
+    int pTackLine = (pLines - 1) / 2 + 1;
+    for (int line = startLine; line <= endLine; line++) {
+      for (int samp = startSamp; samp <= endSamp; samp++) {
+        int firstSamp = samp - pTackSamp;
+        int firstLine = line - pTackLine;
+
+        // The subsearch chip is Null outside of the search chip
+        int left = max(firstSamp, 0);
+        int right = min(firstSamp + pSamples, sSamples);
+        int top = max(firstLine, 0);
+        int bottom = min(firstLine + pLines, sLines);
+        if (left >= right || top >= bottom) continue;
+
+        int valid = sValid[bottom * (sSamples + 1) + right] -
+                    sValid[top * (sSamples + 1) + right] -
+                    sValid[bottom * (sSamples + 1) + left] +
+                    sValid[top * (sSamples + 1) + left];
+        if (100.0 * (double) valid / (double)(pSamples * pLines) < SubsearchValidPercent()) {
+          continue;
+        }
+
+        int index = ((firstLine + lines) % lines) * samples + (firstSamp + samples) % samples;
+        double n = floor(counts[index].real() + 0.5);
+        double percentValid = n / (pLines * pSamples);
+        if (percentValid * 100.0 < PatternValidPercent()) continue;
+        if (n <= 1.0) continue;
+
+        double sumX = sums[index].real();
+        double sumY = sums[index].imag();
+        double varianceX = sumSquares[index].real() - sumX * sumX / n;
+        double varianceY = sumSquares[index].imag() - sumY * sumY / n;
+        if (varianceX <= pTolerance || varianceY <= sTolerance) continue;
+
+        double covariance = counts[index].imag() - sumX * sumY / n;
+        double r = covariance / sqrt(varianceX * varianceY);
+        fChip.SetValue(samp, line, min(fabs(r), 1.0));
+      }
+    }
+
+    return true;
+  }
+
+
   /**
    * This virtual method must return if the 1st fit is equal to or better
    * than the second fit.
@@ -40,4 +290,3 @@ namespace Isis {
 extern "C" Isis::AutoReg *MaximumCorrelationPlugin(Isis::Pvl &pvl) {
   return new Isis::MaximumCorrelation(pvl);
 }
-
@@ -39,6 +39,12 @@ namespace Isis {
    * correlation between the two is computed.  The best fit = 1.0 which means
    * the pattern chip and sub-search chip are identical
    *
+   * For large search chips the correlation of every position is computed at
+   * once from the cross correlations of the valid pixel masks, values and
+   * squared values of the two chips, which are found with fast Fourier
+   * transforms. The results are the same as walking the search chip, up to
+   * rounding.
+   *
    * @ingroup PatternMatching
    *
    * @see MinimumDifference AutoReg
@@ -56,6 +62,9 @@ namespace Isis {
 
     protected:
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch);
+      virtual bool ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                  int startSamp, int endSamp,
+                                  int startLine, int endLine);
       virtual bool CompareFits(double fit1, double fit2);
       virtual double IdealFit() const {
         return 1.0;
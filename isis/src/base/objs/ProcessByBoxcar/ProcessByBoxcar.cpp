@@ -20,12 +20,16 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <vector>
+
 #include "BoxcarCachingAlgorithm.h"
 #include "BoxcarManager.h"
 #include "Buffer.h"
 #include "LineManager.h"
 #include "Process.h"
 #include "ProcessByBoxcar.h"
+#include "RankFilter.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -44,18 +48,27 @@ namespace Isis {
     p_boxsizeSet = true;
   }
 
+
   /**
-   * Starts the systematic processing of the input cube by moving a boxcar,
-   * p_boxSamples by p_boxLines, through the cube one pixel at a time. The input
-   * and output buffers contain a Boxcar of the size indicated in p_boxSamples
-   * and p_boxLines. The input and output cube must be initialized prior to
-   * calling this method.
+   * Sets the range of valid pixels, inclusive, for the RankFilter given to
+   * rank filtering functions. By default all non-special pixels are valid.
    *
-   * @param funct (Isis::Buffer &in, double &out) Name of your processing function
+   * @param low The smallest valid pixel
+   * @param high The largest valid pixel
+   */
+  void ProcessByBoxcar::SetValidRange(const double low, const double high) {
+    p_low = low;
+    p_high = high;
+  }
+
+
+  /**
+   * Checks that there is one input and one output cube of the same size and
+   * that the boxcar size has been set.
    *
    * @throws Isis::IException::Programmer
    */
-  void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, double &out)) {
+  void ProcessByBoxcar::VerifyCubes() {
     // Error checks ... there must be one input and output
     if(InputCubes.size() != 1) {
       string m = "You must specify exactly one input cube";
@@ -92,6 +105,22 @@ namespace Isis {
       string m = "Use the SetBoxcarSize method to set the boxcar size";
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
+  }
+
+
+  /**
+   * Starts the systematic processing of the input cube by moving a boxcar,
+   * p_boxSamples by p_boxLines, through the cube one pixel at a time. The input
+   * and output buffers contain a Boxcar of the size indicated in p_boxSamples
+   * and p_boxLines. The input and output cube must be initialized prior to
+   * calling this method.
+   *
+   * @param funct (Isis::Buffer &in, double &out) Name of your processing function
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, double &out)) {
+    VerifyCubes();
 
     // Construct boxcar buffer and line buffer managers
     Isis::BoxcarManager box(*InputCubes[0], p_boxSamples, p_boxLines);
@@ -119,6 +148,71 @@ namespace Isis {
 
   }
 
+
+  /**
+   * Starts the systematic processing of the input cube a line at a time with
+   * a RankFilter holding the p_boxSamples by p_boxLines boxcar around each
+   * pixel of the line. Pixels outside of the cube are Null, as they are for
+   * the other StartProcess. The input and output cube must be initialized prior
+   * to calling this method.
+   *
+   * @param funct (Isis::Buffer &in, Isis::Buffer &out, Isis::RankFilter &filter)
+   *              Name of your processing function. in holds the input line,
+   *              out the output line to fill and filter the boxcars around the
+   *              pixels of the line.
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, Isis::Buffer &out,
+                                                Isis::RankFilter &filter)) {
+    VerifyCubes();
+
+    Cube *icube = InputCubes[0];
+    RankFilter filter(icube->sampleCount(), p_boxSamples, p_boxLines);
+    filter.SetMinMax(p_low, p_high);
+
+    Isis::LineManager reader(*icube);
+    Isis::LineManager in(*icube);
+    Isis::LineManager out(*OutputCubes[0]);
+    std::vector<double> nullLine(icube->sampleCount(), Null);
+    int halfLines = filter.HalfHeight();
+
+    p_progress->SetMaximumSteps(icube->lineCount() * icube->bandCount());
+    p_progress->CheckStatus();
+
+    for (out.begin(); !out.end(); out.next()) {
+      int line = out.Line();
+      int band = out.Band();
+
+      // Slide the boxcar down one line, or fill it at the top of a band
+      int first = line + halfLines;
+      if (line == 1) {
+        filter.Reset();
+        first = 1 - halfLines;
+      }
+      else {
+        filter.RemoveLine();
+      }
+
+      for (int boxLine = first; boxLine <= line + halfLines; boxLine++) {
+        if (boxLine < 1 || boxLine > icube->lineCount()) {
+          filter.AddLine(&nullLine[0]);
+        }
+        else {
+          reader.SetLine(boxLine, band);
+          icube->read(reader);
+          filter.AddLine(reader.DoubleBuffer());
+        }
+      }
+
+      in.SetLine(line, band);
+      icube->read(in);
+      funct(in, out, filter);
+      OutputCubes[0]->write(out);
+      p_progress->CheckStatus();
+    }
+  }
+
   /**
    * End the boxcar processing sequence and cleans up by closing cubes, freeing
    * memory, etc.
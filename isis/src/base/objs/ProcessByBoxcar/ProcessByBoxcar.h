@@ -22,16 +22,25 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <float.h>
+
 #include "Process.h"
 #include "Buffer.h"
 
 namespace Isis {
+  class RankFilter;
+
   /**
    * @brief Process cubes by boxcar
    *
    * This is the processing class used to move a boxcar through cube data. This
    * class allows only one input cube and one output cube.
    *
+   * Filters that need ranks of the boxcar, such as the median or the mode, can
+   * process a line at a time with a RankFilter instead of sorting every
+   * boxcar. The RankFilter slides along the line and only updates the columns
+   * entering and leaving the boxcar.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2003-01-03 Tracie Sucharski
@@ -58,6 +67,10 @@ namespace Isis {
       bool p_boxsizeSet; //!< Indicates whether the boxcar size has been set
       int p_boxSamples;  //!< Number of samples in boxcar
       int p_boxLines;    //!< Number of lines in boxcar
+      double p_low;      //!< The smallest valid pixel for rank filtering
+      double p_high;     //!< The largest valid pixel for rank filtering
+
+      void VerifyCubes();
 
 
     public:
@@ -65,12 +78,15 @@ namespace Isis {
       //! Constructs a ProcessByBoxcar object
       ProcessByBoxcar() {
         p_boxsizeSet = false;
+        p_low = -DBL_MAX;
+        p_high = DBL_MAX;
       };
 
       //! Destroys the ProcessByBoxcar object.
       virtual ~ProcessByBoxcar() {};
 
       void SetBoxcarSize(const int ns, const int nl);
+      void SetValidRange(const double low, const double high);
 
       using Isis::Process::StartProcess;  // make parent functions visable
       virtual void StartProcess(void funct(Isis::Buffer &in, double &out));
@@ -78,6 +94,13 @@ namespace Isis {
         StartProcess(funct);
       }
 
+      virtual void StartProcess(void funct(Isis::Buffer &in, Isis::Buffer &out,
+                                           Isis::RankFilter &filter));
+      void ProcessCube(void funct(Isis::Buffer &in, Isis::Buffer &out,
+                                  Isis::RankFilter &filter)) {
+        StartProcess(funct);
+      }
+
       void EndProcess();
       void Finalize();
   };
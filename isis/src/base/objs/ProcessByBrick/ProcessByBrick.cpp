@@ -20,11 +20,19 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <algorithm>
 #include <functional>
 
+#include <QAtomicInt>
+#include <QMutex>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentRun>
+
 #include "ProcessByBrick.h"
 #include "Brick.h"
 #include "Cube.h"
+#include "IException.h"
 
 using namespace std;
 
@@ -43,6 +51,8 @@ namespace Isis {
     p_outputBrickSizeSet = false;
     p_wrapOption = false;
     p_reverse = false;
+    p_threadedStartProcess = false;
+    p_inputOverviewLevel = 0;
   }
 
 
@@ -437,6 +447,60 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
+  /**
+   * Allow the StartProcess() methods to call the application function from
+   * several threads at once (see RunParallelStartProcess()). The number of
+   * threads is the GlobalThreads setting. This is off by default; only turn
+   * it on once the function passed to StartProcess() is reentrant: it may
+   * only touch the buffers it is given and state that is safe to share
+   * between threads.
+   *
+   * @param threaded Specifies whether or not StartProcess() may use threads
+   */
+  void ProcessByBrick::SetThreadedStartProcess(bool threaded) {
+    p_threadedStartProcess = threaded;
+  }
+
+
+  /**
+   * Returns true if the StartProcess() methods may use several threads.
+   * @see SetThreadedStartProcess()
+   * @return The value of the threaded StartProcess option
+   */
+  bool ProcessByBrick::ThreadsStartProcess() {
+    return p_threadedStartProcess;
+  }
+
+
+  /**
+   * Read the input cube from one of its overview levels (see
+   * Cube::createOverviews()) instead of its full resolution data. The input
+   * bricks then traverse the overview's dimensions, so the output cube should
+   * be sized with Cube::overviewSampleCount() and Cube::overviewLineCount().
+   * This is only supported with a single, read only input cube.
+   *
+   * @param level The overview level to read, or 0 for the full resolution data
+   */
+  void ProcessByBrick::SetInputOverviewLevel(int level) {
+    if (level < 0) {
+      string m = "The overview level must be zero or greater";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    p_inputOverviewLevel = level;
+  }
+
+
+  /**
+   * Returns the overview level the input cube is read from.
+   * @see SetInputOverviewLevel()
+   * @return The overview level, 0 for the full resolution data
+   */
+  int ProcessByBrick::InputOverviewLevel() {
+    return p_inputOverviewLevel;
+  }
+
+
   /**
    * Starts the systematic processing of the input cube by moving an arbitrary
    * shaped brick through the cube. This method requires that exactly one input
@@ -451,30 +515,7 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
    * @throws iException::Programmer
    */
   void ProcessByBrick::StartProcess(void funct(Buffer &in)) {
-    Cube *cube = NULL;
-    Brick *brick = NULL;
-
-    bool haveInput = PrepProcessCubeInPlace(&cube, &brick);
-
-    // Loop and let the app programmer work with the bricks
-    p_progress->SetMaximumSteps(brick->Bricks());
-    p_progress->CheckStatus();
-
-    for (brick->begin(); !brick->end(); (*brick)++) {
-      if (haveInput)
-        cube->read(*brick);  // input only
-
-      funct(*brick);
-
-      // output only or input/output
-      if ((!haveInput) || (cube->isReadWrite())) {
-        cube->write(*brick);
-      }
-
-      p_progress->CheckStatus();
-    }
-
-    delete brick;
+    ProcessByBrick::StartProcess(std::function<void(Buffer &)>(funct));
   }
 
 
@@ -483,6 +524,9 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
    * shaped brick through the cube. This method requires that exactly one input
    * cube be loaded. No output cubes are produced.
    *
+   * If SetThreadedStartProcess() was turned on, funct is called from several
+   * threads at once (see RunParallelStartProcess()).
+   *
    * @deprecated Please use ProcessCubeInPlace, ProcessCube, or ProcessCubes
    * @param funct (Buffer &in) Receive an nxm brick in the input buffer.
    *                                If n=1 and m=lines this will process by
@@ -501,18 +545,55 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
     p_progress->SetMaximumSteps(brick->Bricks());
     p_progress->CheckStatus();
 
-    for (brick->begin(); !brick->end(); (*brick)++) {
-      if (haveInput)
-        cube->read(*brick);  // input only
+    int threadCount = StartProcessThreadCount();
+    if (threadCount > 1) {
+      bool writeOutput = (!haveInput) || (cube->isReadWrite());
 
-      funct(*brick);
+      vector<Brick *> bricks;
+      for (int i = 0; i < ParallelSlotCount(threadCount); i++) {
+        bricks.push_back(new Brick(*brick));
+      }
 
-      // output only or input/output
-      if ((!haveInput) || (cube->isReadWrite())) {
-        cube->write(*brick);
+      try {
+        RunParallelStartProcess(brick->Bricks(), threadCount,
+            [&](int slot, int position) {
+              bricks[slot]->setpos(position);
+              if (haveInput) {
+                ReadInput(cube, *bricks[slot], p_inputOverviewLevel);
+              }
+            },
+            [&](int slot) {
+              funct(*bricks[slot]);
+            },
+            [&](int slot) {
+              if (writeOutput) {
+                cube->write(*bricks[slot]);
+              }
+            });
+      }
+      catch (...) {
+        DeleteBricks(bricks);
+        delete brick;
+        throw;
       }
 
-      p_progress->CheckStatus();
+      DeleteBricks(bricks);
+    }
+    else {
+      for (brick->begin(); !brick->end(); (*brick)++) {
+        if (haveInput) {
+          ReadInput(cube, *brick, p_inputOverviewLevel);  // input only
+        }
+
+        funct(*brick);
+
+        // output only or input/output
+        if ((!haveInput) || (cube->isReadWrite())) {
+          cube->write(*brick);
+        }
+
+        p_progress->CheckStatus();
+      }
     }
 
     delete brick;
@@ -534,29 +615,8 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
    * @throws iException::Programmer
    */
   void ProcessByBrick::StartProcess(void funct(Buffer &in, Buffer &out)) {
-    Brick *ibrick = NULL;
-    Brick *obrick = NULL;
-
-    int numBricks = PrepProcessCube(&ibrick, &obrick);
-
-    // Loop and let the app programmer work with the bricks
-    p_progress->SetMaximumSteps(numBricks);
-    p_progress->CheckStatus();
-
-    ibrick->begin();
-    obrick->begin();
-
-    for (int i = 0; i < numBricks; i++) {
-      InputCubes[0]->read(*ibrick);
-      funct(*ibrick, *obrick);
-      OutputCubes[0]->write(*obrick);
-      p_progress->CheckStatus();
-      (*ibrick)++;
-      (*obrick)++;
-    }
-
-    delete ibrick;
-    delete obrick;
+    ProcessByBrick::StartProcess(
+        std::function<void(Buffer &, Buffer &)>(funct));
   }
 
 
@@ -566,6 +626,9 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
    * cube and one output cube be loaded using the SetInputCube and SetOutputCube
    * methods.
    *
+   * If SetThreadedStartProcess() was turned on, funct is called from several
+   * threads at once (see RunParallelStartProcess()).
+   *
    * @deprecated Please use ProcessCubeInPlace, ProcessCube, or ProcessCubes
    * @param funct (Buffer &in, Buffer &out) Receive an nxm brick in
    *              the input buffer and output the an nxm brick. If n=1 and
@@ -584,16 +647,52 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
     p_progress->SetMaximumSteps(numBricks);
     p_progress->CheckStatus();
 
-    ibrick->begin();
-    obrick->begin();
+    int threadCount = StartProcessThreadCount();
+    if (threadCount > 1) {
+      vector<Brick *> ibricks;
+      vector<Brick *> obricks;
+      for (int i = 0; i < ParallelSlotCount(threadCount); i++) {
+        ibricks.push_back(new Brick(*ibrick));
+        obricks.push_back(new Brick(*obrick));
+      }
 
-    for (int i = 0; i < numBricks; i++) {
-      InputCubes[0]->read(*ibrick);
-      funct(*ibrick, *obrick);
-      OutputCubes[0]->write(*obrick);
-      p_progress->CheckStatus();
-      (*ibrick)++;
-      (*obrick)++;
+      try {
+        RunParallelStartProcess(numBricks, threadCount,
+            [&](int slot, int position) {
+              ibricks[slot]->setpos(position);
+              obricks[slot]->setpos(position);
+              ReadInput(InputCubes[0], *ibricks[slot], p_inputOverviewLevel);
+            },
+            [&](int slot) {
+              funct(*ibricks[slot], *obricks[slot]);
+            },
+            [&](int slot) {
+              OutputCubes[0]->write(*obricks[slot]);
+            });
+      }
+      catch (...) {
+        DeleteBricks(ibricks);
+        DeleteBricks(obricks);
+        delete ibrick;
+        delete obrick;
+        throw;
+      }
+
+      DeleteBricks(ibricks);
+      DeleteBricks(obricks);
+    }
+    else {
+      ibrick->begin();
+      obrick->begin();
+
+      for (int i = 0; i < numBricks; i++) {
+        ReadInput(InputCubes[0], *ibrick, p_inputOverviewLevel);
+        funct(*ibrick, *obrick);
+        OutputCubes[0]->write(*obrick);
+        p_progress->CheckStatus();
+        (*ibrick)++;
+        (*obrick)++;
+      }
     }
 
     delete ibrick;
@@ -606,6 +705,9 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
    * shaped brick through the cube. This method allows multiple input and output
    * cubes.
    *
+   * If SetThreadedStartProcess() was turned on, funct is called from several
+   * threads at once (see RunParallelStartProcess()).
+   *
    * @deprecated Please use ProcessCubeInPlace, ProcessCube, or ProcessCubes
    * @param funct (vector<Buffer *> &in, vector<Buffer *> &out)
    *              Receive an nxm brick in the input buffer. If n=1 and m=lines
@@ -631,36 +733,118 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
     p_progress->SetMaximumSteps(numBricks);
     p_progress->CheckStatus();
 
-    for(int t = 0; t < numBricks; t++) {
-      // Read the input buffers
-      for(unsigned int i = 0; i < InputCubes.size(); i++) {
-        InputCubes[i]->read(*ibufs[i]);
+    int threadCount = StartProcessThreadCount();
+    if (threadCount > 1) {
+      // One set of input and output bricks per slot, parallel to imgrs/omgrs
+      vector< vector<Brick *> > islots;
+      vector< vector<Buffer *> > islotBufs;
+      vector< vector<Brick *> > oslots;
+      vector< vector<Buffer *> > oslotBufs;
+      for (int i = 0; i < ParallelSlotCount(threadCount); i++) {
+        islots.push_back(vector<Brick *>());
+        islotBufs.push_back(vector<Buffer *>());
+        for (unsigned int j = 0; j < imgrs.size(); j++) {
+          islots.back().push_back(new Brick(*imgrs[j]));
+          islotBufs.back().push_back(islots.back().back());
+        }
+
+        oslots.push_back(vector<Brick *>());
+        oslotBufs.push_back(vector<Buffer *>());
+        for (unsigned int j = 0; j < omgrs.size(); j++) {
+          oslots.back().push_back(new Brick(*omgrs[j]));
+          oslotBufs.back().push_back(oslots.back().back());
+        }
       }
 
-      // Pass them to the application function
-      funct(ibufs, obufs);
+      try {
+        RunParallelStartProcess(numBricks, threadCount,
+            [&](int slot, int position) {
+              vector<Brick *> &inputBricks = islots[slot];
+              for (unsigned int i = 0; i < inputBricks.size(); i++) {
+                // if the wrap option is on, wrap around to the beginning
+                if (Wraps()) {
+                  inputBricks[i]->setpos(position % inputBricks[i]->Bricks());
+                }
+                else {
+                  inputBricks[i]->setpos(position);
+                }
+
+                // Enforce same band
+                if (i != 0 &&
+                    inputBricks[i]->Band() != inputBricks[0]->Band() &&
+                    InputCubes[i]->bandCount() != 1) {
+                  inputBricks[i]->SetBaseBand(inputBricks[0]->Band());
+                }
+
+                InputCubes[i]->prefetch(*inputBricks[i]);
+                InputCubes[i]->read(*inputBricks[i]);
+              }
 
-      // And copy them into the output cubes
-      for(unsigned int i = 0; i < OutputCubes.size(); i++) {
-        OutputCubes[i]->write(*obufs[i]);
-        omgrs[i]->next();
+              for (unsigned int i = 0; i < oslots[slot].size(); i++) {
+                oslots[slot][i]->setpos(position);
+              }
+            },
+            [&](int slot) {
+              funct(islotBufs[slot], oslotBufs[slot]);
+            },
+            [&](int slot) {
+              for (unsigned int i = 0; i < OutputCubes.size(); i++) {
+                OutputCubes[i]->write(*oslots[slot][i]);
+              }
+            });
       }
+      catch (...) {
+        for (unsigned int i = 0; i < islots.size(); i++) {
+          DeleteBricks(islots[i]);
+          DeleteBricks(oslots[i]);
+        }
+        for (unsigned int i = 0; i < ibufs.size(); i++) {
+          delete ibufs[i];
+        }
+        for (unsigned int i = 0; i < obufs.size(); i++) {
+          delete obufs[i];
+        }
+        throw;
+      }
+
+      for (unsigned int i = 0; i < islots.size(); i++) {
+        DeleteBricks(islots[i]);
+        DeleteBricks(oslots[i]);
+      }
+    }
+    else {
+      for(int t = 0; t < numBricks; t++) {
+        // Read the input buffers
+        for(unsigned int i = 0; i < InputCubes.size(); i++) {
+          InputCubes[i]->prefetch(*imgrs[i]);
+          InputCubes[i]->read(*ibufs[i]);
+        }
+
+        // Pass them to the application function
+        funct(ibufs, obufs);
+
+        // And copy them into the output cubes
+        for(unsigned int i = 0; i < OutputCubes.size(); i++) {
+          OutputCubes[i]->write(*obufs[i]);
+          omgrs[i]->next();
+        }
 
-      for(unsigned int i = 0; i < InputCubes.size(); i++) {
-        imgrs[i]->next();
+        for(unsigned int i = 0; i < InputCubes.size(); i++) {
+          imgrs[i]->next();
 
-        // if the manager has reached the end and the
-        // wrap option is on, wrap around to the beginning
-        if(Wraps() && imgrs[i]->end())
-          imgrs[i]->begin();
+          // if the manager has reached the end and the
+          // wrap option is on, wrap around to the beginning
+          if(Wraps() && imgrs[i]->end())
+            imgrs[i]->begin();
 
-        // Enforce same band
-        if(imgrs[i]->Band() != imgrs[0]->Band() &&
-           InputCubes[i]->bandCount() != 1) {
-          imgrs[i]->SetBaseBand(imgrs[0]->Band());
+          // Enforce same band
+          if(imgrs[i]->Band() != imgrs[0]->Band() &&
+             InputCubes[i]->bandCount() != 1) {
+            imgrs[i]->SetBaseBand(imgrs[0]->Band());
+          }
         }
+        p_progress->CheckStatus();
       }
-      p_progress->CheckStatus();
     }
 
     for(unsigned int i = 0; i < ibufs.size(); i++) {
@@ -737,6 +921,196 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
+  /**
+   * Read an input brick, from the cube's overview level when one was chosen
+   *   with SetInputOverviewLevel().
+   *
+   * @param cube The input cube
+   * @param brick The brick to fill
+   * @param overviewLevel The overview level to read, or 0 for full resolution
+   */
+  void ProcessByBrick::ReadInput(Cube *cube, Brick &brick, int overviewLevel) {
+    if (overviewLevel > 0) {
+      cube->readOverview(brick, overviewLevel);
+    }
+    else {
+      cube->prefetch(brick);
+      cube->read(brick);
+    }
+  }
+
+
+  /**
+   * Get the number of threads the StartProcess() methods should use. This is
+   *   one (the original sequential behavior) unless the application turned on
+   *   SetThreadedStartProcess(), in which case it is the GlobalThreads setting.
+   *
+   * @return The number of threads to call the application function from
+   */
+  int ProcessByBrick::StartProcessThreadCount() const {
+    if (!p_threadedStartProcess) {
+      return 1;
+    }
+
+    return max(1, QThreadPool::globalInstance()->maxThreadCount());
+  }
+
+
+  /**
+   * @param threadCount The number of processing threads
+   * @return The number of brick sets RunParallelStartProcess() needs; one per
+   *     position that can be in flight at once.
+   */
+  int ProcessByBrick::ParallelSlotCount(int threadCount) {
+    return 2 * 4 * threadCount;
+  }
+
+
+  /**
+   * Runs a StartProcess() traversal with the application function called from
+   *   threadCount threads. The positions are handled in blocks of a few
+   *   positions per thread:
+   *   <ol>
+   *     <li>read() is called for every position of the block, in order, on
+   *       this thread.</li>
+   *     <li>process() is called for every position of the block on the
+   *       processing threads, in no particular order. Each thread takes the
+   *       next unprocessed position when it finishes one, so uneven work is
+   *       balanced. The next block is read while this happens.</li>
+   *     <li>write() is called for every position of the block, in order, on
+   *       this thread.</li>
+   *   </ol>
+   *   All cube I/O happens on this thread and in the same order as the
+   *   sequential loop, so only process() needs to be thread safe. Each
+   *   position in flight gets its own slot (0 to ParallelSlotCount() - 1),
+   *   which the caller uses to pick a set of preallocated bricks; the slots
+   *   are reused from block to block.
+   *
+   * If process() throws, the remaining positions in the block are still
+   *   processed, nothing more is written and the first error is rethrown.
+   *
+   * @param numSteps The number of positions in the traversal
+   * @param threadCount The number of processing threads
+   * @param read Fills the slot's bricks with the data at the given position
+   * @param process Calls the application function on the slot's bricks
+   * @param write Writes the slot's bricks to the output cubes
+   */
+  void ProcessByBrick::RunParallelStartProcess(int numSteps, int threadCount,
+      std::function<void(int slot, int position)> read,
+      std::function<void(int slot)> process,
+      std::function<void(int slot)> write) {
+    int blockSize = ParallelSlotCount(threadCount) / 2;
+
+    QMutex errorMutex;
+    bool processFailed = false;
+    IException processError;
+
+    // The slots of the block being processed. Each worker takes the next
+    //   unclaimed slot until the block is done.
+    QVector<int> blockSlots;
+    QAtomicInt nextSlotIndex;
+
+    std::function<void()> processBlock = [&]() {
+      int slotIndex = nextSlotIndex.fetchAndAddOrdered(1);
+
+      while (slotIndex < blockSlots.size()) {
+        try {
+          process(blockSlots.at(slotIndex));
+        }
+        catch (IException &e) {
+          QMutexLocker locker(&errorMutex);
+          if (!processFailed) {
+            processFailed = true;
+            processError = e;
+          }
+        }
+        catch (std::exception &e) {
+          QMutexLocker locker(&errorMutex);
+          if (!processFailed) {
+            processFailed = true;
+            processError = IException(IException::Unknown, e.what(), _FILEINFO_);
+          }
+        }
+        catch (...) {
+          QMutexLocker locker(&errorMutex);
+          if (!processFailed) {
+            processFailed = true;
+            processError = IException(IException::Unknown,
+                                      "Unknown error in the processing function", _FILEINFO_);
+          }
+        }
+
+        slotIndex = nextSlotIndex.fetchAndAddOrdered(1);
+      }
+    };
+
+    // The pool is declared after everything its workers use, so that its
+    //   destructor waits for them before those go out of scope
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+
+    for (int position = 0; position < min(blockSize, numSteps); position++) {
+      read(position, position);
+      blockSlots.append(position);
+    }
+
+    int firstSlot = 0;
+    for (int blockStart = 0; blockStart < numSteps; blockStart += blockSize) {
+      nextSlotIndex.storeRelease(0);
+      for (int i = 0; i < min(threadCount, blockSlots.size()); i++) {
+        QtConcurrent::run(&threadPool, processBlock);
+      }
+
+      // Read the next block into the other half of the slots while this one
+      //   is being processed.
+      int nextFirstSlot = blockSize - firstSlot;
+      int nextBlockStart = blockStart + blockSize;
+      QVector<int> nextBlockSlots;
+      try {
+        for (int position = nextBlockStart;
+             position < min(nextBlockStart + blockSize, numSteps);
+             position++) {
+          int slot = nextFirstSlot + position - nextBlockStart;
+          read(slot, position);
+          nextBlockSlots.append(slot);
+        }
+      }
+      catch (...) {
+        threadPool.waitForDone();
+        throw;
+      }
+
+      threadPool.waitForDone();
+
+      if (processFailed) {
+        throw processError;
+      }
+
+      foreach (int slot, blockSlots) {
+        write(slot);
+        p_progress->CheckStatus();
+      }
+
+      blockSlots = nextBlockSlots;
+      firstSlot = nextFirstSlot;
+    }
+  }
+
+
+  /**
+   * Deletes and clears a list of bricks.
+   *
+   * @param bricks The bricks to delete
+   */
+  void ProcessByBrick::DeleteBricks(std::vector<Brick *> &bricks) {
+    for (unsigned int i = 0; i < bricks.size(); i++) {
+      delete bricks[i];
+    }
+
+    bricks.clear();
+  }
+
+
   /**
    * Calculates the maximum dimensions of all the cubes and returns them in a
    * vector where position 0 is the max sample, position 1 is the max line, and
@@ -777,6 +1151,22 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
+  /**
+   * Make sure the input cube has the overview level set with
+   *   SetInputOverviewLevel().
+   *
+   * @throws IException::User "The input cube does not have the overview level"
+   */
+  void ProcessByBrick::CheckInputOverviewLevel() const {
+    if (p_inputOverviewLevel > InputCubes[0]->overviewCount()) {
+      QString m = "The input cube [" + InputCubes[0]->fileName() +
+                  "] does not have overview level [" +
+                  QString::number(p_inputOverviewLevel) + "]";
+      throw IException(IException::User, m, _FILEINFO_);
+    }
+  }
+
+
   /**
    * Prepare and check to run "function" parameter for
    * StartProcess(void funct(Buffer &in)) and
@@ -817,8 +1207,25 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
       haveInput = true;
       *cube = InputCubes[0];
-      *bricks = new Brick(**cube, p_inputBrickSamples[1],
-          p_inputBrickLines[1], p_inputBrickBands[1], p_reverse);
+      if (p_inputOverviewLevel > 0) {
+        CheckInputOverviewLevel();
+        if ((*cube)->isReadWrite()) {
+          string m = "An input cube that is read from its overviews can not "
+                     "also be written to";
+          throw IException(IException::Programmer, m, _FILEINFO_);
+        }
+
+        *bricks = new Brick((*cube)->overviewSampleCount(p_inputOverviewLevel),
+                            (*cube)->overviewLineCount(p_inputOverviewLevel),
+                            (*cube)->bandCount(),
+                            p_inputBrickSamples[1], p_inputBrickLines[1],
+                            p_inputBrickBands[1], (*cube)->pixelType(),
+                            p_reverse);
+      }
+      else {
+        *bricks = new Brick(**cube, p_inputBrickSamples[1],
+            p_inputBrickLines[1], p_inputBrickBands[1], p_reverse);
+      }
     }
     else {
       SetBricks(InPlace);
@@ -887,12 +1294,23 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
                         p_inputBrickBands[0], 1);
     }
 
+    // The input is traversed with the dimensions of the overview it is read
+    // from, if any
+    int inputSamples = InputCubes[0]->sampleCount();
+    int inputLines = InputCubes[0]->lineCount();
+    if (p_inputOverviewLevel > 0) {
+      CheckInputOverviewLevel();
+      inputSamples = InputCubes[0]->overviewSampleCount(p_inputOverviewLevel);
+      inputLines = InputCubes[0]->overviewLineCount(p_inputOverviewLevel);
+    }
+
     // Construct brick buffers
     if (Wraps()) {
       // Use the size of each cube as the area for the bricks to traverse since
       // we will be wrapping if we hit the end of one, but not the other.
-      *ibrick = new Brick(*InputCubes[0], p_inputBrickSamples[1],
-          p_inputBrickLines[1], p_inputBrickBands[1], p_reverse);
+      *ibrick = new Brick(inputSamples, inputLines, InputCubes[0]->bandCount(),
+          p_inputBrickSamples[1], p_inputBrickLines[1], p_inputBrickBands[1],
+          InputCubes[0]->pixelType(), p_reverse);
       *obrick = new Brick(*OutputCubes[0], p_outputBrickSamples[1],
           p_outputBrickLines[1], p_outputBrickBands[1], p_reverse);
     }
@@ -901,13 +1319,9 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
       // input cube and the output cube. We will use this size when
       // constructing each of the bricks' area to traverse so that we don't
       // read into nonexistent bands of the smaller of the two cubes.
-      vector<Cube *> allCubes;
-      allCubes.push_back(InputCubes[0]);
-      allCubes.push_back(OutputCubes[0]);
-      vector<int> maxDimensions = CalculateMaxDimensions(allCubes);
-      int maxSamples = maxDimensions[0];
-      int maxLines = maxDimensions[1];
-      int maxBands = maxDimensions[2];
+      int maxSamples = max(inputSamples, OutputCubes[0]->sampleCount());
+      int maxLines = max(inputLines, OutputCubes[0]->lineCount());
+      int maxBands = max(InputCubes[0]->bandCount(), OutputCubes[0]->bandCount());
 
       *ibrick = new Brick(maxSamples, maxLines, maxBands,
                                 p_inputBrickSamples[1],
@@ -961,6 +1375,12 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    if (p_inputOverviewLevel > 0) {
+      string m = "Reading the input from an overview level is only supported "
+                 "with a single input cube";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
     SetBricks(InputOutputList);
 
     //  Make sure the brick size has been set
@@ -145,6 +145,12 @@ namespace Isis {
       void SetWrap(bool wrap);
       bool Wraps();
 
+      void SetThreadedStartProcess(bool threaded);
+      bool ThreadsStartProcess();
+
+      void SetInputOverviewLevel(int level);
+      int InputOverviewLevel();
+
       using Isis::Process::StartProcess;  // make parents virtual function visable
       virtual void StartProcess(void funct(Buffer &in));
       virtual void StartProcess(std::function<void(Buffer &in)> funct );
@@ -185,7 +191,7 @@ namespace Isis {
         bool writeOutput = (!haveInput) || (cube->isReadWrite());
 
         ProcessCubeInPlaceFunctor<Functor> wrapperFunctor(
-            cube, brick, haveInput, writeOutput, functor);
+            cube, brick, haveInput, writeOutput, p_inputOverviewLevel, functor);
 
         RunProcess(wrapperFunctor, brick->Bricks(), threaded);
 
@@ -221,7 +227,7 @@ namespace Isis {
         int numBricks = PrepProcessCube(&inputCubeData, &outputCubeData);
 
         ProcessCubeFunctor<Functor> wrapperFunctor(InputCubes[0], inputCubeData,
-            OutputCubes[0], outputCubeData, functor);
+            p_inputOverviewLevel, OutputCubes[0], outputCubeData, functor);
 
         RunProcess(wrapperFunctor, numBricks, threaded);
 
@@ -280,6 +286,8 @@ namespace Isis {
 
 
     private:
+      static void ReadInput(Cube *cube, Brick &brick, int overviewLevel);
+
       /**
        * This method runs the given wrapper functor numSteps times with
        *   or without threading, reporting progress in both cases. This method
@@ -346,6 +354,8 @@ namespace Isis {
            *     before calling the processingFunctor.
            * @param writeOutput True if we should write the resulting brick from
            *     the processingFunctor into the cube
+           * @param overviewLevel The overview level to read the cube from, or 0
+           *     to read its full resolution data
            * @param processingFunctor The functor supplied to
            *     ProcessCubeInPlace() which actually does the work/
            *     calculations.
@@ -353,11 +363,13 @@ namespace Isis {
           ProcessCubeInPlaceFunctor(Cube *cube,
                                     const Brick *templateBrick,
                                     bool readInput, bool writeOutput,
+                                    int overviewLevel,
                                     const T &processingFunctor) :
               m_cube(cube),
               m_templateBrick(templateBrick),
               m_readInput(readInput),
               m_writeOutput(writeOutput),
+              m_overviewLevel(overviewLevel),
               m_processingFunctor(processingFunctor) {
           }
 
@@ -372,6 +384,7 @@ namespace Isis {
               m_templateBrick(other.m_templateBrick),
               m_readInput(other.m_readInput),
               m_writeOutput(other.m_writeOutput),
+              m_overviewLevel(other.m_overviewLevel),
               m_processingFunctor(other.m_processingFunctor) {
           }
 
@@ -395,8 +408,9 @@ namespace Isis {
             Brick cubeData(*m_templateBrick);
             cubeData.setpos(brickPosition);
 
-            if (m_readInput)
-              m_cube->read(cubeData);
+            if (m_readInput) {
+              ReadInput(m_cube, cubeData, m_overviewLevel);
+            }
 
             m_processingFunctor(cubeData);
 
@@ -421,6 +435,7 @@ namespace Isis {
 
             m_readInput = rhs.m_readInput;
             m_writeOutput = rhs.m_writeOutput;
+            m_overviewLevel = rhs.m_overviewLevel;
 
             m_processingFunctor = rhs.m_processingFunctor;
 
@@ -436,6 +451,8 @@ namespace Isis {
           bool m_readInput;
           //! Should we write to the output cube after processing
           bool m_writeOutput;
+          //! The overview level to read from, 0 for full resolution
+          int m_overviewLevel;
 
           //! The functor which does the work/arbitrary calculations
           const T &m_processingFunctor;
@@ -466,6 +483,8 @@ namespace Isis {
            * @param inputCube The cube to read from for input data
            * @param inputTemplateBrick A brick initialized for use with the
            *     processingFunctor's input parameter
+           * @param inputOverviewLevel The overview level to read the input cube
+           *     from, or 0 to read its full resolution data
            * @param outputCube The cube to write to after running the
            *     processingFunctor
            * @param outputTemplateBrick A brick initialized for use with the
@@ -476,11 +495,13 @@ namespace Isis {
            */
           ProcessCubeFunctor(Cube *inputCube,
                              const Brick *inputTemplateBrick,
+                             int inputOverviewLevel,
                              Cube *outputCube,
                              const Brick *outputTemplateBrick,
                              const T &processingFunctor) :
               m_inputCube(inputCube),
               m_inputTemplateBrick(inputTemplateBrick),
+              m_inputOverviewLevel(inputOverviewLevel),
               m_outputCube(outputCube),
               m_outputTemplateBrick(outputTemplateBrick),
               m_processingFunctor(processingFunctor) {
@@ -495,6 +516,7 @@ namespace Isis {
           ProcessCubeFunctor(const ProcessCubeFunctor &other) :
               m_inputCube(other.m_inputCube),
               m_inputTemplateBrick(other.m_inputTemplateBrick),
+              m_inputOverviewLevel(other.m_inputOverviewLevel),
               m_outputCube(other.m_outputCube),
               m_outputTemplateBrick(other.m_outputTemplateBrick),
               m_processingFunctor(other.m_processingFunctor) {
@@ -523,7 +545,7 @@ namespace Isis {
             inputCubeData.setpos(brickPosition);
             outputCubeData.setpos(brickPosition);
 
-            m_inputCube->read(inputCubeData);
+            ReadInput(m_inputCube, inputCubeData, m_inputOverviewLevel);
 
             m_processingFunctor(inputCubeData, outputCubeData);
 
@@ -543,6 +565,7 @@ namespace Isis {
           ProcessCubeFunctor &operator=(const ProcessCubeFunctor &rhs) {
             m_inputCube = rhs.m_inputCube;
             m_inputTemplateBrick = rhs.m_inputTemplateBrick;
+            m_inputOverviewLevel = rhs.m_inputOverviewLevel;
 
             m_outputCube = rhs.m_outputCube;
             m_outputTemplateBrick = rhs.m_outputTemplateBrick;
@@ -557,6 +580,8 @@ namespace Isis {
           Cube *m_inputCube;
           //! An example brick for the input parameter to m_processingFunctor
           const Brick *m_inputTemplateBrick;
+          //! The overview level to read the input from, 0 for full resolution
+          int m_inputOverviewLevel;
 
           //! The cube to write to with the output of m_processingFunctor
           Cube *m_outputCube;
@@ -669,6 +694,7 @@ namespace Isis {
                 inputBrick->SetBaseBand(functorBricks.first[0]->Band());
               }
 
+              m_inputCubes[i]->prefetch(*inputBrick);
               m_inputCubes[i]->read(*inputBrick);
             }
 
@@ -742,7 +768,15 @@ namespace Isis {
 
 
       void BlockingReportProgress(QFuture<void> &future);
+      int StartProcessThreadCount() const;
+      static int ParallelSlotCount(int threadCount);
+      void RunParallelStartProcess(int numSteps, int threadCount,
+          std::function<void(int slot, int position)> read,
+          std::function<void(int slot)> process,
+          std::function<void(int slot)> write);
+      static void DeleteBricks(std::vector<Brick *> &bricks);
       std::vector<int> CalculateMaxDimensions(std::vector<Cube *> cubes) const;
+      void CheckInputOverviewLevel() const;
       bool PrepProcessCubeInPlace(Cube **cube, Brick **bricks);
       int PrepProcessCube(Brick **ibrick, Brick **obrick);
       int PrepProcessCubes(std::vector<Buffer *> & ibufs,
@@ -831,12 +865,17 @@ namespace Isis {
                         objects when the Processing Direction is changed from
                         LinesFirst to BandsFirst*/
       bool p_wrapOption;    //!< Indicates whether the brick manager will wrap
+      bool p_threadedStartProcess; /**< Indicates whether StartProcess() may
+                                        call the application function from
+                                        several threads*/
       bool p_inputBrickSizeSet;  /**< Indicates whether the brick size has been
                                       set*/
       bool p_outputBrickSizeSet; /**< Indicates whether the brick size has been
                                       set*/
 
       int p_outputRequirements;
+      int p_inputOverviewLevel; /**< The overview level the input cube is read
+                                     from, 0 for full resolution*/
 
 
       std::vector<int> p_inputBrickSamples;  /**< Number of samples in the input
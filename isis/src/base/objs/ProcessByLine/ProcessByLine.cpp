@@ -106,7 +106,7 @@ namespace Isis {
         case InPlace:
 
           if (InputCubes.size() == 1) {
-            SetBrickSize(InputCubes[0]->sampleCount(), 1, 1);
+            SetBrickSize(InputCubes[0]->overviewSampleCount(InputOverviewLevel()), 1, 1);
           }
 
           else {
@@ -117,7 +117,8 @@ namespace Isis {
 
         case InputOutput:
 
-          SetInputBrickSize(InputCubes[0]->sampleCount(), 1, 1);
+          SetInputBrickSize(InputCubes[0]->overviewSampleCount(InputOverviewLevel()),
+                            1, 1);
           SetOutputBrickSize(OutputCubes[0]->sampleCount(), 1, 1);
 
           break;
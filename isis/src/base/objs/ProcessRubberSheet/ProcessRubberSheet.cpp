@@ -23,12 +23,18 @@
 #include <iostream>
 #include <iomanip>
 
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <QVector>
 
 #include "Affine.h"
 #include "BasisFunction.h"
 #include "BoxcarCachingAlgorithm.h"
 #include "Brick.h"
+#include "IException.h"
 #include "Interpolator.h"
 #include "LeastSquares.h"
 #include "Portal.h"
@@ -157,6 +163,12 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    int threadCount = transformThreadCount();
+    if (threadCount > 1) {
+      threadedStartProcess(trans, interp, threadCount);
+      return;
+    }
+
     // allocate the sampMap/lineMap vectors
     p_lineMap.resize(p_startQuadSize);
     p_sampMap.resize(p_startQuadSize);
@@ -195,7 +207,8 @@ namespace Isis {
             SlowGeom(otile, iportal, trans, interp);
           }
           else {
-            QuadTree(otile, iportal, trans, interp, useLastTileMap);
+            QuadTree(otile, iportal, trans, interp, useLastTileMap,
+                     p_lineMap, p_sampMap);
           }
 
           useLastTileMap = true;
@@ -220,7 +233,7 @@ namespace Isis {
           SlowGeom(otile, iportal, trans, interp);
         }
         else {
-          QuadTree(otile, iportal, trans, interp, false);
+          QuadTree(otile, iportal, trans, interp, false, p_lineMap, p_sampMap);
         }
 
         OutputCubes[0]->write(otile);
@@ -249,6 +262,264 @@ namespace Isis {
   }
 
 
+  /**
+   * Registers a function that creates a new transform, equivalent to the one
+   * given to StartProcess or processPatchTransform. When it is set and there is
+   * more than one global thread, those methods transform the cube on the global
+   * threads. Every thread uses a transform created by this function, so the
+   * transforms must not share anything they change (such as a Camera or a
+   * Projection). The transform given to the method is not used by the threads.
+   *
+   * The function is always called from the thread that started the processing,
+   * and the transforms it creates are deleted when the processing is done.
+   * If a band change function is registered, the transforms are created again
+   * after it has been called for each band.
+   *
+   * @param transformFactory Creates a transform for a thread. Pass an empty
+   *                         function to process on one thread.
+   */
+  void ProcessRubberSheet::setTransformFactory(std::function<Transform *()> transformFactory) {
+    m_transformFactory = transformFactory;
+  }
+
+
+  /**
+   * Creates the state of one transform thread.
+   *
+   * @param trans The transform of the thread, deleted with the thread
+   * @param interp The interpolator, used to size the input portal
+   * @param inputCube The cube to read the input pixels from
+   * @param outputCube The cube the output tiles are positioned in
+   * @param tileSize The size of the output tiles and tile maps
+   */
+  ProcessRubberSheet::TransformThread::TransformThread(Transform *trans,
+                                                       Interpolator &interp,
+                                                       Cube &inputCube, Cube &outputCube,
+                                                       int tileSize) :
+      iportal(interp.Samples(), interp.Lines(), inputCube.pixelType(),
+              interp.HotSample(), interp.HotLine()),
+      otile(outputCube, tileSize, tileSize) {
+    transform = trans;
+
+    lineMap.resize(tileSize, std::vector<double>(tileSize));
+    sampMap.resize(tileSize, std::vector<double>(tileSize));
+  }
+
+
+  //! Destroys the thread state and its transform.
+  ProcessRubberSheet::TransformThread::~TransformThread() {
+    delete transform;
+    transform = NULL;
+  }
+
+
+  /**
+   * @return @b int The number of threads to transform the cube with. This is
+   *     the number of global threads if a transform factory is registered and
+   *     one otherwise.
+   */
+  int ProcessRubberSheet::transformThreadCount() const {
+    if (!m_transformFactory) {
+      return 1;
+    }
+
+    return QThreadPool::globalInstance()->maxThreadCount();
+  }
+
+
+  /**
+   * Creates the state of the transform threads, each with a new transform from
+   * the transform factory.
+   *
+   * @param interp The interpolator given to the processing method
+   * @param threadCount The number of threads
+   *
+   * @return @b QVector<QSharedPointer<TransformThread>> The state of each thread
+   */
+  QVector< QSharedPointer<ProcessRubberSheet::TransformThread> >
+      ProcessRubberSheet::createTransformThreads(Interpolator &interp, int threadCount) {
+    int tileSize = (int) p_startQuadSize;
+
+    QVector< QSharedPointer<TransformThread> > threads;
+    for (int thread = 0; thread < threadCount; thread++) {
+      Transform *threadTransform = m_transformFactory();
+      if (!threadTransform) {
+        string msg = "The transform factory did not create a transform";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+
+      threads.append(QSharedPointer<TransformThread>(
+          new TransformThread(threadTransform, interp,
+                              *InputCubes[0], *OutputCubes[0], tileSize)));
+    }
+
+    return threads;
+  }
+
+
+  /**
+   * Runs transform on the global threads for every item (output tile or input
+   * patch) and calls write for the items in order on this thread. The items
+   * are handled in blocks of a few items per thread; each thread takes the next
+   * item of the block when it finishes one, so uneven work is balanced, and the
+   * block is written once all of its items are transformed.
+   *
+   * If transform throws, the rest of the block is still transformed, nothing
+   * more is written and the first error is rethrown.
+   *
+   * @param itemCount The number of items
+   * @param threadCount The number of threads
+   * @param transform Transforms an item with the state of the given thread
+   * @param write Writes a transformed item to the output cube
+   */
+  void ProcessRubberSheet::runTransformThreads(int itemCount, int threadCount,
+      std::function<void(int thread, int item)> transform,
+      std::function<void(int item)> write) {
+    int blockSize = 4 * threadCount;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+
+    QMutex errorMutex;
+    bool transformFailed = false;
+    IException transformError;
+
+    QAtomicInt nextItem;
+
+    for (int blockStart = 0; blockStart < itemCount; blockStart += blockSize) {
+      int blockEnd = min(blockStart + blockSize, itemCount);
+      nextItem.storeRelease(blockStart);
+
+      for (int thread = 0; thread < threadCount; thread++) {
+        std::function<void()> transformBlock = [&, thread, blockEnd]() {
+          int item = nextItem.fetchAndAddOrdered(1);
+
+          while (item < blockEnd) {
+            try {
+              transform(thread, item);
+            }
+            catch (IException &e) {
+              QMutexLocker locker(&errorMutex);
+              if (!transformFailed) {
+                transformFailed = true;
+                transformError = e;
+              }
+            }
+            catch (std::exception &e) {
+              QMutexLocker locker(&errorMutex);
+              if (!transformFailed) {
+                transformFailed = true;
+                transformError = IException(IException::Unknown, e.what(), _FILEINFO_);
+              }
+            }
+
+            item = nextItem.fetchAndAddOrdered(1);
+          }
+        };
+
+        QtConcurrent::run(&threadPool, transformBlock);
+      }
+
+      threadPool.waitForDone();
+
+      if (transformFailed) {
+        throw transformError;
+      }
+
+      for (int item = blockStart; item < blockEnd; item++) {
+        write(item);
+      }
+    }
+  }
+
+
+  /**
+   * The threaded version of StartProcess. Each thread fills whole output tiles,
+   * every band of a tile at a time when there is no band change function, and
+   * the tiles are written in the same order as StartProcess.
+   *
+   * @param trans The transform of the first thread
+   * @param interp The interpolator, shared by the threads
+   * @param threadCount The number of threads
+   */
+  void ProcessRubberSheet::threadedStartProcess(Transform &trans, Interpolator &interp,
+                                                int threadCount) {
+    TileManager otile(*OutputCubes[0], p_startQuadSize, p_startQuadSize);
+    int bandCount = OutputCubes[0]->bandCount();
+    int tilesPerBand = otile.Tiles() / bandCount;
+
+    p_progress->SetMaximumSteps(otile.Tiles());
+    p_progress->CheckStatus();
+
+    // Every thread reads its own part of the input cube
+    InputCubes[0]->addCachingAlgorithm(
+        new UniqueIOCachingAlgorithm(2 * InputCubes[0]->bandCount() * threadCount));
+    OutputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
+
+    // The filled output tiles of each item, in the order to write them
+    QVector< QList< QSharedPointer<Buffer> > > outputTiles(tilesPerBand);
+
+    std::function<void(int item)> write = [&](int item) {
+      foreach (QSharedPointer<Buffer> outputTile, outputTiles[item]) {
+        OutputCubes[0]->write(*outputTile);
+        p_progress->CheckStatus();
+      }
+      outputTiles[item].clear();
+    };
+
+    if (p_bandChangeFunct == NULL) {
+      QVector< QSharedPointer<TransformThread> > threads =
+          createTransformThreads(interp, threadCount);
+
+      // Bands after the first reuse the tile map of the first
+      std::function<void(int thread, int item)> transform = [&](int thread, int item) {
+        TransformThread &state = *threads[thread];
+
+        for (int band = 1; band <= bandCount; band++) {
+          state.otile.SetTile(item + 1, band);
+
+          if (p_startQuadSize <= 2) {
+            SlowGeom(state.otile, state.iportal, *state.transform, interp);
+          }
+          else {
+            QuadTree(state.otile, state.iportal, *state.transform, interp, band > 1,
+                     state.lineMap, state.sampMap);
+          }
+
+          outputTiles[item].append(QSharedPointer<Buffer>(new Buffer(state.otile)));
+        }
+      };
+
+      runTransformThreads(tilesPerBand, threadCount, transform, write);
+    }
+    else {
+      for (int band = 1; band <= bandCount; band++) {
+        p_bandChangeFunct(band);
+
+        QVector< QSharedPointer<TransformThread> > threads =
+            createTransformThreads(interp, threadCount);
+
+        std::function<void(int thread, int item)> transform = [&](int thread, int item) {
+          TransformThread &state = *threads[thread];
+          state.otile.SetTile(item + 1, band);
+
+          if (p_startQuadSize <= 2) {
+            SlowGeom(state.otile, state.iportal, *state.transform, interp);
+          }
+          else {
+            QuadTree(state.otile, state.iportal, *state.transform, interp, false,
+                     state.lineMap, state.sampMap);
+          }
+
+          outputTiles[item].append(QSharedPointer<Buffer>(new Buffer(state.otile)));
+        };
+
+        runTransformThreads(tilesPerBand, threadCount, transform, write);
+      }
+    }
+  }
+
+
   void ProcessRubberSheet::SlowGeom(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp) {
 
@@ -284,7 +555,9 @@ namespace Isis {
 
   void ProcessRubberSheet::QuadTree(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp,
-                                    bool useLastTileMap) {
+                                    bool useLastTileMap,
+                                    std::vector< std::vector<double> > &lineMap,
+                                    std::vector< std::vector<double> > &sampMap) {
 
     // Initializations
     vector<Quad *> quadTree;
@@ -305,7 +578,7 @@ namespace Isis {
       // Loop and compute the input coordinates filling the maps
       // until the quad tree is empty
       while (quadTree.size() > 0) {
-        ProcessQuad(quadTree, trans, p_lineMap, p_sampMap);
+        ProcessQuad(quadTree, trans, lineMap, sampMap);
       }
     }
 
@@ -313,8 +586,8 @@ namespace Isis {
     int outputBand = otile.Band();
     for (int i = 0, line = 0; line < p_startQuadSize; line++) {
       for (int samp = 0; samp < p_startQuadSize; samp++, i++) {
-        double inputLine = p_lineMap[line][samp];
-        double inputSamp = p_sampMap[line][samp];
+        double inputLine = lineMap[line][samp];
+        double inputSamp = sampMap[line][samp];
         if (inputLine != NULL8) {
           iportal.SetPosition(inputSamp, inputLine, outputBand);
           InputCubes[0]->read(iportal);
@@ -811,6 +1084,12 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    int threadCount = transformThreadCount();
+    if (threadCount > 1) {
+      threadedPatchTransform(trans, interp, threadCount);
+      return;
+    }
+
     // Create a portal buffer for reading from the input file
     Portal iportal(interp.Samples(), interp.Lines(),
                    InputCubes[0]->pixelType() ,
@@ -861,21 +1140,96 @@ namespace Isis {
         for (int samp = m_patchStartSample;
               samp <= InputCubes[0]->sampleCount();
               samp += m_patchSampleIncrement, p_progress->CheckStatus()) {
+          QList< QSharedPointer<Brick> > patchBricks;
           transformPatch((double)samp, (double)(samp + m_patchSamples - 1),
                          (double)line, (double)(line + m_patchLines - 1),
-                         iportal, trans, interp);
+                         iportal, trans, interp, patchBricks);
+
+          foreach (QSharedPointer<Brick> patchBrick, patchBricks) {
+            writePatch(*patchBrick);
+          }
         }
       }
     }
   }
 
 
-  // Private method to process a small patch of the input cube
+  /**
+   * The threaded version of processPatchTransform. Each thread transforms whole
+   * input patches, and the output bricks of the patches are written in the same
+   * order as processPatchTransform so overlapping patches give the same result.
+   *
+   * @param trans The transform of the first thread
+   * @param interp The interpolator, shared by the threads
+   * @param threadCount The number of threads
+   */
+  void ProcessRubberSheet::threadedPatchTransform(Transform &trans, Interpolator &interp,
+                                                  int threadCount) {
+    // The starting sample and line of each patch in a band
+    QVector<int> patchSamples;
+    QVector<int> patchLines;
+    for (int line = m_patchStartLine; line <= InputCubes[0]->lineCount();
+          line += m_patchLineIncrement) {
+      for (int samp = m_patchStartSample;
+            samp <= InputCubes[0]->sampleCount();
+            samp += m_patchSampleIncrement) {
+        patchSamples.append(samp);
+        patchLines.append(line);
+      }
+    }
+
+    p_progress->SetMaximumSteps(InputCubes[0]->bandCount() * patchSamples.size());
+    p_progress->CheckStatus();
+
+    // The output bricks of each patch, in the order to write them
+    QVector< QList< QSharedPointer<Brick> > > patchBricks(patchSamples.size());
+
+    std::function<void(int item)> write = [&](int item) {
+      foreach (QSharedPointer<Brick> patchBrick, patchBricks[item]) {
+        writePatch(*patchBrick);
+      }
+      patchBricks[item].clear();
+      p_progress->CheckStatus();
+    };
+
+    QVector< QSharedPointer<TransformThread> > threads;
+    for (int band = 1; band <= InputCubes[0]->bandCount(); band++) {
+      if (p_bandChangeFunct != NULL) {
+        p_bandChangeFunct(band);
+        threads.clear();
+      }
+
+      if (threads.isEmpty()) {
+        threads = createTransformThreads(interp, threadCount);
+      }
+
+      foreach (QSharedPointer<TransformThread> state, threads) {
+        state->iportal.SetPosition(1, 1, band);
+      }
+
+      std::function<void(int thread, int item)> transform = [&](int thread, int item) {
+        TransformThread &state = *threads[thread];
+        int samp = patchSamples[item];
+        int line = patchLines[item];
+
+        transformPatch((double)samp, (double)(samp + m_patchSamples - 1),
+                       (double)line, (double)(line + m_patchLines - 1),
+                       state.iportal, *state.transform, interp, patchBricks[item]);
+      };
+
+      runTransformThreads(patchSamples.size(), threadCount, transform, write);
+    }
+  }
+
+
+  // Private method to process a small patch of the input cube. The output
+  // bricks it fills are appended to patchBricks for writePatch().
   void ProcessRubberSheet::transformPatch(double ssamp, double esamp,
                                           double sline, double eline,
                                           Portal &iportal,
                                           Transform &trans,
-                                          Interpolator &interp) {
+                                          Interpolator &interp,
+                                          QList< QSharedPointer<Brick> > &patchBricks) {
     // Let's make sure our patch is contained in the input file
     // TODO:  Think about the image edges should I be adding 0.5
     if (esamp > InputCubes[0]->sampleCount()) {
@@ -935,7 +1289,7 @@ namespace Isis {
 
     // If at least one of the 4 input tile corners did NOT transform, split it
     if (isamps.size() < 4) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
       return;
     }
 
@@ -978,11 +1332,11 @@ namespace Isis {
      */
 
     if (osampMax - osampMin + 1.0 > OutputCubes[0]->sampleCount() * 0.50) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
       return;
     }
     if (olineMax - olineMin + 1.0 > OutputCubes[0]->lineCount() * 0.50) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
       return;
     }
 
@@ -1008,18 +1362,18 @@ namespace Isis {
       ilineLSQ.Solve(LeastSquares::QRD);
     }
     catch (IException &e) {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
       return;
     }
 
     // If the fit at any corner isn't good enough break it down
     for (int i=0; i<isamps.size(); i++) {
       if (fabs(isampLSQ.Residual(i)) > 0.5) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
         return;
       }
       if (fabs(ilineLSQ.Residual(i)) > 0.5) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
         return;
       }
     }
@@ -1042,12 +1396,12 @@ namespace Isis {
       double err = (csamp - isamp) * (csamp - isamp) +
                    (cline - iline) * (cline - iline);
       if (err > 0.25) {
-        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+        splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
         return;
       }
     }
     else {
-      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp);
+      splitPatch(ssamp, esamp, sline, eline, iportal, trans, interp, patchBricks);
       return;
     }
 #endif
@@ -1063,11 +1417,11 @@ namespace Isis {
     // Now we can do our typical backwards geom. Loop over the output cube
     // coordinates and compute input cube coordinates for the corners of the current
     // buffer. The buffer is the same size as the current patch size.
-    Brick oBrick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
-    oBrick.SetBasePosition(osampMin, olineMin, iportal.Band());
+    QSharedPointer<Brick> oBrick(
+        new Brick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1));
+    oBrick->SetBasePosition(osampMin, olineMin, iportal.Band());
 
     int brickIndex = 0;
-    bool foundNull = false;
     for (int oline = olineMin; oline <= olineMax; oline++) {
       double isamp = A * osampMin + B * oline + C;
       double iline = D * osampMin + E * oline + F;
@@ -1078,13 +1432,25 @@ namespace Isis {
         // Now read the data around the input coordinate and interpolate a DN
         iportal.SetPosition(isamp, iline, iportal.Band());
         InputCubes[0]->read(iportal);
-        double dn = interp.Interpolate(isamp, iline, iportal.DoubleBuffer());
-        oBrick[brickIndex] = dn;
-        if (dn == Null) foundNull = true;
+        (*oBrick)[brickIndex] = interp.Interpolate(isamp, iline, iportal.DoubleBuffer());
         brickIndex++;
       }
     }
 
+    patchBricks.append(oBrick);
+  }
+
+
+  // Private method to write an output brick of the patch transform
+  void ProcessRubberSheet::writePatch(Brick &patchBrick) {
+    bool foundNull = false;
+    for (int brickIndex = 0; brickIndex < patchBrick.size(); brickIndex++) {
+      if (patchBrick[brickIndex] == Null) {
+        foundNull = true;
+        break;
+      }
+    }
+
     // If there are any special pixel Null values in this output brick, we may be
     // up against an edge of the input image where the interpolaters get Nulls from
     // outside the image. Since the patches have some overlap due to finding the
@@ -1097,18 +1463,19 @@ namespace Isis {
     // asynchronous write of buffers to the cube, where a race condition may have generated
     // different dns, not bad, but making testing more difficult.
     if (foundNull) {
-      Brick readBrick(*OutputCubes[0], osampMax-osampMin+1, olineMax-olineMin+1, 1);
-      readBrick.SetBasePosition(osampMin, olineMin, iportal.Band());
+      Brick readBrick(*OutputCubes[0], patchBrick.SampleDimension(),
+                      patchBrick.LineDimension(), 1);
+      readBrick.SetBasePosition(patchBrick.Sample(), patchBrick.Line(), patchBrick.Band());
       OutputCubes[0]->read(readBrick);
-      for (brickIndex = 0; brickIndex<(osampMax-osampMin+1)*(olineMax-olineMin+1); brickIndex++) {
+      for (int brickIndex = 0; brickIndex < readBrick.size(); brickIndex++) {
         if (readBrick[brickIndex] != Null) {
-          oBrick[brickIndex] = readBrick[brickIndex];
+          patchBrick[brickIndex] = readBrick[brickIndex];
         }
       }
     }
 
     // Write filled buffer to cube
-    OutputCubes[0]->write(oBrick);
+    OutputCubes[0]->write(patchBrick);
   }
 
 
@@ -1116,7 +1483,8 @@ namespace Isis {
   // process
   void ProcessRubberSheet::splitPatch(double ssamp, double esamp,
                                        double sline, double eline, Portal &iportal,
-                                       Transform &trans, Interpolator &interp) {
+                                       Transform &trans, Interpolator &interp,
+                                       QList< QSharedPointer<Brick> > &patchBricks) {
 
     // Is the input patch too small to even worry about transforming?
     if ((esamp - ssamp < 0.1) && (eline - sline < 0.1)) return;
@@ -1127,16 +1495,16 @@ namespace Isis {
 
     transformPatch(ssamp, midSamp,
                    sline, midLine,
-                   iportal, trans, interp);
+                   iportal, trans, interp, patchBricks);
     transformPatch(midSamp, esamp,
                    sline, midLine,
-                   iportal, trans, interp);
+                   iportal, trans, interp, patchBricks);
     transformPatch(ssamp, midSamp,
                    midLine, eline,
-                   iportal, trans, interp);
+                   iportal, trans, interp, patchBricks);
     transformPatch(midSamp, esamp,
                    midLine, eline,
-                   iportal, trans, interp);
+                   iportal, trans, interp, patchBricks);
 
     return;
   }
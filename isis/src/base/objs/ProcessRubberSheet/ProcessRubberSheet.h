@@ -22,6 +22,12 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <functional>
+
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
+
 #include "Process.h"
 #include "Buffer.h"
 #include "Transform.h"
@@ -31,6 +37,7 @@
 
 namespace Isis {
   class Brick;
+  class Cube;
 
   /**
    * @brief Derivative of Process, designed for geometric transformations
@@ -45,6 +52,14 @@ namespace Isis {
    * an Interpolator object. This class allows only one input cube and one
    * output cube.
    *
+   * Applications whose transform can be recreated may register a transform
+   * factory with setTransformFactory(). The output tiles (StartProcess) or
+   * input patches (processPatchTransform) are then transformed on the global
+   * threads, each thread using its own transform, and written to the output
+   * cube in the same order as the single threaded methods. Only map2map does
+   * this so far; camera transforms (cam2map, map2cam) call CSPICE, which is
+   * not thread safe, so they are processed on one thread.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2002-10-22 Stuart Sides
@@ -113,6 +128,9 @@ namespace Isis {
    *                                            References #2215.
    *   @history 2017-06-09 Christopher Combs - Changed loop counter int in
                                StartProcess to long long int. References #4611.
+   *   @history 2026-10-16 Isis Development Team - Added setTransformFactory() to
+   *                           transform on the global threads. Only map2map uses
+   *                           it; cam2map and map2cam stay on one thread.
    *
    *   @todo 2005-02-11 Stuart Sides - finish documentation and add coded and
    *                        implementation example to class documentation
@@ -135,6 +153,9 @@ namespace Isis {
       // Register a function to be called when the band number changes
       virtual void BandChange(void (*funct)(const int band));
 
+      // Register a function that creates a transform for each thread
+      virtual void setTransformFactory(std::function<Transform *()> transformFactory);
+
       virtual void ForceTile(double Samp, double Line) {
         p_forceSamp = Samp;
         p_forceLine = Line;
@@ -191,7 +212,9 @@ namespace Isis {
                     Transform &trans, Interpolator &interp);
       void QuadTree(TileManager &otile, Portal &iportal,
                     Transform &trans, Interpolator &interp,
-                    bool useLastTileMap);
+                    bool useLastTileMap,
+                    std::vector< std::vector<double> > &lineMap,
+                    std::vector< std::vector<double> > &sampMap);
 
       bool TestLine(Transform &trans, int ssamp, int esamp, int sline,
                     int eline, int increment);
@@ -200,11 +223,46 @@ namespace Isis {
 
       void transformPatch (double startingSample, double endingSample,
                            double startingLine, double endingLine,
-                           Portal &iportal, Transform &trans, Interpolator &interp);
+                           Portal &iportal, Transform &trans, Interpolator &interp,
+                           QList< QSharedPointer<Brick> > &patchBricks);
 
       void splitPatch (double startingSample, double endingSample,
                        double startingLine, double endingLine,
-                       Portal &iportal, Transform &trans, Interpolator &interp);
+                       Portal &iportal, Transform &trans, Interpolator &interp,
+                       QList< QSharedPointer<Brick> > &patchBricks);
+
+      void writePatch(Brick &patchBrick);
+
+      /**
+       * The transform, input portal and tile maps one thread works with.
+       *
+       * @author 2026-10-16 Isis Development Team
+       *
+       * @internal
+       */
+      class TransformThread {
+        public:
+          TransformThread(Transform *trans, Interpolator &interp,
+                          Cube &inputCube, Cube &outputCube, int tileSize);
+          ~TransformThread();
+
+          Transform *transform; //!< The transform of this thread, owned by it
+          Portal iportal;       //!< Reads the input pixels to interpolate
+          TileManager otile;    //!< Positions the output tiles
+          std::vector< std::vector<double> > lineMap; //!< Input lines of the current tile
+          std::vector< std::vector<double> > sampMap; //!< Input samples of the current tile
+      };
+
+      int transformThreadCount() const;
+      QVector< QSharedPointer<TransformThread> > createTransformThreads(Interpolator &interp,
+                                                                        int threadCount);
+      void runTransformThreads(int itemCount, int threadCount,
+                               std::function<void(int thread, int item)> transform,
+                               std::function<void(int item)> write);
+
+      void threadedStartProcess(Transform &trans, Interpolator &interp, int threadCount);
+      void threadedPatchTransform(Transform &trans, Interpolator &interp, int threadCount);
+
 #if 0
       void transformPatch (double startingSample, double endingSample,
                            double startingLine, double endingLine);
@@ -229,6 +287,9 @@ namespace Isis {
       int m_patchSampleIncrement;
       int m_patchLineIncrement;
 
+      //! Creates the transforms of the threads after the first, if set
+      std::function<Transform *()> m_transformFactory;
+
 #if 0
       Portal *m_iportal;
       Brick *m_obrick;
@@ -33,6 +33,24 @@
 
 using namespace std;
 
+namespace {
+  /**
+   * Checks a name for whitespace. Keyword names can not contain whitespace,
+   * so lookups of such names skip the keyword index and go through
+   * PvlKeyword, which reports the bad name.
+   *
+   * @param name The name to check
+   *
+   * @return bool True if the name contains whitespace
+   */
+  bool hasWhiteSpace(const QString &name) {
+    for (int i = 0; i < name.size(); i++) {
+      if (name[i].isSpace()) return true;
+    }
+    return false;
+  }
+}
+
 namespace Isis {
 
   /**
@@ -76,8 +94,8 @@ namespace Isis {
    * @throws iException::Pvl The keyword doesn't exist.
    */
   Isis::PvlKeyword &PvlContainer::findKeyword(const QString &name) {
-    PvlKeywordIterator key = findKeyword(name, begin(), end());
-    if(key == end()) {
+    PvlKeywordIterator key = findKeyword(name, m_keywords.begin(), m_keywords.end());
+    if(key == m_keywords.end()) {
       QString msg = "PVL Keyword [" + name + "] does not exist in [" +
                    type() + " = " + this->name() + "]";
       if(m_filename.size() > 0) msg += " in file [" + m_filename + "]";
@@ -111,8 +129,8 @@ namespace Isis {
    * @throws iException::Pvl Keyword doesn't exist.
    */
   void PvlContainer::deleteKeyword(const QString &name) {
-    PvlKeywordIterator key = findKeyword(name, begin(), end());
-    if(key == end()) {
+    PvlKeywordIterator key = findKeyword(name, m_keywords.begin(), m_keywords.end());
+    if(key == m_keywords.end()) {
       QString msg = "PVL Keyword [" + name + "] does not exist in [" +
                    type() + " = " + this->name() + "]";
       if(m_filename.size() > 0) msg += " in file [" + m_filename + "]";
@@ -120,6 +138,7 @@ namespace Isis {
     }
 
     m_keywords.erase(key);
+    m_keywordIndex.invalidate();
   }
 
 
@@ -136,10 +155,11 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
-    PvlKeywordIterator key = begin();
+    PvlKeywordIterator key = m_keywords.begin();
     for(int i = 0; i < index; i++) key++;
 
     m_keywords.erase(key);
+    m_keywordIndex.invalidate();
   }
 
 
@@ -155,7 +175,7 @@ namespace Isis {
     for(int index = 0; index < m_keywords.size(); index ++) {
       PvlKeyword &current = m_keywords[index];
 
-      for(PvlKeywordIterator key = begin() + index + 1; key < end(); key ++) {
+      for(PvlKeywordIterator key = m_keywords.begin() + index + 1; key < m_keywords.end(); key ++) {
         if(current == *key) {
           key = m_keywords.erase(key);
           keywordDeleted = true;
@@ -163,6 +183,8 @@ namespace Isis {
       }
     }
 
+    if(keywordDeleted) m_keywordIndex.invalidate();
+
     return keywordDeleted;
   }
 
@@ -190,7 +212,7 @@ namespace Isis {
       QString msg = Message::ArraySubscriptNotInRange(index);
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
-    return *(m_keywords.begin() + index);
+    return m_keywordIndex.watch(m_keywords[index]);
   };
 
 
@@ -219,6 +241,7 @@ namespace Isis {
                                 const InsertMode mode) {
     if(mode == Append) {
       m_keywords.push_back(key);
+      m_keywordIndex.append(key, m_keywords.size());
     }
     else if(hasKeyword(key.name())) {
       Isis::PvlKeyword &outkey = findKeyword(key.name());
@@ -226,6 +249,7 @@ namespace Isis {
     }
     else {
       m_keywords.push_back(key);
+      m_keywordIndex.append(key, m_keywords.size());
     }
   }
 
@@ -248,7 +272,10 @@ namespace Isis {
    */
   PvlContainer::PvlKeywordIterator PvlContainer::addKeyword(const Isis::PvlKeyword &key,
       PvlKeywordIterator pos) {
-    return (m_keywords.insert(pos, key));
+    m_keywordIndex.invalidate();
+    PvlKeywordIterator inserted = m_keywords.insert(pos, key);
+    m_keywordIndex.watch(*inserted);
+    return inserted;
   }
 
   /**
@@ -358,7 +385,8 @@ namespace Isis {
 
 
   /**
-   * Find the index of a keyword, using iterators.
+   * Find the index of a keyword, using iterators. Searches of the whole
+   * container use the keyword index, which watches the keyword found.
    * @param name The name of the keyword.
    * @param beg The beginning iterator.
    * @param end The ending iterator.
@@ -367,13 +395,24 @@ namespace Isis {
   PvlContainer::PvlKeywordIterator PvlContainer::findKeyword(const QString &name,
       PvlContainer::PvlKeywordIterator beg,
       PvlContainer::PvlKeywordIterator end) {
-    PvlKeyword temp(name);
-    return find(beg, end, temp);
+    PvlKeywordIterator key;
+    if (beg == m_keywords.begin() && end == m_keywords.end() && !hasWhiteSpace(name)) {
+      int index = m_keywordIndex.indexOf(name, m_keywords);
+      key = (index < 0) ? end : beg + index;
+    }
+    else {
+      PvlKeyword temp(name);
+      key = find(beg, end, temp);
+    }
+
+    if (key != end) m_keywordIndex.watch(*key);
+    return key;
   };
 
 
   /**
-   * Find the index of a keyword, using iterators.
+   * Find the index of a keyword, using iterators. Searches of the whole
+   * container use the keyword index.
    * @param name The name of the keyword.
    * @param beg The beginning iterator.
    * @param end The ending iterator.
@@ -382,6 +421,11 @@ namespace Isis {
   PvlContainer::ConstPvlKeywordIterator PvlContainer::findKeyword(const QString &name,
       PvlContainer::ConstPvlKeywordIterator beg,
       PvlContainer::ConstPvlKeywordIterator end) const {
+    if (beg == begin() && end == this->end() && !hasWhiteSpace(name)) {
+      int index = m_keywordIndex.indexOf(name, m_keywords);
+      return (index < 0) ? end : beg + index;
+    }
+
     PvlKeyword temp(name);
     return find(beg, end, temp);
   };
@@ -390,8 +434,13 @@ namespace Isis {
   //! This is an assignment operator
   const PvlContainer &PvlContainer::operator=(const PvlContainer &other) {
     m_filename = other.m_filename;
+    if (m_name.size() != other.m_name.size() ||
+        (m_name.size() > 0 && m_name[0] != other.m_name[0])) {
+      m_indexMember.renamed();
+    }
     m_name = other.m_name;
     m_keywords = other.m_keywords;
+    m_keywordIndex.invalidate();
     m_formatTemplate = other.m_formatTemplate;
 
     return *this;
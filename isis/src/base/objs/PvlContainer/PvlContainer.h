@@ -21,6 +21,7 @@
  */
 
 #include "PvlKeyword.h"
+#include "PvlNameIndex.h"
 
 template<typename T> class QList;
 
@@ -68,6 +69,7 @@ namespace Isis {
 
       //! Set the name of the container.
       void setName(const QString &name) {
+        if (m_name.size() == 0 || m_name[0] != name) m_indexMember.renamed();
         m_name.setValue(name);
       };
       /**
@@ -104,6 +106,7 @@ namespace Isis {
       //! Clears PvlKeywords
       void clear() {
         m_keywords.clear();
+        m_keywordIndex.invalidate();
       };
       //! Contains both modes: Append or Replace.
       enum InsertMode { Append, Replace };
@@ -186,10 +189,12 @@ namespace Isis {
                                     PvlKeywordIterator pos);
 
       /**
-       * Return the beginning iterator.
+       * Return the beginning iterator. The keywords can be renamed through
+       * it, so the keyword index watches all of them.
        * @return The beginning iterator.
        */
       PvlKeywordIterator begin() {
+        m_keywordIndex.watchAll(m_keywords);
         return m_keywords.begin();
       };
 
@@ -294,6 +299,8 @@ namespace Isis {
       const PvlContainer &operator=(const PvlContainer &other);
 
     protected:
+      friend class PvlNameIndex;
+
       QString m_filename;                   /**<This contains the filename
                                                     used to initialize
                                                     the pvl object. If the
@@ -304,6 +311,10 @@ namespace Isis {
       QList<PvlKeyword> m_keywords; /**<This is the vector of
                                                     PvlKeywords the container is
                                                     holding. */
+      PvlNameIndex m_keywordIndex;  //!< Finds keywords in m_keywords by name
+
+      //! Tells the index of the object this container is in about renames
+      PvlNameIndex::Member m_indexMember;
 
       void init();
 
@@ -142,6 +142,7 @@ namespace Isis {
     }
 
     if (m_name) {
+      if (final != m_name) m_indexMember.renamed();
       delete [] m_name;
       m_name = NULL;
     }
@@ -1839,6 +1840,7 @@ namespace Isis {
       m_formatter = other.m_formatter;
 
       if (m_name) {
+        if (!other.m_name || strcmp(m_name, other.m_name) != 0) m_indexMember.renamed();
         delete [] m_name;
         m_name = NULL;
       }
@@ -32,6 +32,7 @@
 
 #include "Constants.h"
 #include "IString.h"
+#include "PvlNameIndex.h"
 
 namespace Isis {
   class PvlSequence;
@@ -270,9 +271,14 @@ namespace Isis {
       PvlFormat *m_formatter;
 
     private:
+      friend class PvlNameIndex;
+
       //! The keyword's name... This is a c-string for memory efficiency
       char * m_name;
 
+      //! Tells the index of the container this keyword is in about renames
+      PvlNameIndex::Member m_indexMember;
+
       /**
        * The values in the keyword. This is a QVarLengthArray purely for
        *   optimization purposes. The amount of memory consumed by other data
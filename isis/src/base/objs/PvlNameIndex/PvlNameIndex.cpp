@@ -0,0 +1,149 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+#include "PvlNameIndex.h"
+
+#include <cctype>
+
+#include "PvlContainer.h"
+#include "PvlKeyword.h"
+
+namespace Isis {
+
+  //! Constructs an empty index
+  PvlNameIndex::PvlNameIndex() {
+    m_valid = false;
+    m_items = 0;
+    m_builtAt = 0;
+    m_renames = new RenameCount;
+  }
+
+
+  /**
+   * Constructs an empty index. Indexes are never copied because they belong
+   *   to a particular list, and neither is the rename count of the members
+   *   the other index watches.
+   *
+   * @param other Not used
+   */
+  PvlNameIndex::PvlNameIndex(const PvlNameIndex &other) {
+    m_valid = false;
+    m_items = 0;
+    m_builtAt = 0;
+    m_renames = new RenameCount;
+  }
+
+
+  //! Destroys the index
+  PvlNameIndex::~PvlNameIndex() {
+  }
+
+
+  /**
+   * Invalidates the index, which happens whenever its owner's list is
+   *   assigned.
+   *
+   * @param other Not used
+   *
+   * @return PvlNameIndex& This index
+   */
+  PvlNameIndex &PvlNameIndex::operator=(const PvlNameIndex &other) {
+    invalidate();
+    return *this;
+  }
+
+
+  /**
+   * Throws the index away. The owner must call this whenever it adds, removes
+   *   or reorders members of its list.
+   */
+  void PvlNameIndex::invalidate() {
+    QMutexLocker locker(&m_mutex);
+    m_valid = false;
+    m_index.clear();
+  }
+
+
+  /**
+   * Gets the name a keyword is indexed by.
+   *
+   * @param item The keyword
+   * @param name Set to the keyword name
+   *
+   * @return bool Always true, keywords always have a name
+   */
+  bool PvlNameIndex::memberName(const PvlKeyword &item, QString &name) {
+    name = item.name();
+    return true;
+  }
+
+
+  /**
+   * Gets the name a group or object is indexed by. Containers that were
+   *   constructed without a name are not indexed, since they can not be
+   *   found by name.
+   *
+   * @param item The group or object
+   * @param name Set to the container name if it has one
+   *
+   * @return bool Whether the container has a name
+   */
+  bool PvlNameIndex::memberName(const PvlContainer &item, QString &name) {
+    if (item.m_name.size() == 0) return false;
+
+    name = item.m_name[0];
+    return true;
+  }
+
+
+  /**
+   * Folds a name the way PvlKeyword::stringEqual compares names: whitespace,
+   *   spaces and underscores are removed and letters are upper cased. Two
+   *   names are equal under stringEqual exactly when their folded names are
+   *   equal.
+   *
+   * @param name The name to fold
+   *
+   * @return QByteArray The folded name
+   */
+  QByteArray PvlNameIndex::fold(const QString &name) {
+    QByteArray bytes = name.toUtf8();
+    QByteArray folded;
+    folded.reserve(bytes.size());
+
+    for (int i = 0; i < bytes.size(); i++) {
+      char c = bytes[i];
+      switch (c) {
+        case ' ':
+        case '_':
+        case '\n':
+        case '\r':
+        case '\t':
+        case '\f':
+        case '\v':
+        case '\b':
+          break;
+        default:
+          folded.append((char) toupper((unsigned char) c));
+      }
+    }
+
+    return folded;
+  }
+}
@@ -0,0 +1,251 @@
+#ifndef PvlNameIndex_h
+#define PvlNameIndex_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QExplicitlySharedDataPointer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedData>
+#include <QString>
+
+namespace Isis {
+  class PvlContainer;
+  class PvlKeyword;
+
+  /**
+   * @brief A lazily built name index for the members of a Pvl container
+   *
+   * PvlContainer keeps its keywords, and PvlObject its groups and objects, in
+   *   lists that were searched from the front with PvlKeyword::stringEqual for
+   *   every lookup. This maps the names of the members of a list, folded the
+   *   same way stringEqual compares them (whitespace and underscores removed,
+   *   upper case), to the position of the first member with that name.
+   *
+   * The index is built by the first lookup in a list with at least
+   *   MinimumItems members. Members added to the end of the list are added to
+   *   the index with append(); any other change makes the owner call
+   *   invalidate(). Members can also be renamed through the references the
+   *   owner hands out, so the owner passes every member it hands out to
+   *   watch(). That gives the member the index's rename count, which
+   *   PvlKeyword::setName, PvlContainer::setName and their assignment operators
+   *   bump through Member::renamed(). Only the index of the list the renamed
+   *   member is in rebuilds on its next lookup. Lists smaller than
+   *   MinimumItems are searched from the front like before.
+   *
+   * Lookups are thread safe, so const Pvl objects can still be searched by
+   *   several threads at once.
+   *
+   * @ingroup Parsing
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class PvlNameIndex {
+    private:
+      //! The number of renames of the members of one list
+      class RenameCount : public QSharedData {
+        public:
+          QAtomicInt count; //!< Bumped by every rename
+      };
+
+    public:
+      /**
+       * The part of a keyword or container that tells the index of the list it
+       *   is in that it was renamed. Copies are not in the list, so they start
+       *   out without an index, and assigning a member keeps the index of the
+       *   position it is assigned to.
+       */
+      class Member {
+        public:
+          //! Constructs a member that is not watched by any index
+          Member() {
+          }
+
+          //! Constructs a member that is not watched by any index
+          Member(const Member &other) {
+          }
+
+          //! Keeps the index this member is watched by
+          Member &operator=(const Member &other) {
+            return *this;
+          }
+
+          //! Makes the index watching this member rebuild on its next lookup
+          void renamed() const {
+            if (m_renames) m_renames->count.fetchAndAddOrdered(1);
+          }
+
+        private:
+          friend class PvlNameIndex;
+
+          /**
+           * The rename count of the index watching this member. It is shared
+           *   so that a member can outlive the index, which happens when lists
+           *   that were implicitly shared detach.
+           */
+          QExplicitlySharedDataPointer<RenameCount> m_renames;
+      };
+
+      PvlNameIndex();
+      PvlNameIndex(const PvlNameIndex &other);
+      ~PvlNameIndex();
+
+      PvlNameIndex &operator=(const PvlNameIndex &other);
+
+      void invalidate();
+
+      template <typename T>
+      void append(const T &item, int size);
+
+      template <typename T>
+      int indexOf(const QString &name, const QList<T> &items) const;
+
+      /**
+       * Watches a member the owner is handing out a reference to, so renaming
+       *   it invalidates this index.
+       *
+       * @param item A member of the list this index belongs to. It must have
+       *             a PvlNameIndex::Member named m_indexMember.
+       *
+       * @return T& The member
+       */
+      template <typename T>
+      T &watch(T &item) const {
+        if (item.m_indexMember.m_renames != m_renames) {
+          item.m_indexMember.m_renames = m_renames;
+        }
+        return item;
+      }
+
+      template <typename T>
+      void watchAll(QList<T> &items) const;
+
+      static QByteArray fold(const QString &name);
+
+      //! The smallest list that is indexed
+      static const int MinimumItems = 8;
+
+    private:
+      static bool memberName(const PvlKeyword &item, QString &name);
+      static bool memberName(const PvlContainer &item, QString &name);
+
+      mutable QMutex m_mutex;                  //!< Guards the index during lookups
+      mutable QHash<QByteArray, int> m_index;  //!< Folded names to their first position
+      mutable bool m_valid;                    //!< Whether the index has been built
+      mutable int m_items;                     //!< The list size the index was built for
+      mutable int m_builtAt;                   //!< The rename count the index was built at
+
+      //! Counts renames of the members handed out by the owner
+      QExplicitlySharedDataPointer<RenameCount> m_renames;
+  };
+
+
+  /**
+   * Watches every member of a list, for owners handing out iterators.
+   *
+   * @param items The list this index belongs to
+   */
+  template <typename T>
+  void PvlNameIndex::watchAll(QList<T> &items) const {
+    for (int i = 0; i < items.size(); i++) {
+      watch(items[i]);
+    }
+  }
+
+
+  /**
+   * Adds a member that was appended to the owner's list, so that building
+   *   labels one keyword at a time does not rebuild the index for every lookup.
+   *
+   * @param item The new member
+   * @param size The size of the list after the member was appended
+   */
+  template <typename T>
+  void PvlNameIndex::append(const T &item, int size) {
+    QString name;
+    bool named = memberName(item, name);
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_valid) return;
+
+    if (m_items != size - 1) {
+      m_valid = false;
+      m_index.clear();
+      return;
+    }
+
+    if (named) {
+      QByteArray key = fold(name);
+      if (!m_index.contains(key)) m_index.insert(key, size - 1);
+    }
+    m_items = size;
+  }
+
+
+  /**
+   * Finds the first member of a list with the given name, building the index
+   *   if it is missing or out of date.
+   *
+   * @param name The name to look for
+   * @param items The list the index belongs to. Its members must be
+   *              keywords or containers.
+   *
+   * @return int The position of the first member with the name, or -1 if there
+   *             is none
+   */
+  template <typename T>
+  int PvlNameIndex::indexOf(const QString &name, const QList<T> &items) const {
+    if (items.size() < MinimumItems) {
+      for (int i = 0; i < items.size(); i++) {
+        if (items[i].isNamed(name)) return i;
+      }
+      return -1;
+    }
+
+    QByteArray key = fold(name);
+
+    QMutexLocker locker(&m_mutex);
+    int renames = m_renames->count.loadAcquire();
+    if (!m_valid || m_items != items.size() || m_builtAt != renames) {
+      m_index.clear();
+      m_index.reserve(items.size());
+
+      // Go backwards so that the first of several members with a name wins
+      QString itemName;
+      for (int i = items.size() - 1; i >= 0; i--) {
+        if (memberName(items[i], itemName)) m_index.insert(fold(itemName), i);
+      }
+
+      m_valid = true;
+      m_items = items.size();
+      m_builtAt = renames;
+    }
+
+    return m_index.value(key, -1);
+  }
+}
+
+#endif
@@ -121,9 +121,9 @@ namespace Isis {
     while(searchList.size() > 0) {
       PvlGroupIterator it =
         searchList[0]->findGroup(name,
-                                 searchList[0]->beginGroup(),
-                                 searchList[0]->endGroup());
-      if(it != searchList[0]->endGroup()) return *it;
+                                 searchList[0]->m_groups.begin(),
+                                 searchList[0]->m_groups.end());
+      if(it != searchList[0]->m_groups.end()) return *it;
       if(opts == Traverse) {
         for(int i = 0; i < searchList[0]->objects(); i++) {
           searchList.push_back(&searchList[0]->object(i));
@@ -202,20 +202,17 @@ namespace Isis {
 
     while(searchList.size() > 0) {
       PvlKeywordIterator it =
-        searchList[0]->findKeyword(kname, searchList[0]->begin(),
-                                   searchList[0]->end());
-      if(it != searchList[0]->end()) {
+        searchList[0]->findKeyword(kname, searchList[0]->m_keywords.begin(),
+                                   searchList[0]->m_keywords.end());
+      if(it != searchList[0]->m_keywords.end()) {
         return *it;
       }
 
       // See if the keyword is inside a Group of this Object
       for(int g = 0; g < searchList[0]->groups(); g++) {
-        PvlKeywordIterator it =
-          searchList[0]->group(g).findKeyword(kname,
-                                              searchList[0]->group(g).begin(),
-                                              searchList[0]->group(g).end());
-        if(it != searchList[0]->group(g).end()) {
-          return *it;
+        PvlGroup &group = searchList[0]->group(g);
+        if(group.hasKeyword(kname)) {
+          return group.findKeyword(kname);
         }
       }
 
@@ -310,9 +307,9 @@ namespace Isis {
     while(searchList.size() > 0) {
       PvlObjectIterator it =
         searchList[0]->findObject(name,
-                                  searchList[0]->beginObject(),
-                                  searchList[0]->endObject());
-      if(it != searchList[0]->endObject()) return *it;
+                                  searchList[0]->m_objects.begin(),
+                                  searchList[0]->m_objects.end());
+      if(it != searchList[0]->m_objects.end()) return *it;
       if(opts == Traverse) {
         for(int i = 0; i < searchList[0]->objects(); i++) {
           searchList.push_back(&searchList[0]->object(i));
@@ -379,8 +376,8 @@ namespace Isis {
    * @throws IException
    */
   void PvlObject::deleteObject(const QString &name) {
-    PvlObjectIterator key = findObject(name, beginObject(), endObject());
-    if(key == endObject()) {
+    PvlObjectIterator key = findObject(name, m_objects.begin(), m_objects.end());
+    if(key == m_objects.end()) {
       QString msg = "Unable to find PVL object [" + name + "] in " + type() +
                    " [" + this->name() + "]";
       if(m_filename.size() > 0) msg += " in file [" + m_filename + "]";
@@ -388,6 +385,7 @@ namespace Isis {
     }
 
     m_objects.erase(key);
+    m_objectIndex.invalidate();
   }
 
 
@@ -406,10 +404,11 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
-    PvlObjectIterator key = beginObject();
+    PvlObjectIterator key = m_objects.begin();
     for(int i = 0; i < index; i++)  key++;
 
     m_objects.erase(key);
+    m_objectIndex.invalidate();
   }
 
 
@@ -421,8 +420,8 @@ namespace Isis {
    * @throws IException
    */
   void PvlObject::deleteGroup(const QString &name) {
-    PvlGroupIterator key = findGroup(name, beginGroup(), endGroup());
-    if(key == endGroup()) {
+    PvlGroupIterator key = findGroup(name, m_groups.begin(), m_groups.end());
+    if(key == m_groups.end()) {
       QString msg = "Unable to find PVL group [" + name + "] in " + type() +
                    " [" + this->name() + "]";
       if(m_filename.size() > 0) msg += " in file [" + m_filename + "]";
@@ -430,6 +429,7 @@ namespace Isis {
     }
 
     m_groups.erase(key);
+    m_groupIndex.invalidate();
   }
 
 
@@ -448,10 +448,11 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
-    PvlGroupIterator key = beginGroup();
+    PvlGroupIterator key = m_groups.begin();
     for(int i = 0; i < index; i++)  key++;
 
     m_groups.erase(key);
+    m_groupIndex.invalidate();
   }
 
 
@@ -470,7 +471,7 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    return m_groups[index];
+    return m_groupIndex.watch(m_groups[index]);
   }
 
 
@@ -507,7 +508,7 @@ namespace Isis {
       throw IException(Isis::IException::Programmer, msg, _FILEINFO_);
     }
 
-    return m_objects[index];
+    return m_objectIndex.watch(m_objects[index]);
   }
 
   /**
@@ -838,6 +839,8 @@ namespace Isis {
 
     m_objects = other.m_objects;
     m_groups = other.m_groups;
+    m_objectIndex.invalidate();
+    m_groupIndex.invalidate();
 
     return *this;
   }
@@ -101,10 +101,12 @@ namespace Isis {
 
 
       /**
-       * Returns the beginning group index.
+       * Returns the beginning group index. The groups can be renamed through
+       * it, so the group index watches all of them.
        * @return The iterator of the beginning group..
        */
       PvlGroupIterator beginGroup() {
+        m_groupIndex.watchAll(m_groups);
         return m_groups.begin();
       };
 
@@ -145,8 +147,18 @@ namespace Isis {
       PvlGroupIterator findGroup(const QString &name,
                                  PvlGroupIterator beg,
                                  PvlGroupIterator end) {
-        Isis::PvlGroup temp(name);
-        return std::find(beg, end, temp);
+        PvlGroupIterator found;
+        if (beg == m_groups.begin() && end == m_groups.end()) {
+          int index = m_groupIndex.indexOf(name, m_groups);
+          found = (index < 0) ? end : beg + index;
+        }
+        else {
+          Isis::PvlGroup temp(name);
+          found = std::find(beg, end, temp);
+        }
+
+        if (found != end) m_groupIndex.watch(*found);
+        return found;
       }
 
 
@@ -159,6 +171,10 @@ namespace Isis {
       ConstPvlGroupIterator findGroup(const QString &name,
                                       ConstPvlGroupIterator beg,
                                       ConstPvlGroupIterator end) const {
+        if (beg == beginGroup() && end == endGroup()) {
+          int index = m_groupIndex.indexOf(name, m_groups);
+          return (index < 0) ? end : beg + index;
+        }
         Isis::PvlGroup temp(name);
         return std::find(beg, end, temp);
       }
@@ -201,6 +217,7 @@ namespace Isis {
        */
       void addGroup(const Isis::PvlGroup &group) {
         m_groups.push_back(group);
+        m_groupIndex.append(group, m_groups.size());
         //m_groups[m_groups.size()-1].SetFileName(FileName());
       };
 
@@ -245,10 +262,12 @@ namespace Isis {
 
 
       /**
-       * Returns the index of the beginning object.
+       * Returns the index of the beginning object. The objects can be renamed
+       * through it, so the object index watches all of them.
        * @return The beginning object's index.
        */
       PvlObjectIterator beginObject() {
+        m_objectIndex.watchAll(m_objects);
         return m_objects.begin();
       };
 
@@ -290,8 +309,18 @@ namespace Isis {
       PvlObjectIterator findObject(const QString &name,
                                    PvlObjectIterator beg,
                                    PvlObjectIterator end) {
-        PvlObject temp(name);
-        return std::find(beg, end, temp);
+        PvlObjectIterator found;
+        if (beg == m_objects.begin() && end == m_objects.end()) {
+          int index = m_objectIndex.indexOf(name, m_objects);
+          found = (index < 0) ? end : beg + index;
+        }
+        else {
+          PvlObject temp(name);
+          found = std::find(beg, end, temp);
+        }
+
+        if (found != end) m_objectIndex.watch(*found);
+        return found;
       }
 
 
@@ -305,6 +334,10 @@ namespace Isis {
       ConstPvlObjectIterator findObject(const QString &name,
                                         ConstPvlObjectIterator beg,
                                         ConstPvlObjectIterator end) const {
+        if (beg == beginObject() && end == endObject()) {
+          int index = m_objectIndex.indexOf(name, m_objects);
+          return (index < 0) ? end : beg + index;
+        }
         PvlObject temp(name);
         return std::find(beg, end, temp);
       }
@@ -322,6 +355,7 @@ namespace Isis {
        */
       void addObject(const PvlObject &object) {
         m_objects.push_back(object);
+        m_objectIndex.append(object, m_objects.size());
         m_objects[m_objects.size()-1].setFileName(fileName());
       }
 
@@ -358,6 +392,8 @@ namespace Isis {
         Isis::PvlContainer::clear();
         m_objects.clear();
         m_groups.clear();
+        m_objectIndex.invalidate();
+        m_groupIndex.invalidate();
       }
 
       const PvlObject &operator=(const PvlObject &other);
@@ -370,6 +406,8 @@ namespace Isis {
                                                 in the current PvlObject. */
       QList<PvlGroup> m_groups;/**<A vector of PvlGroups contained
                                                 in the current PvlObject. */
+      PvlNameIndex m_objectIndex; //!< Finds objects in m_objects by name
+      PvlNameIndex m_groupIndex;  //!< Finds groups in m_groups by name
   };
 }
 
@@ -0,0 +1,417 @@
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:09 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "RankFilter.h"
+
+#include <algorithm>
+#include <float.h>
+
+#include "IException.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+namespace Isis {
+
+  /**
+   * Constructs a RankFilter with no lines loaded. Because this is a line based
+   * filtering object, the number of samples and the boxcar size must be given
+   * to the constructor.
+   *
+   * @param ns Number of samples in a line
+   * @param width Width of the boxcar (must be odd)
+   * @param height Height of the boxcar (must be odd)
+   *
+   * @throws Isis::IException::Programmer
+   */
+  RankFilter::RankFilter(const int ns, const int width, const int height) {
+    if (ns <= 0) {
+      string msg = "Invalid value for [ns] in RankFilter constructor";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (width < 1 || (width % 2) == 0) {
+      string msg = "[Width] must be odd and greater than or equal to one in "
+                   "RankFilter constructor";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (height < 1 || (height % 2) == 0) {
+      string msg = "[Height] must be odd and greater than or equal to one in "
+                   "RankFilter constructor";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_ns = ns;
+    m_width = width;
+    m_halfWidth = width / 2;
+    m_height = height;
+    m_halfHeight = height / 2;
+    m_minimum = -DBL_MAX;
+    m_maximum = DBL_MAX;
+    m_leaves = 0;
+    m_built = false;
+    m_lastIndex = -1;
+  }
+
+
+  //! Destroys the RankFilter
+  RankFilter::~RankFilter() {
+  }
+
+
+  /**
+   * Sets the range of valid pixel values, inclusive. Pixels are only counted
+   * if they are not special and fall within the range. If this is never called
+   * all non-special pixels are valid.
+   *
+   * @param minimum Minimum valid pixel
+   * @param maximum Maximum valid pixel
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void RankFilter::SetMinMax(const double minimum, const double maximum) {
+    if (minimum > maximum) {
+      string msg = "Minimum must not be greater than maximum in [RankFilter::SetMinMax]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_minimum = minimum;
+    m_maximum = maximum;
+    m_built = false;
+  }
+
+
+  /**
+   * Adds a line to the bottom of the boxcar. The line is copied.
+   *
+   * @param buf The line, which must have as many samples as the filter
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void RankFilter::AddLine(const double *buf) {
+    if ((int) m_lines.size() >= m_height) {
+      string msg = "Number of lines added exceeds boxcar height ... "
+                   "use RemoveLine before AddLine";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_lines.push_back(vector<double>(buf, buf + m_ns));
+    m_built = false;
+  }
+
+
+  /**
+   * Removes the line at the top of the boxcar, which is the oldest line added.
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void RankFilter::RemoveLine() {
+    if (m_lines.empty()) {
+      string msg = "There are no lines to remove from the boxcar";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_lines.erase(m_lines.begin());
+    m_built = false;
+  }
+
+
+  //! Removes all lines from the boxcar
+  void RankFilter::Reset() {
+    m_lines.clear();
+    m_built = false;
+  }
+
+
+  /**
+   * Returns the number of valid pixels in the boxcar around a sample.
+   *
+   * @param index The sample index, from zero
+   *
+   * @return int
+   */
+  int RankFilter::Count(const int index) {
+    Compute(index);
+    return m_counts[1];
+  }
+
+
+  /**
+   * Returns a valid pixel in the boxcar around a sample by its rank, which is
+   * its position if the valid pixels were sorted.
+   *
+   * @param index The sample index, from zero
+   * @param rank The rank, from zero for the smallest pixel
+   *
+   * @return double The pixel, or Null if there are not that many valid pixels
+   */
+  double RankFilter::Rank(const int index, const int rank) {
+    Compute(index);
+    if (rank < 0 || rank >= m_counts[1]) return Null;
+
+    int remaining = rank;
+    int node = 1;
+    while (node < m_leaves) {
+      int left = 2 * node;
+      if (m_counts[left] > remaining) {
+        node = left;
+      }
+      else {
+        remaining -= m_counts[left];
+        node = left + 1;
+      }
+    }
+
+    return m_values[node - m_leaves];
+  }
+
+
+  /**
+   * Returns the median of the valid pixels in the boxcar around a sample. For
+   * an even number of pixels this is the lower of the two middle pixels.
+   *
+   * @param index The sample index, from zero
+   *
+   * @return double The median, or Null if there are no valid pixels
+   */
+  double RankFilter::Median(const int index) {
+    Compute(index);
+    return Rank(index, (m_counts[1] - 1) / 2);
+  }
+
+
+  /**
+   * Returns the most common valid pixel in the boxcar around a sample. When
+   * several pixel values are equally common the smallest one is returned.
+   *
+   * @param index The sample index, from zero
+   *
+   * @return double The mode, or Null if there are no valid pixels
+   */
+  double RankFilter::Mode(const int index) {
+    Compute(index);
+    if (m_counts[1] == 0) return Null;
+    return m_values[m_maxLeaves[1]];
+  }
+
+
+  /**
+   * Returns how many times the mode occurs in the boxcar around a sample.
+   *
+   * @param index The sample index, from zero
+   *
+   * @return int
+   */
+  int RankFilter::ModeCount(const int index) {
+    Compute(index);
+    return m_maxCounts[1];
+  }
+
+
+  /**
+   * Returns the width of the boxcar
+   *
+   * @return int
+   */
+  int RankFilter::Width() const {
+    return m_width;
+  }
+
+
+  /**
+   * Returns half the width of the boxcar rounded down
+   *
+   * @return int
+   */
+  int RankFilter::HalfWidth() const {
+    return m_halfWidth;
+  }
+
+
+  /**
+   * Returns the height of the boxcar
+   *
+   * @return int
+   */
+  int RankFilter::Height() const {
+    return m_height;
+  }
+
+
+  /**
+   * Returns half the height of the boxcar rounded down
+   *
+   * @return int
+   */
+  int RankFilter::HalfHeight() const {
+    return m_halfHeight;
+  }
+
+
+  /**
+   * Returns the number of samples in a line
+   *
+   * @return int
+   */
+  int RankFilter::Samples() const {
+    return m_ns;
+  }
+
+
+  /**
+   * Returns the lowest valid pixel value
+   *
+   * @return double
+   */
+  double RankFilter::Low() const {
+    return m_minimum;
+  }
+
+
+  /**
+   * Returns the highest valid pixel value
+   *
+   * @return double
+   */
+  double RankFilter::High() const {
+    return m_maximum;
+  }
+
+
+  /**
+   * Checks if a pixel counts toward the statistics
+   *
+   * @param value The pixel
+   *
+   * @return bool
+   */
+  bool RankFilter::IsValid(const double value) const {
+    return IsValidPixel(value) && value >= m_minimum && value <= m_maximum;
+  }
+
+
+  /**
+   * Sorts the valid pixels of the loaded lines and sets up an empty tree of
+   * counts over them.
+   */
+  void RankFilter::Build() {
+    m_values.clear();
+    for (unsigned int line = 0; line < m_lines.size(); line++) {
+      for (int samp = 0; samp < m_ns; samp++) {
+        if (IsValid(m_lines[line][samp])) m_values.push_back(m_lines[line][samp]);
+      }
+    }
+
+    sort(m_values.begin(), m_values.end());
+    m_values.erase(unique(m_values.begin(), m_values.end()), m_values.end());
+
+    m_leaves = 1;
+    while (m_leaves < (int) m_values.size()) m_leaves *= 2;
+
+    ClearCounts();
+    m_built = true;
+  }
+
+
+  //! Empties the boxcar without changing the sorted pixel values
+  void RankFilter::ClearCounts() {
+    m_counts.assign(2 * m_leaves, 0);
+    m_maxCounts.assign(2 * m_leaves, 0);
+    m_maxLeaves.resize(2 * m_leaves);
+    for (int leaf = 0; leaf < m_leaves; leaf++) {
+      m_maxLeaves[m_leaves + leaf] = leaf;
+    }
+    for (int node = m_leaves - 1; node >= 1; node--) {
+      m_maxLeaves[node] = m_maxLeaves[2 * node];
+    }
+
+    m_lastIndex = -1;
+  }
+
+
+  /**
+   * Adds or removes the valid pixels of one column of the boxcar.
+   *
+   * @param sample The sample index of the column
+   * @param change 1 to add the column, -1 to remove it
+   */
+  void RankFilter::Update(const int sample, const int change) {
+    for (unsigned int line = 0; line < m_lines.size(); line++) {
+      double value = m_lines[line][sample];
+      if (!IsValid(value)) continue;
+
+      int leaf = lower_bound(m_values.begin(), m_values.end(), value) - m_values.begin();
+      int node = m_leaves + leaf;
+      m_counts[node] += change;
+      m_maxCounts[node] = m_counts[node];
+
+      for (node /= 2; node >= 1; node /= 2) {
+        int left = 2 * node;
+        int right = left + 1;
+        m_counts[node] = m_counts[left] + m_counts[right];
+        if (m_maxCounts[left] >= m_maxCounts[right]) {
+          m_maxCounts[node] = m_maxCounts[left];
+          m_maxLeaves[node] = m_maxLeaves[left];
+        }
+        else {
+          m_maxCounts[node] = m_maxCounts[right];
+          m_maxLeaves[node] = m_maxLeaves[right];
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Makes the tree hold the boxcar around a sample. Moving to the next sample
+   * only updates the columns that leave and enter the boxcar; any other move
+   * recounts the whole boxcar.
+   *
+   * @param index The sample index, from zero
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void RankFilter::Compute(const int index) {
+    if (index < 0 || index >= m_ns) {
+      string msg = "Sample index is outside of the line in RankFilter";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (!m_built) Build();
+    if (index == m_lastIndex) return;
+
+    if (m_lastIndex >= 0 && index == m_lastIndex + 1) {
+      if (m_lastIndex - m_halfWidth >= 0) Update(m_lastIndex - m_halfWidth, -1);
+      if (index + m_halfWidth < m_ns) Update(index + m_halfWidth, 1);
+    }
+    else {
+      if (m_lastIndex >= 0) ClearCounts();
+      int first = max(0, index - m_halfWidth);
+      int last = min(m_ns - 1, index + m_halfWidth);
+      for (int samp = first; samp <= last; samp++) {
+        Update(samp, 1);
+      }
+    }
+
+    m_lastIndex = index;
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef RankFilter_h
+#define RankFilter_h
+/**
+ * @file
+ * $Revision: 1.1.1.1 $
+ * $Date: 2006/10/31 23:18:09 $
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <vector>
+
+namespace Isis {
+  /**
+   * @brief Sliding window rank statistics for NxM boxcars
+   *
+   * This is the rank statistics counterpart of QuickFilter. The lines of a
+   *   boxcar are added with AddLine and the median, mode or any other rank of
+   *   the valid pixels around a sample can then be asked for with an index
+   *   into the line. A valid pixel is not special and lies within the range
+   *   set with SetMinMax. Samples outside of the line are treated as Null,
+   *   just like the pixels ProcessByBoxcar reads outside of the cube.
+   *
+   * Instead of sorting every boxcar, the valid pixels of the loaded lines are
+   *   sorted once and a tree of counts over the sorted values is kept for the
+   *   boxcar around the last index. When the index increases by one, only the
+   *   column leaving the boxcar and the column entering it are updated, so
+   *   moving along a line costs O(height log n) per sample instead of
+   *   O(width height log(width height)).
+   *
+   * @ingroup Statistics
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class RankFilter {
+    public:
+      RankFilter(const int ns, const int width, const int height);
+      ~RankFilter();
+
+      int Count(const int index);
+      double Rank(const int index, const int rank);
+      double Median(const int index);
+      double Mode(const int index);
+      int ModeCount(const int index);
+
+      int Width() const;
+      int HalfWidth() const;
+      int Height() const;
+      int HalfHeight() const;
+      int Samples() const;
+
+      double Low() const;
+      double High() const;
+
+      void AddLine(const double *buf);
+      void RemoveLine();
+      void Reset();
+
+      void SetMinMax(const double minimum, const double maximum);
+
+    private:
+      bool IsValid(const double value) const;
+      void Compute(const int index);
+      void Build();
+      void ClearCounts();
+      void Update(const int sample, const int change);
+
+      int m_ns;          //!< The number of samples in a line
+      int m_width;       //!< The width of the boxcar, which is odd
+      int m_halfWidth;   //!< Half the width of the boxcar, rounded down
+      int m_height;      //!< The height of the boxcar, which is odd
+      int m_halfHeight;  //!< Half the height of the boxcar, rounded down
+      double m_minimum;  //!< The smallest valid pixel value
+      double m_maximum;  //!< The largest valid pixel value
+
+      //! The lines in the boxcar, oldest first
+      std::vector< std::vector<double> > m_lines;
+
+      //! The sorted, distinct valid pixel values of the loaded lines
+      std::vector<double> m_values;
+      int m_leaves;      //!< The number of leaves in the tree, a power of two
+      //! The number of boxcar pixels at or under each tree node
+      std::vector<int> m_counts;
+      //! The largest leaf count under each tree node
+      std::vector<int> m_maxCounts;
+      //! The first leaf under each tree node with the largest count
+      std::vector<int> m_maxLeaves;
+
+      bool m_built;      //!< Whether the tree matches the loaded lines
+      int m_lastIndex;   //!< The index the tree holds the boxcar of, or -1
+  };
+};
+
+#endif
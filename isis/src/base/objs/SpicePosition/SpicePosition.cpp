@@ -242,8 +242,6 @@ namespace Isis {
    *                      to make software more readable.
    */
   const std::vector<double> &SpicePosition::SetEphemerisTime(double et) {
-    NaifStatus::CheckErrors();
-
     // Save the time
     if(et == p_et) return p_coordinate;
     p_et = et;
@@ -262,11 +260,11 @@ namespace Isis {
       SetEphemerisTimePolyFunctionOverHermiteConstant();
     }
     else {  // Read from the kernel
+      NaifStatus::CheckErrors();
       SetEphemerisTimeSpice();
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
-
     // Return the coordinate
     return p_coordinate;
   }
@@ -445,14 +443,14 @@ namespace Isis {
                        _FILEINFO_);
     }
 
-    // Loop through and move the table to the cache
+    // Move the table to the cache a column at a time instead of unpacking
+    // every record
     if (p_source != PolyFunction) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-        if (rec.Fields() == 7) {
+      if (table.Records() > 0) {
+        if (table.RecordFields() == 7) {
           p_hasVelocity = true;
         }
-        else if (rec.Fields() == 4) {
+        else if (table.RecordFields() == 4) {
           p_hasVelocity = false;
         }
         else  {
@@ -460,44 +458,57 @@ namespace Isis {
           throw IException(IException::Programmer, msg, _FILEINFO_);
         }
 
-        std::vector<double> j2000Coord;
-        j2000Coord.push_back((double)rec[0]);
-        j2000Coord.push_back((double)rec[1]);
-        j2000Coord.push_back((double)rec[2]);
-        int inext = 3;
+        std::vector<double> x, y, z, times;
+        table.Column(0, x);
+        table.Column(1, y);
+        table.Column(2, z);
+        table.Column(p_hasVelocity ? 6 : 3, times);
 
-        p_cache.push_back(j2000Coord);
+        std::vector<double> vx, vy, vz;
         if (p_hasVelocity) {
-          std::vector<double> j2000Velocity;
-          j2000Velocity.push_back((double)rec[3]);
-          j2000Velocity.push_back((double)rec[4]);
-          j2000Velocity.push_back((double)rec[5]);
-          inext = 6;
+          table.Column(3, vx);
+          table.Column(4, vy);
+          table.Column(5, vz);
+        }
 
-          p_cacheVelocity.push_back(j2000Velocity);
+        p_cache.reserve(p_cache.size() + times.size());
+        p_cacheTime.reserve(p_cacheTime.size() + times.size());
+        if (p_hasVelocity) p_cacheVelocity.reserve(p_cacheVelocity.size() + times.size());
+
+        for (unsigned int r = 0; r < times.size(); r++) {
+          std::vector<double> j2000Coord(3);
+          j2000Coord[0] = x[r];
+          j2000Coord[1] = y[r];
+          j2000Coord[2] = z[r];
+          p_cache.push_back(j2000Coord);
+
+          if (p_hasVelocity) {
+            std::vector<double> j2000Velocity(3);
+            j2000Velocity[0] = vx[r];
+            j2000Velocity[1] = vy[r];
+            j2000Velocity[2] = vz[r];
+            p_cacheVelocity.push_back(j2000Velocity);
+          }
+
+          p_cacheTime.push_back(times[r]);
         }
-        p_cacheTime.push_back((double)rec[inext]);
       }
     }
     else {
-      // Coefficient table for postion coordinates x, y, and z
+      // Coefficient table for postion coordinates x, y, and z. The last record
+      // holds the function time parameters.
       std::vector<double> coeffX, coeffY, coeffZ;
+      table.Column(0, coeffX);
+      table.Column(1, coeffY);
+      table.Column(2, coeffZ);
 
-      for (int r = 0; r < table.Records() - 1; r++) {
-        TableRecord &rec = table[r];
+      double baseTime = coeffX.back();
+      double timeScale = coeffY.back();
+      double degree = coeffZ.back();
+      coeffX.pop_back();
+      coeffY.pop_back();
+      coeffZ.pop_back();
 
-        if(rec.Fields() != 3) {
-          // throw an error
-        }
-        coeffX.push_back((double)rec[0]);
-        coeffY.push_back((double)rec[1]);
-        coeffZ.push_back((double)rec[2]);
-      }
-      // Take care of function time parameters
-      TableRecord &rec = table[table.Records()-1];
-      double baseTime = (double)rec[0];
-      double timeScale = (double)rec[1];
-      double degree = (double)rec[2];
       SetPolynomialDegree((int) degree);
       SetOverrideBaseTime(baseTime, timeScale);
       SetPolynomial(coeffX, coeffY, coeffZ);
@@ -17,6 +17,7 @@
 
 
 #include "BasisFunction.h"
+#include "Constants.h"
 #include "IException.h"
 #include "IString.h"
 #include "LeastSquares.h"
@@ -44,6 +45,177 @@ extern int ck3sdn(double sdntol, bool avflag, int *nrec,
                   int nints, double *starts, double *dparr,
                   int *intarr);
 
+// Rotation math for evaluating cached rotations. These match the Naif routines
+// named in each comment, but do not touch the Naif error and trace state, so
+// rotations loaded from tables can be evaluated on several threads at once.
+// Matrices are 3x3 in row-major order.
+namespace {
+
+  //! out = a * b (mxm_c)
+  void multiplyMatrices(const double *a, const double *b, double *out) {
+    double product[9];
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        product[row*3 + col] = a[row*3] * b[col] + a[row*3 + 1] * b[3 + col] +
+                               a[row*3 + 2] * b[6 + col];
+      }
+    }
+    std::copy(product, product + 9, out);
+  }
+
+
+  //! out = transpose(a) * b (mtxm_c)
+  void multiplyTransposeMatrix(const double *a, const double *b, double *out) {
+    double product[9];
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        product[row*3 + col] = a[row] * b[col] + a[3 + row] * b[3 + col] +
+                               a[6 + row] * b[6 + col];
+      }
+    }
+    std::copy(product, product + 9, out);
+  }
+
+
+  //! out = a * transpose(b) (mxmt_c)
+  void multiplyMatrixTranspose(const double *a, const double *b, double *out) {
+    double product[9];
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        product[row*3 + col] = a[row*3] * b[col*3] + a[row*3 + 1] * b[col*3 + 1] +
+                               a[row*3 + 2] * b[col*3 + 2];
+      }
+    }
+    std::copy(product, product + 9, out);
+  }
+
+
+  //! out = m * v (mxv_c)
+  void multiplyVector(const double *m, const double *v, double *out) {
+    double product[3];
+    for (int row = 0; row < 3; row++) {
+      product[row] = m[row*3] * v[0] + m[row*3 + 1] * v[1] + m[row*3 + 2] * v[2];
+    }
+    std::copy(product, product + 3, out);
+  }
+
+
+  //! out = transpose(m) * v (mtxv_c)
+  void multiplyTransposeVector(const double *m, const double *v, double *out) {
+    double product[3];
+    for (int col = 0; col < 3; col++) {
+      product[col] = m[col] * v[0] + m[3 + col] * v[1] + m[6 + col] * v[2];
+    }
+    std::copy(product, product + 3, out);
+  }
+
+
+  //! The frame rotation by angle about axis 1, 2 or 3 (rotate_c)
+  void axisRotation(double angle, int axis, double *out) {
+    int i = (axis + 2) % 3;
+    int j = (i + 1) % 3;
+    int k = (i + 2) % 3;
+    double c = cos(angle);
+    double s = sin(angle);
+
+    std::fill(out, out + 9, 0.0);
+    out[i*3 + i] = 1.0;
+    out[j*3 + j] = c;
+    out[j*3 + k] = s;
+    out[k*3 + j] = -s;
+    out[k*3 + k] = c;
+  }
+
+
+  //! [angle3]axis3 * [angle2]axis2 * [angle1]axis1 (eul2m_c)
+  void eulerMatrix(double angle3, double angle2, double angle1,
+                   int axis3, int axis2, int axis1, double *out) {
+    double rotation[9];
+    axisRotation(angle1, axis1, out);
+    axisRotation(angle2, axis2, rotation);
+    multiplyMatrices(rotation, out, out);
+    axisRotation(angle3, axis3, rotation);
+    multiplyMatrices(rotation, out, out);
+  }
+
+
+  //! The axis and angle, in [0, pi], that a matrix rotates vectors by (raxisa_c)
+  void rotationAxisAngle(const double *m, double *axis, double &angle) {
+    // Find the largest component of the unit quaternion first for stability
+    double trace = m[0] + m[4] + m[8];
+    double q[4];
+    double squares[4] = { 1.0 + trace, 1.0 + 2.0 * m[0] - trace,
+                          1.0 + 2.0 * m[4] - trace, 1.0 + 2.0 * m[8] - trace };
+    int largest = std::max_element(squares, squares + 4) - squares;
+    double scale = 0.5 / sqrt(squares[largest]);
+
+    switch (largest) {
+      case 0:
+        q[0] = 0.25 / scale;
+        q[1] = (m[7] - m[5]) * scale;
+        q[2] = (m[2] - m[6]) * scale;
+        q[3] = (m[3] - m[1]) * scale;
+        break;
+      case 1:
+        q[1] = 0.25 / scale;
+        q[0] = (m[7] - m[5]) * scale;
+        q[2] = (m[1] + m[3]) * scale;
+        q[3] = (m[2] + m[6]) * scale;
+        break;
+      case 2:
+        q[2] = 0.25 / scale;
+        q[0] = (m[2] - m[6]) * scale;
+        q[1] = (m[1] + m[3]) * scale;
+        q[3] = (m[5] + m[7]) * scale;
+        break;
+      default:
+        q[3] = 0.25 / scale;
+        q[0] = (m[3] - m[1]) * scale;
+        q[1] = (m[2] + m[6]) * scale;
+        q[2] = (m[5] + m[7]) * scale;
+        break;
+    }
+
+    if (q[0] < 0.0) {
+      for (int i = 0; i < 4; i++) {
+        q[i] = -q[i];
+      }
+    }
+
+    double norm = sqrt(q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm == 0.0) {
+      axis[0] = 0.0;
+      axis[1] = 0.0;
+      axis[2] = 1.0;
+      angle = 0.0;
+      return;
+    }
+
+    axis[0] = q[1] / norm;
+    axis[1] = q[2] / norm;
+    axis[2] = q[3] / norm;
+    angle = 2.0 * atan2(norm, q[0]);
+  }
+
+
+  //! The matrix that rotates vectors by angle about a unit axis (axisar_c)
+  void axisAngleMatrix(const double *axis, double angle, double *out) {
+    double c = cos(angle);
+    double s = sin(angle);
+    double t = 1.0 - c;
+
+    out[0] = c + t * axis[0] * axis[0];
+    out[1] = t * axis[0] * axis[1] - s * axis[2];
+    out[2] = t * axis[0] * axis[2] + s * axis[1];
+    out[3] = t * axis[1] * axis[0] + s * axis[2];
+    out[4] = c + t * axis[1] * axis[1];
+    out[5] = t * axis[1] * axis[2] - s * axis[0];
+    out[6] = t * axis[2] * axis[0] - s * axis[1];
+    out[7] = t * axis[2] * axis[1] + s * axis[0];
+    out[8] = c + t * axis[2] * axis[2];
+  }
+}
+
 namespace Isis {
   /**
    * Construct an empty SpiceRotation class using a valid Naif frame code to
@@ -553,86 +725,71 @@ namespace Isis {
       loadPCFromTable(table.Label());
     }
 
-    int recFields = table[0].Fields();
+    int recFields = table.RecordFields();
 
-    // Loop through and move the table to the cache.  Retrieve the first record to
-    // establish the type of cache and then use the appropriate loop.
-
-    // list table of quaternion and time
-    if (recFields == 5) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
+    // Move the table to the cache a column at a time instead of unpacking
+    // every record. The number of fields establishes the type of cache.
 
-        std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
+    // list table of quaternion and time, optionally with the angular velocity
+    // vector before the time
+    if (recFields == 5 || recFields == 8) {
+      std::vector<double> q0, q1, q2, q3, times;
+      table.Column(0, q0);
+      table.Column(1, q1);
+      table.Column(2, q2);
+      table.Column(3, q3);
+      table.Column(recFields - 1, times);
 
-        Quaternion q(j2000Quat);
-        std::vector<double> CJ = q.ToMatrix();
-        p_cache.push_back(CJ);
-        p_cacheTime.push_back((double)rec[4]);
+      std::vector<double> av1, av2, av3;
+      if (recFields == 8) {
+        table.Column(4, av1);
+        table.Column(5, av2);
+        table.Column(6, av3);
       }
-      p_source = Memcache;
-    }
-
-    // list table of quaternion, angular velocity vector, and time
-    else if (recFields == 8) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
 
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
-
-        std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
+      p_cache.reserve(times.size());
+      p_cacheTime.reserve(times.size());
+      if (recFields == 8) p_cacheAv.reserve(times.size());
 
+      std::vector<double> j2000Quat(4);
+      for (unsigned int r = 0; r < times.size(); r++) {
+        j2000Quat[0] = q0[r];
+        j2000Quat[1] = q1[r];
+        j2000Quat[2] = q2[r];
+        j2000Quat[3] = q3[r];
 
         Quaternion q(j2000Quat);
-        std::vector<double> CJ = q.ToMatrix();
-        p_cache.push_back(CJ);
+        p_cache.push_back(q.ToMatrix());
 
-        std::vector<double> av;
-        av.push_back((double)rec[4]);
-        av.push_back((double)rec[5]);
-        av.push_back((double)rec[6]);
-        p_cacheAv.push_back(av);
+        if (recFields == 8) {
+          std::vector<double> av(3);
+          av[0] = av1[r];
+          av[1] = av2[r];
+          av[2] = av3[r];
+          p_cacheAv.push_back(av);
+          p_hasAngularVelocity = true;
+        }
 
-        p_cacheTime.push_back((double)rec[7]);
-        p_hasAngularVelocity = true;
+        p_cacheTime.push_back(times[r]);
       }
       p_source = Memcache;
     }
 
-    // coefficient table for angle1, angle2, and angle3
+    // coefficient table for angle1, angle2, and angle3. The last record holds
+    // the time parameters.
     else if (recFields == 3) {
       std::vector<double> coeffAng1, coeffAng2, coeffAng3;
+      table.Column(0, coeffAng1);
+      table.Column(1, coeffAng2);
+      table.Column(2, coeffAng3);
 
-      for (int r = 0; r < table.Records() - 1; r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw an error
-        }
-        coeffAng1.push_back((double)rec[0]);
-        coeffAng2.push_back((double)rec[1]);
-        coeffAng3.push_back((double)rec[2]);
-      }
+      double baseTime = coeffAng1.back();
+      double timeScale = coeffAng2.back();
+      double degree = coeffAng3.back();
+      coeffAng1.pop_back();
+      coeffAng2.pop_back();
+      coeffAng3.pop_back();
 
-      // Take care of time parameters
-      TableRecord &rec = table[table.Records()-1];
-      double baseTime = (double)rec[0];
-      double timeScale = (double)rec[1];
-      double degree = (double)rec[2];
       SetPolynomialDegree((int) degree);
       SetOverrideBaseTime(baseTime, timeScale);
       SetPolynomial(coeffAng1, coeffAng2, coeffAng3);
@@ -1286,14 +1443,12 @@ namespace Isis {
    * @return vector<double>  A direction vector in J2000 frame.
    */
   std::vector<double> SpiceRotation::J2000Vector(const std::vector<double> &rVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> jVec;
     if (rVec.size() == 3) {
-      double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
+      double TJ[9];
+      multiplyMatrices(&p_TC[0], &p_CJ[0], TJ);
       jVec.resize(3);
-      mtxv_c(TJ, (SpiceDouble *) &rVec[0], (SpiceDouble *) &jVec[0]);
+      multiplyTransposeVector(TJ, &rVec[0], &jVec[0]);
     }
 
     else if (rVec.size() == 6) {
@@ -1313,8 +1468,8 @@ namespace Isis {
       jVec.resize(6);
 
       mxvg_c(stateJT, (SpiceDouble *) &rVec[0], 6, 6, (SpiceDouble *) &jVec[0]);
+      NaifStatus::CheckErrors();
     }
-    NaifStatus::CheckErrors();
     return (jVec);
   }
 
@@ -1578,15 +1733,13 @@ namespace Isis {
    * @return @b vector<double> A direction vector in reference frame.
    */
   std::vector<double> SpiceRotation::ReferenceVector(const std::vector<double> &jVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> rVec(3);
 
     if (jVec.size() == 3) {
-      double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
+      double TJ[9];
+      multiplyMatrices(&p_TC[0], &p_CJ[0], TJ);
       rVec.resize(3);
-      mxv_c(TJ, (SpiceDouble *) &jVec[0], (SpiceDouble *) &rVec[0]);
+      multiplyVector(TJ, &jVec[0], &rVec[0]);
     }
     else if (jVec.size() == 6) {
       // See Naif routine frmchg for the format of the state matrix.  The constant rotation, TC,
@@ -1598,9 +1751,9 @@ namespace Isis {
       stateTJ = StateTJ();
       rVec.resize(6);
       mxvg_c((SpiceDouble *) &stateTJ[0], (SpiceDouble *) &jVec[0], 6, 6, (SpiceDouble *) &rVec[0]);
+      NaifStatus::CheckErrors();
     }
 
-    NaifStatus::CheckErrors();
     return (rVec);
   }
 
@@ -2192,17 +2345,15 @@ namespace Isis {
    * @return @b double Wrapped angle.
    */
   double SpiceRotation::WrapAngle(double compareAngle, double angle) {
-    NaifStatus::CheckErrors();
     double diff1 = compareAngle - angle;
 
-    if (diff1 < -1 * pi_c()) {
-      angle -= twopi_c();
+    if (diff1 < -1 * PI) {
+      angle -= TWOPI;
     }
-    else if (diff1 > pi_c()) {
-      angle += twopi_c();
+    else if (diff1 > PI) {
+      angle += TWOPI;
     }
 
-    NaifStatus::CheckErrors();
     return angle;
   }
 
@@ -2725,11 +2876,9 @@ namespace Isis {
    * @return @b vector<double> Returned matrix.
    */
   std::vector<double> SpiceRotation::Matrix() {
-    NaifStatus::CheckErrors();
     std::vector<double> TJ;
     TJ.resize(9);
-    mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], (SpiceDouble( *) [3]) &TJ[0]);
-    NaifStatus::CheckErrors();
+    multiplyMatrices(&p_TC[0], &p_CJ[0], &TJ[0]);
     return TJ;
   }
 
@@ -3127,7 +3276,6 @@ namespace Isis {
    */
   void SpiceRotation::setEphemerisTimeMemcache() {
     // If the cache has only one rotation, set it
-    NaifStatus::CheckErrors();
     if (p_cache.size() == 1) {
       p_CJ = p_cache[0];
       if (p_hasAngularVelocity) {
@@ -3156,27 +3304,26 @@ namespace Isis {
                     (p_cacheTime[cacheIndex+1] - p_cacheTime[cacheIndex]);
       /*        Quaternion Q2 (p_cache[cacheIndex+1]);
                Quaternion Q1 (p_cache[cacheIndex]);*/
-      std::vector<double> CJ2(p_cache[cacheIndex+1]);
-      std::vector<double> CJ1(p_cache[cacheIndex]);
-      SpiceDouble J2J1[3][3];
-      mtxm_c((SpiceDouble( *)[3]) &CJ2[0], (SpiceDouble( *)[3]) &CJ1[0], J2J1);
-      SpiceDouble axis[3];
-      SpiceDouble angle;
-      raxisa_c(J2J1, axis, &angle);
-      SpiceDouble delta[3][3];
-      axisar_c(axis, angle * (SpiceDouble)mult, delta);
-      mxmt_c((SpiceDouble *) &CJ1[0], delta, (SpiceDouble( *) [3]) &p_CJ[0]);
+      const std::vector<double> &CJ2 = p_cache[cacheIndex+1];
+      const std::vector<double> &CJ1 = p_cache[cacheIndex];
+      double J2J1[9];
+      multiplyTransposeMatrix(&CJ2[0], &CJ1[0], J2J1);
+      double axis[3];
+      double angle;
+      rotationAxisAngle(J2J1, axis, angle);
+      double delta[9];
+      axisAngleMatrix(axis, angle * mult, delta);
+      multiplyMatrixTranspose(&CJ1[0], delta, &p_CJ[0]);
 
       if (p_hasAngularVelocity) {
-        double v1[3], v2[3]; // Vectors surrounding desired time
-        vequ_c((SpiceDouble *) &p_cacheAv[cacheIndex][0], v1);
-        vequ_c((SpiceDouble *) &p_cacheAv[cacheIndex+1][0], v2);
-        vscl_c((1. - mult), v1, v1);
-        vscl_c(mult, v2, v2);
-        vadd_c(v1, v2, (SpiceDouble *) &p_av[0]);
+        // Vectors surrounding desired time
+        const std::vector<double> &v1 = p_cacheAv[cacheIndex];
+        const std::vector<double> &v2 = p_cacheAv[cacheIndex+1];
+        for (int i = 0; i < 3; i++) {
+          p_av[i] = (1. - mult) * v1[i] + mult * v2[i];
+        }
       }
     }
-    NaifStatus::CheckErrors();
   }
 
 
@@ -3301,11 +3448,11 @@ namespace Isis {
    angles.push_back(function3.Evaluate(rtime));
 
    // Get the first angle back into the range Naif expects [-180.,180.]
-   if (angles[0] <= -1 * pi_c()) {
-     angles[0] += twopi_c();
+   if (angles[0] <= -1 * PI) {
+     angles[0] += TWOPI;
    }
-   else if (angles[0] > pi_c()) {
-     angles[0] -= twopi_c();
+   else if (angles[0] > PI) {
+     angles[0] -= TWOPI;
    }
    return angles;
   }
@@ -3318,7 +3465,6 @@ namespace Isis {
    * @see SpiceRotatation::SetEphemerisTime
    */
   void SpiceRotation::setEphemerisTimePolyFunction() {
-   NaifStatus::CheckErrors();
    Isis::PolynomialUnivariate function1(p_degree);
    Isis::PolynomialUnivariate function2(p_degree);
    Isis::PolynomialUnivariate function3(p_degree);
@@ -3335,16 +3481,14 @@ namespace Isis {
    double angle3 = function3.Evaluate(rtime);
 
    // Get the first angle back into the range Naif expects [-180.,180.]
-   if (angle1 < -1 * pi_c()) {
-     angle1 += twopi_c();
+   if (angle1 < -1 * PI) {
+     angle1 += TWOPI;
    }
-   else if (angle1 > pi_c()) {
-     angle1 -= twopi_c();
+   else if (angle1 > PI) {
+     angle1 -= TWOPI;
    }
 
-   eul2m_c((SpiceDouble) angle3, (SpiceDouble) angle2, (SpiceDouble) angle1,
-           p_axis3,              p_axis2,              p_axis1,
-           (SpiceDouble( *)[3]) &p_CJ[0]);
+   eulerMatrix(angle3, angle2, angle1, p_axis3, p_axis2, p_axis1, &p_CJ[0]);
 
    if (p_hasAngularVelocity) {
      if ( p_degree == 0)
@@ -3352,7 +3496,6 @@ namespace Isis {
      else
        ComputeAv();
    }
-   NaifStatus::CheckErrors();
   }
 
 
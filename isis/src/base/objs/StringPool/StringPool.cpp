@@ -0,0 +1,96 @@
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include "StringPool.h"
+
+#include <QHash>
+#include <QReadLocker>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QWriteLocker>
+
+namespace Isis {
+  namespace {
+    //! The number of independently locked parts of the pool
+    const int Shards = 64;
+
+    //! One part of the pool, holding the strings that hash to it
+    struct Shard {
+      QReadWriteLock lock;    //!< Guards the strings of this part
+      QSet<QString> strings;  //!< The pooled strings
+    };
+
+    /**
+     * The pool is split by string hash, so that threads interning different
+     * strings do not wait on each other, and each part is read locked for the
+     * lookups that find a string already pooled, which is almost all of them.
+     */
+    Shard *shards() {
+      static Shard pool[Shards];
+      return pool;
+    }
+  }
+
+
+  /**
+   * Returns the pooled copy of a string, adding the string to the pool if
+   * there is no equal string in it yet. The returned string is equal to the
+   * argument and shares its characters with every other string interned with
+   * the same value.
+   *
+   * @param string The string to intern
+   *
+   * @return @b QString The pooled copy of the string
+   */
+  QString StringPool::intern(const QString &string) {
+    // Empty strings have nothing to share
+    if (string.isEmpty()) {
+      return string;
+    }
+
+    Shard &shard = shards()[qHash(string) % Shards];
+
+    {
+      QReadLocker locker(&shard.lock);
+      QSet<QString>::const_iterator pooled = shard.strings.constFind(string);
+      if (pooled != shard.strings.constEnd()) {
+        return *pooled;
+      }
+    }
+
+    QWriteLocker locker(&shard.lock);
+    return *shard.strings.insert(string);
+  }
+
+
+  /**
+   * Returns the number of distinct strings in the pool.
+   *
+   * @return @b int The number of pooled strings
+   */
+  int StringPool::size() {
+    int size = 0;
+    for (int i = 0; i < Shards; i++) {
+      QReadLocker locker(&shards()[i].lock);
+      size += shards()[i].strings.size();
+    }
+    return size;
+  }
+}
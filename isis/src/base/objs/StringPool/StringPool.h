@@ -0,0 +1,59 @@
+#ifndef StringPool_h
+#define StringPool_h
+/**
+ * @file
+ *
+ *   Unless noted otherwise, the portions of Isis written by the USGS are public
+ *   domain. See individual third-party library and package descriptions for
+ *   intellectual property information,user agreements, and related information.
+ *
+ *   Although Isis has been used by the USGS, no warranty, expressed or implied,
+ *   is made by the USGS as to the accuracy and functioning of such software
+ *   and related material nor shall the fact of distribution constitute any such
+ *   warranty, and no responsibility is assumed by the USGS in connection
+ *   therewith.
+ *
+ *   For additional information, launch
+ *   $ISISROOT/doc//documents/Disclaimers/Disclaimers.html in a browser or see
+ *   the Privacy &amp; Disclaimers page on the Isis website,
+ *   http://isis.astrogeology.usgs.gov, and the USGS privacy and disclaimers on
+ *   http://www.usgs.gov/privacy.html.
+ */
+
+#include <QString>
+
+namespace Isis {
+
+  /**
+   * @brief A process wide pool of shared strings
+   *
+   * QString copies share their characters until one of them is changed, but
+   * strings that are read or built separately do not, even when they are
+   * equal. Large control networks repeat a few strings, like cube serial
+   * numbers and chooser names, on every point and measure. Passing these
+   * through intern() returns the pooled copy of each string, so all of the
+   * equal strings share one copy of their characters.
+   *
+   * Strings are never removed from the pool, so only strings with few
+   * distinct values should be interned. Date-times, for example, are not. The
+   * pool is safe to use from several threads. It is split into parts that are
+   * locked separately, and strings that are already pooled are found under a
+   * read lock, so threads reading a network at once rarely wait on it.
+   *
+   * @ingroup Utility
+   *
+   * @author 2026-10-16 Isis Development Team
+   *
+   * @internal
+   */
+  class StringPool {
+    public:
+      static QString intern(const QString &string);
+      static int size();
+
+    private:
+      StringPool();
+  };
+}
+
+#endif
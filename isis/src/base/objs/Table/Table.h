@@ -114,6 +114,11 @@ namespace Isis {
       // Read a record
       TableRecord &operator[](const int index);
 
+      // Read all values of a field
+      void Column(const int field, std::vector<double> &values) const;
+      void Column(const int field, std::vector<int> &values) const;
+      void Column(const int field, std::vector<float> &values) const;
+
       // Add a record
       void operator+=(TableRecord &rec);
 
@@ -129,6 +134,10 @@ namespace Isis {
       static QString toString(Table table, QString fieldDelimiter=",");
 
     protected:
+      int ColumnOffset(const int field, const TableField::Type type) const;
+      template <typename T> void ReadColumn(const int field, const TableField::Type type,
+                                            std::vector<T> &values) const;
+
       void ReadInit();
       void ReadData(std::istream &stream);
       void WriteInit();
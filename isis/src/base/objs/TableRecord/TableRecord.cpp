@@ -62,6 +62,17 @@ namespace Isis {
     return p_fields[field];
   }
 
+  /**
+   *  Returns the TableField at the specified location in the TableRecord
+   *
+   * @param field  Index of desired field
+   *
+   * @return The TableField at specified location in the record
+   */
+  const TableField &TableRecord::operator[](const int field) const {
+    return p_fields[field];
+  }
+
   /**
    * Returns the TableField in the record whose name corresponds to the
    * input string
@@ -61,6 +61,7 @@ namespace Isis {
         
       void operator+=(Isis::TableField &field);
       TableField&operator [](const int field);
+      const TableField &operator[](const int field) const;
       TableField &operator[](const QString &field);
 
       int Fields() const;
@@ -1,11 +1,15 @@
 #include "Isis.h"
 
+#include <cfloat>
+#include <functional>
+
 #include <QString>
 #include  <QColor>
 #include <QMenuBar>
 
-#include "ControlNet.h"
 #include "ControlMeasure.h"
+#include "ControlNetVersioner.h"
+#include "ControlPoint.h"
 #include "FileList.h"
 #include "Process.h"
 #include "Histogram.h"
@@ -17,11 +21,14 @@
 #include "HistogramItem.h"
 #include "IString.h"
 #include "CubePlotCurve.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 using namespace Isis;
 
 QColor curveColor(int i);
+void forEachResidual(const FileName &netFile, Progress *progress,
+                     std::function<void(double)> addResidual);
 
 void IsisMain() {
   Process p;
@@ -88,11 +95,19 @@ void IsisMain() {
 
   //loop throught the control nets writing reports and drawing histograms as needed
   for (int i=0;i<fList.size();i++) {  
-    ControlNet net(fList[i].toString(),&progress);
+    // The network is streamed twice, to find the range of the residuals and
+    // then to bin them, so it is never held in memory
+    double minimum = DBL_MAX;
+    double maximum = -DBL_MAX;
+    forEachResidual(fList[i], &progress, [&](double residual) {
+      if (!IsSpecial(residual) && residual > maximum) maximum = residual;
+      if (!IsSpecial(residual) && residual < minimum) minimum = residual;
+    });
+
     Histogram *hist;
     // Setup the histogram
     try {
-      hist = new Histogram(net, &ControlMeasure::GetResidualMagnitude, ui.GetDouble("BIN_WIDTH"));
+      hist = new Histogram(Histogram::withBinWidth(minimum, maximum, ui.GetDouble("BIN_WIDTH")));
     }
     catch (IException &e) {
       QString msg = "The following error was thrown while building a histogram from netfile [" + 
@@ -107,6 +122,10 @@ void IsisMain() {
 
       continue; //skip to the next next net file
     }
+
+    forEachResidual(fList[i], &progress, [&](double residual) {
+      hist->AddData(residual);
+    });
        
 
     //Tabular Histogram Data 
@@ -182,6 +201,24 @@ void IsisMain() {
   p.EndProcess();
 }
 
+/**
+ * Streams a control network from its file and passes the residual magnitude
+ * of each measure to addResidual, skipping ignored points and measures.
+ */
+void forEachResidual(const FileName &netFile, Progress *progress,
+                     std::function<void(double)> addResidual) {
+  ControlNetVersioner reader(netFile, [&](ControlPoint *point) {
+    if (point->IsIgnored()) return;
+
+    for (int j = 0; j < point->GetNumMeasures(); j++) {
+      const ControlMeasure *measure = point->GetMeasure(j);
+      if (measure->IsIgnored()) continue;
+
+      addResidual(measure->GetResidualMagnitude());
+    }
+  }, progress);
+}
+
 QColor curveColor(int i) {
   int  j = i%16;
 
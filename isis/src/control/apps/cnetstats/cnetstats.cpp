@@ -24,10 +24,37 @@ namespace Isis{
     *                 through.
     */
   void cnetstats(UserInterface &ui, Pvl *log) {
-    ControlNet innet(ui.GetFileName("CNET"));
-    QString inlist(ui.GetFileName("FROMLIST"));
+    // The image stats and filters work on the graph of the whole network, so
+    // it is only loaded when there is an image list to use them with
+    if (ui.WasEntered("FROMLIST")) {
+      ControlNet innet(ui.GetFileName("CNET"));
+      QString inlist(ui.GetFileName("FROMLIST"));
+
+      cnetstats(innet, inlist, ui, log);
+      return;
+    }
+
+    if (ui.WasEntered("DEFFILE") ||
+        (ui.WasEntered("CREATE_IMAGE_STATS") && ui.GetBoolean("CREATE_IMAGE_STATS"))) {
+      QString msg = "An image list [FROMLIST] must be entered to filter the Control Net "
+                    "or to create image stats";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    // Get the Point Stats File
+    QString sPointFile = "";
+    if (ui.WasEntered("CREATE_POINT_STATS") && ui.GetBoolean("CREATE_POINT_STATS")) {
+      sPointFile = ui.GetFileName("POINT_STATS_FILE");
+    }
+
+    // The point and measure stats are streamed from the file
+    Progress statsProgress;
+    ControlNetStatistics cNetStats(ui.GetFileName("CNET"), sPointFile, &statsProgress);
 
-    cnetstats(innet, inlist, ui, log);
+    // Log the summary of the input Control Network
+    PvlGroup statsGrp;
+    cNetStats.GenerateControlNetStats(statsGrp);
+    log->addGroup(statsGrp);
   }
 
   /**
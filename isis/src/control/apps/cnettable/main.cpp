@@ -9,7 +9,7 @@
 #include "CameraPointInfo.h"
 #include "ControlMeasure.h"
 #include "ControlMeasureLogData.h"
-#include "ControlNet.h"
+#include "ControlNetVersioner.h"
 #include "ControlPoint.h"
 #include "Displacement.h"
 #include "FileName.h"
@@ -56,18 +56,11 @@ void IsisMain() {
 
   // Get user entered information
   UserInterface & ui = Application::GetUserInterface();
-  ControlNet cnet(ui.GetFileName("CNET"));
   SerialNumberList serials(ui.GetFileName("FROMLIST"));
   append = ui.GetBoolean("APPEND");
 
-  if (cnet.GetNumMeasures() == 0) {
-    string msg = "Your control network must contain at least one point";
-    throw IException(IException::User, msg, _FILEINFO_);
-  }
-
-  prog.SetMaximumSteps(cnet.GetNumMeasures());
-
   // If append is true, output will be appended or a new file created
+  QString openMode;
   if (append) {
     // Check to see if its a new file or we open an existing file
     FileName file(ui.GetFileName("FLATFILE"));
@@ -76,11 +69,11 @@ void IsisMain() {
       // Set this because it is used elsewhere
       append = false;
     }
-    txt = new TextFile(ui.GetFileName("FLATFILE"), "append");
+    openMode = "append";
   }
   // Without append, if the files exists it will be overwritten
   else {
-    txt = new TextFile(ui.GetFileName("FLATFILE"), "overwrite");
+    openMode = "overwrite";
   }
 
   PvlGroup * grp = NULL;
@@ -91,9 +84,11 @@ void IsisMain() {
   outside = ui.GetBoolean("ALLOWOUTSIDE");
   errors = ui.GetBoolean("ALLOWERRORS");
 
-  // Loop through all points in controlnet
-  for (int i = 0; i < cnet.GetNumPoints(); i++) {
-    const ControlPoint * cpoint = cnet[i];
+  // Stream the points of the control network so it is never held in memory.
+  // The flat file is opened at the first measure, so a network without any
+  // measures leaves it alone.
+  ControlNetVersioner reader(ui.GetFileName("CNET"), [&](ControlPoint *point) {
+    const ControlPoint * cpoint = point;
 
     if (isFirst && !append) {
       measureLabels += "ControlPointId,";
@@ -290,21 +285,23 @@ void IsisMain() {
         string msg = "You shouldn't have gotten here. Errors in CameraPointInfo class";
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
+      if (txt == NULL) {
+        txt = new TextFile(ui.GetFileName("FLATFILE"), openMode);
+      }
       Write(grp, *cmeasure);
       delete grp;
       grp = NULL;
     }
+  }, &prog);
 
-    // Making progress!
-    prog.CheckStatus();
+  if (txt == NULL) {
+    string msg = "Your control network must contain at least one point";
+    throw IException(IException::User, msg, _FILEINFO_);
   }
 
   // All done, clean up
-  prog.CheckStatus();
-  if (txt != NULL) {
-    delete txt;
-    txt = NULL;
-  }
+  delete txt;
+  txt = NULL;
 }
 
 // This function is meant to check a value, and, if it is a special pixel
@@ -6,10 +6,13 @@
 #include <sstream>
 
 // qt lib
+#include <QAtomicInt>
 #include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
+#include <QElapsedTimer>
 #include <QMutex>
+#include <QtConcurrentMap>
 
 // boost lib
 #include <boost/lexical_cast.hpp>
@@ -392,7 +395,7 @@ namespace Isis {
     // m_cholmodCommon, m_sparseNormals are not initialized
     m_L = NULL;
     m_cholmodNormal = NULL;
-    m_cholmodTriplet = NULL;
+    m_cholmodPatternChanged = true;
 
     // should we initialize objects m_xResiduals, m_yResiduals, m_xyResiduals
 
@@ -574,7 +577,9 @@ namespace Isis {
       return false;
     }
 
-    m_cholmodTriplet = NULL;
+    m_cholmodNormal = NULL;
+    m_L = NULL;
+    m_cholmodPatternChanged = true;
 
     cholmod_start(&m_cholmodCommon);
 
@@ -636,14 +641,13 @@ namespace Isis {
   /**
    * @brief Free CHOLMOD library variables.
    *
-   * Frees m_cholmodTriplet, m_cholmodNormal, and m_L.
+   * Frees m_cholmodNormal and m_L.
    * Calls cholmod_finish when complete.
    *
    * @return @b bool If the CHOLMOD library successfully cleaned up.
    */
   bool BundleAdjust::freeCHOLMODLibraryVariables() {
 
-    cholmod_free_triplet(&m_cholmodTriplet, &m_cholmodCommon);
     cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
     cholmod_free_factor(&m_L, &m_cholmodCommon);
 
@@ -765,7 +769,9 @@ namespace Isis {
 
         emit statusUpdate( QString("starting iteration %1\n").arg(m_iteration) );
 
-        clock_t iterationStartClock = clock();
+        // clock() adds up the time of every thread, so the iteration is timed by the wall clock
+        QElapsedTimer iterationTimer;
+        iterationTimer.start();
 
         // zero normals (after iteration 0)
         if (m_iteration != 1) {
@@ -773,11 +779,17 @@ namespace Isis {
         }
 
         // form normal equations -- computePartials is called in here.
+        QElapsedTimer assemblyTimer;
+        assemblyTimer.start();
+
         if (!formNormalEquations()) {
           m_bundleResults.setConverged(false);
           break;
         }
 
+        double assemblyTime = assemblyTimer.nsecsElapsed() / 1.0e9;
+        m_bundleResults.addElapsedTimeAssembly(assemblyTime);
+
         // testing
         if (m_abort) {
           m_bundleResults.setConverged(false);
@@ -908,14 +920,16 @@ namespace Isis {
         }
 
         m_bundleResults.printMaximumLikelihoodTierInformation();
-        clock_t iterationStopClock = clock();
-        double iterationTime = (iterationStopClock - iterationStartClock)
-                                / (double)CLOCKS_PER_SEC;
+        double iterationTime = iterationTimer.nsecsElapsed() / 1.0e9;
         emit statusUpdate( QString("End of Iteration %1 \n").arg(m_iteration) );
         emit statusUpdate( QString("Elapsed Time: %1 \n").arg(iterationTime,
                                                            fieldWidth,
                                                            format,
                                                            precision) );
+        emit statusUpdate( QString("Normal Equations Time: %1 \n").arg(assemblyTime,
+                                                                    fieldWidth,
+                                                                    format,
+                                                                    precision) );
 
         // check for maximum iterations
         if (m_iteration >= m_bundleSettings->convergenceCriteriaMaximumIterations()) {
@@ -931,12 +945,8 @@ namespace Isis {
         // TODO: is this necessary ???
         // probably all ready initialized to 101 nodes in bundle settings constructor...
 
-        // if we're using CHOLMOD and still going, release cholmod_factor
-        // (if we don't, memory leaks will occur), otherwise we need it for error propagation
-        if (!m_bundleResults.converged() || !m_bundleSettings->errorPropagation()) {
-          cholmod_free_factor(&m_L, &m_cholmodCommon);
-        }
-
+        // m_L is kept so that the next iteration can reuse its symbolic analysis, and it is
+        // needed for error propagation. It is freed with the other CHOLMOD variables.
 
         iterationSummary();
 
@@ -1028,9 +1038,6 @@ namespace Isis {
     static LinearAlgebra::Matrix coeffImage;
     static LinearAlgebra::Matrix coeffPoint3D(2, 3);
     static LinearAlgebra::Vector coeffRHS(2);
-    static boost::numeric::ublas::symmetric_matrix<double, upper> N22(3);
-    SparseBlockColumnMatrix N12;
-    static LinearAlgebra::Vector n2(3);
     boost::numeric::ublas::compressed_vector<double> n1(m_rank);
 
     m_RHS.resize(m_rank);
@@ -1043,16 +1050,13 @@ namespace Isis {
       coeffTarget.resize(2,numTargetBodyParameters);
     }
 
-    // clear N12, n1, and nj
-    N12.clear();
+    // clear n1 and nj
     n1.clear();
     m_RHS.clear();
 
     // clear static matrices
     coeffPoint3D.clear();
     coeffRHS.clear();
-    N22.clear();
-    n2.clear();
 
     // loop over 3D points
     int numGood3DPoints = 0;
@@ -1060,6 +1064,19 @@ namespace Isis {
     int pointIndex = 0;
     int num3DPoints = m_bundleControlPoints.size();
 
+    // The partials are computed on this thread for a batch of points. They can't be spread over
+    // threads, even with a camera clone per thread:
+    //  - GetXY(), SetImage() and the partials run through CSPICE routines, which keep static
+    //    state and a process wide error subsystem and are not thread safe.
+    //  - Each iteration applies the corrections to the SpicePosition and SpiceRotation of the
+    //    observation's cameras, so clones would have to be rebuilt every iteration.
+    // The measure normals and the point normals (the Schur complement) don't use the cameras, so
+    // they are formed for the whole batch in parallel, each point into its own matrices. They are
+    // then added to the normal equations in point order, so the result does not depend on the
+    // number of threads.
+    QVector<PointNormals> batch(PointNormalsBatchSize);
+    int batchSize = 0;
+
     outputBundleStatus("\n\n");
     
     for (int i = 0; i < num3DPoints; i++) {
@@ -1073,14 +1090,19 @@ namespace Isis {
         continue;
       }
 
-      if ( i != 0 ) {
-        N22.clear();
-        N12.wipe();
-        n2.clear();
-      }
+      PointNormals &pointNormals = batch[batchSize];
+      pointNormals.point = point;
+      pointNormals.N22.clear();
+      pointNormals.N12.wipe();
+      pointNormals.n2.clear();
+      pointNormals.measureCount = 0;
 
       // loop over measures for this point
       int numMeasures = point->size();
+      if (pointNormals.measures.size() < numMeasures) {
+        pointNormals.measures.resize(numMeasures);
+      }
+
       for (int j = 0; j < numMeasures; j++) {
         BundleMeasureQsp measure = point->at(j);
 
@@ -1103,12 +1125,26 @@ namespace Isis {
         int numObs = m_bundleResults.numberObservations();
         m_bundleResults.setNumberObservations(numObs + 2);
 
-        formMeasureNormals(N22, N12, n1, n2, coeffTarget, coeffImage, coeffPoint3D, coeffRHS,
-                             measure->observationIndex());
+        // keep the partials for formMeasureNormals()
+        MeasureNormals &measureNormals = pointNormals.measures[pointNormals.measureCount];
+        measureNormals.blockIndex = measure->observationIndex();
+        if (m_bundleSettings->solveTargetBody()) {
+          measureNormals.blockIndex++;
+        }
+        measureNormals.coeffTarget = coeffTarget;
+        measureNormals.coeffImage = coeffImage;
+        measureNormals.coeffPoint3D = coeffPoint3D;
+        measureNormals.coeffRHS = coeffRHS;
+        pointNormals.measureCount++;
 
       } // end loop over this points measures
 
-      formPointNormals(N22, N12, n2, m_RHS, point);
+      batchSize++;
+
+      if (batchSize == PointNormalsBatchSize) {
+        formBatchPointNormals(batch, batchSize, n1);
+        batchSize = 0;
+      }
 
       pointIndex++;
 
@@ -1116,6 +1152,9 @@ namespace Isis {
 
   } // end loop over 3D points
 
+  // form the normals for the last partial batch
+  formBatchPointNormals(batch, batchSize, n1);
+
   // finally, form the reduced normal equations
   formWeightedNormals(n1, m_RHS);
 
@@ -1127,140 +1166,151 @@ namespace Isis {
 
 
   /**
-   * Form the auxilary normal equation matrices for a measure.
-   * N22, N12, n1, and n2 will contain the auxilary matrices when completed.
+   * Form the auxilary normal equation matrices for a measure from the partial derivatives kept
+   * in measure. The point's N22, N12 and n2 are added to in pointNormals. The image (and target
+   * body) blocks of N11 and n1 are kept in measure, so that accumulateMeasureNormals() can add
+   * them to the shared normal equations.
    *
-   * @param N22 The normal equation matrix for the point on the body.
-   * @param N12 The normal equation matrix for the camera and the target body.
-   * @param n1 The right hand side vector for the camera and the target body.
-   * @param n2 The right hand side vector for the point on the body.
-   * @param coeffTarget The matrix containing target body pertial derivatives.
-   * @param coeffImage The matrix containing camera position and orientation partial derivatives.
-   * @param coeffPoint3D The matrix containing point lat, lon, and radius partial derivatives.
-   * @param coeffRHS The vector containing weighted x,y residuals.
-   * @param observationIndex The index of the observation containing the measure that
-   *                         the partial derivative matrices are for.
+   * This only changes pointNormals and measure, so it is called for many points at once from
+   * different threads.
    *
-   * @return @b bool If the matrices were successfully formed.
+   * @param pointNormals The normal equation matrices for the control point.
+   * @param measure The measure's partial derivatives and normal equation blocks.
    *
    * @see BundleAdjust::formNormalEquations
    */
-  bool BundleAdjust::formMeasureNormals(symmetric_matrix<double, upper>&N22,
-                                        SparseBlockColumnMatrix &N12,
-                                        compressed_vector<double> &n1,
-                                        vector<double> &n2,
-                                        matrix<double> &coeffTarget,
-                                        matrix<double> &coeffImage,
-                                        matrix<double> &coeffPoint3D,
-                                        vector<double> &coeffRHS,
-                                        int observationIndex) {
-
-    static symmetric_matrix<double, upper> N11;
-    static matrix<double> N11TargetImage;
+  void BundleAdjust::formMeasureNormals(PointNormals &pointNormals, MeasureNormals &measure) {
 
-    int blockIndex = observationIndex;
+    SparseBlockColumnMatrix &N12 = pointNormals.N12;
+    int blockIndex = measure.blockIndex;
 
     // if we are solving for target body parameters
-    int numTargetPartials = coeffTarget.size2();
+    int numTargetPartials = measure.coeffTarget.size2();
     if (m_bundleSettings->solveTargetBody()) {
-      blockIndex++;
-
-      static vector<double> n1Target(numTargetPartials);
-      n1Target.resize(numTargetPartials);
-      n1Target.clear();
 
       // form N11 (normals for target body)
-      N11.resize(numTargetPartials);
-      N11.clear();
-
-      N11 = prod(trans(coeffTarget), coeffTarget);
-
-      // insert submatrix at column, row
-      m_sparseNormals.insertMatrixBlock(0, 0, numTargetPartials, numTargetPartials);
-
-      (*(*m_sparseNormals[0])[0]) += N11;
+      measure.N11Target = prod(trans(measure.coeffTarget), measure.coeffTarget);
 
       // form portion of N11 between target and image
-      N11TargetImage.resize(numTargetPartials, coeffImage.size2());
-      N11TargetImage.clear();
-      N11TargetImage = prod(trans(coeffTarget),coeffImage);
-
-      m_sparseNormals.insertMatrixBlock(blockIndex, 0,
-                                        numTargetPartials, coeffImage.size2());
-      (*(*m_sparseNormals[blockIndex])[0]) += N11TargetImage;
+      measure.N11TargetImage = prod(trans(measure.coeffTarget), measure.coeffImage);
 
       // form N12 target portion
-      static matrix<double> N12Target(numTargetPartials, 3);
-      N12Target.clear();
-
-      N12Target = prod(trans(coeffTarget), coeffPoint3D);
+      matrix<double> N12Target = prod(trans(measure.coeffTarget), measure.coeffPoint3D);
 
       // insert N12Target into N12
       N12.insertMatrixBlock(0, numTargetPartials, 3);
       *N12[0] += N12Target;
 
       // form n1Target
-      n1Target = prod(trans(coeffTarget), coeffRHS);
-
-      // insert n1Target into n1
-      for (int i = 0; i < numTargetPartials; i++) {
-        n1(i) += n1Target(i);
-      }
+      measure.n1Target = prod(trans(measure.coeffTarget), measure.coeffRHS);
     }
 
+    int numImagePartials = measure.coeffImage.size2();
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ below is ok (2015-06-03)
-// TODO - if solving for target (and/or self-cal) have to use not observationIndex below but
-// observationIndex plus 1 or 2
+    // form N11 (normals for photo)
+    measure.N11Image = prod(trans(measure.coeffImage), measure.coeffImage);
+
+    // form N12Image
+    matrix<double> N12Image = prod(trans(measure.coeffImage), measure.coeffPoint3D);
 
-    int numImagePartials = coeffImage.size2();
+    // insert N12Image into N12
+    N12.insertMatrixBlock(blockIndex, numImagePartials, 3);
+    *N12[blockIndex] += N12Image;
 
-    static LinearAlgebra::Vector n1Image(numImagePartials);
-    n1Image.resize(numImagePartials);
-    n1Image.clear();
+    // form n1
+    measure.n1Image = prod(trans(measure.coeffImage), measure.coeffRHS);
 
-    // form N11 (normals for photo)
-    N11.resize(numImagePartials);
-    N11.clear();
+    // form N22
+    pointNormals.N22 += prod(trans(measure.coeffPoint3D), measure.coeffPoint3D);
 
-    N11 = prod(trans(coeffImage), coeffImage);
+    // form n2
+    pointNormals.n2 += prod(trans(measure.coeffPoint3D), measure.coeffRHS);
+  }
 
-    int t = m_sparseNormals.at(blockIndex)->startColumn();
 
-    // insert submatrix at column, row
-    m_sparseNormals.insertMatrixBlock(blockIndex, blockIndex,
-                                      numImagePartials, numImagePartials);
+  /**
+   * Add a measure's N11 and n1 blocks, formed by formMeasureNormals(), to the normal equations.
+   *
+   * @param measure The measure's normal equation blocks.
+   * @param n1 The right hand side vector for the camera and the target body.
+   *
+   * @see BundleAdjust::formNormalEquations
+   */
+  void BundleAdjust::accumulateMeasureNormals(MeasureNormals &measure,
+                                              compressed_vector<double> &n1) {
 
-    (*(*m_sparseNormals[blockIndex])[blockIndex]) += N11;
+    int blockIndex = measure.blockIndex;
 
-    // form N12Image
-    static matrix<double> N12Image(numImagePartials, 3);
-    N12Image.resize(numImagePartials, 3);
-    N12Image.clear();
+    if (m_bundleSettings->solveTargetBody()) {
+      int numTargetPartials = measure.N11Target.size1();
+
+      // insert submatrix at column, row
+      m_sparseNormals.insertMatrixBlock(0, 0, numTargetPartials, numTargetPartials);
 
-    N12Image = prod(trans(coeffImage), coeffPoint3D);
+      (*(*m_sparseNormals[0])[0]) += measure.N11Target;
 
-    // insert N12Image into N12
-    N12.insertMatrixBlock(blockIndex, numImagePartials, 3);
-    *N12[blockIndex] += N12Image;
+      m_sparseNormals.insertMatrixBlock(blockIndex, 0,
+                                        numTargetPartials, measure.N11TargetImage.size2());
+      (*(*m_sparseNormals[blockIndex])[0]) += measure.N11TargetImage;
 
-    // form n1
-    n1Image = prod(trans(coeffImage), coeffRHS);
+      // insert n1Target into n1
+      for (int i = 0; i < numTargetPartials; i++) {
+        n1(i) += measure.n1Target(i);
+      }
+    }
+
+    int numImagePartials = measure.N11Image.size1();
+
+    int t = m_sparseNormals.at(blockIndex)->startColumn();
+
+    // insert submatrix at column, row
+    m_sparseNormals.insertMatrixBlock(blockIndex, blockIndex,
+                                      numImagePartials, numImagePartials);
+
+    (*(*m_sparseNormals[blockIndex])[blockIndex]) += measure.N11Image;
 
     // insert n1Image into n1
     // TODO - MUST ACCOUNT FOR TARGET BODY PARAMETERS
     // WHEN INSERTING INTO n1 HERE!!!!!
     for (int i = 0; i < numImagePartials; i++) {
-      n1(i + t) += n1Image(i);
+      n1(i + t) += measure.n1Image(i);
     }
+  }
 
-    // form N22
-    N22 += prod(trans(coeffPoint3D), coeffPoint3D);
 
-    // form n2
-    n2 += prod(trans(coeffPoint3D), coeffRHS);
+  /**
+   * Form the measure and point normals for a batch of control points whose partials have been
+   * computed and add them to the normal equations. The normals are formed in parallel using the
+   * global thread pool, each point into its own matrices, then accumulated in point order.
+   *
+   * @param batch The points' normal equation matrices.
+   * @param batchSize The number of points at the front of batch to use.
+   * @param n1 The right hand side vector for the camera and the target body.
+   *
+   * @see BundleAdjust::formNormalEquations
+   */
+  void BundleAdjust::formBatchPointNormals(QVector<PointNormals> &batch, int batchSize,
+                                           compressed_vector<double> &n1) {
+    if (batchSize <= 0) {
+      return;
+    }
 
-    return true;
+    QtConcurrent::blockingMap(batch.begin(), batch.begin() + batchSize,
+                              [this](PointNormals &pointNormals) {
+                                for (int i = 0; i < pointNormals.measureCount; i++) {
+                                  formMeasureNormals(pointNormals, pointNormals.measures[i]);
+                                }
+                                formPointNormals(pointNormals);
+                              });
+
+    for (int i = 0; i < batchSize; i++) {
+      PointNormals &pointNormals = batch[i];
+      for (int j = 0; j < pointNormals.measureCount; j++) {
+        accumulateMeasureNormals(pointNormals.measures[j], n1);
+      }
+      accumulatePointNormals(pointNormals, m_RHS);
+      pointNormals.point.clear();
+    }
   }
 
 
@@ -1268,24 +1318,23 @@ namespace Isis {
    * Compute the Q matrix and NIC vector for a control point.  The inputs N22, N12, and n2
    * come from calling formMeasureNormals() with the control point's measures.
    * The Q matrix and NIC vector are stored in the BundleControlPoint.
-   * R = N12 x Q is accumulated into m_sparseNormals.
+   * The products R = N12 x Q and Q(transpose) x n2 are stored in pointNormals so that
+   * accumulatePointNormals() can add them to the reduced normal equations.
    *
-   * @param N22 The normal equation matrix for the point on the body.
-   * @param N12 The normal equation matrix for the camera and the target body.
-   * @param n2 The right hand side vector for the point on the body.
-   * @param nj The output right hand side vector.
-   * @param bundleControlPoint The control point that the Q matrixs are NIC vector
-   *                           are being formed for.
+   * This only changes pointNormals and its control point, so it is called for many points at
+   * once from different threads.
+   *
+   * @param pointNormals The normal equation matrices for the control point.
    *
    * @return @b bool If the matrices were successfully formed.
    *
    * @see BundleAdjust::formNormalEquations
    */
-  bool BundleAdjust::formPointNormals(symmetric_matrix<double, upper>&N22,
-                                      SparseBlockColumnMatrix &N12,
-                                      vector<double> &n2,
-                                      vector<double> &nj,
-                                      BundleControlPointQsp &bundleControlPoint) {
+  bool BundleAdjust::formPointNormals(PointNormals &pointNormals) {
+
+    BundleControlPointQsp &bundleControlPoint = pointNormals.point;
+    symmetric_matrix<double, upper> &N22 = pointNormals.N22;
+    vector<double> &n2 = pointNormals.n2;
 
     boost::numeric::ublas::bounded_vector<double, 3> &NIC = bundleControlPoint->nicVector();
     SparseBlockRowMatrix &Q = bundleControlPoint->cholmodQMatrix();
@@ -1293,6 +1342,8 @@ namespace Isis {
     NIC.clear();
     Q.zeroBlocks();
 
+    pointNormals.numConstrainedParameters = 0;
+
     // weighting of 3D point parameters
     // Make sure weights are in the units corresponding to the bundle coordinate type
     boost::numeric::ublas::bounded_vector<double, 3> &weights
@@ -1303,19 +1354,19 @@ namespace Isis {
     if (weights(0) > 0.0) {
       N22(0,0) += weights(0);
       n2(0) += (-weights(0) * corrections(0));
-      m_bundleResults.incrementNumberConstrainedPointParameters(1);
+      pointNormals.numConstrainedParameters++;
     }
 
     if (weights(1) > 0.0) {
       N22(1,1) += weights(1);
       n2(1) += (-weights(1) * corrections(1));
-      m_bundleResults.incrementNumberConstrainedPointParameters(1);
+      pointNormals.numConstrainedParameters++;
     }
 
     if (weights(2) > 0.0) {
       N22(2,2) += weights(2);
       n2(2) += (-weights(2) * corrections(2));
-      m_bundleResults.incrementNumberConstrainedPointParameters(1);
+      pointNormals.numConstrainedParameters++;
     }
 
     // invert N22
@@ -1327,21 +1378,83 @@ namespace Isis {
     bundleControlPoint->setAdjustedSurfacePoint(SurfacePoint);
 
     // form Q (this is N22{-1} * N12{T})
-    productATransB(N22, N12, Q);
+    productATransB(N22, pointNormals.N12, Q);
 
     // form product of N22(inverse) and n2; store in NIC
     NIC = prod(N22, n2);
 
-    // accumulate -R directly into reduced normal equations
-    productAB(N12, Q);
+    // form R for the reduced normal equations
+    productAB(pointNormals.N12, Q, pointNormals.R);
 
-    // accumulate -nj
-    accumProductAlphaAB(-1.0, Q, n2, nj);
+    // form the point's part of nj
+    productATransV(Q, n2, pointNormals.nj);
 
     return true;
   }
 
 
+  /**
+   * Add a control point's contribution, formed by formPointNormals(), to the reduced normal
+   * equations. -R is accumulated into m_sparseNormals and -Q(transpose) x n2 into nj.
+   *
+   * @param pointNormals The normal equation matrices for the control point.
+   * @param nj The output right hand side vector.
+   *
+   * @see BundleAdjust::formNormalEquations
+   */
+  void BundleAdjust::accumulatePointNormals(PointNormals &pointNormals, vector<double> &nj) {
+
+    m_bundleResults.incrementNumberConstrainedPointParameters(
+        pointNormals.numConstrainedParameters);
+
+    SparseBlockColumnMatrix &N12 = pointNormals.N12;
+    SparseBlockRowMatrix &Q = pointNormals.point->cholmodQMatrix();
+
+    // walk N12 and Q in the same order as productAB
+    QMapIterator<int, LinearAlgebra::Matrix*> N12it(N12);
+    QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
+    int productIndex = 0;
+
+    while ( N12it.hasNext() ) {
+      N12it.next();
+
+      int rowIndex = N12it.key();
+
+      while ( Qit.hasNext() ) {
+        Qit.next();
+
+        int columnIndex = Qit.key();
+
+        if ( rowIndex > columnIndex ) {
+          continue;
+        }
+
+        // insert submatrix at column, row
+        m_sparseNormals.insertMatrixBlock(columnIndex, rowIndex,
+                                          N12it.value()->size1(), Qit.value()->size2());
+
+        (*(*m_sparseNormals[columnIndex])[rowIndex]) -= pointNormals.R[productIndex];
+        productIndex++;
+      }
+      Qit.toFront();
+    }
+
+    // accumulate -nj
+    int blockIndex = 0;
+    while ( Qit.hasNext() ) {
+      Qit.next();
+
+      const LinearAlgebra::Vector &blockProduct = pointNormals.nj[blockIndex];
+      int numParams = m_sparseNormals.at(Qit.key())->startColumn();
+
+      for (unsigned i = 0; i < blockProduct.size(); i++) {
+        nj(numParams+i) += -1.0*blockProduct(i);
+      }
+      blockIndex++;
+    }
+  }
+
+
   /**
    * Apply weighting for spacecraft position, velocity, acceleration and camera angles, angular
    * velocities, angular accelerations if so stipulated (legalese).
@@ -1446,21 +1559,25 @@ namespace Isis {
 
 
   /**
-   * Perform the matrix multiplication C = N12 x Q.
-   * The result, C, is stored in m_sparseNormals.
+   * Perform the matrix multiplication C = N12 x Q for every pair of blocks that falls in the
+   * upper triangle of the normal equations matrix.
    *
    * @param N12 A sparse block matrix.
    * @param Q A sparse block matrix
+   * @param C The output products, in the order of the N12 blocks and then the Q blocks.
    *
    * @see BundleAdjust::formPointNormals
    */
   void BundleAdjust::productAB(SparseBlockColumnMatrix &N12,
-                               SparseBlockRowMatrix &Q) {
+                               SparseBlockRowMatrix &Q,
+                               QList<LinearAlgebra::Matrix> &C) {
+    C.clear();
+
     // iterators for N12 and Q
     QMapIterator<int, LinearAlgebra::Matrix*> N12it(N12);
     QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
 
-    // now multiply blocks and subtract from m_sparseNormals
+    // now multiply blocks
     while ( N12it.hasNext() ) {
       N12it.next();
 
@@ -1478,11 +1595,7 @@ namespace Isis {
 
         LinearAlgebra::Matrix *Qblock = Qit.value();
 
-        // insert submatrix at column, row
-        m_sparseNormals.insertMatrixBlock(columnIndex, rowIndex,
-                                          N12block->size1(), Qblock->size2());
-
-        (*(*m_sparseNormals[columnIndex])[rowIndex]) -= prod(*N12block,*Qblock);
+        C.append(prod(*N12block,*Qblock));
       }
       Qit.toFront();
     }
@@ -1490,41 +1603,25 @@ namespace Isis {
 
 
   /**
-   * Performs the matrix multiplication nj = nj + alpha (Q x n2).
+   * Performs the matrix multiplication C = Q(transpose) x v, one product per block of Q.
    *
-   * @param alpha A constant multiplier.
    * @param Q A sparse block matrix.
-   * @param n2 A vector.
-   * @param nj The output accumulation vector.
+   * @param v A vector.
+   * @param C The output products, in the order of the Q blocks.
    *
    * @see BundleAdjust::formPointNormals
    */
-  void BundleAdjust::accumProductAlphaAB(double alpha,
-                                         SparseBlockRowMatrix &Q,
-                                         vector<double> &n2,
-                                         vector<double> &nj) {
-
-    if (alpha == 0.0) {
-      return;
-    }
-
-    int numParams;
+  void BundleAdjust::productATransV(SparseBlockRowMatrix &Q,
+                                    vector<double> &v,
+                                    QList<LinearAlgebra::Vector> &C) {
+    C.clear();
 
     QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
 
     while ( Qit.hasNext() ) {
       Qit.next();
 
-      int columnIndex = Qit.key();
-      LinearAlgebra::Matrix *Qblock = Qit.value();
-
-      LinearAlgebra::Vector blockProduct = prod(trans(*Qblock),n2);
-
-      numParams = m_sparseNormals.at(columnIndex)->startColumn();
-
-      for (unsigned i = 0; i < blockProduct.size(); i++) {
-        nj(numParams+i) += alpha*blockProduct(i);
-      }
+      C.append(prod(trans(*Qit.value()),v));
     }
   }
 
@@ -1532,32 +1629,47 @@ namespace Isis {
   /**
    * Compute the solution to the normal equations using the CHOLMOD library.
    *
+   * The symbolic analysis of the normal equations matrix (the fill reducing ordering and the
+   * structure of m_L) only depends on its sparsity pattern, so it is done on the first iteration
+   * and then only redone if the pattern changes. Later iterations only refactor numerically.
+   *
    * @return @b bool If the solution was successfully computed.
    *
-   * @throws IException::Programmer "CHOLMOD: Failed to load Triplet matrix"
+   * @throws IException::Programmer "CHOLMOD: Failed to load sparse matrix"
    *
    * @see BundleAdjust::solveCholesky
    */
   bool BundleAdjust::solveSystem() {
 
-    // load cholmod triplet
-    if ( !loadCholmodTriplet() ) {
-      QString msg = "CHOLMOD: Failed to load Triplet matrix";
+    // load cholmod sparse matrix
+    if ( !loadCholmodSparse() ) {
+      QString msg = "CHOLMOD: Failed to load sparse matrix";
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    // convert triplet to sparse matrix
-    m_cholmodNormal = cholmod_triplet_to_sparse(m_cholmodTriplet,
-                                                m_cholmodTriplet->nnz,
-                                                &m_cholmodCommon);
+    QElapsedTimer phaseTimer;
+
+    // analyze matrix, only when the pattern of the normal equations has changed
+    if ( !m_L || m_cholmodPatternChanged ) {
+      phaseTimer.start();
+
+      cholmod_free_factor(&m_L, &m_cholmodCommon);
+      m_L = cholmod_analyze(m_cholmodNormal, &m_cholmodCommon);
+
+      if ( !m_L ) {
+        QString msg = "CHOLMOD: Failed to analyze sparse matrix";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
 
-    // analyze matrix
-    // TODO should we analyze just 1st iteration?
-    m_L = cholmod_analyze(m_cholmodNormal, &m_cholmodCommon);
+      m_cholmodPatternChanged = false;
+      m_bundleResults.addElapsedTimeAnalyze(phaseTimer.nsecsElapsed() / 1.0e9);
+    }
 
     // create cholmod cholesky factor
     // CHOLMOD will choose LLT or LDLT decomposition based on the characteristics of the matrix.
+    phaseTimer.start();
     cholmod_factorize(m_cholmodNormal, m_L, &m_cholmodCommon);
+    m_bundleResults.addElapsedTimeFactorize(phaseTimer.nsecsElapsed() / 1.0e9);
 
     // check for "matrix not positive definite" error
     if (m_cholmodCommon.status == CHOLMOD_NOT_POSDEF) {
@@ -1571,6 +1683,8 @@ namespace Isis {
     // cholmod solution and right-hand side vectors
     cholmod_dense *x, *b;
 
+    phaseTimer.start();
+
     // initialize right-hand side vector
     b = cholmod_zeros(m_cholmodNormal->nrow, 1, m_cholmodNormal->xtype, &m_cholmodCommon);
 
@@ -1589,133 +1703,167 @@ namespace Isis {
       m_imageSolution[i] = sx[i];
     }
 
-    // free cholmod structures
-    cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
+    // free cholmod structures, m_cholmodNormal is reused by the next iteration
     cholmod_free_dense(&b, &m_cholmodCommon);
     cholmod_free_dense(&x, &m_cholmodCommon);
 
+    m_bundleResults.addElapsedTimeSolve(phaseTimer.nsecsElapsed() / 1.0e9);
+
     return true;
   }
 
 
   /**
-   * @brief Load sparse normal equations matrix into CHOLMOD triplet.
+   * @brief Load sparse normal equations matrix into a CHOLMOD sparse matrix.
    *
-   * Blocks from the sparse block normal matrix are loaded into a CHOLMOD triplet.
-   * Before the triplet can be used with CHOLMOD, it must be converted to a
-   * CHOLMOD sparse matrix via cholmod_triplet_to_sparse.
+   * Blocks from the sparse block normal matrix are copied straight into the compressed column
+   * arrays of m_cholmodNormal, which stores the upper triangle of the normal equations matrix.
+   * Every block in a block column shares the block column's columns and the blocks are kept in
+   * row order, so each column's row indices come out sorted without a triplet intermediate.
    *
-   * @return @b bool If the triplet was successfully formed.
+   * m_cholmodNormal is kept between iterations and only reallocated when the normal equations
+   * matrix grows, so after the first iteration only the values are rewritten. The column
+   * pointers and row indices are compared with the previous ones as they are written, and
+   * m_cholmodPatternChanged is set if they differ.
+   *
+   * The normal equations are still accumulated block by block in m_sparseNormals (the measure
+   * normals, the point reduction and the parameter weights all add into it), so every
+   * iteration keeps both copies in memory and copies the values across here.
+   *
+   * @return @b bool If the sparse matrix was successfully formed.
    *
    * @see BundleAdjust::solveSystem
    */
-  bool BundleAdjust::loadCholmodTriplet() {
-
-    if ( m_iteration == 1 ) {
-      int numElements = m_sparseNormals.numberOfElements();
-      m_cholmodTriplet = cholmod_allocate_triplet(m_rank, m_rank, numElements,
-                                                  -1, CHOLMOD_REAL, &m_cholmodCommon);
-
-      if ( !m_cholmodTriplet ) {
-        outputBundleStatus("\nTriplet allocation failure\n");
-        return false;
-      }
-
-      m_cholmodTriplet->nnz = 0;
-    }
+  bool BundleAdjust::loadCholmodSparse() {
 
-    int *tripletColumns = (int*) m_cholmodTriplet->i;
-    int *tripletRows = (int*) m_cholmodTriplet->j;
-    double *tripletValues = (double*)m_cholmodTriplet->x;
-
-    double entryValue;
-
-    int numEntries = 0;
+    int numBlockColumns = m_sparseNormals.size();
 
-    int numBlockcolumns = m_sparseNormals.size();
-    for (int columnIndex = 0; columnIndex < numBlockcolumns; columnIndex++) {
+    // count the entries in the upper triangle
+    size_t numEntries = 0;
+    for (int columnIndex = 0; columnIndex < numBlockColumns; columnIndex++) {
 
       SparseBlockColumnMatrix *normalsColumn = m_sparseNormals[columnIndex];
 
       if ( !normalsColumn ) {
-        QString status = "\nSparseBlockColumnMatrix retrieval failure at column " + 
+        QString status = "\nSparseBlockColumnMatrix retrieval failure at column " +
                          QString::number(columnIndex);
         outputBundleStatus(status);
         return false;
       }
 
-      int numLeadingColumns = normalsColumn->startColumn();
+      int numColumns = blockColumnWidth(columnIndex);
 
       QMapIterator< int, LinearAlgebra::Matrix * > it(*normalsColumn);
-
       while ( it.hasNext() ) {
         it.next();
 
-        int rowIndex = it.key();
-
-        // note: as the normal equations matrix is symmetric, the # of leading rows for a block is
-        //       equal to the # of leading columns for a block column at the "rowIndex" position
-        int numLeadingRows = m_sparseNormals.at(rowIndex)->startColumn();
-
-        LinearAlgebra::Matrix *normalsBlock = it.value();
-        if ( !normalsBlock ) {
-          QString status = "\nmatrix block retrieval failure at column ";
-          status.append(columnIndex);
-          status.append(", row ");
-          status.append(rowIndex);
+        if ( !it.value() ) {
+          QString status = "\nmatrix block retrieval failure at column " +
+                           QString::number(columnIndex) + ", row " + QString::number(it.key());
           outputBundleStatus(status);
-          status = "Total # of block columns: " + QString::number(numBlockcolumns);
+          status = "Total # of block columns: " + QString::number(numBlockColumns);
           outputBundleStatus(status);
           status = "Total # of blocks: " + QString::number(m_sparseNormals.numberOfBlocks());
           outputBundleStatus(status);
           return false;
         }
 
-        if ( columnIndex == rowIndex )  {   // diagonal block (upper-triangular)
-          for (unsigned ii = 0; ii < normalsBlock->size1(); ii++) {
-            for (unsigned jj = ii; jj < normalsBlock->size2(); jj++) {
-              entryValue = normalsBlock->at_element(ii,jj);
-              int entryColumnIndex = jj + numLeadingColumns;
-              int entryRowIndex = ii + numLeadingRows;
+        if ( it.key() == columnIndex ) {
+          numEntries += numColumns * (numColumns + 1) / 2;
+        }
+        else {
+          numEntries += it.value()->size1() * numColumns;
+        }
+      }
+    }
+
+    if ( !m_cholmodNormal || m_cholmodNormal->nzmax < numEntries ) {
+      cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
+      m_cholmodNormal = cholmod_allocate_sparse(m_rank, m_rank, numEntries, true, true, 1,
+                                                CHOLMOD_REAL, &m_cholmodCommon);
 
-              if ( m_iteration == 1 ) {
-                tripletColumns[numEntries] = entryColumnIndex;
-                tripletRows[numEntries] = entryRowIndex;
-                m_cholmodTriplet->nnz++;
-              }
+      if ( !m_cholmodNormal ) {
+        outputBundleStatus("\nSparse matrix allocation failure\n");
+        return false;
+      }
 
-              tripletValues[numEntries] = entryValue;
+      m_cholmodPatternChanged = true;
+    }
 
-              numEntries++;
-            }
-          }
+    bool patternChanged = m_cholmodPatternChanged;
+
+    int *columnStarts = (int*) m_cholmodNormal->p;
+    int *rowIndices = (int*) m_cholmodNormal->i;
+    double *values = (double*) m_cholmodNormal->x;
+
+    int entryIndex = 0;
+
+    for (int columnIndex = 0; columnIndex < numBlockColumns; columnIndex++) {
+
+      SparseBlockColumnMatrix *normalsColumn = m_sparseNormals[columnIndex];
+
+      int numLeadingColumns = normalsColumn->startColumn();
+      int numColumns = blockColumnWidth(columnIndex);
+
+      for (int jj = 0; jj < numColumns; jj++) {
+        if ( patternChanged || columnStarts[numLeadingColumns + jj] != entryIndex ) {
+          patternChanged = true;
+          columnStarts[numLeadingColumns + jj] = entryIndex;
         }
-        else {                // off-diagonal block (square)
-          for (unsigned ii = 0; ii < normalsBlock->size1(); ii++) {
-            for (unsigned jj = 0; jj < normalsBlock->size2(); jj++) {
-              entryValue = normalsBlock->at_element(ii,jj);
-              int entryColumnIndex = jj + numLeadingColumns;
-              int entryRowIndex = ii + numLeadingRows;
-
-              if ( m_iteration ==1 ) {
-                tripletColumns[numEntries] = entryRowIndex;
-                tripletRows[numEntries] = entryColumnIndex;
-                m_cholmodTriplet->nnz++;
-              }
 
-              tripletValues[numEntries] = entryValue;
+        QMapIterator< int, LinearAlgebra::Matrix * > it(*normalsColumn);
+        while ( it.hasNext() ) {
+          it.next();
+
+          int rowIndex = it.key();
+          LinearAlgebra::Matrix *normalsBlock = it.value();
+
+          // note: as the normal equations matrix is symmetric, the # of leading rows for a block
+          //       is equal to the # of leading columns for a block column at the "rowIndex"
+          //       position
+          int numLeadingRows = m_sparseNormals.at(rowIndex)->startColumn();
 
-              numEntries++;
+          // only the upper triangle of the diagonal block is used
+          unsigned numRows = (rowIndex == columnIndex) ? jj + 1 : normalsBlock->size1();
+
+          for (unsigned ii = 0; ii < numRows; ii++) {
+            if ( patternChanged || rowIndices[entryIndex] != (int) (numLeadingRows + ii) ) {
+              patternChanged = true;
+              rowIndices[entryIndex] = numLeadingRows + ii;
             }
+            values[entryIndex] = normalsBlock->at_element(ii, jj);
+            entryIndex++;
           }
         }
       }
     }
 
+    if ( patternChanged || columnStarts[m_rank] != entryIndex ) {
+      patternChanged = true;
+      columnStarts[m_rank] = entryIndex;
+    }
+
+    m_cholmodPatternChanged = patternChanged;
+
     return true;
   }
 
 
+  /**
+   * @param columnIndex The index of a block column of the normal equations matrix.
+   *
+   * @return @b int The number of parameters (matrix columns) in the block column.
+   */
+  int BundleAdjust::blockColumnWidth(int columnIndex) const {
+    int nextStartColumn = m_rank;
+    if ( columnIndex + 1 < m_sparseNormals.size() ) {
+      nextStartColumn = m_sparseNormals.at(columnIndex + 1)->startColumn();
+    }
+
+    return nextStartColumn - m_sparseNormals.at(columnIndex)->startColumn();
+  }
+
+
   /**
    * Compute inverse of normal equations matrix for CHOLMOD.
    * The inverse is stored in m_normalInverse.
@@ -1819,6 +1967,9 @@ namespace Isis {
    * @return @b bool If the partials were successfully computed.
    *
    * @throws IException::User "Unable to map apriori surface point for measure"
+   *
+   * @note This uses the measure's camera and CSPICE, so it must only be called from one
+   *       thread; see formNormalEquations().
    */
   bool BundleAdjust::computePartials(matrix<double> &coeffTarget,
                                      matrix<double> &coeffImage,
@@ -2583,10 +2734,8 @@ namespace Isis {
   bool BundleAdjust::errorPropagation() {
     emit(statusBarUpdate("Error Propagation"));
     // free unneeded memory
-    cholmod_free_triplet(&m_cholmodTriplet, &m_cholmodCommon);
     cholmod_free_sparse(&m_cholmodNormal, &m_cholmodCommon);
 
-    LinearAlgebra::Matrix T(3, 3);
     // *** TODO *** 
     // Can any of the control point specific code be moved to BundleControlPoint?
 
@@ -2608,31 +2757,157 @@ namespace Isis {
       pointCovariances[d].clear();
     }
 
-    cholmod_dense *x;        // solution vector
-    cholmod_dense *b;        // right-hand side (column vectors of identity)
+    // The column by column inverse is only needed to write the inverse matrix file
+    if (m_bundleSettings->createInverseMatrix()) {
+      errorPropagationInverseColumns(pointCovariances);
+    }
+    else {
+      errorPropagationSelectedInverse(pointCovariances);
+    }
 
-    b = cholmod_zeros ( m_rank, 1, CHOLMOD_REAL, &m_cholmodCommon );
-    double *pb = (double*)b->x;
+    // can free sparse normals now
+    m_sparseNormals.wipe();
 
-    double *px = NULL;
+    outputBundleStatus("\n\n");
+     
+    currentTime = Isis::iTime::CurrentLocalTime().toLatin1().data();
+    
+    status = "\rFilling point covariance matrices: Time ";
+    status.append(currentTime.c_str());
+    outputBundleStatus(status);
+    outputBundleStatus("\n\n");
 
-    SparseBlockColumnMatrix inverseMatrix;
+    // now loop over points again and set final covariance stuff
+    // *** TODO *** Can this loop go into BundleControlPoint
+    int pointIndex = 0;
+    for (int j = 0; j < numObjectPoints; j++) {
 
-    // Create unique file name
-    FileName matrixFile(m_bundleSettings->outputFilePrefix() + "inverseMatrix.dat");
-    //???FileName matrixFile = FileName::createTempFile(m_bundleSettings.outputFilePrefix()
-    //???                                               + "inverseMatrix.dat");
-    // Create file handle
-    QFile matrixOutput(matrixFile.expanded());
+      BundleControlPointQsp point = m_bundleControlPoints.at(pointIndex);
 
-    // Check to see if creating the inverse correlation matrix is turned on
-    if (m_bundleSettings->createInverseMatrix()) {
-      // Open file to write to
-      matrixOutput.open(QIODevice::WriteOnly);
-    }
-    QDataStream outStream(&matrixOutput);
+      if ( point->isRejected() ) {
+        pointIndex++;
+        continue;
+      }
 
-    int i, j, k;
+      if (j%100 == 0) {
+        status = "\rError Propagation: Filling point covariance matrices ";
+        status.append(QString("%1").arg(j+1));
+        status.append(" of ");
+        status.append(QString("%1").arg(numObjectPoints));
+        status.append("\r");
+        outputBundleStatus(status);
+      }
+
+      // get corresponding point covariance matrix
+      boost::numeric::ublas::symmetric_matrix<double> &covariance = pointCovariances[pointIndex];
+
+      // Update and reset the matrix
+      // Get the Limiting Error Propagation uncertainties:  sigmas for coordinate 1, 2, and 3 in meters
+      // 
+      SurfacePoint SurfacePoint = point->adjustedSurfacePoint();
+
+      // Get the TEP by adding the corresponding members of pCovar and covariance      
+      boost::numeric::ublas::symmetric_matrix <double,boost::numeric::ublas::upper> pCovar;
+      
+      if (m_bundleSettings->controlPointCoordTypeBundle() == SurfacePoint::Latitudinal) {
+        pCovar = SurfacePoint.GetSphericalMatrix(SurfacePoint::Kilometers);
+      }
+      else {
+        // Assume Rectangular coordinates 
+        pCovar = SurfacePoint.GetRectangularMatrix(SurfacePoint::Kilometers);
+      }
+      pCovar += covariance;
+      pCovar *= sigma0Squared;
+
+      // debug lines
+      // if (j < 3) {
+      //   std::cout << " Adjusted surface point ..." << std::endl;
+      //   std:: cout << "     sigmaLat (radians) = " << sqrt(pCovar(0,0)) << std::endl;
+      //   std:: cout << "     sigmaLon (radians) = " << sqrt(pCovar(1,1)) << std::endl;
+      //   std:: cout << "     sigmaRad (km) = " << sqrt(pCovar(2,2)) << std::endl;
+      // std::cout <<  "      Adjusted matrix = " << std::endl;
+      // std::cout << "       " << pCovar(0,0) << "   " << pCovar(0,1) << "   "
+      //           << pCovar(0,2) << std::endl; 
+      // std::cout << "        " << pCovar(1,0) << "   " << pCovar(1,1) << "   "
+      //           << pCovar(1,2) << std::endl; 
+      // std::cout << "        " << pCovar(2,0) << "   " << pCovar(2,1) << "   "
+      //           << pCovar(2,2) << std::endl;
+      // }
+      // end debug
+      
+      // Distance units are km**2
+      SurfacePoint.SetMatrix(m_bundleSettings->controlPointCoordTypeBundle(),pCovar);
+      point->setAdjustedSurfacePoint(SurfacePoint);
+      // // debug lines
+      // if (j < 3) {
+      //   boost::numeric::ublas::symmetric_matrix <double,boost::numeric::ublas::upper> recCovar;
+      //   recCovar = SurfacePoint.GetRectangularMatrix(SurfacePoint::Meters);
+      //   std:: cout << "     sigmaLat (meters) = " << 
+      //     point->adjustedSurfacePoint().GetSigmaDistance(SurfacePoint::Latitudinal,
+      //     SurfacePoint::One).meters() << std::endl;
+      //   std:: cout << "     sigmaLon (meters) = " <<
+      //     point->adjustedSurfacePoint().GetSigmaDistance(SurfacePoint::Latitudinal,
+      //     SurfacePoint::Two).meters() << std::endl;
+      //   std:: cout << "   sigmaRad (km) = " << sqrt(pCovar(2,2)) << std::endl;
+      //   std::cout << "Rectangular matrix with radius in meters" << std::endl;
+      //   std::cout << "       " << recCovar(0,0) << "   " << recCovar(0,1) << "   "
+      //           << recCovar(0,2) << std::endl; 
+      //   std::cout << "        " << recCovar(1,0) << "   " << recCovar(1,1) << "   "
+      //           << recCovar(1,2) << std::endl; 
+      //   std::cout << "        " << recCovar(2,0) << "   " << recCovar(2,1) << "   "
+      //           << recCovar(2,2) << std::endl;
+      // }
+      // // end debug
+
+      pointIndex++;
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Sum the image and target body contributions to the point covariance matrices by solving
+   * for the inverse of the normal equations matrix one column at a time. Each block column of
+   * the inverse is written to the inverse matrix file, so this is only used when the inverse
+   * correlation matrix is requested. It also sets the adjusted image and target body sigmas.
+   *
+   * @param pointCovariances The point covariance matrices, indexed like m_bundleControlPoints.
+   *
+   * @throws IException::User "Input data and settings are not sufficiently stable
+   *                           for error propagation."
+   *
+   * @see BundleAdjust::errorPropagation
+   */
+  void BundleAdjust::errorPropagationInverseColumns(
+      std::vector< symmetric_matrix<double> > &pointCovariances) {
+    QElapsedTimer inverseTimer;
+    cholmod_dense *x;        // solution vector
+    cholmod_dense *b;        // right-hand side (column vectors of identity)
+
+    b = cholmod_zeros ( m_rank, 1, CHOLMOD_REAL, &m_cholmodCommon );
+    double *pb = (double*)b->x;
+
+    double *px = NULL;
+
+    SparseBlockColumnMatrix inverseMatrix;
+
+    // Create unique file name
+    FileName matrixFile(m_bundleSettings->outputFilePrefix() + "inverseMatrix.dat");
+    //???FileName matrixFile = FileName::createTempFile(m_bundleSettings.outputFilePrefix()
+    //???                                               + "inverseMatrix.dat");
+    // Create file handle
+    QFile matrixOutput(matrixFile.expanded());
+
+    // Open file to write to
+    matrixOutput.open(QIODevice::WriteOnly);
+    QDataStream outStream(&matrixOutput);
+
+    LinearAlgebra::Matrix T(3, 3);
+
+    int numObjectPoints = m_bundleControlPoints.size();
+
+    int i, j, k;
     int columnIndex = 0;
     int numColumns = 0;
     int numBlockColumns = m_sparseNormals.size();
@@ -2677,7 +2952,9 @@ namespace Isis {
         }
         pb[columnIndex] = 1.0;
 
+        inverseTimer.start();
         x = cholmod_solve ( CHOLMOD_A, m_L, b, &m_cholmodCommon );
+        m_bundleResults.addElapsedTimeInverse(inverseTimer.nsecsElapsed() / 1.0e9);
         px = (double*)x->x;
         int rp = 0;
 
@@ -2723,10 +3000,8 @@ namespace Isis {
         }
       }
 
-      // Output the inverse matrix if requested
-      if (m_bundleSettings->createInverseMatrix()) {
-        outStream << inverseMatrix;
-      }
+      // Output the inverse matrix
+      outStream << inverseMatrix;
 
       // now loop over all object points to sum contributions into 3x3 point covariance matrix
       int pointIndex = 0;
@@ -2734,6 +3009,7 @@ namespace Isis {
         emit(pointUpdate(j+1));
         BundleControlPointQsp point = m_bundleControlPoints.at(pointIndex);
         if ( point->isRejected() ) {
+          pointIndex++;
           continue;
         }
 
@@ -2813,113 +3089,265 @@ namespace Isis {
       }
     }
 
-    if (m_bundleSettings->createInverseMatrix()) {
-      // Close the file.
-      matrixOutput.close();
-      // Save the location of the "covariance" matrix
-      m_bundleResults.setCorrMatCovFileName(matrixFile);
-    }
-
-    // can free sparse normals now
-    m_sparseNormals.wipe();
+    // Close the file.
+    matrixOutput.close();
+    // Save the location of the "covariance" matrix
+    m_bundleResults.setCorrMatCovFileName(matrixFile);
 
     // free b (right-hand side vector
     cholmod_free_dense(&b,&m_cholmodCommon);
+  }
 
-    outputBundleStatus("\n\n");
-     
-    currentTime = Isis::iTime::CurrentLocalTime().toLatin1().data();
-    
-    status = "\rFilling point covariance matrices: Time ";
-    status.append(currentTime.c_str());
-    outputBundleStatus(status);
-    outputBundleStatus("\n\n");
 
-    // now loop over points again and set final covariance stuff
-    // *** TODO *** Can this loop go into BundleControlPoint
-    int pointIndex = 0;
-    for (j = 0; j < numObjectPoints; j++) {
+  /**
+   * Sum the image and target body contributions to the point covariance matrices using the
+   * blocks of the inverse of the normal equations matrix formed by selectedInverse(). It also
+   * sets the adjusted image and target body sigmas.
+   *
+   * The points only read the inverse, so their covariance matrices are summed in parallel.
+   *
+   * @param pointCovariances The point covariance matrices, indexed like m_bundleControlPoints.
+   *
+   * @throws IException::User "Input data and settings are not sufficiently stable
+   *                           for error propagation."
+   *
+   * @see BundleAdjust::errorPropagation
+   */
+  void BundleAdjust::errorPropagationSelectedInverse(
+      std::vector< symmetric_matrix<double> > &pointCovariances) {
 
-      BundleControlPointQsp point = m_bundleControlPoints.at(pointIndex);
+    outputBundleStatus("\rError Propagation: Selected Inverse");
 
-      if ( point->isRejected() ) {
-        continue;
+    SparseBlockMatrix inverse;
+
+    QElapsedTimer inverseTimer;
+    inverseTimer.start();
+    selectedInverse(inverse);
+    m_bundleResults.addElapsedTimeInverse(inverseTimer.nsecsElapsed() / 1.0e9);
+
+    int numBlockColumns = inverse.size();
+    for (int i = 0; i < numBlockColumns; i++) {
+      LinearAlgebra::Matrix *covMatrix = inverse.at(i)->value(i);
+      int numColumns = covMatrix->size2();
+
+      // save adjusted target body sigmas if solving for target
+      vector< double > *adjustedSigmas;
+      if (m_bundleSettings->solveTargetBody() && i == 0) {
+        adjustedSigmas = &m_bundleTargetBody->adjustedSigmas();
+      }
+      // save adjusted image sigmas
+      else if (m_bundleSettings->solveTargetBody()) {
+        adjustedSigmas = &m_bundleObservations.at(i-1)->adjustedSigmas();
+      }
+      else {
+        adjustedSigmas = &m_bundleObservations.at(i)->adjustedSigmas();
       }
 
-      if (j%100 == 0) {
-        status = "\rError Propagation: Filling point covariance matrices ";
-        status.append(QString("%1").arg(j+1));
-        status.append(" of ");
-        status.append(QString("%1").arg(numObjectPoints));
-        status.append("\r");
-        outputBundleStatus(status);
+      for (int z = 0; z < numColumns; z++) {
+        (*adjustedSigmas)[z] = sqrt((*covMatrix)(z,z))*m_bundleResults.sigma0();
       }
+    }
+
+    outputBundleStatus("\rError Propagation: Summing point covariance matrices");
+
+    QVector<int> pointIndices;
+    for (int j = 0; j < m_bundleControlPoints.size(); j++) {
+      if ( !m_bundleControlPoints.at(j)->isRejected() ) {
+        pointIndices.append(j);
+      }
+    }
+
+    QAtomicInt unstable(0);
+
+    QtConcurrent::blockingMap(pointIndices.begin(), pointIndices.end(),
+                              [&](int pointIndex) {
+      // get corresponding Q matrix
+      // NOTE: we are getting a reference to the Q matrix stored
+      //       in the BundleControlPoint for speed (without the & it is dirt slow)
+      SparseBlockRowMatrix &Q = m_bundleControlPoints.at(pointIndex)->cholmodQMatrix();
 
       // get corresponding point covariance matrix
       boost::numeric::ublas::symmetric_matrix<double> &covariance = pointCovariances[pointIndex];
 
-      // Update and reset the matrix
-      // Get the Limiting Error Propagation uncertainties:  sigmas for coordinate 1, 2, and 3 in meters
-      // 
-      SurfacePoint SurfacePoint = point->adjustedSurfacePoint();
+      LinearAlgebra::Matrix T(3, 3);
 
-      // Get the TEP by adding the corresponding members of pCovar and covariance      
-      boost::numeric::ublas::symmetric_matrix <double,boost::numeric::ublas::upper> pCovar;
-      
-      if (m_bundleSettings->controlPointCoordTypeBundle() == SurfacePoint::Latitudinal) {
-        pCovar = SurfacePoint.GetSphericalMatrix(SurfacePoint::Kilometers);
+      // the point's covariance sums Q(a) x inverse(a, b) x Q(b)(transpose) over the pairs of
+      // Q blocks, which all fall in the pattern of the normal equations matrix
+      QMapIterator< int, LinearAlgebra::Matrix * > firstIt(Q);
+      while ( firstIt.hasNext() ) {
+        firstIt.next();
+
+        int i = firstIt.key();
+        LinearAlgebra::Matrix *firstQBlock = firstIt.value();
+
+        QMapIterator< int, LinearAlgebra::Matrix * > secondIt(Q);
+        while ( secondIt.hasNext() ) {
+          secondIt.next();
+
+          int nKey = secondIt.key();
+
+          if (nKey > i) {
+            break;
+          }
+
+          LinearAlgebra::Matrix *secondQBlock = secondIt.value();
+          LinearAlgebra::Matrix *inverseBlock = inverse.at(i)->value(nKey);
+
+          if ( !firstQBlock || !secondQBlock || !inverseBlock ) {// should never be NULL
+            continue;
+          }
+
+          T = prod(*inverseBlock, trans(*firstQBlock));
+          T = prod(*secondQBlock,T);
+
+          if (nKey != i) {
+            T += trans(T);
+          }
+
+          try {
+            covariance += T;
+          }
+          catch (std::exception &e) {
+            unstable.store(1);
+            return;
+          }
+        }
       }
-      else {
-        // Assume Rectangular coordinates 
-        pCovar = SurfacePoint.GetRectangularMatrix(SurfacePoint::Kilometers);
+    });
+
+    if (unstable.load()) {
+      outputBundleStatus("\n\n");
+      QString msg = "Input data and settings are not sufficiently stable "
+                    "for error propagation.";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Compute the blocks of the inverse of the normal equations matrix that are in the pattern of
+   * the normal equations matrix (the upper triangle blocks of m_sparseNormals) with a selected
+   * (Takahashi) inversion of the Cholesky factor m_L. These are all of the blocks that error
+   * propagation needs, and they can be formed without solving for the full inverse.
+   *
+   * m_L is converted in place to a simplicial LL' factor. For column j of the permuted inverse
+   * Z, from the last column to the first,
+   *   Z(i,j) = -(1 / L(j,j)) sum over k > j of Z(i,k) L(k,j), for i > j in the pattern of L, and
+   *   Z(j,j) = (1 / L(j,j)) (1 / L(j,j) - sum over k > j of Z(k,j) L(k,j)).
+   * Only the entries of Z in the pattern of L are needed, and these contain the pattern of the
+   * normal equations matrix.
+   *
+   * @param inverse The output blocks of the inverse, with the same blocks as m_sparseNormals.
+   *
+   * @throws IException::Programmer "CHOLMOD: Failed to convert the factor for selected inversion"
+   *
+   * @see BundleAdjust::errorPropagationSelectedInverse
+   */
+  void BundleAdjust::selectedInverse(SparseBlockMatrix &inverse) {
+
+    if ( !cholmod_change_factor(CHOLMOD_REAL, true, false, true, true, m_L, &m_cholmodCommon) ) {
+      QString msg = "CHOLMOD: Failed to convert the factor for selected inversion";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int n = m_L->n;
+    int *Lp = (int*) m_L->p;
+    int *Li = (int*) m_L->i;
+    double *Lx = (double*) m_L->x;
+    int *perm = (int*) m_L->Perm;
+
+    // Z has the same pattern as L, the diagonal entry is the first in each column
+    std::vector<double> Z(Lp[n]);
+
+    std::vector<double> columnValues(n, 0.0);
+    std::vector<double> sums(n, 0.0);
+    std::vector<int> marks(n, -1);
+
+    for (int j = n - 1; j >= 0; j--) {
+      double diagonal = Lx[Lp[j]];
+
+      // scatter column j of L
+      for (int p = Lp[j] + 1; p < Lp[j+1]; p++) {
+        columnValues[Li[p]] = Lx[p];
+        marks[Li[p]] = j;
+        sums[Li[p]] = 0.0;
       }
-      pCovar += covariance;
-      pCovar *= sigma0Squared;
 
-      // debug lines
-      // if (j < 3) {
-      //   std::cout << " Adjusted surface point ..." << std::endl;
-      //   std:: cout << "     sigmaLat (radians) = " << sqrt(pCovar(0,0)) << std::endl;
-      //   std:: cout << "     sigmaLon (radians) = " << sqrt(pCovar(1,1)) << std::endl;
-      //   std:: cout << "     sigmaRad (km) = " << sqrt(pCovar(2,2)) << std::endl;
-      // std::cout <<  "      Adjusted matrix = " << std::endl;
-      // std::cout << "       " << pCovar(0,0) << "   " << pCovar(0,1) << "   "
-      //           << pCovar(0,2) << std::endl; 
-      // std::cout << "        " << pCovar(1,0) << "   " << pCovar(1,1) << "   "
-      //           << pCovar(1,2) << std::endl; 
-      // std::cout << "        " << pCovar(2,0) << "   " << pCovar(2,1) << "   "
-      //           << pCovar(2,2) << std::endl;
-      // }
-      // end debug
-      
-      // Distance units are km**2
-      SurfacePoint.SetMatrix(m_bundleSettings->controlPointCoordTypeBundle(),pCovar);
-      point->setAdjustedSurfacePoint(SurfacePoint);
-      // // debug lines
-      // if (j < 3) {
-      //   boost::numeric::ublas::symmetric_matrix <double,boost::numeric::ublas::upper> recCovar;
-      //   recCovar = SurfacePoint.GetRectangularMatrix(SurfacePoint::Meters);
-      //   std:: cout << "     sigmaLat (meters) = " << 
-      //     point->adjustedSurfacePoint().GetSigmaDistance(SurfacePoint::Latitudinal,
-      //     SurfacePoint::One).meters() << std::endl;
-      //   std:: cout << "     sigmaLon (meters) = " <<
-      //     point->adjustedSurfacePoint().GetSigmaDistance(SurfacePoint::Latitudinal,
-      //     SurfacePoint::Two).meters() << std::endl;
-      //   std:: cout << "   sigmaRad (km) = " << sqrt(pCovar(2,2)) << std::endl;
-      //   std::cout << "Rectangular matrix with radius in meters" << std::endl;
-      //   std::cout << "       " << recCovar(0,0) << "   " << recCovar(0,1) << "   "
-      //           << recCovar(0,2) << std::endl; 
-      //   std::cout << "        " << recCovar(1,0) << "   " << recCovar(1,1) << "   "
-      //           << recCovar(1,2) << std::endl; 
-      //   std::cout << "        " << recCovar(2,0) << "   " << recCovar(2,1) << "   "
-      //           << recCovar(2,2) << std::endl;
-      // }
-      // // end debug
+      // sums(i) = sum over k > j of Z(i,k) L(k,j). For i and k in the pattern of column j,
+      // Z(i,k) is in column min(i,k) of Z.
+      for (int p = Lp[j] + 1; p < Lp[j+1]; p++) {
+        int k = Li[p];
+        double lkj = Lx[p];
 
-      pointIndex++;
+        sums[k] += Z[Lp[k]] * lkj;
+
+        for (int q = Lp[k] + 1; q < Lp[k+1]; q++) {
+          int i = Li[q];
+          if ( marks[i] == j ) {
+            sums[i] += Z[q] * lkj;
+            sums[k] += Z[q] * columnValues[i];
+          }
+        }
+      }
+
+      double diagonalSum = 0.0;
+      for (int p = Lp[j] + 1; p < Lp[j+1]; p++) {
+        Z[p] = -sums[Li[p]] / diagonal;
+        diagonalSum += Lx[p] * Z[p];
+      }
+      Z[Lp[j]] = (1.0 / diagonal - diagonalSum) / diagonal;
     }
 
-    return true;
+    // create the inverse blocks in the pattern of the normal equations
+    int numBlockColumns = m_sparseNormals.size();
+    inverse.setNumberOfColumns(numBlockColumns);
+
+    std::vector<int> parameterBlocks(m_rank);
+    for (int columnIndex = 0; columnIndex < numBlockColumns; columnIndex++) {
+      SparseBlockColumnMatrix *normalsColumn = m_sparseNormals.at(columnIndex);
+
+      int startColumn = normalsColumn->startColumn();
+      int numColumns = blockColumnWidth(columnIndex);
+
+      inverse.at(columnIndex)->setStartColumn(startColumn);
+      for (int jj = 0; jj < numColumns; jj++) {
+        parameterBlocks[startColumn + jj] = columnIndex;
+      }
+
+      QMapIterator< int, LinearAlgebra::Matrix * > it(*normalsColumn);
+      while ( it.hasNext() ) {
+        it.next();
+        inverse.insertMatrixBlock(columnIndex, it.key(), it.value()->size1(), numColumns);
+      }
+    }
+    inverse.zeroBlocks();
+
+    // copy Z into the blocks, undoing the fill reducing permutation
+    for (int j = 0; j < n; j++) {
+      for (int p = Lp[j]; p < Lp[j+1]; p++) {
+        int row = perm[Li[p]];
+        int column = perm[j];
+        if ( row > column ) {
+          std::swap(row, column);
+        }
+
+        int rowBlock = parameterBlocks[row];
+        int columnBlock = parameterBlocks[column];
+
+        LinearAlgebra::Matrix *block = inverse.at(columnBlock)->value(rowBlock);
+        if ( !block ) {
+          continue;
+        }
+
+        int ii = row - inverse.at(rowBlock)->startColumn();
+        int jj = column - inverse.at(columnBlock)->startColumn();
+
+        (*block)(ii, jj) = Z[p];
+        if ( rowBlock == columnBlock ) {
+          (*block)(jj, ii) = Z[p];
+        }
+      }
+    }
   }
   
 
@@ -24,7 +24,9 @@
  *   http://www.usgs.gov/privacy.html.
  */
 // Qt lib
+#include <QList>
 #include <QObject> // parent class
+#include <QVector>
 
 // std lib
 #include <vector>
@@ -329,6 +331,9 @@ namespace Isis {
    *                            adjustment.  In the future a control net diagnostic program might be 
    *                            useful to detect any points not visible on an image based on the exterior 
    *                            orientation of the image.  References #2591.
+   *  @history 2026-10-16 Isis Development Team - The measure normals are formed in parallel
+   *                            and added to the normal equations in point order. The time spent
+   *                            forming the normal equations is reported for each iteration.
    */
   class BundleAdjust : public QObject {
       Q_OBJECT
@@ -401,6 +406,11 @@ namespace Isis {
       bool computeBundleStatistics();
       void applyParameterCorrections();
       bool errorPropagation();
+      void errorPropagationInverseColumns(
+          std::vector< boost::numeric::ublas::symmetric_matrix<double> > &pointCovariances);
+      void errorPropagationSelectedInverse(
+          std::vector< boost::numeric::ublas::symmetric_matrix<double> > &pointCovariances);
+      void selectedInverse(SparseBlockMatrix &inverse);
       double computeResiduals();
       bool computeRejectionLimit();
       bool flagOutliers();
@@ -414,33 +424,68 @@ namespace Isis {
                            LinearAlgebra::Vector  &coeffRHS,
                            BundleMeasure          &measure,
                            BundleControlPoint     &point);
-      bool formMeasureNormals(boost::numeric::ublas::symmetric_matrix<
-                                  double, boost::numeric::ublas::upper >         &N22,
-                              SparseBlockColumnMatrix                            &N12,
-                              boost::numeric::ublas::compressed_vector< double > &n1,
-                              LinearAlgebra::Vector                              &n2,
-                              LinearAlgebra::Matrix                              &coeffTarget,
-                              LinearAlgebra::Matrix                              &coeffImage,
-                              LinearAlgebra::Matrix                              &coeffPoint3D,
-                              LinearAlgebra::Vector                              &coeffRHS,
-                              int                                                observationIndex);
-      bool formPointNormals(boost::numeric::ublas::symmetric_matrix<
-                                double, boost::numeric::ublas::upper >  &N22,
-                            SparseBlockColumnMatrix                     &N12,
-                            LinearAlgebra::Vector                       &n2,
-                            LinearAlgebra::Vector                       &nj,
-                            BundleControlPointQsp                       &point);
+
+      /**
+       * The partial derivatives of a single measure and the normal equation blocks they add to
+       * the images' part of the normal equations (N11 and n1).
+       */
+      struct MeasureNormals {
+        int blockIndex;                                    //!< The observation's block.
+        LinearAlgebra::Matrix coeffTarget;                 //!< Target body partials.
+        LinearAlgebra::Matrix coeffImage;                  //!< Image partials.
+        LinearAlgebra::Matrix coeffPoint3D;                //!< Point partials.
+        LinearAlgebra::Vector coeffRHS;                    //!< Weighted x,y residuals.
+        boost::numeric::ublas::symmetric_matrix<
+            double, boost::numeric::ublas::upper > N11Target;  //!< Target body normals.
+        LinearAlgebra::Matrix N11TargetImage;              //!< Target body/image normals.
+        LinearAlgebra::Vector n1Target;                    //!< Target body right hand side.
+        boost::numeric::ublas::symmetric_matrix<
+            double, boost::numeric::ublas::upper > N11Image;   //!< Image normals.
+        LinearAlgebra::Vector n1Image;                     //!< Image right hand side.
+      };
+
+      /**
+       * The normal equation matrices contributed by a single control point. These are formed
+       * for a batch of points at a time: the partials (which need the cameras) on the main
+       * thread, the measure normals and the point's Schur complement products in parallel, and
+       * then everything is added to the normal equations in point order.
+       */
+      struct PointNormals {
+        PointNormals() : N22(3), n2(3), numConstrainedParameters(0), measureCount(0) {}
+
+        BundleControlPointQsp point;                       //!< The control point.
+        boost::numeric::ublas::symmetric_matrix<
+            double, boost::numeric::ublas::upper > N22;    //!< The point's normals.
+        SparseBlockColumnMatrix N12;                       //!< The image/point normals.
+        LinearAlgebra::Vector n2;                          //!< The point's right hand side.
+        int numConstrainedParameters;                      //!< Weighted point parameters.
+        QList<LinearAlgebra::Matrix> R;                    //!< The N12 x Q blocks.
+        QList<LinearAlgebra::Vector> nj;                   //!< The Q(transpose) x n2 blocks.
+        QVector<MeasureNormals> measures;                  //!< The measures' partials.
+        int measureCount;                                  //!< The used part of measures.
+      };
+
+      //! The number of points whose point normals are formed in parallel at a time.
+      static const int PointNormalsBatchSize = 512;
+
+      void formBatchPointNormals(QVector<PointNormals> &batch, int batchSize,
+                                 boost::numeric::ublas::compressed_vector< double > &n1);
+      void formMeasureNormals(PointNormals &pointNormals, MeasureNormals &measure);
+      void accumulateMeasureNormals(MeasureNormals &measure,
+                                    boost::numeric::ublas::compressed_vector< double > &n1);
+      bool formPointNormals(PointNormals &pointNormals);
+      void accumulatePointNormals(PointNormals &pointNormals, LinearAlgebra::Vector &nj);
       bool formWeightedNormals(boost::numeric::ublas::compressed_vector< double >  &n1,
                                LinearAlgebra::Vector                               &nj);
 
       // dedicated matrix functions
 
-      void productAB(SparseBlockColumnMatrix &A,
-                     SparseBlockRowMatrix    &B);
-      void accumProductAlphaAB(double                alpha,
-                               SparseBlockRowMatrix  &A,
-                               LinearAlgebra::Vector &B,
-                               LinearAlgebra::Vector &C);
+      void productAB(SparseBlockColumnMatrix       &A,
+                     SparseBlockRowMatrix          &B,
+                     QList<LinearAlgebra::Matrix>  &C);
+      void productATransV(SparseBlockRowMatrix          &A,
+                          LinearAlgebra::Vector         &v,
+                          QList<LinearAlgebra::Vector>  &C);
       bool invert3x3(boost::numeric::ublas::symmetric_matrix<
                           double, boost::numeric::ublas::upper >  &m);
       bool productATransB(boost::numeric::ublas::symmetric_matrix<
@@ -457,7 +502,8 @@ namespace Isis {
       bool initializeCHOLMODLibraryVariables();
       bool freeCHOLMODLibraryVariables();
       bool cholmodInverse();
-      bool loadCholmodTriplet();
+      bool loadCholmodSparse();
+      int blockColumnWidth(int columnIndex) const;
       bool wrapUp();
 
       // member variables
@@ -512,24 +558,26 @@ namespace Isis {
       LinearAlgebra::Vector m_RHS;                           /**!< The right hand side of the
                                                                    normal equations.*/
       SparseBlockMatrix m_sparseNormals;                     /**!< The sparse block normal
-                                                                   equations matrix.  Used to
-                                                                   populate m_cholmodTriplet and
-                                                                   for error propagation.*/
-      cholmod_triplet  *m_cholmodTriplet;                    /**!< The CHOLMOD triplet
-                                                                   representation of the sparse
-                                                                   normal equations matrix.
-                                                                   Created from m_sparseNormals
-                                                                   and then used to create
-                                                                   m_cholmodNormal.*/
+                                                                   equations matrix. The normals
+                                                                   are accumulated here and then
+                                                                   copied into m_cholmodNormal
+                                                                   each iteration.*/
       cholmod_sparse *m_cholmodNormal;                       /**!< The CHOLMOD sparse normal
                                                                    equations matrix used by
                                                                    cholmod_factorize to solve the
-                                                                   system. Created from
-                                                                   m_cholmodTriplet.*/
+                                                                   system. Loaded directly from
+                                                                   m_sparseNormals and reused
+                                                                   between iterations.*/
       cholmod_factor *m_L;                                   /**!< The lower triangular L matrix
                                                                    from Cholesky decomposition.
                                                                    Created from m_cholmodNormal by
-                                                                   cholmod_factorize.*/
+                                                                   cholmod_factorize. Its symbolic
+                                                                   analysis is kept between
+                                                                   iterations.*/
+      bool m_cholmodPatternChanged;                          /**!< If the sparsity pattern of
+                                                                   m_cholmodNormal changed the last
+                                                                   time it was loaded, so m_L has
+                                                                   to be analyzed again.*/
       LinearAlgebra::Vector m_imageSolution;                 /**!< The image parameter solution
                                                                    vector.*/
 
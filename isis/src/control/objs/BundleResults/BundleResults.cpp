@@ -98,6 +98,11 @@ namespace Isis {
         m_sigma0(src.m_sigma0),
         m_elapsedTime(src.m_elapsedTime),
         m_elapsedTimeErrorProp(src.m_elapsedTimeErrorProp),
+        m_elapsedTimeAssembly(src.m_elapsedTimeAssembly),
+        m_elapsedTimeAnalyze(src.m_elapsedTimeAnalyze),
+        m_elapsedTimeFactorize(src.m_elapsedTimeFactorize),
+        m_elapsedTimeSolve(src.m_elapsedTimeSolve),
+        m_elapsedTimeInverse(src.m_elapsedTimeInverse),
         m_converged(src.m_converged),
         m_bundleControlPoints(src.m_bundleControlPoints),
         m_outNet(src.m_outNet),
@@ -183,6 +188,11 @@ namespace Isis {
       m_sigma0 = src.m_sigma0;
       m_elapsedTime = src.m_elapsedTime;
       m_elapsedTimeErrorProp = src.m_elapsedTimeErrorProp;
+      m_elapsedTimeAssembly = src.m_elapsedTimeAssembly;
+      m_elapsedTimeAnalyze = src.m_elapsedTimeAnalyze;
+      m_elapsedTimeFactorize = src.m_elapsedTimeFactorize;
+      m_elapsedTimeSolve = src.m_elapsedTimeSolve;
+      m_elapsedTimeInverse = src.m_elapsedTimeInverse;
       m_converged = src.m_converged;
       m_bundleControlPoints = src.m_bundleControlPoints;
       m_outNet = src.m_outNet;
@@ -307,6 +317,11 @@ namespace Isis {
     m_sigma0 = 0.0;
     m_elapsedTime = 0.0;
     m_elapsedTimeErrorProp = 0.0;
+    m_elapsedTimeAssembly = 0.0;
+    m_elapsedTimeAnalyze = 0.0;
+    m_elapsedTimeFactorize = 0.0;
+    m_elapsedTimeSolve = 0.0;
+    m_elapsedTimeInverse = 0.0;
     m_converged = false; // or initialze method
 
     m_cumPro = NULL;
@@ -805,6 +820,51 @@ namespace Isis {
     m_elapsedTimeErrorProp = time;
   }
 
+  /**
+   * Adds to the elapsed time spent forming the normal equations.
+   *
+   * @param time The elapsed time to add.
+   */
+  void BundleResults::addElapsedTimeAssembly(double time) {
+    m_elapsedTimeAssembly += time;
+  }
+
+  /**
+   * Adds to the elapsed time spent computing the symbolic factorization of the normal equations.
+   *
+   * @param time The elapsed time to add.
+   */
+  void BundleResults::addElapsedTimeAnalyze(double time) {
+    m_elapsedTimeAnalyze += time;
+  }
+
+  /**
+   * Adds to the elapsed time spent computing the numeric factorization of the normal equations.
+   *
+   * @param time The elapsed time to add.
+   */
+  void BundleResults::addElapsedTimeFactorize(double time) {
+    m_elapsedTimeFactorize += time;
+  }
+
+  /**
+   * Adds to the elapsed time spent solving the factored normal equations.
+   *
+   * @param time The elapsed time to add.
+   */
+  void BundleResults::addElapsedTimeSolve(double time) {
+    m_elapsedTimeSolve += time;
+  }
+
+  /**
+   * Adds to the elapsed time spent inverting the normal equations for error propagation.
+   *
+   * @param time The elapsed time to add.
+   */
+  void BundleResults::addElapsedTimeInverse(double time) {
+    m_elapsedTimeInverse += time;
+  }
+
 
   /**
    * Sets if the bundle adjustment converged.
@@ -1248,6 +1308,51 @@ namespace Isis {
     return m_elapsedTimeErrorProp;
   }
 
+  /**
+   * Returns the elapsed time spent forming the normal equations.
+   *
+   * @return @b double The elapsed time spent forming the normal equations.
+   */
+  double BundleResults::elapsedTimeAssembly() const {
+    return m_elapsedTimeAssembly;
+  }
+
+  /**
+   * Returns the elapsed time spent computing the symbolic factorization of the normal equations.
+   *
+   * @return @b double The elapsed time spent computing the symbolic factorization of the normal equations.
+   */
+  double BundleResults::elapsedTimeAnalyze() const {
+    return m_elapsedTimeAnalyze;
+  }
+
+  /**
+   * Returns the elapsed time spent computing the numeric factorization of the normal equations.
+   *
+   * @return @b double The elapsed time spent computing the numeric factorization of the normal equations.
+   */
+  double BundleResults::elapsedTimeFactorize() const {
+    return m_elapsedTimeFactorize;
+  }
+
+  /**
+   * Returns the elapsed time spent solving the factored normal equations.
+   *
+   * @return @b double The elapsed time spent solving the factored normal equations.
+   */
+  double BundleResults::elapsedTimeSolve() const {
+    return m_elapsedTimeSolve;
+  }
+
+  /**
+   * Returns the elapsed time spent inverting the normal equations for error propagation.
+   *
+   * @return @b double The elapsed time spent inverting the normal equations for error propagation.
+   */
+  double BundleResults::elapsedTimeInverse() const {
+    return m_elapsedTimeInverse;
+  }
+
 
   /**
    * Returns whether or not the bundle adjustment converged.
@@ -1611,6 +1716,11 @@ namespace Isis {
     stream.writeStartElement("elapsedTime");
     stream.writeAttribute("time", toString(elapsedTime()));
     stream.writeAttribute("errorProp", toString(elapsedTimeErrorProp()));
+    stream.writeAttribute("assembly", toString(elapsedTimeAssembly()));
+    stream.writeAttribute("analyze", toString(elapsedTimeAnalyze()));
+    stream.writeAttribute("factorize", toString(elapsedTimeFactorize()));
+    stream.writeAttribute("solve", toString(elapsedTimeSolve()));
+    stream.writeAttribute("inverse", toString(elapsedTimeInverse()));
     stream.writeEndElement(); // end elapsed time
 
     stream.writeStartElement("minMaxSigmas");
@@ -1904,6 +2014,31 @@ namespace Isis {
           m_xmlHandlerBundleResults->m_elapsedTimeErrorProp = toDouble(errorProp);
         }
 
+        QString assembly = atts.value("assembly");
+        if (!assembly.isEmpty()) {
+          m_xmlHandlerBundleResults->m_elapsedTimeAssembly = toDouble(assembly);
+        }
+
+        QString analyze = atts.value("analyze");
+        if (!analyze.isEmpty()) {
+          m_xmlHandlerBundleResults->m_elapsedTimeAnalyze = toDouble(analyze);
+        }
+
+        QString factorize = atts.value("factorize");
+        if (!factorize.isEmpty()) {
+          m_xmlHandlerBundleResults->m_elapsedTimeFactorize = toDouble(factorize);
+        }
+
+        QString solve = atts.value("solve");
+        if (!solve.isEmpty()) {
+          m_xmlHandlerBundleResults->m_elapsedTimeSolve = toDouble(solve);
+        }
+
+        QString inverse = atts.value("inverse");
+        if (!inverse.isEmpty()) {
+          m_xmlHandlerBundleResults->m_elapsedTimeInverse = toDouble(inverse);
+        }
+
       }
 // ???      else if (qName == "minMaxSigmaDistances") {
 // ???        QString units = atts.value("units");
@@ -173,6 +173,11 @@ namespace Isis {
       void setSigma0(double sigma0);
       void setElapsedTime(double time);
       void setElapsedTimeErrorProp(double time);
+      void addElapsedTimeAssembly(double time);
+      void addElapsedTimeAnalyze(double time);
+      void addElapsedTimeFactorize(double time);
+      void addElapsedTimeSolve(double time);
+      void addElapsedTimeInverse(double time);
       void setConverged(bool converged); // or initialze method
       void setBundleControlPoints(QVector<BundleControlPointQsp> controlPoints);
       void setOutputControlNet(ControlNetQsp outNet);
@@ -225,6 +230,11 @@ namespace Isis {
       double sigma0() const;
       double elapsedTime() const;
       double elapsedTimeErrorProp() const;
+      double elapsedTimeAssembly() const;
+      double elapsedTimeAnalyze() const;
+      double elapsedTimeFactorize() const;
+      double elapsedTimeSolve() const;
+      double elapsedTimeInverse() const;
       bool converged() const; // or initialze method
       QVector<BundleControlPointQsp> &bundleControlPoints();
       ControlNetQsp outputControlNet() const;
@@ -323,6 +333,11 @@ namespace Isis {
       double m_sigma0;                         //!< std deviation of unit weight
       double m_elapsedTime;                    //!< elapsed time for bundle
       double m_elapsedTimeErrorProp;           //!< elapsed time for error propagation
+      double m_elapsedTimeAssembly;            //!< elapsed time forming the normal equations
+      double m_elapsedTimeAnalyze;             //!< elapsed time in symbolic factorization
+      double m_elapsedTimeFactorize;           //!< elapsed time in numeric factorization
+      double m_elapsedTimeSolve;               //!< elapsed time solving the factored system
+      double m_elapsedTimeInverse;             //!< elapsed time inverting the normal equations
       bool m_converged;
       
       // Variables for output methods in BundleSolutionInfo
@@ -184,6 +184,12 @@ int main(int argc, char *argv[]) {
     results.setSigma0(15.0);
     results.setElapsedTime(16.0);
     results.setElapsedTimeErrorProp(17.0);
+    results.addElapsedTimeAssembly(1.0);
+    results.addElapsedTimeAssembly(2.0);
+    results.addElapsedTimeAnalyze(4.0);
+    results.addElapsedTimeFactorize(5.0);
+    results.addElapsedTimeSolve(6.0);
+    results.addElapsedTimeInverse(7.0);
     results.setConverged(true); // or initialze method
     results.incrementFixedPoints();
     results.incrementHeldImages();
@@ -33,6 +33,7 @@
 #include "IString.h"
 #include "iTime.h"
 #include "SpecialPixel.h"
+#include "StringPool.h"
 
 using namespace std;
 
@@ -42,10 +43,6 @@ namespace Isis {
    */
   ControlMeasure::ControlMeasure() {
     InitializeToNull();
-    p_serialNumber = new QString;
-    p_chooserName = new QString;
-    p_dateTime = new QString;
-    p_loggedData = new QVector<ControlMeasureLogData>();
 
     p_measureType = Candidate;
     p_editLock = false;
@@ -63,11 +60,11 @@ namespace Isis {
   ControlMeasure::ControlMeasure(const ControlMeasure &other) {
     InitializeToNull();
 
-    p_serialNumber = new QString(*other.p_serialNumber);
-    p_chooserName = new QString(*other.p_chooserName);
-    p_dateTime = new QString(*other.p_dateTime);
+    p_serialNumber = other.p_serialNumber;
+    p_chooserName = other.p_chooserName;
+    p_dateTime = other.p_dateTime;
 
-    p_loggedData = new QVector<ControlMeasureLogData>(*other.p_loggedData);
+    p_loggedData = other.p_loggedData;
 
     p_measureType = other.p_measureType;
     p_editLock = other.p_editLock;
@@ -92,11 +89,6 @@ namespace Isis {
     p_sample = Null;
     p_line = Null;
 
-    p_serialNumber = NULL;
-    p_chooserName = NULL;
-    p_dateTime = NULL;
-    p_loggedData = NULL;
-
     p_diameter = Null;
     p_aprioriSample = Null;
     p_aprioriLine = Null;
@@ -121,26 +113,6 @@ namespace Isis {
    * Free the memory allocated by a control
    */
   ControlMeasure::~ControlMeasure() {
-    if (p_serialNumber) {
-      delete p_serialNumber;
-      p_serialNumber = NULL;
-    }
-
-    if (p_chooserName) {
-      delete p_chooserName;
-      p_chooserName = NULL;
-    }
-
-    if (p_dateTime) {
-      delete p_dateTime;
-      p_dateTime = NULL;
-    }
-
-    if (p_loggedData) {
-      delete p_loggedData;
-      p_loggedData = NULL;
-    }
-
   }
 
 
@@ -200,7 +172,7 @@ namespace Isis {
   ControlMeasure::Status ControlMeasure::SetCubeSerialNumber(QString newSerialNumber) {
     if (IsEditLocked())
       return MeasureLocked;
-    *p_serialNumber = newSerialNumber;
+    p_serialNumber = StringPool::intern(newSerialNumber);
     return Success;
   }
 
@@ -209,7 +181,7 @@ namespace Isis {
   ControlMeasure::Status ControlMeasure::SetChooserName() {
     if (IsEditLocked())
       return MeasureLocked;
-    *p_chooserName = "";
+    p_chooserName = "";
     return Success;
   }
 
@@ -218,7 +190,7 @@ namespace Isis {
   ControlMeasure::Status ControlMeasure::SetChooserName(QString name) {
     if (IsEditLocked())
       return MeasureLocked;
-    *p_chooserName = name;
+    p_chooserName = StringPool::intern(name);
     return Success;
   }
 
@@ -260,7 +232,7 @@ namespace Isis {
   ControlMeasure::Status ControlMeasure::SetDateTime() {
     if (IsEditLocked())
       return MeasureLocked;
-    *p_dateTime = Application::DateTime();
+    p_dateTime = Application::DateTime();
     return Success;
   }
 
@@ -269,7 +241,7 @@ namespace Isis {
   ControlMeasure::Status ControlMeasure::SetDateTime(QString datetime) {
     if (IsEditLocked())
       return MeasureLocked;
-    *p_dateTime = datetime;
+    p_dateTime = datetime;
     return Success;
   }
 
@@ -455,7 +427,7 @@ namespace Isis {
     if (HasLogData(data.GetDataType()))
       UpdateLogData(data);
     else
-      p_loggedData->append(data);
+      p_loggedData.append(data);
   }
 
 
@@ -466,11 +438,11 @@ namespace Isis {
    * @param dataType A ControlMeasureLogData::NumericLogDataType
    */
   void ControlMeasure::DeleteLogData(long dataType) {
-    for (int i = p_loggedData->size()-1; i >= 0; i--) {
-      ControlMeasureLogData logDataEntry = p_loggedData->at(i);
+    for (int i = p_loggedData.size()-1; i >= 0; i--) {
+      ControlMeasureLogData logDataEntry = p_loggedData.at(i);
 
       if (logDataEntry.GetDataType() == dataType)
-        p_loggedData->remove(i);
+        p_loggedData.remove(i);
     }
   }
 
@@ -480,8 +452,8 @@ namespace Isis {
    *   should work for all types of log data.
    */
   QVariant ControlMeasure::GetLogValue(long dataType) const {
-    for (int i = 0; i < p_loggedData->size(); i++) {
-      const ControlMeasureLogData &logDataEntry = p_loggedData->at(i);
+    for (int i = 0; i < p_loggedData.size(); i++) {
+      const ControlMeasureLogData &logDataEntry = p_loggedData.at(i);
 
       if (logDataEntry.GetDataType() == dataType)
         return logDataEntry.GetValue();
@@ -497,8 +469,8 @@ namespace Isis {
    * @param dataType A ControlMeasureLogData::NumericLogDataType
    */
   bool ControlMeasure::HasLogData(long dataType) const {
-    for (int i = 0; i < p_loggedData->size(); i++) {
-      const ControlMeasureLogData &logDataEntry = p_loggedData->at(i);
+    for (int i = 0; i < p_loggedData.size(); i++) {
+      const ControlMeasureLogData &logDataEntry = p_loggedData.at(i);
 
       if (logDataEntry.GetDataType() == dataType)
         return true;
@@ -517,11 +489,11 @@ namespace Isis {
   void ControlMeasure::UpdateLogData(ControlMeasureLogData newLogData) {
     bool updated = false;
 
-    for (int i = 0; i < p_loggedData->size(); i++) {
-      ControlMeasureLogData logDataEntry = p_loggedData->at(i);
+    for (int i = 0; i < p_loggedData.size(); i++) {
+      ControlMeasureLogData logDataEntry = p_loggedData.at(i);
 
       if (logDataEntry.GetDataType() == newLogData.GetDataType()) {
-        (*p_loggedData)[i] = newLogData;
+        p_loggedData[i] = newLogData;
         updated = true;
       }
     }
@@ -553,8 +525,8 @@ namespace Isis {
 
   //! Return the chooser name
   QString ControlMeasure::GetChooserName() const {
-    if (*p_chooserName != "") {
-      return *p_chooserName;
+    if (p_chooserName != "") {
+      return p_chooserName;
     }
     else {
       return FileName(Application::Name()).name();
@@ -563,19 +535,19 @@ namespace Isis {
 
   //! Returns true if the choosername is not empty.
   bool ControlMeasure::HasChooserName() const {
-    return !p_chooserName->isEmpty();
+    return !p_chooserName.isEmpty();
   }
 
   //! Return the serial number of the cube containing the coordinate
   QString ControlMeasure::GetCubeSerialNumber() const {
-    return *p_serialNumber;
+    return p_serialNumber;
   }
 
 
   //! Return the date/time the coordinate was last changed
   QString ControlMeasure::GetDateTime() const {
-    if (*p_dateTime != "") {
-      return *p_dateTime;
+    if (p_dateTime != "") {
+      return p_dateTime;
     }
     else {
       return Application::DateTime();
@@ -584,7 +556,7 @@ namespace Isis {
 
   //! Returns true if the datetime is not empty.
   bool ControlMeasure::HasDateTime() const {
-    return !p_dateTime->isEmpty();
+    return !p_dateTime.isEmpty();
   }
 
 
@@ -788,8 +760,8 @@ namespace Isis {
     ControlMeasureLogData::NumericLogDataType typedDataType =
       (ControlMeasureLogData::NumericLogDataType)dataType;
 
-    while (foundIndex < p_loggedData->size()) {
-      const ControlMeasureLogData &logData = p_loggedData->at(foundIndex);
+    while (foundIndex < p_loggedData.size()) {
+      const ControlMeasureLogData &logData = p_loggedData.at(foundIndex);
       if (logData.GetDataType() == typedDataType) {
         return logData;
       }
@@ -807,11 +779,7 @@ namespace Isis {
    * @return @b QVector<ControlMeasureLogData> All of the log data for the measure.
    */
   QVector<ControlMeasureLogData> ControlMeasure::GetLogDataEntries() const {
-    QVector<ControlMeasureLogData> logs;
-    if (p_loggedData) {
-      logs = *p_loggedData;
-    }
-    return logs;
+    return p_loggedData;
   }
 
 
@@ -876,15 +844,15 @@ namespace Isis {
     data.append(qsl);
     qsl.clear();
 
-    qsl << "ChooserName" << *p_chooserName;
+    qsl << "ChooserName" << p_chooserName;
     data.append(qsl);
     qsl.clear();
 
-    qsl << "CubeSerialNumber" << *p_serialNumber;
+    qsl << "CubeSerialNumber" << p_serialNumber;
     data.append(qsl);
     qsl.clear();
 
-    qsl << "DateTime" << *p_dateTime;
+    qsl << "DateTime" << p_dateTime;
     data.append(qsl);
     qsl.clear();
 
@@ -1015,38 +983,16 @@ namespace Isis {
     if (this == &other)
       return *this;
 
-    if (p_serialNumber) {
-      delete p_serialNumber;
-      p_serialNumber = NULL;
-    }
-    if (p_chooserName) {
-      delete p_chooserName;
-      p_chooserName = NULL;
-    }
-    if (p_dateTime) {
-      delete p_dateTime;
-      p_dateTime = NULL;
-    }
-    if (p_loggedData) {
-      delete p_loggedData;
-      p_loggedData = NULL;
-    }
-
-    p_serialNumber = new QString;
-    p_chooserName = new QString;
-    p_dateTime = new QString;
-    p_loggedData = new QVector<ControlMeasureLogData>();
-
     bool oldLock = p_editLock;
     p_editLock = false;
 
     p_sample = other.p_sample;
     p_line = other.p_line;
-    *p_loggedData = *other.p_loggedData;
+    p_loggedData = other.p_loggedData;
 
-    SetCubeSerialNumber(*other.p_serialNumber);
-    SetChooserName(*other.p_chooserName);
-    SetDateTime(*other.p_dateTime);
+    SetCubeSerialNumber(other.p_serialNumber);
+    SetChooserName(other.p_chooserName);
+    SetDateTime(other.p_dateTime);
     SetType(other.p_measureType);
     //  Call SetIgnored to update the ControlGraphNode.  However, SetIgnored
     //  will return if EditLock is true, so set to false temporarily.
@@ -1099,9 +1045,9 @@ namespace Isis {
    */
   bool ControlMeasure::operator==(const Isis::ControlMeasure &pMeasure) const {
     return pMeasure.p_measureType == p_measureType &&
-        *pMeasure.p_serialNumber == *p_serialNumber &&
-        *pMeasure.p_chooserName == *p_chooserName &&
-        *pMeasure.p_dateTime == *p_dateTime &&
+        pMeasure.p_serialNumber == p_serialNumber &&
+        pMeasure.p_chooserName == p_chooserName &&
+        pMeasure.p_dateTime == p_dateTime &&
         pMeasure.p_editLock == p_editLock &&
         pMeasure.p_ignore == p_ignore &&
         pMeasure.p_jigsawRejected == p_jigsawRejected &&
@@ -1123,7 +1069,7 @@ namespace Isis {
   }
 
   void ControlMeasure::MeasureModified() {
-    *p_dateTime = "";
-    *p_chooserName = "";
+    p_dateTime = "";
+    p_chooserName = "";
   }
 }
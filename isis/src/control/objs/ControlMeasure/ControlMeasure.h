@@ -24,17 +24,18 @@
  */
 
 #include <QObject>
+#include <QString>
+#include <QVector>
+
+#include "ControlMeasureLogData.h"
 
-template< class A> class QVector;
 template< class A> class QList;
-class QString;
 class QStringList;
 class QVariant;
 
 namespace Isis {
   class Application;
   class Camera;
-  class ControlMeasureLogData;
   class ControlPoint;
   class PvlGroup;
   class PvlKeyword;
@@ -185,6 +186,10 @@ namespace Isis {
    *                           Fixes #5435.
    *  @history 2018-06-29 Adam Goins - Modified operator= to use setters when setting values
    *                           so that the proper signals/slots are called. Fixes #5435.
+   *  @history 2026-10-16 Isis Development Team - Serial numbers and chooser names are shared
+   *                           through StringPool. They, the date-time and the log data are
+   *                           stored by value. Serial numbers are still strings here and in the
+   *                           ControlNet graph. Removed the unused p_comments member.
    */
   class ControlMeasure : public QObject {
 
@@ -357,18 +362,17 @@ namespace Isis {
       ControlPoint *parentPoint;  //!< Pointer to parent ControlPoint, may be null
       // structure connecting measures in an image
 
-      QString *p_serialNumber;
+      QString p_serialNumber;  //!< Interned with StringPool
       MeasureType p_measureType;
 
-      QVector<ControlMeasureLogData> * p_loggedData;
-      PvlGroup *p_comments;
+      QVector<ControlMeasureLogData> p_loggedData;
 
       /**
        * list the program used and the definition file or include the user
        * name for qnet
        */
-      QString *p_chooserName;
-      QString *p_dateTime;
+      QString p_chooserName;   //!< Interned with StringPool
+      QString p_dateTime;
       bool p_editLock;        //!< If true do not edit anything in measure.
       bool p_ignore;
       bool p_jigsawRejected;  //!< Status of measure for last bundle adjust iteration
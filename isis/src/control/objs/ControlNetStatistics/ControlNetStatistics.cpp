@@ -12,6 +12,7 @@
 #include <geos/geom/Polygon.h>
 
 #include "ControlNet.h"
+#include "ControlNetVersioner.h"
 #include "ControlPoint.h"
 #include "ControlMeasure.h"
 #include "ControlMeasureLogData.h"
@@ -72,6 +73,48 @@ namespace Isis {
     GetPointDoubleStats();
   }
 
+  /**
+   * Constructs the point and measure statistics of a network file without
+   * loading the whole network. The points are streamed from the file one at a
+   * time. The image stats need a ControlNet and can not be made this way.
+   *
+   * @param psCNetFile - Input Control network file
+   * @param psPointFile - Output Point Statistics File, none if it is empty
+   * @param pProgress - Check Progress if not Null
+   */
+  ControlNetStatistics::ControlNetStatistics(const QString &psCNetFile, const QString &psPointFile,
+                                             Progress *pProgress) {
+    numCNetImages = 0;
+    mCNet = NULL;
+    mProgress = pProgress;
+
+    InitPointIntStats();
+    InitPointDoubleStats();
+
+    ofstream ostm;
+    if (psPointFile != "") {
+      OpenPointStats(ostm, psPointFile);
+    }
+
+    Statistics residualMagStats;
+    Statistics pixelShiftStats;
+
+    ControlNetVersioner reader(FileName(psCNetFile), [&](ControlPoint *cPoint) {
+      AddPointIntStats(cPoint);
+      AddPointDoubleStats(cPoint, residualMagStats, pixelShiftStats);
+      if (ostm.is_open()) {
+        WritePointStats(ostm, cPoint);
+      }
+    }, mProgress);
+
+    mPointDoubleStats[avgResidual] = residualMagStats.Average();
+    mPointDoubleStats[avgPixelShift] = pixelShiftStats.Average();
+
+    if (ostm.is_open()) {
+      ClosePointStats(ostm, psPointFile);
+    }
+  }
+
   /**
    * Destructor
    *
@@ -114,18 +157,18 @@ namespace Isis {
       pStatsGrp += PvlKeyword("ImagesInControlNet", toString(numCNetImages));
     }
 
-    pStatsGrp += PvlKeyword("TotalPoints",       toString(mCNet->GetNumPoints()));
+    pStatsGrp += PvlKeyword("TotalPoints",       toString(mPointIntStats[totalPoints]));
     pStatsGrp += PvlKeyword("ValidPoints",       toString(NumValidPoints()));
-    pStatsGrp += PvlKeyword("IgnoredPoints",     toString(mCNet->GetNumPoints() - NumValidPoints()));
+    pStatsGrp += PvlKeyword("IgnoredPoints",     toString(mPointIntStats[totalPoints] - NumValidPoints()));
     pStatsGrp += PvlKeyword("FixedPoints",       toString(NumFixedPoints()));
     pStatsGrp += PvlKeyword("ConstrainedPoints", toString(NumConstrainedPoints()));
     pStatsGrp += PvlKeyword("FreePoints",        toString(NumFreePoints()));
-    pStatsGrp += PvlKeyword("EditLockPoints",    toString(mCNet->GetNumEditLockPoints()));
+    pStatsGrp += PvlKeyword("EditLockPoints",    toString(NumEditLockedPoints()));
 
     pStatsGrp += PvlKeyword("TotalMeasures",     toString(NumMeasures()));
     pStatsGrp += PvlKeyword("ValidMeasures",     toString(NumValidMeasures()));
     pStatsGrp += PvlKeyword("IgnoredMeasures",   toString(NumIgnoredMeasures()));
-    pStatsGrp += PvlKeyword("EditLockMeasures",  toString(mCNet->GetNumEditLockMeasures()));
+    pStatsGrp += PvlKeyword("EditLockMeasures",  toString(NumEditLockedMeasures()));
 
     double dValue = GetAverageResidual();
     pStatsGrp += PvlKeyword("AvgResidual",       (dValue == Null ? "Null" : toString(dValue)));
@@ -210,6 +253,11 @@ namespace Isis {
    * @author Sharmila Prasad (11/1/2011)
    */
   void ControlNetStatistics::GenerateImageStats() {
+    if (mCNet == NULL) {
+      QString msg = "Image Stats can not be generated from a streamed Control Net";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
     geos::geom::GeometryFactory::Ptr geosFactory = geos::geom::GeometryFactory::create();
 
     CubeManager cubeMgr;
@@ -383,18 +431,13 @@ namespace Isis {
    * @param psPointFile - Output Point Statisitics File
    */
   void ControlNetStatistics::GeneratePointStats(const QString &psPointFile) {
-    Isis::FileName outFile(psPointFile);
-
-    ofstream ostm;
-    QString outName(outFile.expanded());
-    ostm.open(outName.toLatin1().data(), std::ios::out);
-
-    if ( ostm.fail() ) {
-      QString msg = QObject::tr("Cannot open file [%1]").arg(psPointFile);
-      throw IException(IException::Io, msg, _FILEINFO_);
+    if (mCNet == NULL) {
+      QString msg = "Point Stats can not be generated from a streamed Control Net";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    ostm << " PointId, PointType, PointIgnore, PointEditLock, TotalMeasures, MeasuresValid, MeasuresIgnore, MeasuresEditLock," << endl;
+    ofstream ostm;
+    OpenPointStats(ostm, psPointFile);
 
     int iNumPoints = mCNet->GetNumPoints();
 
@@ -406,21 +449,63 @@ namespace Isis {
     }
 
     for (int i = 0; i < iNumPoints; i++) {
-      const ControlPoint *cPoint = mCNet->GetPoint(i);
-      int iNumMeasures     = cPoint->GetNumMeasures();
-      int iValidMeasures   = cPoint->GetNumValidMeasures();
-      int iIgnoredMeasures = iNumMeasures - iValidMeasures;
-
-      // Log into the output file
-      ostm << cPoint->GetId()   << ", " << sPointType[(int)cPoint->GetType()] << ", " << sBoolean[(int)cPoint->IsIgnored()] << ", " ;
-      ostm << sBoolean[(int)cPoint->IsEditLocked()] << ", " << iNumMeasures << ", " << iValidMeasures << ", ";
-      ostm << iIgnoredMeasures << ", " << cPoint->GetNumLockedMeasures() << endl;
+      WritePointStats(ostm, mCNet->GetPoint(i));
 
       // Update Progress
       if (mProgress != NULL)
         mProgress->CheckStatus();
     }
 
+    ClosePointStats(ostm, psPointFile);
+  }
+
+
+  /**
+   * Opens the Point Stats File and writes its header
+   *
+   * @param ostm - Stream to open
+   * @param psPointFile - Output Point Statisitics File
+   */
+  void ControlNetStatistics::OpenPointStats(ofstream &ostm, const QString &psPointFile) {
+    Isis::FileName outFile(psPointFile);
+
+    QString outName(outFile.expanded());
+    ostm.open(outName.toLatin1().data(), std::ios::out);
+
+    if ( ostm.fail() ) {
+      QString msg = QObject::tr("Cannot open file [%1]").arg(psPointFile);
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    ostm << " PointId, PointType, PointIgnore, PointEditLock, TotalMeasures, MeasuresValid, MeasuresIgnore, MeasuresEditLock," << endl;
+  }
+
+
+  /**
+   * Writes the stats of one Control Point into the Point Stats File
+   *
+   * @param ostm - Open Point Stats File
+   * @param cPoint - Control Point
+   */
+  void ControlNetStatistics::WritePointStats(ofstream &ostm, const ControlPoint *cPoint) {
+    int iNumMeasures     = cPoint->GetNumMeasures();
+    int iValidMeasures   = cPoint->GetNumValidMeasures();
+    int iIgnoredMeasures = iNumMeasures - iValidMeasures;
+
+    // Log into the output file
+    ostm << cPoint->GetId()   << ", " << sPointType[(int)cPoint->GetType()] << ", " << sBoolean[(int)cPoint->IsIgnored()] << ", " ;
+    ostm << sBoolean[(int)cPoint->IsEditLocked()] << ", " << iNumMeasures << ", " << iValidMeasures << ", ";
+    ostm << iIgnoredMeasures << ", " << cPoint->GetNumLockedMeasures() << endl;
+  }
+
+
+  /**
+   * Closes the Point Stats File, checking that all of it was written
+   *
+   * @param ostm - Open Point Stats File
+   * @param psPointFile - Output Point Statisitics File
+   */
+  void ControlNetStatistics::ClosePointStats(ofstream &ostm, const QString &psPointFile) {
     if (!ostm) {
       QString msg = QObject::tr("Error writing to file: [%1]").arg(psPointFile);
       throw IException(IException::Io, msg, _FILEINFO_);
@@ -436,56 +521,76 @@ namespace Isis {
    * @author sprasad (7/19/2011)
    */
   void ControlNetStatistics::GetPointIntStats() {
+    InitPointIntStats();
+
+    int iNumPoints = mCNet->GetNumPoints();
+    for (int i = 0; i < iNumPoints; i++) {
+      AddPointIntStats(mCNet->GetPoint(i));
+    }
+  }
+
+
+  /**
+   * Initialize Point count stats
+   */
+  void ControlNetStatistics::InitPointIntStats() {
     // Init all the entries
     // totalPoints, validPoints, ignoredPoints, fixedPoints, constrainedPoints, editLockedPoints,
     // totalMeasures, validMeasures, ignoredMeasures, editLockedMeasures
     for (int i=0; i<numPointIntStats; i++) {
       mPointIntStats[i] = 0;
     }
+  }
 
-    int iNumPoints = mCNet->GetNumPoints();
 
+  /**
+   * Add the counts of one Control Point and its measures to the network statistics
+   *
+   * @param cPoint - Control Point
+   */
+  void ControlNetStatistics::AddPointIntStats(const ControlPoint *cPoint) {
     // totalPoints
-    mPointIntStats[totalPoints] = iNumPoints;
+    mPointIntStats[totalPoints]++;
 
-    for (int i = 0; i < iNumPoints; i++) {
-      if (!mCNet->GetPoint(i)->IsIgnored()) {
-        // validPoints
-        mPointIntStats[validPoints]++;
-      }
-      else {
-        // ignoredPoints
-        mPointIntStats[ignoredPoints]++;
-      }
+    if (!cPoint->IsIgnored()) {
+      // validPoints
+      mPointIntStats[validPoints]++;
+    }
+    else {
+      // ignoredPoints
+      mPointIntStats[ignoredPoints]++;
+    }
 
-      // fixedPoints
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Fixed)
-        mPointIntStats[fixedPoints]++;
+    // fixedPoints
+    if (cPoint->GetType() == ControlPoint::Fixed)
+      mPointIntStats[fixedPoints]++;
 
-      // constrainedPoints
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Constrained)
-        mPointIntStats[constrainedPoints]++;
+    // constrainedPoints
+    if (cPoint->GetType() == ControlPoint::Constrained)
+      mPointIntStats[constrainedPoints]++;
 
-      // free points
-      if (mCNet->GetPoint(i)->GetType() == ControlPoint::Free)
-        mPointIntStats[freePoints]++;
+    // free points
+    if (cPoint->GetType() == ControlPoint::Free)
+      mPointIntStats[freePoints]++;
 
-      // editLockedPoints
-      if (mCNet->GetPoint(i)->IsEditLocked()) {
-        mPointIntStats[editLockedPoints]++;
-      }
+    // editLockedPoints
+    if (cPoint->IsEditLocked()) {
+      mPointIntStats[editLockedPoints]++;
+    }
 
-      // totalMeasures
-      mPointIntStats[totalMeasures] += mCNet->GetPoint(i)->GetNumMeasures();
+    // totalMeasures
+    int iNumMeasures = cPoint->GetNumMeasures();
+    mPointIntStats[totalMeasures] += iNumMeasures;
 
-      // validMeasures
-      mPointIntStats[validMeasures] += mCNet->GetPoint(i)->GetNumValidMeasures();
+    // validMeasures
+    int iValidMeasures = cPoint->GetNumValidMeasures();
+    mPointIntStats[validMeasures] += iValidMeasures;
 
-      // editLockedMeasures
-      mPointIntStats[editLockedMeasures] +=  mCNet->GetPoint(i)->GetNumLockedMeasures();
-    }
     // ignoredMeasures
-    mPointIntStats[ignoredMeasures] = mPointIntStats[totalMeasures] -  mPointIntStats[validMeasures];
+    mPointIntStats[ignoredMeasures] += iNumMeasures - iValidMeasures;
+
+    // editLockedMeasures
+    mPointIntStats[editLockedMeasures] += cPoint->GetNumLockedMeasures();
   }
 
 
@@ -511,79 +616,92 @@ namespace Isis {
     InitPointDoubleStats();
 
     int iNumPoints = mCNet->GetNumPoints();
-    double dValue = 0;
 
     Statistics residualMagStats;
     Statistics pixelShiftStats;
 
     for (int i = 0; i < iNumPoints; i++) {
-      ControlPoint * cp = mCNet->GetPoint(i);
+      AddPointDoubleStats(mCNet->GetPoint(i), residualMagStats, pixelShiftStats);
+    }
 
-      if (!cp->IsIgnored()) {
-        for (int cmIndex = 0; cmIndex < cp->GetNumMeasures(); cmIndex++) {
-          ControlMeasure *cm = cp->GetMeasure(cmIndex);
+    // Average Residuals
+    mPointDoubleStats[avgResidual] = residualMagStats.Average();
 
-          if (!cm->IsIgnored()) {
-            residualMagStats.AddData(cm->GetResidualMagnitude());
+    // Average Shift
+    mPointDoubleStats[avgPixelShift] = pixelShiftStats.Average();
+  }
 
-            if (!IsSpecial(cm->GetPixelShift()))
-              pixelShiftStats.AddData(fabs(cm->GetPixelShift()));
-          }
-        }
-      }
 
-      Statistics resMagStats = cp->GetStatistic(
-          &ControlMeasure::GetResidualMagnitude);
-      UpdateMinMaxStats(resMagStats, minResidual, maxResidual);
+  /**
+   * Add the Residuals and Shifts of one Control Point to the network statistics
+   *
+   * @param cp - Control Point
+   * @param residualMagStats - Residual magnitudes of the valid measures so far
+   * @param pixelShiftStats - Pixel shifts of the valid measures so far
+   */
+  void ControlNetStatistics::AddPointDoubleStats(const ControlPoint *cp,
+                                                 Statistics &residualMagStats,
+                                                 Statistics &pixelShiftStats) {
+    double dValue = 0;
+
+    if (!cp->IsIgnored()) {
+      for (int cmIndex = 0; cmIndex < cp->GetNumMeasures(); cmIndex++) {
+        const ControlMeasure *cm = cp->GetMeasure(cmIndex);
 
-      Statistics resLineStats = cp->GetStatistic(
-          &ControlMeasure::GetLineResidual);
-      UpdateMinMaxStats(resLineStats, minLineResidual, maxLineResidual);
+        if (!cm->IsIgnored()) {
+          residualMagStats.AddData(cm->GetResidualMagnitude());
 
-      Statistics resSampStats = cp->GetStatistic(
-          &ControlMeasure::GetSampleResidual);
-      UpdateMinMaxStats(resSampStats, minSampleResidual, maxSampleResidual);
+          if (!IsSpecial(cm->GetPixelShift()))
+            pixelShiftStats.AddData(fabs(cm->GetPixelShift()));
+        }
+      }
+    }
 
-      Statistics pixShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetPixelShift);
-      UpdateMinMaxStats(pixShiftStats, minPixelShift, maxPixelShift);
+    Statistics resMagStats = cp->GetStatistic(
+        &ControlMeasure::GetResidualMagnitude);
+    UpdateMinMaxStats(resMagStats, minResidual, maxResidual);
 
-      Statistics lineShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetLineShift);
-      UpdateMinMaxStats(lineShiftStats, minLineShift, maxLineShift);
+    Statistics resLineStats = cp->GetStatistic(
+        &ControlMeasure::GetLineResidual);
+    UpdateMinMaxStats(resLineStats, minLineResidual, maxLineResidual);
 
-      Statistics sampShiftStats = cp->GetStatistic(
-          &ControlMeasure::GetSampleShift);
-      UpdateMinMaxStats(sampShiftStats, minSampleShift, maxSampleShift);
+    Statistics resSampStats = cp->GetStatistic(
+        &ControlMeasure::GetSampleResidual);
+    UpdateMinMaxStats(resSampStats, minSampleResidual, maxSampleResidual);
 
-      Statistics gFitStats = cp->GetStatistic(
-          ControlMeasureLogData::GoodnessOfFit);
-      UpdateMinMaxStats(gFitStats, minGFit, maxGFit);
+    Statistics pixShiftStats = cp->GetStatistic(
+        &ControlMeasure::GetPixelShift);
+    UpdateMinMaxStats(pixShiftStats, minPixelShift, maxPixelShift);
 
-      Statistics minPixelZScoreStats = cp->GetStatistic(
-          ControlMeasureLogData::MinimumPixelZScore);
+    Statistics lineShiftStats = cp->GetStatistic(
+        &ControlMeasure::GetLineShift);
+    UpdateMinMaxStats(lineShiftStats, minLineShift, maxLineShift);
 
-      if (minPixelZScoreStats.ValidPixels()) {
-        dValue = fabs(minPixelZScoreStats.Minimum());
-        if (mPointDoubleStats[minPixelZScore] > dValue)
-          mPointDoubleStats[minPixelZScore] = dValue;
-      }
+    Statistics sampShiftStats = cp->GetStatistic(
+        &ControlMeasure::GetSampleShift);
+    UpdateMinMaxStats(sampShiftStats, minSampleShift, maxSampleShift);
 
-      Statistics maxPixelZScoreStats = cp->GetStatistic(
-          ControlMeasureLogData::MaximumPixelZScore);
+    Statistics gFitStats = cp->GetStatistic(
+        ControlMeasureLogData::GoodnessOfFit);
+    UpdateMinMaxStats(gFitStats, minGFit, maxGFit);
 
-      if (maxPixelZScoreStats.ValidPixels()) {
-        dValue = fabs(maxPixelZScoreStats.Maximum());
-        if (mPointDoubleStats[maxPixelZScore] > dValue)
-          mPointDoubleStats[maxPixelZScore] = dValue;
-      }
+    Statistics minPixelZScoreStats = cp->GetStatistic(
+        ControlMeasureLogData::MinimumPixelZScore);
+
+    if (minPixelZScoreStats.ValidPixels()) {
+      dValue = fabs(minPixelZScoreStats.Minimum());
+      if (mPointDoubleStats[minPixelZScore] > dValue)
+        mPointDoubleStats[minPixelZScore] = dValue;
     }
 
-    // Average Residuals
-    mPointDoubleStats[avgResidual] = residualMagStats.Average();
+    Statistics maxPixelZScoreStats = cp->GetStatistic(
+        ControlMeasureLogData::MaximumPixelZScore);
 
-    // Average Shift
-    mPointDoubleStats[avgPixelShift] = pixelShiftStats.Average();
+    if (maxPixelZScoreStats.ValidPixels()) {
+      dValue = fabs(maxPixelZScoreStats.Maximum());
+      if (mPointDoubleStats[maxPixelZScore] > dValue)
+        mPointDoubleStats[maxPixelZScore] = dValue;
+    }
   }
 
 
@@ -1,6 +1,8 @@
 #ifndef _CONTROLNETSTATISTICS_H_
 #define _CONTROLNETSTATISTICS_H_
 
+#include <fstream>
+
 #include <QMap>
 #include <QVector> 
 
@@ -35,6 +37,7 @@
 
 namespace Isis {
   class ControlNet;
+  class ControlPoint;
   class Progress;
   class PvlGroup;
 
@@ -75,6 +78,10 @@ namespace Isis {
    *                           Fixes #996.
    *  @history 2017-12-12 Kristin Berry - Updated std::map to QMap and std::vector to QVector. Fixes
    *                           #5259.
+   *  @history 2026-10-16 Isis Development Team - Added a constructor that streams the points of
+   *                           a Control Net file for the point and measure stats, and split the
+   *                           point stats into per point methods it shares with the ControlNet
+   *                           constructors.
    */
   class ControlNetStatistics {
     public:
@@ -84,6 +91,10 @@ namespace Isis {
       //! Constructor
       ControlNetStatistics(ControlNet *pCNet, Progress *pProgress = 0);
 
+      //! Constructor, streams the points of a Control Net file
+      ControlNetStatistics(const QString &psCNetFile, const QString &psPointFile,
+                           Progress *pProgress = 0);
+
       //! Destructor
       ~ControlNetStatistics();
 
@@ -256,9 +267,28 @@ namespace Isis {
       //! Get point count stats
       void GetPointIntStats();
 
+      //! Init point count stats
+      void InitPointIntStats();
+
+      //! Add the counts of a point to the point count stats
+      void AddPointIntStats(const ControlPoint *cPoint);
+
       //! Get Point stats for Residuals and Shifts
       void GetPointDoubleStats();
 
+      //! Add the Residuals and Shifts of a point to the Point stats
+      void AddPointDoubleStats(const ControlPoint *cp, Statistics &residualMagStats,
+                               Statistics &pixelShiftStats);
+
+      //! Open the Point Stats file and write its header
+      void OpenPointStats(std::ofstream &ostm, const QString &psPointFile);
+
+      //! Write the stats of a point into the Point Stats file
+      void WritePointStats(std::ofstream &ostm, const ControlPoint *cPoint);
+
+      //! Close the Point Stats file
+      void ClosePointStats(std::ofstream &ostm, const QString &psPointFile);
+
       void UpdateMinMaxStats(const Statistics & stats,
                              ePointDoubleStats min,
                              ePointDoubleStats max);
@@ -3,8 +3,15 @@
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/numeric/ublas/io.hpp>
 
+#include <vector>
+
 #include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedPointer>
 #include <QString>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include "ControlNetFileHeaderV0002.pb.h"
 #include "ControlNetFileHeaderV0005.pb.h"
@@ -83,6 +90,37 @@ namespace Isis {
   }
 
 
+  /**
+   * Construct a ControlNetVersioner that streams the points of a file. Each point is passed to
+   * visitPoint as soon as it is read and is deleted when visitPoint returns, so the versioner
+   * never holds the whole network. The header is kept as usual.
+   *
+   * Version 5 protobuf files, the format that is written, are read a batch of points at a time,
+   * so the memory used does not grow with the size of the network. Files in older formats are
+   * read in full before their points are visited.
+   *
+   * @param netFile The control network file to read in.
+   * @param visitPoint Called with each point, in file order. It must not keep the point.
+   * @param progress The progress object to track reading points.
+   */
+  ControlNetVersioner::ControlNetVersioner(const FileName netFile,
+                                           std::function<void(ControlPoint *)> visitPoint,
+                                           Progress *progress)
+      : m_ownsPoints(true), m_visitPoint(visitPoint) {
+    try {
+      read(netFile, progress);
+
+      while ( !m_points.isEmpty() ) {
+        addPoint( m_points.takeFirst() );
+      }
+    }
+    catch (...) {
+      qDeleteAll(m_points);
+      throw;
+    }
+  }
+
+
   /**
    * Destroy a ControlNetVersioner. If the versioner owns the control points stored in it,
    * they will also be deleted.
@@ -1137,7 +1175,8 @@ namespace Isis {
 
   /**
    * Read a protobuf version 5 control network and prepare the data to be
-   *  converted into a control network.
+   *  converted into a control network. The points are parsed and converted
+   *  on the global thread pool.
    *
    * @param header The Pvl file header that contains byte offsets for the protobuf messages
    * @param netFile The filename of the control network file.
@@ -1218,8 +1257,6 @@ namespace Isis {
     input.open(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
     input.seekg(filePos, ios::beg);
 
-    IstreamInputStream pointInStream(&input);
-
     BigInt numberOfPoints = 0;
 
     if ( protoBufferInfo.hasGroup("ControlNetworkInfo") ) {
@@ -1241,47 +1278,141 @@ namespace Isis {
       progress->CheckStatus();
     }
 
+    // The points are length prefixed messages, so they are read in batches.
+    // The messages of a batch are first copied out of the file in order, then
+    // parsed and converted into ControlPoints on the global thread pool. The
+    // points are appended in file order and the error reported for a batch is
+    // the one for its first bad point, the same as reading them one at a time.
     Isis::EndianSwapper lsb("LSB");
-    int pointIndex = -1;
-    while (pointInStream.ByteCount() < pointsLength) {
-      pointIndex += 1;
-      QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+    QThread *readThread = QThread::currentThread();
+    const int batchBytes = 64 * 1024 * 1024;
+    BigInt pointsRead = 0;
+    int pointIndex = 0;
+    while (pointsRead < pointsLength) {
+      vector<char> batch;
+      vector<int> offsets;
+      vector<int> sizes;
+      bool scanFailed = false;
+      while (pointsRead < pointsLength && (int) batch.size() < batchBytes) {
+        uint32_t size = 0;
+        input.read(reinterpret_cast<char *>(&size), sizeof(size));
+        size = lsb.Uint32_t(&size);
 
-      try {
+        // A size that runs past the end of the points would read garbage or
+        // allocate far more than the file holds, so it is a bad point
+        int offset = batch.size();
+        if ( (BigInt) size > pointsLength - pointsRead - (BigInt) sizeof(size) ) {
+          input.setstate(ios::failbit);
+        }
+        if (input) {
+          batch.resize(offset + size);
+          input.read(batch.data() + offset, size);
+        }
+        if ( !input ) {
+          scanFailed = true;
+          break;
+        }
 
-        CodedInputStream pointCodedInStream(&pointInStream);
-        pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512,
-                                              1024 * 1024 * 400);
+        offsets.push_back(offset);
+        sizes.push_back(size);
+        pointsRead += sizeof(size) + size;
+      }
 
-        uint32_t size;
-        pointCodedInStream.ReadRaw(reinterpret_cast<char *>(&size), sizeof(size));
+      int batchSize = offsets.size();
+      vector<int> indices(batchSize);
+      for (int i = 0; i < batchSize; i++) {
+        indices[i] = i;
+      }
 
-        size = lsb.Uint32_t(&size);
+      vector<ControlPoint *> batchPoints(batchSize, NULL);
+      QMutex errorMutex;
+      int errorIndex = batchSize;
+      IException error;
 
-        CodedInputStream::Limit oldPointLimit = pointCodedInStream.PushLimit(size);
-        newPoint->ParseFromCodedStream(&pointCodedInStream);
-        pointCodedInStream.PopLimit(oldPointLimit);
-      }
-      catch (...) {
+      // The point that could not be read comes after the rest of the batch, so
+      // it is only reported if all of them can be parsed and converted
+      if (scanFailed) {
         QString msg = "Failed to read protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "].";
-        throw IException(IException::Io, msg, _FILEINFO_);
+                      + toString(pointIndex + batchSize) + "].";
+        error = IException(IException::Io, msg, _FILEINFO_);
+      }
+      auto fail = [&](int i, const IException &e) {
+        QMutexLocker locker(&errorMutex);
+        if (i < errorIndex) {
+          errorIndex = i;
+          error = e;
+        }
+      };
+
+      QtConcurrent::blockingMap(indices.begin(), indices.end(), [&](int i) {
+        QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+
+        try {
+          CodedInputStream pointCodedInStream(
+                reinterpret_cast<const google::protobuf::uint8 *>(batch.data() + offsets[i]),
+                sizes[i]);
+          pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512,
+                                                1024 * 1024 * 400);
+          newPoint->ParseFromCodedStream(&pointCodedInStream);
+        }
+        catch (...) {
+          QString msg = "Failed to read protobuf version 2 control point at index ["
+                        + toString(pointIndex + i) + "].";
+          fail(i, IException(IException::Io, msg, _FILEINFO_));
+          return;
+        }
+
+        try {
+          ControlPointV0005 point(newPoint);
+          ControlPoint *controlPoint = createPoint(point);
+
+          // The pool's threads hand the point and its measures to the reading
+          // thread, which the rest of the network belongs to
+          foreach (ControlMeasure *measure, controlPoint->getMeasures()) {
+            measure->moveToThread(readThread);
+          }
+          controlPoint->moveToThread(readThread);
+          batchPoints[i] = controlPoint;
+        }
+        catch (IException &e) {
+          QString msg = "Failed to convert protobuf version 2 control point at index ["
+                        + toString(pointIndex + i) + "] into a ControlPoint.";
+          fail(i, IException(e, IException::Io, msg, _FILEINFO_));
+        }
+        // Anything else escaping the map would skip the cleanup of the points
+        // already built for this batch
+        catch (...) {
+          QString msg = "Failed to convert protobuf version 2 control point at index ["
+                        + toString(pointIndex + i) + "] into a ControlPoint.";
+          fail(i, IException(IException::Io, msg, _FILEINFO_));
+        }
+      });
+
+      if (errorIndex < batchSize || scanFailed) {
+        for (int i = 0; i < batchSize; i++) {
+          delete batchPoints[i];
+        }
+        throw error;
       }
 
       try {
-        ControlPointV0005 point(newPoint);
-        m_points.append( createPoint(point) );
+        for (int i = 0; i < batchSize; i++) {
+          ControlPoint *point = batchPoints[i];
+          batchPoints[i] = NULL;
+          addPoint(point);
 
-        if (progress && numberOfPoints != 0) {
-          progress->CheckStatus();
+          if (progress && numberOfPoints != 0) {
+            progress->CheckStatus();
+          }
         }
-
       }
-      catch (IException &e) {
-        QString msg = "Failed to convert protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "] into a ControlPoint.";
-        throw IException(e, IException::Io, msg, _FILEINFO_);
+      catch (...) {
+        for (int i = 0; i < batchSize; i++) {
+          delete batchPoints[i];
+        }
+        throw;
       }
+      pointIndex += batchSize;
     }
   }
 
@@ -1625,6 +1756,23 @@ namespace Isis {
   }
 
 
+  /**
+   * Keeps a point that was read from a file. When the versioner is streaming the file, the point
+   * is passed to the point visitor and deleted instead.
+   *
+   * @param point The point that was read.
+   */
+  void ControlNetVersioner::addPoint(ControlPoint *point) {
+    if ( !m_visitPoint ) {
+      m_points.append(point);
+      return;
+    }
+
+    QScopedPointer<ControlPoint> visitedPoint(point);
+    m_visitPoint(point);
+  }
+
+
   /**
    * Create the internal header from a V0001 header.
    *
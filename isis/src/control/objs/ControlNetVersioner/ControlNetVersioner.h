@@ -23,6 +23,8 @@
  *   http://www.usgs.gov/privacy.html.
  */
 
+#include <functional>
+
 #include <QString>
 
 #include <QList>
@@ -428,6 +430,9 @@ namespace Isis {
     public:
       ControlNetVersioner(ControlNet *net);
       ControlNetVersioner(const FileName netFile, Progress *progress=NULL);
+      ControlNetVersioner(const FileName netFile,
+                          std::function<void(ControlPoint *)> visitPoint,
+                          Progress *progress=NULL);
       ~ControlNetVersioner();
 
       QString netId() const;
@@ -522,6 +527,8 @@ namespace Isis {
 
       ControlMeasure *createMeasure(const ControlPointFileEntryV0002_Measure&);
 
+      void addPoint(ControlPoint *point);
+
       void createHeader(const ControlNetHeaderV0001 header);
 
       void writeHeader(std::fstream *output);
@@ -535,6 +542,8 @@ namespace Isis {
                              This will be true when the versioner created the points from a file.
                              This will be false when the versioner copied the points from an
                              esiting control network.*/
+      std::function<void(ControlPoint *)> m_visitPoint; /**< Called with each point read from a
+                                                             file instead of keeping it, if set.*/
 
   };
 }
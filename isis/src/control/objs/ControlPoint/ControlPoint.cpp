@@ -25,6 +25,7 @@
 #include "SerialNumberList.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
+#include "StringPool.h"
 
 using boost::numeric::ublas::symmetric_matrix;
 using boost::numeric::ublas::upper;
@@ -480,7 +481,7 @@ namespace Isis {
     if (editLock) {
       return PointLocked;
     }
-    chooserName = name;
+    chooserName = StringPool::intern(name);
     return Success;
   }
 
@@ -750,7 +751,7 @@ namespace Isis {
       return PointLocked;
     }
     PointModified();
-    aprioriRadiusSourceFile = sourceFile;
+    aprioriRadiusSourceFile = StringPool::intern(sourceFile);
     return Success;
   }
 
@@ -834,7 +835,7 @@ namespace Isis {
       return PointLocked;
     }
     PointModified();
-    aprioriSurfacePointSourceFile = sourceFile;
+    aprioriSurfacePointSourceFile = StringPool::intern(sourceFile);
     return Success;
   }
 
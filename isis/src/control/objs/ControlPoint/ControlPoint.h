@@ -365,6 +365,8 @@ namespace Isis {
    *                           coordinates.
    *  @history 2019-05-16 Debbie A. Cook  See history entry for ComputeResiduals.  Modified call to 
    *                           CameraGroundMap to not do back-of-planet test. References #2591.
+   *  @history 2026-10-16 Isis Development Team - Chooser names and a priori source files are
+   *                           shared through StringPool.
    */
   class ControlPoint : public QObject {
 
@@ -45,6 +45,7 @@ namespace Isis {
     p_viewport = viewport;
     p_bufferInitialized = false;
     p_band = -1;
+    p_overviewCount = p_viewport->cube()->overviewCount();
     p_enabled = true;
     p_initialStretchDone = false;
     p_viewportHeight = p_viewport->viewport()->height();
@@ -58,6 +59,11 @@ namespace Isis {
     connect(this, SIGNAL(ReadCube(int, int, int, int, int, int, void *)),
             p_dataThread, SLOT(ReadCube(int, int, int, int, int, int, void *)));
 
+    connect(this,
+            SIGNAL(ReadCubeOverview(int, int, int, int, int, int, int, void *)),
+            p_dataThread,
+            SLOT(ReadCubeOverview(int, int, int, int, int, int, int, void *)));
+
     connect(p_dataThread, SIGNAL(ReadReady(void *, int, const Isis::Brick *)),
             this, SLOT(DataReady(void *, int, const Isis::Brick *)));
 
@@ -73,6 +79,11 @@ namespace Isis {
     disconnect(this, SIGNAL(ReadCube(int, int, int, int, int, int, void *)),
                p_dataThread, SLOT(ReadCube(int, int, int, int, int, int, void *)));
 
+    disconnect(this,
+               SIGNAL(ReadCubeOverview(int, int, int, int, int, int, int, void *)),
+               p_dataThread,
+               SLOT(ReadCubeOverview(int, int, int, int, int, int, int, void *)));
+
     disconnect(p_dataThread, SIGNAL(ReadReady(void *, int, const Isis::Brick *)),
                this, SLOT(DataReady(void *, int, const Isis::Brick *)));
 
@@ -551,13 +562,45 @@ namespace Isis {
     int roundedSamp = (int)(ssamp + 0.5);
     int roundedLine = (int)(line + 0.5);
 
-    emit ReadCube(p_cubeId, roundedSamp, roundedLine, roundedSamp + brickWidth,
-                  roundedLine, p_band, this);
+    int level = overviewLevel(fill);
+    if (level > 0) {
+      emit ReadCubeOverview(p_cubeId, roundedSamp, roundedLine,
+                            roundedSamp + brickWidth, roundedLine, p_band,
+                            level, this);
+    }
+    else {
+      emit ReadCube(p_cubeId, roundedSamp, roundedLine,
+                    roundedSamp + brickWidth, roundedLine, p_band, this);
+    }
 
     fill->incRequestPosition();
   }
 
 
+  /**
+   * This returns the overview level a fill action should read from. This is
+   * the coarsest level (see Cube::createOverviews()) that still has at least
+   * one pixel for every viewport pixel, so the view looks the same as when
+   * every viewport pixel is read from the full resolution data.
+   *
+   * @param fill The fill action
+   *
+   * @return The overview level, 0 for the full resolution data
+   */
+  int ViewportBuffer::overviewLevel(ViewportBufferFill *fill) const {
+    // Cube samples per viewport pixel
+    double samplesPerPixel = fill->viewportToSample(1) -
+                             fill->viewportToSample(0);
+
+    int level = 0;
+    while (level < p_overviewCount && (2 << level) <= samplesPerPixel) {
+      level++;
+    }
+
+    return level;
+  }
+
+
   /**
    * This processes the next available action, or starts
    * processing it, if possible. This method keeps the buffer
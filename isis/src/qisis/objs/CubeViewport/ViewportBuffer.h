@@ -74,6 +74,9 @@ namespace Isis {
    *                           and fill action creation
    *   @history 2011-06-20 Steven Lambright - Fixed panning issue where panning
    *                           beyond a full screen was a problem. 
+   *   @history 2026-10-16 Isis Development Team - Lines are read from the
+   *                           cube's overview levels when zoomed out far
+   *                           enough.
    */
   class ViewportBuffer : public QObject {
       Q_OBJECT
@@ -142,6 +145,22 @@ namespace Isis {
       void ReadCube(int cubeId, int startSample, int startLine,
                     int endSample, int endLine, int band, void *caller);
 
+      /**
+       * Ask the cube data thread for data from an overview level
+       *
+       * @param cubeId
+       * @param startSample
+       * @param startLine
+       * @param endSample
+       * @param endLine
+       * @param band
+       * @param overviewLevel
+       * @param caller
+       */
+      void ReadCubeOverview(int cubeId, int startSample, int startLine,
+                            int endSample, int endLine, int band,
+                            int overviewLevel, void *caller);
+
       //! Tell cube data thread we're done with a brick
       void DoneWithData(int, const Isis::Brick *);
 
@@ -157,6 +176,7 @@ namespace Isis {
       ViewportBufferFill *createViewportBufferFill(QRect, bool);
 
       void requestCubeLine(ViewportBufferFill *fill);
+      int overviewLevel(ViewportBufferFill *fill) const;
 
       void resizeBuffer(unsigned int width, unsigned int height);
       void shiftBuffer(int deltaX, int deltaY);
@@ -170,6 +190,7 @@ namespace Isis {
       CubeDataThread *p_dataThread;  //!< manages cube io
 
       int p_band; //!< The band to read from
+      int p_overviewCount; //!< The number of overview levels in the cube
 
       bool p_enabled; //!< True if reading from cube (active)
       std::vector< std::vector<double> > p_buffer; //!< The buffer to hold cube dn values
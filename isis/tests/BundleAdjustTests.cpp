@@ -0,0 +1,142 @@
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QThreadPool>
+
+#include "BundleAdjust.h"
+#include "BundleObservation.h"
+#include "BundleObservationSolveSettings.h"
+#include "BundleResults.h"
+#include "BundleSettings.h"
+#include "BundleSolutionInfo.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "Displacement.h"
+#include "Distance.h"
+#include "Fixtures.h"
+#include "SurfacePoint.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString NETWORK_FILE = "data/threeImageNetwork/controlnetwork.net";
+
+/**
+ * Settings for a small, well constrained adjustment of the three image
+ * network: camera angles and points are both weighted so the normal equations
+ * are positive definite, and error propagation is on.
+ */
+static BundleSettingsQsp bundleSettings(const QString &outputPrefix) {
+  BundleSettingsQsp settings(new BundleSettings);
+  settings->setValidateNetwork(false);
+  settings->setSolveOptions(false, false, true, true, SurfacePoint::Latitudinal,
+                            SurfacePoint::Latitudinal, 1000.0, 1000.0, 1000.0);
+  settings->setConvergenceCriteria(BundleSettings::Sigma0, 1.0e-10, 3);
+  settings->setOutputFilePrefix(outputPrefix);
+
+  BundleObservationSolveSettings observationSettings;
+  observationSettings.setInstrumentPointingSettings(BundleObservationSolveSettings::AnglesOnly,
+                                                    true, 2, 2, false, 2.0);
+  QList<BundleObservationSolveSettings> observationSettingsList;
+  observationSettingsList.append(observationSettings);
+  settings->setObservationSolveOptions(observationSettingsList);
+
+  return settings;
+}
+
+
+// The adjusted points of two solutions to the same network
+static void expectSamePoints(BundleSolutionInfo &expected, BundleSolutionInfo &actual,
+                             bool compareSigmas, double tolerance) {
+  ControlNetQsp expectedNet = expected.bundleResults().outputControlNet();
+  ControlNetQsp actualNet = actual.bundleResults().outputControlNet();
+  ASSERT_EQ(actualNet->GetNumPoints(), expectedNet->GetNumPoints());
+
+  for (int i = 0; i < expectedNet->GetNumPoints(); i++) {
+    const ControlPoint *expectedPoint = expectedNet->GetPoint(i);
+    const ControlPoint *actualPoint = actualNet->GetPoint(i);
+    ASSERT_EQ(actualPoint->GetId(), expectedPoint->GetId());
+    ASSERT_EQ(actualPoint->IsRejected(), expectedPoint->IsRejected());
+
+    SurfacePoint expectedSurface = expectedPoint->GetAdjustedSurfacePoint();
+    SurfacePoint actualSurface = actualPoint->GetAdjustedSurfacePoint();
+    EXPECT_NEAR(actualSurface.GetX().meters(), expectedSurface.GetX().meters(), tolerance)
+        << expectedPoint->GetId();
+    EXPECT_NEAR(actualSurface.GetY().meters(), expectedSurface.GetY().meters(), tolerance)
+        << expectedPoint->GetId();
+    EXPECT_NEAR(actualSurface.GetZ().meters(), expectedSurface.GetZ().meters(), tolerance)
+        << expectedPoint->GetId();
+
+    if (compareSigmas) {
+      EXPECT_NEAR(actualSurface.GetLatSigmaDistance().meters(),
+                  expectedSurface.GetLatSigmaDistance().meters(), tolerance)
+          << expectedPoint->GetId();
+      EXPECT_NEAR(actualSurface.GetLonSigmaDistance().meters(),
+                  expectedSurface.GetLonSigmaDistance().meters(), tolerance)
+          << expectedPoint->GetId();
+      EXPECT_NEAR(actualSurface.GetLocalRadiusSigma().meters(),
+                  expectedSurface.GetLocalRadiusSigma().meters(), tolerance)
+          << expectedPoint->GetId();
+    }
+  }
+}
+
+
+// The point normals are formed in batches on the global thread pool and then
+// added in point order, so the solution can't depend on the thread count.
+TEST_F(ThreeImageNetwork, BundleAdjustParallelNormalsMatchSerial) {
+  int threads = QThreadPool::globalInstance()->maxThreadCount();
+
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  BundleAdjust serialBundle(bundleSettings(tempDir.path() + "/serial_"), NETWORK_FILE,
+                            cubeListFile, false);
+  QScopedPointer<BundleSolutionInfo> serial(serialBundle.solveCholeskyBR());
+
+  QThreadPool::globalInstance()->setMaxThreadCount(8);
+  BundleAdjust parallelBundle(bundleSettings(tempDir.path() + "/parallel_"), NETWORK_FILE,
+                              cubeListFile, false);
+  QScopedPointer<BundleSolutionInfo> parallel(parallelBundle.solveCholeskyBR());
+
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  ASSERT_FALSE(serial.isNull());
+  ASSERT_FALSE(parallel.isNull());
+  EXPECT_EQ(parallel->bundleResults().iterations(), serial->bundleResults().iterations());
+  EXPECT_DOUBLE_EQ(parallel->bundleResults().sigma0(), serial->bundleResults().sigma0());
+  expectSamePoints(*serial, *parallel, true, 1.0e-9);
+}
+
+
+// The Takahashi selected inverse only forms the inverse entries inside the
+// factor's pattern. The point and image sigmas it gives must match the ones
+// from the column by column inverse, which is used when the inverse matrix
+// file is written.
+TEST_F(ThreeImageNetwork, BundleAdjustSelectedInverseMatchesInverseColumns) {
+  BundleSettingsQsp columnSettings = bundleSettings(tempDir.path() + "/columns_");
+  columnSettings->setCreateInverseMatrix(true);
+  BundleAdjust columnBundle(columnSettings, NETWORK_FILE, cubeListFile, false);
+  QScopedPointer<BundleSolutionInfo> columns(columnBundle.solveCholeskyBR());
+
+  BundleAdjust selectedBundle(bundleSettings(tempDir.path() + "/selected_"), NETWORK_FILE,
+                              cubeListFile, false);
+  QScopedPointer<BundleSolutionInfo> selected(selectedBundle.solveCholeskyBR());
+
+  ASSERT_FALSE(columns.isNull());
+  ASSERT_FALSE(selected.isNull());
+  EXPECT_NEAR(selected->bundleResults().sigma0(), columns->bundleResults().sigma0(), 1.0e-12);
+  expectSamePoints(*columns, *selected, true, 1.0e-8);
+
+  const BundleObservationVector &columnObservations = columns->bundleResults().observations();
+  const BundleObservationVector &selectedObservations = selected->bundleResults().observations();
+  ASSERT_EQ(selectedObservations.size(), columnObservations.size());
+
+  for (int i = 0; i < columnObservations.size(); i++) {
+    LinearAlgebra::Vector &expected = columnObservations[i]->adjustedSigmas();
+    LinearAlgebra::Vector &actual = selectedObservations[i]->adjustedSigmas();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (unsigned int j = 0; j < expected.size(); j++) {
+      EXPECT_NEAR(actual[j], expected[j], 1.0e-10) << "observation " << i << " parameter " << j;
+    }
+  }
+}
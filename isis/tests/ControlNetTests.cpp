@@ -0,0 +1,235 @@
+#include <QElapsedTimer>
+#include <QFile>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrentMap>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetVersioner.h"
+#include "ControlPoint.h"
+#include "IException.h"
+#include "StringPool.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// The resident memory of this process in kilobytes, or 0 where /proc is not available
+static qint64 residentKilobytes() {
+  QFile statm("/proc/self/statm");
+  if (!statm.open(QIODevice::ReadOnly)) {
+    return 0;
+  }
+  QStringList pages = QString(statm.readAll()).split(" ");
+  return (pages.size() > 1) ? pages[1].toLongLong() * 4 : 0;
+}
+
+
+// A network of points on a strip of images, each point measured on four
+// neighbouring images
+static void makeNetwork(ControlNet &net, int points, int images) {
+  for (int p = 0; p < points; p++) {
+    ControlPoint *point = new ControlPoint(QString("Point%1").arg(p));
+    point->SetChooserName("ControlNetTests");
+    point->SetDateTime("2026-10-16T12:00:00");
+    for (int m = 0; m < 4; m++) {
+      ControlMeasure *measure = new ControlMeasure;
+      measure->SetCubeSerialNumber(QString("Image%1").arg((p + m) % images));
+      measure->SetCoordinate(100.0 + m, 200.0 + p % 1000);
+      measure->SetChooserName("ControlNetTests");
+      measure->SetDateTime("2026-10-16T12:00:00");
+      point->Add(measure);
+    }
+    net.AddPoint(point);
+  }
+}
+
+
+TEST(ControlNet, MeasuresShareStrings) {
+  ControlNet net;
+  makeNetwork(net, 20, 10);
+
+  // Separately built equal strings share the characters of one interned copy
+  ControlMeasure *first = net.GetPoint(0)->GetMeasure(0);
+  ControlMeasure *second = net.GetPoint(10)->GetMeasure(0);
+  ASSERT_EQ(first->GetCubeSerialNumber(), second->GetCubeSerialNumber());
+  EXPECT_EQ(first->GetCubeSerialNumber().constData(),
+            second->GetCubeSerialNumber().constData());
+  EXPECT_EQ(first->GetChooserName().constData(), second->GetChooserName().constData());
+  EXPECT_EQ(net.GetPoint(0)->GetChooserName().constData(),
+            first->GetChooserName().constData());
+
+  EXPECT_EQ(StringPool::intern(QString("Image") + "3").constData(),
+            net.GetPoint(3)->GetMeasure(0)->GetCubeSerialNumber().constData());
+  EXPECT_EQ(net.GetCubeSerials().size(), 10);
+
+  // Copies and edits keep the values
+  ControlMeasure copy(*first);
+  EXPECT_EQ(copy, *first);
+  copy.SetChooserName("Someone");
+  EXPECT_EQ(copy.GetChooserName(), "Someone");
+  EXPECT_EQ(first->GetChooserName(), "ControlNetTests");
+  copy = *second;
+  EXPECT_EQ(copy.GetCubeSerialNumber(), second->GetCubeSerialNumber());
+}
+
+
+TEST(StringPool, Intern) {
+  QString empty = StringPool::intern(QString());
+  EXPECT_TRUE(empty.isEmpty());
+
+  QString a = StringPool::intern(QString("StringPool") + "Test");
+  int size = StringPool::size();
+  QString b = StringPool::intern(QString("StringPoolTe") + "st");
+  EXPECT_EQ(a, "StringPoolTest");
+  EXPECT_EQ(a.constData(), b.constData());
+  EXPECT_EQ(StringPool::size(), size);
+}
+
+
+TEST(StringPool, InternFromThreads) {
+  // Many threads interning the same few strings all get the same copies
+  QVector<QString> interned(10000);
+  QVector<int> indices(interned.size());
+  for (int i = 0; i < indices.size(); i++) {
+    indices[i] = i;
+  }
+
+  QString *results = interned.data();
+  QtConcurrent::blockingMap(indices, [&](int i) {
+    results[i] = StringPool::intern(QString("ThreadedSerial%1").arg(i % 10));
+  });
+
+  for (int i = 0; i < interned.size(); i++) {
+    EXPECT_EQ(interned[i], QString("ThreadedSerial%1").arg(i % 10));
+    EXPECT_EQ(interned[i].constData(), interned[i % 10].constData());
+  }
+}
+
+
+TEST_F(TempTestingFiles, ControlNetReadKeepsPointOrder) {
+  int points = 2000;
+  QString file = tempDir.path() + "/order.net";
+
+  {
+    ControlNet net;
+    net.SetNetworkId("Order");
+    net.SetUserName("ControlNetTests");
+    makeNetwork(net, points, 50);
+    net.Write(file);
+  }
+
+  // The points are converted on other threads but read back in file order,
+  // belonging to this thread
+  ControlNet net(file);
+  ASSERT_EQ(net.GetNumPoints(), points);
+  for (int p = 0; p < points; p++) {
+    ControlPoint *point = net.GetPoint(p);
+    ASSERT_EQ(point->GetId(), QString("Point%1").arg(p));
+    EXPECT_EQ(point->thread(), QThread::currentThread());
+    ASSERT_EQ(point->GetNumMeasures(), 4);
+    for (int m = 0; m < 4; m++) {
+      ControlMeasure *measure = point->GetMeasure(m);
+      EXPECT_EQ(measure->GetCubeSerialNumber(), QString("Image%1").arg((p + m) % 50));
+      EXPECT_EQ(measure->GetSample(), 100.0 + m);
+      EXPECT_EQ(measure->GetLine(), 200.0 + p % 1000);
+      EXPECT_EQ(measure->thread(), QThread::currentThread());
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, ControlNetVersionerStreamsPoints) {
+  int points = 500;
+  QString file = tempDir.path() + "/stream.net";
+
+  {
+    ControlNet net;
+    net.SetNetworkId("Stream");
+    net.SetUserName("ControlNetTests");
+    makeNetwork(net, points, 20);
+    net.Write(file);
+  }
+
+  // Each point is visited in file order and deleted before the next one
+  int visited = 0;
+  QPointer<ControlPoint> previous;
+  ControlNetVersioner reader(file, [&](ControlPoint *point) {
+    EXPECT_TRUE(previous.isNull());
+    EXPECT_EQ(point->GetId(), QString("Point%1").arg(visited));
+    EXPECT_EQ(point->GetNumMeasures(), 4);
+    previous = point;
+    visited++;
+  });
+
+  EXPECT_EQ(visited, points);
+  EXPECT_TRUE(previous.isNull());
+  EXPECT_EQ(reader.numPoints(), 0);
+  EXPECT_EQ(reader.netId(), "Stream");
+  EXPECT_EQ(reader.userName(), "ControlNetTests");
+}
+
+
+// A truncated file fails on its last point, after the points before it have
+// been parsed and converted
+TEST_F(TempTestingFiles, ControlNetReadTruncatedFile) {
+  int points = 100;
+  QString file = tempDir.path() + "/truncated.net";
+
+  {
+    ControlNet net;
+    net.SetNetworkId("Truncated");
+    net.SetUserName("ControlNetTests");
+    makeNetwork(net, points, 10);
+    net.Write(file);
+  }
+  ASSERT_TRUE(QFile::resize(file, QFile(file).size() - 10));
+
+  try {
+    ControlNet net(file);
+    FAIL() << "Expected an exception";
+  }
+  catch (IException &e) {
+    EXPECT_TRUE(e.toString().contains(QString("index [%1]").arg(points - 1)))
+        << e.toString().toStdString();
+  }
+}
+
+
+// Times reading a large network and records the memory it takes per measure.
+// Run with --gtest_also_run_disabled_tests, on a build with and one without
+// StringPool, to compare the string sharing against unshared strings.
+TEST_F(TempTestingFiles, DISABLED_ControlNetLoadBenchmark) {
+  int points = 250000;
+  QString file = tempDir.path() + "/benchmark.net";
+
+  {
+    ControlNet net;
+    net.SetNetworkId("Benchmark");
+    net.SetUserName("ControlNetTests");
+    makeNetwork(net, points, 1000);
+    net.Write(file);
+  }
+
+  qint64 before = residentKilobytes();
+  QElapsedTimer timer;
+  timer.start();
+  ControlNet net(file);
+  qint64 readTime = timer.elapsed();
+  qint64 after = residentKilobytes();
+
+  RecordProperty("ReadMilliseconds", QString::number(readTime).toStdString());
+  if (before > 0) {
+    RecordProperty("KilobytesPerMeasure",
+                   QString::number((after - before) / (4.0 * points)).toStdString());
+  }
+
+  EXPECT_EQ(net.GetNumPoints(), points);
+  EXPECT_EQ(net.GetNumMeasures(), 4 * points);
+}
@@ -1,12 +1,29 @@
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QList>
+#include <QScopedPointer>
 #include <QTemporaryFile>
 #include <QString>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <iostream>
 
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
 #include "Cube.h"
+#include "CubeBsqHandler.h"
+#include "CubeOverview.h"
+#include "CubeTileHandler.h"
+#include "Brick.h"
 #include "Camera.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "SpecialPixel.h"
 
 #include "Fixtures.h"
 #include "TestUtilities.h"
@@ -232,3 +249,584 @@ TEST(CubeTest, TestCubeAttachSpiceFromIsd) {
 
   EXPECT_PRED_FORMAT2(AssertQStringsEqual, cam->instrumentNameLong(), "Visual Imaging Subsystem Camera B");
 }
+
+
+TEST_F(TempTestingFiles, TestCubeMemoryMappedRead) {
+  PvlKeyword &mappingPref =
+      Preference::Preferences().findGroup("Performance")["CubeMemoryMapping"];
+  QString originalMappingPref = mappingPref[0];
+
+  QList<Cube::Format> formats;
+  formats << Cube::Bsq << Cube::Tile;
+  foreach (Cube::Format format, formats) {
+    QString cubeFile = tempDir.path() + "/mapped" + QString::number(format) + ".cub";
+
+    Cube outCube;
+    outCube.setDimensions(300, 200, 2);
+    outCube.setFormat(format);
+    outCube.setPixelType(SignedWord);
+    outCube.create(cubeFile);
+
+    LineManager outLine(outCube);
+    for (outLine.begin(); !outLine.end(); outLine++) {
+      for (int i = 0; i < outLine.size(); i++) {
+        outLine[i] = (i % 50 == 0) ? Null : outLine.Line() + i * 10 + outLine.Band();
+      }
+      outCube.write(outLine);
+    }
+    outCube.close();
+
+    mappingPref.setValue("Always");
+
+    Cube inCube(cubeFile, "r");
+    LineManager inLine(inCube);
+    for (inLine.begin(); !inLine.end(); inLine++) {
+      inCube.read(inLine);
+      for (int i = 0; i < inLine.size(); i++) {
+        if (i % 50 == 0) {
+          EXPECT_TRUE(IsNullPixel(inLine[i]));
+        }
+        else {
+          EXPECT_EQ(inLine[i], inLine.Line() + i * 10 + inLine.Band());
+        }
+      }
+    }
+    inCube.close();
+
+    // The handler reads through the mapping only when the preference asks for it
+    Pvl label(cubeFile);
+    QFile dataFile(cubeFile);
+    ASSERT_TRUE(dataFile.open(QIODevice::ReadOnly));
+    auto openHandler = [&]() -> CubeIoHandler * {
+      if (format == Cube::Bsq) {
+        return new CubeBsqHandler(&dataFile, NULL, label, true);
+      }
+      return new CubeTileHandler(&dataFile, NULL, label, true);
+    };
+
+    QScopedPointer<CubeIoHandler> mappedHandler(openHandler());
+    EXPECT_TRUE(mappedHandler->isMemoryMapped());
+
+    Brick mappedLine(300, 1, 1, SignedWord);
+    mappedLine.SetBasePosition(1, 7, 2);
+    mappedHandler->read(mappedLine);
+    for (int i = 0; i < mappedLine.size(); i++) {
+      if (i % 50 == 0) {
+        EXPECT_TRUE(IsNullPixel(mappedLine[i]));
+      }
+      else {
+        EXPECT_EQ(mappedLine[i], 7 + i * 10 + 2);
+      }
+    }
+    mappedHandler.reset();
+
+    mappingPref.setValue("Never");
+    QScopedPointer<CubeIoHandler> unmappedHandler(openHandler());
+    EXPECT_FALSE(unmappedHandler->isMemoryMapped());
+    unmappedHandler.reset();
+    dataFile.close();
+
+    mappingPref.setValue(originalMappingPref);
+  }
+}
+
+
+TEST_F(TempTestingFiles, TestCubeReadAhead) {
+  PvlKeyword &readAheadPref =
+      Preference::Preferences().findGroup("Performance")["CubeReadAhead"];
+  QString originalReadAheadPref = readAheadPref[0];
+
+  QList<Cube::Format> formats;
+  formats << Cube::Bsq << Cube::Tile;
+  foreach (Cube::Format format, formats) {
+    QString cubeFile = tempDir.path() + "/readahead" + QString::number(format) + ".cub";
+
+    Cube outCube;
+    outCube.setDimensions(300, 200, 2);
+    outCube.setFormat(format);
+    outCube.setPixelType(SignedWord);
+    outCube.create(cubeFile);
+
+    LineManager outLine(outCube);
+    for (outLine.begin(); !outLine.end(); outLine++) {
+      for (int i = 0; i < outLine.size(); i++) {
+        outLine[i] = (i % 50 == 0) ? Null : outLine.Line() + i * 10 + outLine.Band();
+      }
+      outCube.write(outLine);
+    }
+    outCube.close();
+
+    readAheadPref.setValue("8");
+
+    Cube inCube(cubeFile, "r");
+    LineManager inLine(inCube);
+
+    // Walk half of the cube, then start over so the read ahead has to follow
+    //   a jump back to the beginning.
+    for (inLine.begin(); inLine.currentMap() < 150; inLine++) {
+      inCube.prefetch(inLine);
+      inCube.read(inLine);
+    }
+
+    for (inLine.begin(); !inLine.end(); inLine++) {
+      inCube.prefetch(inLine);
+      inCube.read(inLine);
+      for (int i = 0; i < inLine.size(); i++) {
+        if (i % 50 == 0) {
+          EXPECT_TRUE(IsNullPixel(inLine[i]));
+        }
+        else {
+          EXPECT_EQ(inLine[i], inLine.Line() + i * 10 + inLine.Band());
+        }
+      }
+    }
+
+    // Chunks read ahead for positions the traversal jumped away from are no
+    //   longer protected from the caching algorithms
+    Pvl label(cubeFile);
+    QFile dataFile(cubeFile);
+    ASSERT_TRUE(dataFile.open(QIODevice::ReadOnly));
+    QScopedPointer<CubeIoHandler> handler;
+    if (format == Cube::Bsq) {
+      handler.reset(new CubeBsqHandler(&dataFile, NULL, label, true));
+    }
+    else {
+      handler.reset(new CubeTileHandler(&dataFile, NULL, label, true));
+    }
+
+    for (inLine.begin(); inLine.currentMap() < 20; inLine++) {
+      handler->prefetch(inLine);
+      handler->read(inLine);
+    }
+
+    // The last line has nothing after it to read ahead
+    inLine.SetLine(200, 2);
+    handler->prefetch(inLine);
+    EXPECT_EQ(handler->prefetchedChunkCount(), 0);
+    handler->read(inLine);
+    for (int i = 0; i < inLine.size(); i++) {
+      if (i % 50 == 0) {
+        EXPECT_TRUE(IsNullPixel(inLine[i]));
+      }
+      else {
+        EXPECT_EQ(inLine[i], 200 + i * 10 + 2);
+      }
+    }
+
+    handler.reset();
+    dataFile.close();
+    inCube.close();
+
+    readAheadPref.setValue(originalReadAheadPref);
+  }
+}
+
+
+// Writes every brick of the cube from threadCount threads at once. Thread t
+//   writes bricks t, t + threadCount and so on.
+static void writeBricksConcurrently(Cube &cube, int threadCount,
+                                    int brickSamples, int brickLines) {
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(threadCount);
+
+  QList< QFuture<void> > writers;
+  for (int thread = 0; thread < threadCount; thread++) {
+    writers.append(QtConcurrent::run(&threadPool, [&cube, thread, threadCount,
+                                                   brickSamples, brickLines]() {
+      Brick brick(cube, brickSamples, brickLines, 1);
+      for (int i = thread + 1; i <= brick.Bricks(); i += threadCount) {
+        brick.SetBrick(i);
+        for (int j = 0; j < brick.size(); j++) {
+          int sample = brick.Sample(j);
+          brick[j] = (sample % 37 == 0) ? Null :
+                     brick.Band(j) * 1000000 + brick.Line(j) * 1000 + sample;
+        }
+        cube.write(brick);
+      }
+    }));
+  }
+
+  foreach (QFuture<void> writer, writers) {
+    writer.waitForFinished();
+  }
+}
+
+
+TEST_F(TempTestingFiles, TestCubeConcurrentWrites) {
+  PvlKeyword &writeThreadPref =
+      Preference::Preferences().findGroup("Performance")["CubeWriteThread"];
+  QString originalWriteThreadPref = writeThreadPref[0];
+
+  QStringList writeThreadPrefs;
+  writeThreadPrefs << "Never" << "Always";
+  QList<Cube::Format> formats;
+  formats << Cube::Bsq << Cube::Tile;
+  foreach (QString pref, writeThreadPrefs) {
+    writeThreadPref.setValue(pref);
+
+    foreach (Cube::Format format, formats) {
+      QString cubeFile = tempDir.path() + "/concurrent" + pref + QString::number(format) + ".cub";
+
+      // Lines from different threads share the chunks of both formats
+      Cube outCube;
+      outCube.setDimensions(333, 250, 2);
+      outCube.setFormat(format);
+      outCube.create(cubeFile);
+      writeBricksConcurrently(outCube, 8, 333, 1);
+      outCube.close();
+
+      Cube inCube(cubeFile, "r");
+      LineManager inLine(inCube);
+      for (inLine.begin(); !inLine.end(); inLine++) {
+        inCube.read(inLine);
+        for (int i = 0; i < inLine.size(); i++) {
+          if ((i + 1) % 37 == 0) {
+            EXPECT_TRUE(IsNullPixel(inLine[i]));
+          }
+          else {
+            EXPECT_EQ(inLine[i], inLine.Band() * 1000000 + inLine.Line() * 1000 + i + 1)
+                << pref.toStdString() << " format " << format;
+          }
+        }
+      }
+      inCube.close();
+    }
+  }
+
+  writeThreadPref.setValue(originalWriteThreadPref);
+}
+
+
+// Times writing a tile cube a tile at a time from 1 to 32 threads. The buffers
+//   are converted into the cube's chunks on the writing threads, so this
+//   shows how well writers of different chunks run at the same time. Run with
+//   --gtest_also_run_disabled_tests.
+TEST_F(TempTestingFiles, DISABLED_CubeConcurrentWriteBenchmark) {
+  PvlKeyword &writeThreadPref =
+      Preference::Preferences().findGroup("Performance")["CubeWriteThread"];
+  QString originalWriteThreadPref = writeThreadPref[0];
+  writeThreadPref.setValue("Never");
+
+  for (int threadCount = 1; threadCount <= 32; threadCount *= 2) {
+    QString cubeFile = tempDir.path() + "/benchmark" + QString::number(threadCount) + ".cub";
+
+    Cube outCube;
+    outCube.setDimensions(8192, 8192, 1);
+    outCube.setFormat(Cube::Tile);
+    outCube.setPixelType(SignedWord);
+    outCube.create(cubeFile);
+
+    QElapsedTimer timer;
+    timer.start();
+    writeBricksConcurrently(outCube, threadCount, 128, 128);
+    outCube.close();
+
+    RecordProperty(QString("Threads%1Milliseconds").arg(threadCount).toStdString(),
+                   QString::number(timer.elapsed()).toStdString());
+    QFile::remove(cubeFile);
+  }
+
+  writeThreadPref.setValue(originalWriteThreadPref);
+}
+
+
+TEST_F(TempTestingFiles, TestCubeCompressedFormat) {
+  QString tileFile = tempDir.path() + "/uncompressed.cub";
+  QString compressedFile = tempDir.path() + "/compressed.cub";
+
+  QList<Cube::Format> formats;
+  formats << Cube::Tile << Cube::Compressed;
+  foreach (Cube::Format format, formats) {
+    Cube outCube;
+    outCube.setDimensions(300, 200, 2);
+    outCube.setFormat(format);
+    outCube.setPixelType(SignedWord);
+    outCube.create(format == Cube::Tile ? tileFile : compressedFile);
+
+    // Only the first band has data, the rest of the cube is left Null
+    LineManager outLine(outCube);
+    for (outLine.begin(); outLine.Band() == 1; outLine++) {
+      for (int i = 0; i < outLine.size(); i++) {
+        outLine[i] = (i % 50 == 0) ? Null : outLine.Line() + i;
+      }
+      outCube.write(outLine);
+    }
+    outCube.close();
+  }
+
+  EXPECT_LT(QFileInfo(compressedFile).size(), QFileInfo(tileFile).size() / 2);
+
+  // Rewrite part of the second band so its tiles have to move
+  Cube updateCube(compressedFile, "rw");
+  EXPECT_EQ(updateCube.format(), Cube::Compressed);
+  LineManager updateLine(updateCube);
+  updateLine.SetLine(10, 2);
+  for (int i = 0; i < updateLine.size(); i++) {
+    updateLine[i] = i * 3;
+  }
+  updateCube.write(updateLine);
+  updateCube.close();
+
+  Cube inCube(compressedFile, "r");
+  Pvl *label = inCube.label();
+  PvlObject &core = label->findObject("IsisCube").findObject("Core");
+  EXPECT_EQ(core["Format"][0].toStdString(), "Compressed");
+
+  LineManager inLine(inCube);
+  for (inLine.begin(); !inLine.end(); inLine++) {
+    inCube.read(inLine);
+    for (int i = 0; i < inLine.size(); i++) {
+      if (inLine.Band() == 1) {
+        if (i % 50 == 0) {
+          EXPECT_TRUE(IsNullPixel(inLine[i]));
+        }
+        else {
+          EXPECT_EQ(inLine[i], inLine.Line() + i);
+        }
+      }
+      else if (inLine.Line() == 10) {
+        EXPECT_EQ(inLine[i], i * 3);
+      }
+      else {
+        EXPECT_TRUE(IsNullPixel(inLine[i]));
+      }
+    }
+  }
+  inCube.close();
+}
+
+
+// Rewrites every tile of a compressed cube, alternating between data that
+//   compresses well and data that doesn't. Tiles that grew once have to keep
+//   their space after shrinking, so the file stops growing.
+TEST_F(TempTestingFiles, TestCubeCompressedTileReuse) {
+  QString cubeFile = tempDir.path() + "/reuse.cub";
+
+  auto writeTiles = [](Cube &cube, bool noisy) {
+    unsigned int state = 12345;
+    LineManager line(cube);
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        state = state * 1103515245 + 12345;
+        line[i] = noisy ? (int)((state >> 16) % 30000) : 7;
+      }
+      cube.write(line);
+    }
+  };
+
+  Cube outCube;
+  outCube.setDimensions(2048, 128, 1);
+  outCube.setFormat(Cube::Compressed);
+  outCube.setPixelType(SignedWord);
+  outCube.create(cubeFile);
+  writeTiles(outCube, false);
+  outCube.close();
+
+  QList<qint64> noisySizes;
+  for (int cycle = 0; cycle < 3; cycle++) {
+    Cube noisyCube(cubeFile, "rw");
+    writeTiles(noisyCube, true);
+    noisyCube.close();
+    noisySizes.append(QFileInfo(cubeFile).size());
+
+    Cube quietCube(cubeFile, "rw");
+    writeTiles(quietCube, false);
+    quietCube.close();
+    EXPECT_EQ(QFileInfo(cubeFile).size(), noisySizes.last());
+  }
+
+  EXPECT_EQ(noisySizes[1], noisySizes[0]);
+  EXPECT_EQ(noisySizes[2], noisySizes[0]);
+
+  Cube inCube(cubeFile, "r");
+  LineManager inLine(inCube);
+  for (inLine.begin(); !inLine.end(); inLine++) {
+    inCube.read(inLine);
+    for (int i = 0; i < inLine.size(); i++) {
+      ASSERT_EQ(inLine[i], 7);
+    }
+  }
+  inCube.close();
+}
+
+
+TEST_F(TempTestingFiles, TestCubeOverviews) {
+  QString cubeFile = tempDir.path() + "/overviews.cub";
+
+  Cube outCube;
+  outCube.setDimensions(5, 3, 2);
+  outCube.create(cubeFile);
+
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    for (int i = 0; i < outLine.size(); i++) {
+      outLine[i] = (i + 1) + 10 * outLine.Line() + 100 * outLine.Band();
+    }
+    if (outLine.Band() == 1 && outLine.Line() == 1) {
+      outLine[0] = Null;
+    }
+    if (outLine.Band() == 2 && outLine.Line() < 3) {
+      outLine[2] = Null;
+      outLine[3] = Lrs;
+    }
+    outCube.write(outLine);
+  }
+
+  outCube.createOverviews(2);
+  outCube.close();
+
+  Cube inCube(cubeFile, "r");
+  ASSERT_EQ(inCube.overviewCount(), 2);
+  EXPECT_EQ(inCube.overviewSampleCount(1), 3);
+  EXPECT_EQ(inCube.overviewLineCount(1), 2);
+  EXPECT_EQ(inCube.overviewSampleCount(2), 2);
+  EXPECT_EQ(inCube.overviewLineCount(2), 1);
+
+  // One sample wider than the overview so the last sample is outside of it
+  Brick levelOne(4, 2, 2, inCube.pixelType());
+  levelOne.SetBasePosition(1, 1, 1);
+  inCube.readOverview(levelOne, 1);
+
+  double firstBlock = (112.0 + 121.0 + 122.0) / 3.0;
+  double secondBlock = (113.0 + 114.0 + 123.0 + 124.0) / 4.0;
+  EXPECT_NEAR(levelOne[0], firstBlock, 1e-4);
+  EXPECT_NEAR(levelOne[1], secondBlock, 1e-4);
+  EXPECT_NEAR(levelOne[2], (115.0 + 125.0) / 2.0, 1e-4);
+  EXPECT_TRUE(IsNullPixel(levelOne[3]));
+  EXPECT_NEAR(levelOne[4], (131.0 + 132.0) / 2.0, 1e-4);
+  EXPECT_NEAR(levelOne[6], 135.0, 1e-4);
+
+  // The second band's block of only special pixels keeps its first pixel
+  EXPECT_NEAR(levelOne[8], (211.0 + 212.0 + 221.0 + 222.0) / 4.0, 1e-4);
+  EXPECT_TRUE(IsNullPixel(levelOne[9]));
+
+  Brick levelTwo(2, 1, 1, inCube.pixelType());
+  levelTwo.SetBasePosition(1, 1, 1);
+  inCube.readOverview(levelTwo, 2);
+
+  EXPECT_NEAR(levelTwo[0], (firstBlock + secondBlock + 131.5 + 133.5) / 4.0, 1e-4);
+  EXPECT_NEAR(levelTwo[1], ((115.0 + 125.0) / 2.0 + 135.0) / 2.0, 1e-4);
+
+  EXPECT_THROW(inCube.readOverview(levelTwo, 3), IException);
+  inCube.close();
+}
+
+
+// Overviews can be read from the cube that created them, and are removed
+//   once its DN data changes, including after reopening it read-write.
+TEST_F(TempTestingFiles, TestCubeOverviewsRemovedOnWrite) {
+  QString cubeFile = tempDir.path() + "/staleOverviews.cub";
+
+  Cube outCube;
+  outCube.setDimensions(8, 6, 1);
+  outCube.create(cubeFile);
+
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    for (int i = 0; i < outLine.size(); i++) {
+      outLine[i] = i + 10 * outLine.Line();
+    }
+    outCube.write(outLine);
+  }
+
+  outCube.createOverviews(1);
+  ASSERT_EQ(outCube.overviewCount(), 1);
+
+  Brick levelOne(outCube.overviewSampleCount(1), outCube.overviewLineCount(1), 1,
+                 outCube.pixelType());
+  levelOne.SetBasePosition(1, 1, 1);
+  outCube.readOverview(levelOne, 1);
+  for (int line = 0; line < 3; line++) {
+    for (int sample = 0; sample < 4; sample++) {
+      double expected = 2 * sample + 0.5 + 10 * (2 * line + 1.5);
+      EXPECT_NEAR(levelOne[line * 4 + sample], expected, 1e-4)
+          << "sample " << sample + 1 << " line " << line + 1;
+    }
+  }
+  outCube.close();
+
+  // Reading and writing labels leaves them alone
+  Cube readCube(cubeFile, "rw");
+  EXPECT_EQ(readCube.overviewCount(), 1);
+  readCube.close();
+
+  Cube updateCube(cubeFile, "rw");
+  LineManager updateLine(updateCube);
+  updateLine.SetLine(2);
+  for (int i = 0; i < updateLine.size(); i++) {
+    updateLine[i] = 0;
+  }
+  updateCube.write(updateLine);
+  EXPECT_EQ(updateCube.overviewCount(), 0);
+  EXPECT_THROW(updateCube.readOverview(levelOne, 1), IException);
+  updateCube.close();
+
+  Cube inCube(cubeFile, "r");
+  EXPECT_EQ(inCube.overviewCount(), 0);
+  inCube.close();
+}
+
+
+TEST_F(TempTestingFiles, TestCubeOverviewTiles) {
+  QString defaultFile = tempDir.path() + "/defaultTiles.cub";
+  QString smallFile = tempDir.path() + "/smallTiles.cub";
+
+  // The same pixels with the default layout and with 4x4 tiles, 3 to a part,
+  // so the levels span many tiles and Overview blobs
+  for (int i = 0; i < 2; i++) {
+    Cube outCube;
+    outCube.setDimensions(37, 29, 2);
+    outCube.create(i == 0 ? defaultFile : smallFile);
+
+    LineManager outLine(outCube);
+    for (outLine.begin(); !outLine.end(); outLine++) {
+      for (int s = 0; s < outLine.size(); s++) {
+        outLine[s] = (s % 11 == 0) ? Null :
+                     s + 100 * outLine.Line() + 10000 * outLine.Band();
+      }
+      outCube.write(outLine);
+    }
+
+    if (i == 0) {
+      outCube.createOverviews(3);
+    }
+    else {
+      CubeOverview::create(outCube, 3, 4, 3);
+    }
+    outCube.close();
+  }
+
+  Cube defaultCube(defaultFile, "r");
+  Cube smallCube(smallFile, "r");
+  ASSERT_EQ(smallCube.overviewCount(), 3);
+
+  int parts = 0;
+  for (int i = 0; i < smallCube.label()->objects(); i++) {
+    if (smallCube.label()->object(i).isNamed("Overview")) {
+      parts++;
+    }
+  }
+  // Level 1 has 5x4 tiles, level 2 3x2 and level 3 2x1, in each of two bands
+  EXPECT_EQ(parts, 14 + 4 + 2);
+
+  for (int level = 1; level <= 3; level++) {
+    Brick expected(smallCube.overviewSampleCount(level) + 1,
+                   smallCube.overviewLineCount(level), 2, smallCube.pixelType());
+    Brick actual(expected);
+    expected.SetBasePosition(1, 1, 1);
+    actual.SetBasePosition(1, 1, 1);
+    defaultCube.readOverview(expected, level);
+    smallCube.readOverview(actual, level);
+
+    for (int i = 0; i < expected.size(); i++) {
+      if (IsSpecial(expected[i])) {
+        EXPECT_EQ(actual[i], expected[i]) << "level " << level << " index " << i;
+      }
+      else {
+        EXPECT_NEAR(actual[i], expected[i], 1e-3) << "level " << level << " index " << i;
+      }
+    }
+  }
+
+  EXPECT_THROW(CubeOverview::create(defaultCube, 1, 0), IException);
+}
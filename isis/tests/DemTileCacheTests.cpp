@@ -0,0 +1,71 @@
+#include <QString>
+
+#include "Cube.h"
+#include "DemTileCache.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "SpecialPixel.h"
+
+#include "Fixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+TEST_F(TempTestingFiles, DemTileCacheMatchesPortalInterpolation) {
+  QString cubeFile = tempDir.path() + "/dem.cub";
+
+  // Larger than one tile in both directions
+  Cube outCube;
+  outCube.setDimensions(300, 200, 1);
+  outCube.create(cubeFile);
+
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    for (int i = 0; i < outLine.size(); i++) {
+      outLine[i] = (i + 1) * 0.5 + outLine.Line() * 2.0;
+    }
+    if (outLine.Line() == 50) {
+      outLine[99] = Null;
+    }
+    outCube.write(outLine);
+  }
+  outCube.close();
+
+  Cube demCube(cubeFile, "r");
+
+  QSharedPointer<DemTileCache> demCache = DemTileCache::cache(&demCube);
+  EXPECT_EQ(demCache, DemTileCache::cache(&demCube));
+
+  Interpolator interp(Interpolator::BiLinearType);
+  Portal portal(interp.Samples(), interp.Lines(), demCube.pixelType(),
+                interp.HotSample(), interp.HotLine());
+
+  // Inside a tile, across tile edges, next to a Null and past the edges of the DEM
+  double positions[][2] = { {10.25, 20.75}, {128.5, 64.0}, {127.9, 128.3}, {129.0, 129.0},
+                            {100.4, 50.6}, {99.6, 49.2}, {0.5, 10.0}, {300.5, 200.5},
+                            {250.0, 199.9}, {-3.0, 5.0} };
+
+  for (unsigned int i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+    double sample = positions[i][0];
+    double line = positions[i][1];
+
+    portal.SetPosition(sample, line, 1);
+    demCube.read(portal);
+    double expected = interp.Interpolate(sample, line, portal.DoubleBuffer());
+
+    double actual = demCache->interpolate(sample, line);
+    if (IsSpecial(expected)) {
+      EXPECT_EQ(actual, expected) << "at " << sample << ", " << line;
+    }
+    else {
+      EXPECT_DOUBLE_EQ(actual, expected) << "at " << sample << ", " << line;
+    }
+  }
+
+  EXPECT_EQ(demCache->value(100, 50), Null);
+  EXPECT_DOUBLE_EQ(demCache->value(300, 200), 550.0);
+  EXPECT_EQ(demCache->value(301, 1), Null);
+  EXPECT_GT(demCache->tileCount(), 1);
+}
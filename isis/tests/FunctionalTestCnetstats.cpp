@@ -1,5 +1,6 @@
 #include "cnetstats.h"
 
+#include <QFile>
 #include <QTemporaryFile>
 #include <QTextStream>
 #include <QStringList>
@@ -234,3 +235,58 @@ TEST_F(ThreeImageNetwork, FunctionalTestCnetstatsInvalidDefFile) {
     FAIL() << "Expected error message: \"" << message.toStdString() << "\"";
   }
 }
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetstatsStreamed) {
+  QString netFile = tempDir.path() + "/streamed.net";
+  network->Write(netFile);
+
+  QString loadedPoints = tempDir.path() + "/loadedPoints.csv";
+  QVector<QString> loadedArgs = {"create_point_stats=yes", "point_stats_file=" + loadedPoints};
+  UserInterface loadedOptions(APP_XML, loadedArgs);
+  Pvl loadedLog;
+  QString serialNumList = tempDir.path() + "/cubes.lis";
+  cnetstats(*network, serialNumList, loadedOptions, &loadedLog);
+
+  // Without an image list the network is streamed from its file
+  QString streamedPoints = tempDir.path() + "/streamedPoints.csv";
+  QVector<QString> streamedArgs = {"cnet=" + netFile,
+                                   "create_point_stats=yes",
+                                   "point_stats_file=" + streamedPoints};
+  UserInterface streamedOptions(APP_XML, streamedArgs);
+  Pvl streamedLog;
+  cnetstats(streamedOptions, &streamedLog);
+
+  PvlGroup loadedSummary = loadedLog.findGroup("ControlNetSummary");
+  PvlGroup streamedSummary = streamedLog.findGroup("ControlNetSummary");
+  EXPECT_FALSE(streamedSummary.hasKeyword("TotalImages"));
+  EXPECT_FALSE(streamedSummary.hasKeyword("MinConvexHullRatio"));
+  for (int i = 0; i < streamedSummary.keywords(); i++) {
+    QString name = streamedSummary[i].name();
+    EXPECT_PRED_FORMAT2(AssertQStringsEqual, streamedSummary[name][0], loadedSummary[name][0]);
+  }
+
+  QFile loadedFile(loadedPoints);
+  QFile streamedFile(streamedPoints);
+  ASSERT_TRUE(loadedFile.open(QIODevice::ReadOnly));
+  ASSERT_TRUE(streamedFile.open(QIODevice::ReadOnly));
+  EXPECT_EQ(streamedFile.readAll(), loadedFile.readAll());
+}
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetstatsStreamedImageStats) {
+  QString netFile = tempDir.path() + "/streamed.net";
+  network->Write(netFile);
+
+  QVector<QString> args = {"cnet=" + netFile,
+                           "create_image_stats=yes",
+                           "image_stats_file=" + tempDir.path() + "/images.csv"};
+  UserInterface options(APP_XML, args);
+  Pvl log;
+
+  try {
+    cnetstats(options, &log);
+    FAIL() << "Expected an exception to be thrown";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("An image list [FROMLIST] must be entered"));
+  }
+}
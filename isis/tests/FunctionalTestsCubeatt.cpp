@@ -0,0 +1,91 @@
+#include <QString>
+#include <QVector>
+
+#include "cubeatt.h"
+
+#include "Brick.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/cubeatt.xml").expanded();
+
+TEST_F(TempTestingFiles, FunctionalTestCubeattOverviews) {
+  Cube inCube;
+  inCube.setDimensions(600, 500, 1);
+  inCube.create(tempDir.path() + "/input.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = line.Line() * 1000 + i + 1;
+    }
+    inCube.write(line);
+  }
+  inCube.close();
+
+  QVector<QString> args = {"from=" + tempDir.path() + "/input.cub",
+                           "to=" + tempDir.path() + "/output.cub+Tile",
+                           "overviews=yes"};
+  UserInterface options(APP_XML, args);
+  cubeatt(options);
+
+  Cube outCube(tempDir.path() + "/output.cub");
+  ASSERT_EQ(outCube.sampleCount(), 600);
+  ASSERT_EQ(outCube.lineCount(), 500);
+
+  // Levels are added until the coarsest fits in 256x256
+  ASSERT_EQ(outCube.overviewCount(), 2);
+  EXPECT_EQ(outCube.overviewSampleCount(2), 150);
+  EXPECT_EQ(outCube.overviewLineCount(2), 125);
+
+  Brick overview(outCube.overviewSampleCount(1), 1, 1, Real);
+  overview.SetBasePosition(1, 1, 1);
+  outCube.readOverview(overview, 1);
+  EXPECT_DOUBLE_EQ(overview[0], (1001 + 1002 + 2001 + 2002) / 4.0);
+  EXPECT_DOUBLE_EQ(overview[299], (1599 + 1600 + 2599 + 2600) / 4.0);
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestCubeattNoOverviews) {
+  Cube inCube;
+  inCube.setDimensions(20, 20, 2);
+  inCube.create(tempDir.path() + "/input.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (i == line.Line()) ? Null : line.Band() * 100 + line.Line() + i;
+    }
+    inCube.write(line);
+  }
+  inCube.close();
+
+  QVector<QString> args = {"from=" + tempDir.path() + "/input.cub+2",
+                           "to=" + tempDir.path() + "/output.cub+Bsq"};
+  UserInterface options(APP_XML, args);
+  cubeatt(options);
+
+  Cube outCube(tempDir.path() + "/output.cub");
+  EXPECT_EQ(outCube.overviewCount(), 0);
+  EXPECT_EQ(outCube.format(), Cube::Bsq);
+  ASSERT_EQ(outCube.bandCount(), 1);
+
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      if (i == outLine.Line()) {
+        EXPECT_TRUE(IsNullPixel(outLine[i]));
+      }
+      else {
+        EXPECT_EQ(outLine[i], 200 + outLine.Line() + i);
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include "mask.h"
+
+#include "Cube.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/mask.xml").expanded();
+
+// Expects the two cubes to have the same size and DNs
+static void expectSameCubes(const QString &threadedFile, const QString &serialFile) {
+  Cube threaded(threadedFile);
+  Cube serial(serialFile);
+  ASSERT_EQ(threaded.sampleCount(), serial.sampleCount());
+  ASSERT_EQ(threaded.lineCount(), serial.lineCount());
+  ASSERT_EQ(threaded.bandCount(), serial.bandCount());
+
+  LineManager threadedLine(threaded);
+  LineManager serialLine(serial);
+  for (threadedLine.begin(), serialLine.begin(); !threadedLine.end();
+       threadedLine++, serialLine++) {
+    threaded.read(threadedLine);
+    serial.read(serialLine);
+    for (int i = 0; i < threadedLine.size(); i++) {
+      ASSERT_EQ(threadedLine[i], serialLine[i])
+          << "sample " << i + 1 << " line " << threadedLine.Line()
+          << " band " << threadedLine.Band();
+    }
+  }
+}
+
+// Enough lines that the threaded StartProcess() handles several blocks, and
+// the count of masked pixels is added up from several threads
+TEST_F(TempTestingFiles, FunctionalTestMaskThreaded) {
+  Cube inCube;
+  inCube.setDimensions(25, 311, 1);
+  inCube.create(tempDir.path() + "/in.cub");
+  Cube maskCube;
+  maskCube.setDimensions(25, 311, 1);
+  maskCube.create(tempDir.path() + "/mask.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = line.Line() * 100 + i;
+    }
+    inCube.write(line);
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (i == 7) ? Null : i;
+    }
+    maskCube.write(line);
+  }
+  inCube.close();
+  maskCube.close();
+
+  QVector<QString> args = {"from=" + tempDir.path() + "/in.cub",
+                           "mask=" + tempDir.path() + "/mask.cub",
+                           "to=" + tempDir.path() + "/out.cub",
+                           "minimum=5",
+                           "maximum=19"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  mask(options, &appLog);
+
+  // Per line: samples 0-4 and 20-24 are outside the range and sample 7 is Null
+  PvlGroup results = appLog.findGroup("Results");
+  EXPECT_DOUBLE_EQ((double) results["PixelsMasked"], 311 * 11);
+
+  Cube outCube(tempDir.path() + "/out.cub");
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      if (i < 5 || i > 19 || i == 7) {
+        EXPECT_TRUE(IsNullPixel(outLine[i]));
+      }
+      else {
+        EXPECT_DOUBLE_EQ(outLine[i], outLine.Line() * 100 + i);
+      }
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestMaskThreadedMatchesOneThread) {
+  Cube inCube;
+  inCube.setDimensions(19, 487, 2);
+  inCube.create(tempDir.path() + "/in.cub");
+  Cube maskCube;
+  maskCube.setDimensions(19, 487, 1);
+  maskCube.create(tempDir.path() + "/mask.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = line.Line() * 10 + i * line.Band();
+    }
+    inCube.write(line);
+  }
+  LineManager maskLine(maskCube);
+  for (maskLine.begin(); !maskLine.end(); maskLine++) {
+    for (int i = 0; i < maskLine.size(); i++) {
+      maskLine[i] = ((maskLine.Line() + i) % 11 == 0) ? Null : (maskLine.Line() * 5 + i) % 40;
+    }
+    maskCube.write(maskLine);
+  }
+  inCube.close();
+  maskCube.close();
+
+  int threads = QThreadPool::globalInstance()->maxThreadCount();
+  QStringList outputs = {"serial.cub", "threaded.cub"};
+  double masked[2];
+  for (int run = 0; run < outputs.size(); run++) {
+    QThreadPool::globalInstance()->setMaxThreadCount(run == 0 ? 1 : 8);
+    QVector<QString> args = {"from=" + tempDir.path() + "/in.cub",
+                             "mask=" + tempDir.path() + "/mask.cub",
+                             "to=" + tempDir.path() + "/" + outputs[run],
+                             "minimum=8",
+                             "maximum=31"};
+    UserInterface options(APP_XML, args);
+    Pvl appLog;
+    mask(options, &appLog);
+    masked[run] = appLog.findGroup("Results")["PixelsMasked"];
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  EXPECT_EQ(masked[1], masked[0]);
+  expectSameCubes(tempDir.path() + "/threaded.cub", tempDir.path() + "/serial.cub");
+}
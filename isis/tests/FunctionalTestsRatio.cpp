@@ -0,0 +1,126 @@
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include "ratio.h"
+
+#include "Cube.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/ratio.xml").expanded();
+
+// Expects the two cubes to have the same size and DNs
+static void expectSameCubes(const QString &threadedFile, const QString &serialFile) {
+  Cube threaded(threadedFile);
+  Cube serial(serialFile);
+  ASSERT_EQ(threaded.sampleCount(), serial.sampleCount());
+  ASSERT_EQ(threaded.lineCount(), serial.lineCount());
+  ASSERT_EQ(threaded.bandCount(), serial.bandCount());
+
+  LineManager threadedLine(threaded);
+  LineManager serialLine(serial);
+  for (threadedLine.begin(), serialLine.begin(); !threadedLine.end();
+       threadedLine++, serialLine++) {
+    threaded.read(threadedLine);
+    serial.read(serialLine);
+    for (int i = 0; i < threadedLine.size(); i++) {
+      ASSERT_EQ(threadedLine[i], serialLine[i])
+          << "sample " << i + 1 << " line " << threadedLine.Line()
+          << " band " << threadedLine.Band();
+    }
+  }
+}
+
+// Enough lines that the threaded StartProcess() handles several blocks
+TEST_F(TempTestingFiles, FunctionalTestRatioThreaded) {
+  Cube numerator;
+  numerator.setDimensions(40, 203, 2);
+  numerator.create(tempDir.path() + "/numerator.cub");
+  Cube denominator;
+  denominator.setDimensions(40, 203, 2);
+  denominator.create(tempDir.path() + "/denominator.cub");
+
+  LineManager line(numerator);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (i == 3) ? Null : line.Band() * 1000 + line.Line() + i;
+    }
+    numerator.write(line);
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (i == 5) ? Hrs : i % 10;
+    }
+    denominator.write(line);
+  }
+  numerator.close();
+  denominator.close();
+
+  QVector<QString> args = {"numerator=" + tempDir.path() + "/numerator.cub",
+                           "denominator=" + tempDir.path() + "/denominator.cub",
+                           "to=" + tempDir.path() + "/ratio.cub"};
+  UserInterface options(APP_XML, args);
+  ratio(options);
+
+  Cube outCube(tempDir.path() + "/ratio.cub");
+  ASSERT_EQ(outCube.sampleCount(), 40);
+  ASSERT_EQ(outCube.lineCount(), 203);
+  ASSERT_EQ(outCube.bandCount(), 2);
+
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      if (i == 3 || i == 5 || i % 10 == 0) {
+        EXPECT_TRUE(IsNullPixel(outLine[i]));
+      }
+      else {
+        EXPECT_DOUBLE_EQ(outLine[i],
+                         (outLine.Band() * 1000 + outLine.Line() + i) / (double) (i % 10));
+      }
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestRatioThreadedMatchesOneThread) {
+  Cube numerator;
+  numerator.setDimensions(17, 509, 3);
+  numerator.create(tempDir.path() + "/numerator.cub");
+  Cube denominator;
+  denominator.setDimensions(17, 509, 3);
+  denominator.create(tempDir.path() + "/denominator.cub");
+
+  LineManager line(numerator);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = line.Band() * 0.37 + line.Line() * 1.3 - i;
+    }
+    numerator.write(line);
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (line.Line() + i) % 7 - 3.0;
+    }
+    denominator.write(line);
+  }
+  numerator.close();
+  denominator.close();
+
+  int threads = QThreadPool::globalInstance()->maxThreadCount();
+  QStringList outputs = {"serial.cub", "threaded.cub"};
+  for (int run = 0; run < outputs.size(); run++) {
+    QThreadPool::globalInstance()->setMaxThreadCount(run == 0 ? 1 : 8);
+    QVector<QString> args = {"numerator=" + tempDir.path() + "/numerator.cub",
+                             "denominator=" + tempDir.path() + "/denominator.cub",
+                             "to=" + tempDir.path() + "/" + outputs[run]};
+    UserInterface options(APP_XML, args);
+    ratio(options);
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  expectSameCubes(tempDir.path() + "/threaded.cub", tempDir.path() + "/serial.cub");
+}
@@ -0,0 +1,115 @@
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include "stretch_app.h"
+
+#include "Cube.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/stretch.xml").expanded();
+
+// Expects the two cubes to have the same size and DNs
+static void expectSameCubes(const QString &threadedFile, const QString &serialFile) {
+  Cube threaded(threadedFile);
+  Cube serial(serialFile);
+  ASSERT_EQ(threaded.sampleCount(), serial.sampleCount());
+  ASSERT_EQ(threaded.lineCount(), serial.lineCount());
+  ASSERT_EQ(threaded.bandCount(), serial.bandCount());
+
+  LineManager threadedLine(threaded);
+  LineManager serialLine(serial);
+  for (threadedLine.begin(), serialLine.begin(); !threadedLine.end();
+       threadedLine++, serialLine++) {
+    threaded.read(threadedLine);
+    serial.read(serialLine);
+    for (int i = 0; i < threadedLine.size(); i++) {
+      ASSERT_EQ(threadedLine[i], serialLine[i])
+          << "sample " << i + 1 << " line " << threadedLine.Line()
+          << " band " << threadedLine.Band();
+    }
+  }
+}
+
+// Enough lines that the threaded StartProcess() handles several blocks
+TEST_F(TempTestingFiles, FunctionalTestStretchThreaded) {
+  Cube inCube;
+  inCube.setDimensions(30, 257, 1);
+  inCube.create(tempDir.path() + "/in.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = (i == 0) ? Null : (line.Line() + i) % 100;
+    }
+    inCube.write(line);
+  }
+  inCube.close();
+
+  QVector<QString> args = {"from=" + tempDir.path() + "/in.cub",
+                           "to=" + tempDir.path() + "/out.cub",
+                           "pairs=0:0 50:100 100:150",
+                           "null=0"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  stretch(options, &appLog);
+
+  PvlGroup results = appLog.findGroup("Results");
+  EXPECT_TRUE(results.hasKeyword("StretchPairs"));
+
+  Cube outCube(tempDir.path() + "/out.cub");
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      if (i == 0) {
+        EXPECT_EQ(outLine[i], 0.0);
+        continue;
+      }
+      double dn = (outLine.Line() + i) % 100;
+      double expected = (dn <= 50) ? dn * 2.0 : 100.0 + (dn - 50.0);
+      EXPECT_DOUBLE_EQ(outLine[i], expected);
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestStretchThreadedMatchesOneThread) {
+  Cube inCube;
+  inCube.setDimensions(23, 541, 2);
+  inCube.create(tempDir.path() + "/in.cub");
+
+  LineManager line(inCube);
+  for (line.begin(); !line.end(); line++) {
+    for (int i = 0; i < line.size(); i++) {
+      line[i] = ((line.Line() * 7 + i) % 13 == 0) ? Lrs : (line.Line() * 3 + i + line.Band()) % 211;
+    }
+    inCube.write(line);
+  }
+  inCube.close();
+
+  int threads = QThreadPool::globalInstance()->maxThreadCount();
+  QStringList outputs = {"serial.cub", "threaded.cub"};
+  for (int run = 0; run < outputs.size(); run++) {
+    QThreadPool::globalInstance()->setMaxThreadCount(run == 0 ? 1 : 8);
+    QVector<QString> args = {"from=" + tempDir.path() + "/in.cub",
+                             "to=" + tempDir.path() + "/" + outputs[run],
+                             "pairs=0:10 60:20 150:255 210:0",
+                             "lrs=5"};
+    UserInterface options(APP_XML, args);
+    Pvl appLog;
+    stretch(options, &appLog);
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  expectSameCubes(tempDir.path() + "/threaded.cub", tempDir.path() + "/serial.cub");
+}
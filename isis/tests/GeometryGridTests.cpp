@@ -0,0 +1,200 @@
+#include <cmath>
+
+#include <QString>
+
+#include "GeometryGrid.h"
+#include "IException.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Transform.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Output to input: smooth everywhere except for a gap left of sample 40
+class GeometryGridTestTransform : public Transform {
+  public:
+    int calls = 0;
+
+    bool Xform(double &inSample, double &inLine,
+               const double outSample, const double outLine) {
+      calls++;
+      if (outSample > 35.0 && outSample < 40.0) {
+        return false;
+      }
+      inSample = 0.9 * outSample + 0.001 * outSample * outLine + 2.0;
+      inLine = 1.1 * outLine + 0.2 * sin(outSample / 20.0);
+      return true;
+    }
+};
+
+
+TEST(GeometryGrid, InterpolatesWithinTolerance) {
+  GeometryGridTestTransform exact;
+  GeometryGrid grid(exact, 100, 90, 8, 0.05);
+
+  EXPECT_EQ(grid.spacing(), 8);
+  EXPECT_DOUBLE_EQ(grid.tolerance(), 0.05);
+  EXPECT_GT(grid.exactCells(), 0);
+
+  GeometryGridTestTransform check;
+  for (int line = 1; line <= 90; line += 3) {
+    for (int samp = 1; samp <= 100; samp += 3) {
+      double gridSample, gridLine, exactSample, exactLine;
+      bool gridValid = grid.Xform(gridSample, gridLine, samp, line, exact);
+      bool exactValid = check.Xform(exactSample, exactLine, samp, line);
+
+      EXPECT_EQ(gridValid, exactValid) << "at sample " << samp << ", line " << line;
+      if (gridValid && exactValid) {
+        EXPECT_NEAR(gridSample, exactSample, 0.05) << "at sample " << samp << ", line " << line;
+        EXPECT_NEAR(gridLine, exactLine, 0.05) << "at sample " << samp << ", line " << line;
+      }
+    }
+  }
+}
+
+
+TEST(GeometryGrid, TransformSkipsExactCalls) {
+  GeometryGridTestTransform *exact = new GeometryGridTestTransform();
+  QSharedPointer<GeometryGrid> grid(new GeometryGrid(*exact, 100, 90, 8, 0.05));
+  int buildCalls = exact->calls;
+
+  GeometryGridTransform trans(grid, exact);
+  double inSample, inLine;
+  for (int line = 1; line <= 90; line++) {
+    for (int samp = 1; samp <= 100; samp++) {
+      trans.Xform(inSample, inLine, samp, line);
+    }
+  }
+
+  EXPECT_LT(exact->calls - buildCalls, 100 * 90 / 2);
+}
+
+
+TEST_F(TempTestingFiles, GeometryGridFileRoundTrip) {
+  GeometryGridTestTransform exact;
+  GeometryGrid grid(exact, 100, 90, 8, 0.05);
+  grid.write(tempDir.path() + "/grid.tbl");
+
+  GeometryGrid readGrid(tempDir.path() + "/grid.tbl");
+  EXPECT_TRUE(readGrid.matches(100, 90, 8, 0.05));
+  EXPECT_FALSE(readGrid.matches(100, 90, 16, 0.05));
+  EXPECT_EQ(readGrid.exactCells(), grid.exactCells());
+
+  for (int line = 1; line <= 90; line += 7) {
+    for (int samp = 1; samp <= 100; samp += 7) {
+      double sample1, line1, sample2, line2;
+      bool valid1 = grid.Xform(sample1, line1, samp, line, exact);
+      bool valid2 = readGrid.Xform(sample2, line2, samp, line, exact);
+      EXPECT_EQ(valid1, valid2);
+      if (valid1 && valid2) {
+        EXPECT_DOUBLE_EQ(sample1, sample2);
+        EXPECT_DOUBLE_EQ(line1, line2);
+      }
+    }
+  }
+}
+
+
+TEST(GeometryGrid, FailuresInsideCellsUseExact) {
+  // Only fails on output sample 3, which is between the nodes and the middle
+  // of their cell
+  class NarrowGapTransform : public Transform {
+    public:
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine) {
+        if (outSample > 2.5 && outSample < 3.5) {
+          return false;
+        }
+        inSample = outSample + 1.0;
+        inLine = outLine + 1.0;
+        return true;
+      }
+  };
+
+  NarrowGapTransform exact;
+  GeometryGrid grid(exact, 40, 40, 8, 0.05);
+  EXPECT_EQ(grid.exactCells(), 5);
+
+  double inSample, inLine;
+  for (int line = 1; line <= 40; line++) {
+    EXPECT_FALSE(grid.Xform(inSample, inLine, 3.0, line, exact)) << "at line " << line;
+    EXPECT_TRUE(grid.Xform(inSample, inLine, 12.0, line, exact)) << "at line " << line;
+  }
+}
+
+
+TEST_F(TempTestingFiles, GeometryGridFileSource) {
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "Sinusoidal");
+  mapping += PvlKeyword("PixelResolution", "100.0", "meters/pixel");
+
+  PvlObject source("Source");
+  source += PvlKeyword("InputFile", "input.cub");
+  source += PvlKeyword("SpiceFingerprint", "0123456789abcdef");
+  source.addGroup(mapping);
+
+  GeometryGridTestTransform exact;
+  GeometryGrid grid(exact, 100, 90, 8, 0.05);
+  grid.setSource(source);
+  grid.write(tempDir.path() + "/sourceGrid.tbl");
+
+  GeometryGrid readGrid(tempDir.path() + "/sourceGrid.tbl");
+  EXPECT_TRUE(readGrid.matches(100, 90, 8, 0.05, source));
+  EXPECT_FALSE(readGrid.matches(100, 90, 8, 0.05));
+
+  PvlObject otherInput(source);
+  otherInput["InputFile"].setValue("other.cub");
+  EXPECT_FALSE(readGrid.matches(100, 90, 8, 0.05, otherInput));
+
+  PvlObject otherSpice(source);
+  otherSpice["SpiceFingerprint"].setValue("fedcba9876543210");
+  EXPECT_FALSE(readGrid.matches(100, 90, 8, 0.05, otherSpice));
+
+  PvlObject otherMap(source);
+  otherMap.findGroup("Mapping")["PixelResolution"].setValue("200.0", "meters/pixel");
+  EXPECT_FALSE(readGrid.matches(100, 90, 8, 0.05, otherMap));
+
+  // A grid without a source doesn't match one with a source
+  GeometryGrid noSource(exact, 100, 90, 8, 0.05);
+  EXPECT_FALSE(noSource.matches(100, 90, 8, 0.05, source));
+}
+
+
+TEST(GeometryGrid, BadSpacing) {
+  GeometryGridTestTransform exact;
+  EXPECT_THROW(GeometryGrid(exact, 100, 90, 0), IException);
+}
+
+
+// Output to input: affine, so every cell interpolates exactly
+class GeometryGridAffineTransform : public Transform {
+  public:
+    int calls = 0;
+
+    bool Xform(double &inSample, double &inLine,
+               const double outSample, const double outLine) {
+      calls++;
+      inSample = 0.5 * outSample + 0.25 * outLine + 3.0;
+      inLine = 2.0 * outLine - 1.0;
+      return true;
+    }
+};
+
+
+// Each cell is checked at most at 21 points besides its corner nodes
+TEST(GeometryGrid, ChecksPerCellAreCapped) {
+  GeometryGridAffineTransform exact;
+  GeometryGrid grid(exact, 97, 97, 32, 0.05);
+  EXPECT_EQ(grid.exactCells(), 0);
+  EXPECT_EQ(exact.calls, 4 * 4 + 3 * 3 * 21);
+
+  GeometryGridAffineTransform unevenExact;
+  GeometryGrid unevenGrid(unevenExact, 81, 81, 40, 0.05);
+  EXPECT_EQ(unevenGrid.exactCells(), 0);
+  EXPECT_EQ(unevenExact.calls, 3 * 3 + 2 * 2 * 21);
+}
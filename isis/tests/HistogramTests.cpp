@@ -0,0 +1,26 @@
+#include "Histogram.h"
+
+#include "IException.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+TEST(Histogram, WithBinWidth) {
+  Histogram hist = Histogram::withBinWidth(-1.0, 2.0, 0.25);
+
+  EXPECT_EQ(hist.Bins(), 12);
+  EXPECT_DOUBLE_EQ(hist.BinRangeStart(), -1.0);
+  EXPECT_DOUBLE_EQ(hist.BinRangeEnd(), 2.0);
+
+  // A width that does not divide the range gets one more bin
+  Histogram partial = Histogram::withBinWidth(0.0, 1.0, 0.3);
+  EXPECT_EQ(partial.Bins(), 4);
+}
+
+TEST(Histogram, WithBinWidthErrors) {
+  EXPECT_THROW(Histogram::withBinWidth(0.0, 1.0, 0.0), IException);
+  EXPECT_THROW(Histogram::withBinWidth(0.0, 1.0, -0.5), IException);
+  EXPECT_THROW(Histogram::withBinWidth(1.0, 1.0, 0.5), IException);
+  EXPECT_THROW(Histogram::withBinWidth(2.0, 1.0, 0.5), IException);
+}
@@ -0,0 +1,135 @@
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/Polygon.h>
+
+#include "ImageOverlap.h"
+#include "ImageOverlapSet.h"
+#include "PolygonTools.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Makes a square footprint with its lower left corner at (left, bottom)
+static geos::geom::MultiPolygon *makeSquare(double left, double bottom, double size) {
+  geos::geom::CoordinateSequence *pts = new geos::geom::CoordinateArraySequence();
+  pts->add(geos::geom::Coordinate(left, bottom));
+  pts->add(geos::geom::Coordinate(left, bottom + size));
+  pts->add(geos::geom::Coordinate(left + size, bottom + size));
+  pts->add(geos::geom::Coordinate(left + size, bottom));
+  pts->add(geos::geom::Coordinate(left, bottom));
+
+  std::vector<geos::geom::Geometry *> polys;
+  polys.push_back(globalFactory->createPolygon(globalFactory->createLinearRing(pts), NULL));
+  geos::geom::MultiPolygon *footprint = globalFactory->createMultiPolygon(polys);
+  delete polys[0];
+  return footprint;
+}
+
+
+// Makes footprints in clusters of four overlapping 2x2 squares, with the
+// clusters spread far apart like the footprints of a large mosaic
+static void makeFootprints(int clusters, std::vector<QString> &sns,
+                           std::vector<geos::geom::MultiPolygon *> &footprints) {
+  for (int cluster = 0; cluster < clusters; cluster++) {
+    double x = (cluster % 100) * 10.0;
+    double y = (cluster / 100) * 10.0;
+
+    for (int square = 0; square < 4; square++) {
+      footprints.push_back(makeSquare(x + square % 2, y + square / 2, 2.0));
+      sns.push_back(QString("Image%1").arg(cluster * 4 + square));
+    }
+  }
+}
+
+
+static void findOverlaps(ImageOverlapSet &overlaps, int clusters) {
+  std::vector<QString> sns;
+  std::vector<geos::geom::MultiPolygon *> footprints;
+  makeFootprints(clusters, sns, footprints);
+
+  overlaps.FindImageOverlaps(sns, footprints);
+
+  for (unsigned int i = 0; i < footprints.size(); i++) {
+    delete footprints[i];
+  }
+}
+
+
+TEST(ImageOverlapSet, OverlapsPartitionFootprints) {
+  int clusters = 50;
+  ImageOverlapSet overlaps(true);
+  findOverlaps(overlaps, clusters);
+
+  EXPECT_EQ(overlaps.Errors().size(), 0u);
+
+  // The overlaps cover the union of the footprints exactly once and the
+  // overlaps of each image add up to its footprint
+  double totalArea = 0.0;
+  QHash<QString, double> imageAreas;
+  for (int i = 0; i < overlaps.Size(); i++) {
+    const ImageOverlap *overlap = overlaps[i];
+    double area = overlap->Polygon()->getArea();
+    totalArea += area;
+    for (int sn = 0; sn < overlap->Size(); sn++) {
+      imageAreas[(*overlap)[sn]] += area;
+    }
+  }
+
+  EXPECT_NEAR(totalArea, clusters * 9.0, 1e-8);
+  ASSERT_EQ(imageAreas.size(), clusters * 4);
+  foreach (double area, imageAreas) {
+    EXPECT_NEAR(area, 4.0, 1e-8);
+  }
+
+  // Each cluster is split into 9 unit squares
+  EXPECT_EQ(overlaps.Size(), clusters * 9);
+}
+
+
+// A sliver footprint far from every other footprint is removed like any other
+// sliver, even though the pairs it is in are skipped as disjoint
+TEST(ImageOverlapSet, DisjointSliversAreRemoved) {
+  int clusters = 2;
+  std::vector<QString> sns;
+  std::vector<geos::geom::MultiPolygon *> footprints;
+  makeFootprints(clusters, sns, footprints);
+
+  footprints.push_back(makeSquare(5000.0, 5000.0, 1.0e-8));
+  sns.push_back("Sliver");
+
+  ImageOverlapSet overlaps(true);
+  overlaps.FindImageOverlaps(sns, footprints);
+
+  for (unsigned int i = 0; i < footprints.size(); i++) {
+    delete footprints[i];
+  }
+
+  EXPECT_EQ(overlaps.Size(), clusters * 9);
+  EXPECT_TRUE(overlaps["Sliver"].empty());
+  for (int i = 0; i < overlaps.Size(); i++) {
+    EXPECT_GE(overlaps[i]->Polygon()->getArea(), 1.0e-14);
+  }
+}
+
+
+// Times large footprint sets. Run with --gtest_also_run_disabled_tests.
+TEST(ImageOverlapSet, DISABLED_FindOverlapsBenchmark) {
+  int images[] = { 1000, 10000, 100000 };
+  for (int i = 0; i < 3; i++) {
+    ImageOverlapSet overlaps(true);
+    QElapsedTimer timer;
+    timer.start();
+    findOverlaps(overlaps, images[i] / 4);
+    RecordProperty(QString("Milliseconds%1").arg(images[i]).toStdString(),
+                   QString::number(timer.elapsed()).toStdString());
+    EXPECT_EQ(overlaps.Size(), images[i] / 4 * 9);
+  }
+}
@@ -0,0 +1,41 @@
+#include "Camera.h"
+#include "LineScanCameraGroundMap.h"
+#include "SurfacePoint.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Starting the search at a nearby line has to end at the same focal plane
+// position as searching the whole image.
+TEST_F(LineScannerCube, SeededSetGroundMatchesSearch) {
+  Camera *cam = testCube->camera();
+  LineScanCameraGroundMap *groundMap =
+      dynamic_cast<LineScanCameraGroundMap *>(cam->GroundMap());
+  ASSERT_NE(groundMap, (LineScanCameraGroundMap *) NULL);
+
+  int tested = 0;
+  for (int line = 2; line <= testCube->lineCount(); line += 97) {
+    for (int samp = 1; samp <= testCube->sampleCount(); samp += 101) {
+      if (!cam->SetImage(samp, line)) {
+        continue;
+      }
+      SurfacePoint point = cam->GetSurfacePoint();
+
+      ASSERT_TRUE(groundMap->SetGround(point));
+      double expectedX = groundMap->FocalPlaneX();
+      double expectedY = groundMap->FocalPlaneY();
+
+      ASSERT_TRUE(groundMap->SetGround(point, line - 1));
+      EXPECT_NEAR(groundMap->FocalPlaneX(), expectedX, 1e-4)
+          << "sample " << samp << " line " << line;
+      EXPECT_NEAR(groundMap->FocalPlaneY(), expectedY, 1e-4)
+          << "sample " << samp << " line " << line;
+      tested++;
+    }
+  }
+
+  EXPECT_GT(tested, 0);
+}
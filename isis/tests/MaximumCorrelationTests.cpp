@@ -0,0 +1,203 @@
+#include <cmath>
+#include <cstdlib>
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "Chip.h"
+#include "IString.h"
+#include "MaximumCorrelation.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Exposes the match algorithm and the fit chip shortcut
+class MaximumCorrelationTest : public MaximumCorrelation {
+  public:
+    MaximumCorrelationTest(Pvl &pvl) : MaximumCorrelation(pvl) { };
+
+    bool computeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                        int startSamp, int endSamp, int startLine, int endLine) {
+      return ComputeFitChip(sChip, pChip, fChip, startSamp, endSamp, startLine, endLine);
+    }
+
+    // The fit chip from walking the search chip, like AutoReg::Match
+    void walkFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                     int startSamp, int endSamp, int startLine, int endLine) {
+      fChip.SetSize(sChip.Samples(), sChip.Lines());
+      for (int line = 1; line <= fChip.Lines(); line++) {
+        for (int samp = 1; samp <= fChip.Samples(); samp++) {
+          fChip.SetValue(samp, line, Null);
+        }
+      }
+
+      Chip subsearch(pChip.Samples(), pChip.Lines());
+      for (int line = startLine; line <= endLine; line++) {
+        for (int samp = startSamp; samp <= endSamp; samp++) {
+          sChip.Extract(samp, line, subsearch);
+          if (!subsearch.IsValid(SubsearchValidPercent())) continue;
+          double fit = MatchAlgorithm(pChip, subsearch);
+          if (fit != Null) {
+            fChip.SetValue(samp, line, fit);
+          }
+        }
+      }
+    }
+};
+
+
+static Pvl registrationPvl(int patternSize, int searchSize) {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", "MaximumCorrelation");
+  alg += PvlKeyword("Tolerance", "0.3");
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", toString(patternSize));
+  pchip += PvlKeyword("Lines", toString(patternSize));
+  pchip += PvlKeyword("ValidPercent", "60");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", toString(searchSize));
+  schip += PvlKeyword("Lines", toString(searchSize));
+  schip += PvlKeyword("SubchipValidPercent", "40");
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+// Textured search chip with a flat corner and scattered special pixels, and a
+// noisy pattern cut out of it
+static void makeChips(Chip &search, Chip &pattern, int patternSamp, int patternLine) {
+  srand(22);
+  for (int line = 1; line <= search.Lines(); line++) {
+    for (int samp = 1; samp <= search.Samples(); samp++) {
+      double value = 1000.0 + 50.0 * sin(samp * 0.3) * cos(line * 0.2) + rand() % 20;
+      if (samp > search.Samples() / 2 && line < search.Lines() / 4) value = 1234.0;
+      if (rand() % 10 == 0) value = Null;
+      if (rand() % 50 == 0) value = Hrs;
+      search.SetValue(samp, line, value);
+    }
+  }
+
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      double value = search.GetValue(patternSamp + samp - 1, patternLine + line - 1);
+      if (!IsSpecial(value)) value += rand() % 5;
+      pattern.SetValue(samp, line, value);
+    }
+  }
+}
+
+
+TEST(MaximumCorrelation, FitChipMatchesWalk) {
+  Pvl pvl = registrationPvl(25, 150);
+  MaximumCorrelationTest correlation(pvl);
+
+  Chip search(150, 140);
+  Chip pattern(25, 24);
+  makeChips(search, pattern, 90, 70);
+  search.SetValidRange(0.0, 1100.0);
+
+  int startSamp = 13;
+  int startLine = 12;
+  int endSamp = search.Samples() - startSamp + 1;
+  int endLine = search.Lines() - startLine + 1;
+
+  Chip walked;
+  correlation.walkFitChip(search, pattern, walked, startSamp, endSamp, startLine, endLine);
+
+  Chip computed(search.Samples(), search.Lines());
+  for (int line = 1; line <= computed.Lines(); line++) {
+    for (int samp = 1; samp <= computed.Samples(); samp++) {
+      computed.SetValue(samp, line, Null);
+    }
+  }
+  ASSERT_TRUE(correlation.computeFitChip(search, pattern, computed,
+                                         startSamp, endSamp, startLine, endLine));
+
+  int fits = 0;
+  for (int line = 1; line <= computed.Lines(); line++) {
+    for (int samp = 1; samp <= computed.Samples(); samp++) {
+      double walkedFit = walked.GetValue(samp, line);
+      double computedFit = computed.GetValue(samp, line);
+      ASSERT_EQ(walkedFit == Null, computedFit == Null) << "at sample " << samp << ", line " << line;
+      if (walkedFit != Null) {
+        EXPECT_NEAR(computedFit, walkedFit, 1e-9) << "at sample " << samp << ", line " << line;
+        fits++;
+      }
+    }
+  }
+  EXPECT_GT(fits, 0);
+
+  // The pattern was cut out with its tack at sample 102, line 81
+  EXPECT_GT(computed.GetValue(102, 81), 0.95);
+}
+
+
+TEST(MaximumCorrelation, SmallSearchesAreWalked) {
+  Pvl pvl = registrationPvl(15, 35);
+  MaximumCorrelationTest correlation(pvl);
+
+  Chip search(35, 35);
+  Chip pattern(15, 15);
+  makeChips(search, pattern, 10, 10);
+  Chip fit(35, 35);
+  EXPECT_FALSE(correlation.computeFitChip(search, pattern, fit, 8, 28, 8, 28));
+}
+
+
+// Times the walk against the transforms. Run with --gtest_also_run_disabled_tests.
+TEST(MaximumCorrelation, DISABLED_FitChipBenchmark) {
+  Pvl pvl = registrationPvl(31, 301);
+  MaximumCorrelationTest correlation(pvl);
+
+  Chip search(301, 301);
+  Chip pattern(31, 31);
+  makeChips(search, pattern, 150, 120);
+
+  int start = 16;
+  int end = search.Samples() - start + 1;
+
+  QElapsedTimer timer;
+  timer.start();
+  Chip walked;
+  correlation.walkFitChip(search, pattern, walked, start, end, start, end);
+  qint64 walkTime = timer.elapsed();
+
+  timer.restart();
+  Chip computed(search.Samples(), search.Lines());
+  for (int line = 1; line <= computed.Lines(); line++) {
+    for (int samp = 1; samp <= computed.Samples(); samp++) {
+      computed.SetValue(samp, line, Null);
+    }
+  }
+  ASSERT_TRUE(correlation.computeFitChip(search, pattern, computed, start, end, start, end));
+  qint64 computeTime = timer.elapsed();
+
+  RecordProperty("WalkMilliseconds", QString::number(walkTime).toStdString());
+  RecordProperty("FitChipMilliseconds", QString::number(computeTime).toStdString());
+
+  for (int line = start; line <= end; line += 7) {
+    for (int samp = start; samp <= end; samp += 7) {
+      double walkedFit = walked.GetValue(samp, line);
+      double computedFit = computed.GetValue(samp, line);
+      ASSERT_EQ(walkedFit == Null, computedFit == Null);
+      if (walkedFit != Null) {
+        EXPECT_NEAR(computedFit, walkedFit, 1e-9);
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#include <QString>
+
+#include "Buffer.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "ProcessByLine.h"
+#include "SpecialPixel.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+static void scaleLine(Buffer &in, Buffer &out) {
+  for (int i = 0; i < in.size(); i++) {
+    out[i] = IsSpecial(in[i]) ? in[i] : in[i] * 2.0 + in.Line();
+  }
+}
+
+
+TEST_F(TempTestingFiles, ProcessByLineParallelStartProcess) {
+  Cube inCube;
+  inCube.setDimensions(50, 97, 3);
+  inCube.create(tempDir.path() + "/parallelIn.cub");
+
+  LineManager inLine(inCube);
+  for (inLine.begin(); !inLine.end(); inLine++) {
+    for (int i = 0; i < inLine.size(); i++) {
+      inLine[i] = (i % 7 == 0) ? Null : inLine.Band() * 10000 + inLine.Line() * 100 + i;
+    }
+    inCube.write(inLine);
+  }
+  inCube.reopen("r");
+
+  // An odd number of lines so the last block is partial
+  ProcessByLine process;
+  EXPECT_FALSE(process.ThreadsStartProcess());
+  process.SetThreadedStartProcess(true);
+  process.SetInputCube(&inCube);
+  CubeAttributeOutput outAtt;
+  process.SetOutputCube(tempDir.path() + "/parallelOut.cub", outAtt, 50, 97, 3);
+  process.StartProcess(scaleLine);
+  process.EndProcess();
+
+  Cube outCube(tempDir.path() + "/parallelOut.cub");
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      if (i % 7 == 0) {
+        EXPECT_TRUE(IsNullPixel(outLine[i]));
+      }
+      else {
+        double expected = (outLine.Band() * 10000 + outLine.Line() * 100 + i) * 2.0 +
+                          outLine.Line();
+        EXPECT_DOUBLE_EQ(outLine[i], expected);
+      }
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, ProcessByLineInputOverview) {
+  Cube inCube;
+  inCube.setDimensions(20, 12, 2);
+  inCube.create(tempDir.path() + "/overviewIn.cub");
+
+  LineManager inLine(inCube);
+  for (inLine.begin(); !inLine.end(); inLine++) {
+    for (int i = 0; i < inLine.size(); i++) {
+      inLine[i] = inLine.Band() * 1000 + inLine.Line() * 10 + i;
+    }
+    inCube.write(inLine);
+  }
+  inCube.createOverviews(1);
+  inCube.reopen("r");
+
+  ProcessByLine process;
+  process.SetInputCube(&inCube);
+  process.SetInputOverviewLevel(1);
+  CubeAttributeOutput outAtt;
+  process.SetOutputCube(tempDir.path() + "/overviewOut.cub", outAtt,
+                        inCube.overviewSampleCount(1), inCube.overviewLineCount(1), 2);
+  process.StartProcess(scaleLine);
+  process.EndProcess();
+
+  Cube outCube(tempDir.path() + "/overviewOut.cub");
+  ASSERT_EQ(outCube.sampleCount(), 10);
+  ASSERT_EQ(outCube.lineCount(), 6);
+
+  // Each overview pixel is the average of a 2x2 block of the input
+  LineManager outLine(outCube);
+  for (outLine.begin(); !outLine.end(); outLine++) {
+    outCube.read(outLine);
+    for (int i = 0; i < outLine.size(); i++) {
+      double average = outLine.Band() * 1000 + (2 * outLine.Line() - 0.5) * 10 +
+                       2 * i + 0.5;
+      EXPECT_NEAR(outLine[i], average * 2.0 + outLine.Line(), 1e-3);
+    }
+  }
+
+  ProcessByLine tooDeep;
+  tooDeep.SetInputCube(&inCube);
+  tooDeep.SetInputOverviewLevel(2);
+  tooDeep.SetOutputCube(tempDir.path() + "/tooDeep.cub", outAtt, 5, 3, 2);
+  EXPECT_THROW(tooDeep.StartProcess(scaleLine), IException);
+}
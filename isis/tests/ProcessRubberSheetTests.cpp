@@ -0,0 +1,134 @@
+#include <QString>
+#include <QThreadPool>
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "ProcessRubberSheet.h"
+#include "SpecialPixel.h"
+#include "Transform.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Output to input: a small rotation and shift
+class RubberSheetReverseTransform : public Transform {
+  public:
+    bool Xform(double &inSample, double &inLine,
+               const double outSample, const double outLine) {
+      inSample = 0.98 * outSample + 0.05 * outLine - 3.25;
+      inLine = -0.05 * outSample + 0.98 * outLine + 6.5;
+      return inSample > 0.5 && inLine > 0.5;
+    }
+};
+
+// Input to output: a scale and shift
+class RubberSheetForwardTransform : public Transform {
+  public:
+    bool Xform(double &outSample, double &outLine,
+               const double inSample, const double inLine) {
+      outSample = 1.1 * inSample - 2.5;
+      outLine = 0.9 * inLine + 4.0;
+      return true;
+    }
+};
+
+
+class ProcessRubberSheetThreads : public TempTestingFiles {
+  protected:
+    Cube inCube;
+
+    void SetUp() override {
+      TempTestingFiles::SetUp();
+
+      inCube.setDimensions(150, 140, 2);
+      inCube.create(tempDir.path() + "/rubberIn.cub");
+
+      LineManager inLine(inCube);
+      for (inLine.begin(); !inLine.end(); inLine++) {
+        for (int i = 0; i < inLine.size(); i++) {
+          inLine[i] = (i % 13 == 0) ? Null : inLine.Band() * 1000 + inLine.Line() + i * 0.5;
+        }
+        inCube.write(inLine);
+      }
+      inCube.reopen("r");
+    }
+
+    // Runs the tile (reverse) or patch (forward) transform, threaded when a factory is given
+    void warp(QString outFile, bool forward, bool threaded) {
+      int originalThreads = QThreadPool::globalInstance()->maxThreadCount();
+      QThreadPool::globalInstance()->setMaxThreadCount(3);
+
+      ProcessRubberSheet process;
+      process.SetInputCube(&inCube);
+      CubeAttributeOutput outAtt;
+      process.SetOutputCube(tempDir.path() + "/" + outFile, outAtt, 160, 150, 2);
+      process.SetTiling(16, 4);
+
+      Interpolator interp(Interpolator::BiLinearType);
+
+      if (forward) {
+        RubberSheetForwardTransform trans;
+        if (threaded) {
+          process.setTransformFactory([]() -> Transform * {
+            return new RubberSheetForwardTransform();
+          });
+        }
+        process.processPatchTransform(trans, interp);
+      }
+      else {
+        RubberSheetReverseTransform trans;
+        if (threaded) {
+          process.setTransformFactory([]() -> Transform * {
+            return new RubberSheetReverseTransform();
+          });
+        }
+        process.StartProcess(trans, interp);
+      }
+
+      process.EndProcess();
+
+      QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+    }
+
+    void expectSameCubes(QString firstFile, QString secondFile) {
+      Cube first(tempDir.path() + "/" + firstFile);
+      Cube second(tempDir.path() + "/" + secondFile);
+
+      LineManager firstLine(first);
+      LineManager secondLine(second);
+      int validPixels = 0;
+      for (firstLine.begin(), secondLine.begin(); !firstLine.end(); firstLine++, secondLine++) {
+        first.read(firstLine);
+        second.read(secondLine);
+        for (int i = 0; i < firstLine.size(); i++) {
+          EXPECT_EQ(firstLine[i], secondLine[i])
+              << "at sample " << i + 1 << ", line " << firstLine.Line()
+              << ", band " << firstLine.Band();
+          if (!IsSpecial(firstLine[i])) {
+            validPixels++;
+          }
+        }
+      }
+
+      EXPECT_GT(validPixels, 0);
+    }
+};
+
+
+TEST_F(ProcessRubberSheetThreads, ThreadedStartProcessMatchesSequential) {
+  warp("reverseSequential.cub", false, false);
+  warp("reverseThreaded.cub", false, true);
+  expectSameCubes("reverseSequential.cub", "reverseThreaded.cub");
+}
+
+
+TEST_F(ProcessRubberSheetThreads, ThreadedPatchTransformMatchesSequential) {
+  warp("forwardSequential.cub", true, false);
+  warp("forwardThreaded.cub", true, true);
+  expectSameCubes("forwardSequential.cub", "forwardThreaded.cub");
+}
@@ -0,0 +1,115 @@
+#include <QString>
+
+#include "IException.h"
+#include "PvlContainer.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Enough keywords for the container to index them
+static PvlGroup makeGroup(int keywords) {
+  PvlGroup group("Instrument");
+  for (int i = 0; i < keywords; i++) {
+    group += PvlKeyword(QString("Keyword_%1").arg(i), QString::number(i));
+  }
+  return group;
+}
+
+
+TEST(PvlContainer, IndexedFindMatchesLinearRules) {
+  PvlGroup group = makeGroup(20);
+
+  EXPECT_EQ(group.findKeyword("Keyword_7")[0], "7");
+  EXPECT_EQ(group.findKeyword("KEYWORD7")[0], "7");
+  EXPECT_EQ(group.findKeyword("keyword_1_7")[0], "17");
+  EXPECT_TRUE(group.hasKeyword("kEyWoRd_19"));
+  EXPECT_FALSE(group.hasKeyword("Keyword_20"));
+  EXPECT_THROW(group.findKeyword("Keyword_20"), IException);
+  EXPECT_THROW(group.findKeyword("Keyword 7"), IException);
+
+  const PvlGroup &constGroup = group;
+  EXPECT_EQ(constGroup["Keyword_3"][0], "3");
+}
+
+
+TEST(PvlContainer, IndexedFindReturnsFirstDuplicate) {
+  PvlGroup group = makeGroup(20);
+  group += PvlKeyword("Keyword_5", "duplicate");
+  EXPECT_EQ(group["Keyword_5"][0], "5");
+
+  group.deleteKeyword("Keyword_5");
+  EXPECT_EQ(group["Keyword_5"][0], "duplicate");
+
+  group.deleteKeyword("Keyword_5");
+  EXPECT_FALSE(group.hasKeyword("Keyword_5"));
+}
+
+
+TEST(PvlContainer, IndexedFindAfterChanges) {
+  PvlGroup group = makeGroup(20);
+  EXPECT_TRUE(group.hasKeyword("Keyword_10"));
+
+  // Renamed through a reference the container handed out
+  group["Keyword_10"].setName("Renamed");
+  EXPECT_FALSE(group.hasKeyword("Keyword_10"));
+  EXPECT_EQ(group["Renamed"][0], "10");
+
+  *group.begin() = PvlKeyword("First", "first");
+  EXPECT_FALSE(group.hasKeyword("Keyword_0"));
+  EXPECT_EQ(group["First"][0], "first");
+
+  group.addKeyword(PvlKeyword("Inserted", "inserted"), group.begin() + 2);
+  EXPECT_EQ(group["Inserted"][0], "inserted");
+  EXPECT_EQ(group["Keyword_19"][0], "19");
+
+  group.deleteKeyword(0);
+  EXPECT_FALSE(group.hasKeyword("First"));
+  EXPECT_EQ(group["Keyword_1"][0], "1");
+
+  group.addKeyword(PvlKeyword("Keyword_2", "replaced"), PvlContainer::Replace);
+  EXPECT_EQ(group["Keyword_2"][0], "replaced");
+
+  PvlGroup copy = group;
+  copy.deleteKeyword("Keyword_3");
+  EXPECT_FALSE(copy.hasKeyword("Keyword_3"));
+  EXPECT_TRUE(group.hasKeyword("Keyword_3"));
+
+  group = makeGroup(10);
+  EXPECT_FALSE(group.hasKeyword("Renamed"));
+  EXPECT_EQ(group["Keyword_9"][0], "9");
+
+  group.clear();
+  EXPECT_FALSE(group.hasKeyword("Keyword_9"));
+}
+
+
+TEST(PvlContainer, IndexedFindAfterRenamesInCopies) {
+  PvlGroup group = makeGroup(20);
+  PvlGroup copy = group;
+  EXPECT_TRUE(group.hasKeyword("Keyword_4"));
+  EXPECT_TRUE(copy.hasKeyword("Keyword_4"));
+
+  // Each container only watches the keywords it handed out
+  copy[4].setName("InCopy");
+  EXPECT_TRUE(group.hasKeyword("Keyword_4"));
+  EXPECT_FALSE(copy.hasKeyword("Keyword_4"));
+  EXPECT_EQ(copy["InCopy"][0], "4");
+
+  group[4].setName("InGroup");
+  EXPECT_FALSE(group.hasKeyword("Keyword_4"));
+  EXPECT_FALSE(group.hasKeyword("InCopy"));
+  EXPECT_EQ(group["InGroup"][0], "4");
+
+  // Keywords copied out of the container are not in it
+  PvlKeyword keyword = group["Keyword_5"];
+  keyword.setName("Copied");
+  EXPECT_FALSE(group.hasKeyword("Copied"));
+  EXPECT_TRUE(group.hasKeyword("Keyword_5"));
+
+  (group.begin() + 6)->setName("Iterated");
+  EXPECT_FALSE(group.hasKeyword("Keyword_6"));
+  EXPECT_EQ(group["Iterated"][0], "6");
+}
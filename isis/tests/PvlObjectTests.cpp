@@ -1,6 +1,10 @@
 #include "PvlObject.h"
+#include "Camera.h"
+#include "CameraFactory.h"
 #include "IException.h"
+#include "Fixtures.h"
 
+#include <QElapsedTimer>
 #include <QString>
 
 #include <iostream>
@@ -195,3 +199,87 @@ TEST(PvlObject, constructFromPvl) {
 }
 
 
+
+
+TEST(PvlObject, IndexedGroupAndObjectFinds) {
+  PvlObject root("Root");
+  for (int i = 0; i < 20; i++) {
+    root += PvlGroup(QString("Group_%1").arg(i));
+    root += PvlObject(QString("Object_%1").arg(i));
+  }
+  root.findObject("Object_12") += PvlGroup("Nested");
+
+  EXPECT_TRUE(root.hasGroup("GROUP_7"));
+  EXPECT_TRUE(root.hasObject("object7"));
+  EXPECT_FALSE(root.hasGroup("Group_20"));
+  EXPECT_FALSE(root.hasObject("Object_20"));
+  EXPECT_FALSE(root.hasGroup("Nested"));
+  EXPECT_EQ(root.findGroup("Nested", PvlObject::Traverse).name(), "Nested");
+  EXPECT_THROW(root.findGroup("Nested"), IException);
+
+  root.findGroup("Group_3").setName("Renamed");
+  EXPECT_FALSE(root.hasGroup("Group_3"));
+  EXPECT_TRUE(root.hasGroup("Renamed"));
+
+  root.findObject("Object_4") = PvlObject("Replaced");
+  EXPECT_FALSE(root.hasObject("Object_4"));
+  EXPECT_TRUE(root.hasObject("Replaced"));
+
+  root.group(5).setName("ByIndex");
+  root.object(5).setName("ObjectByIndex");
+  (root.beginGroup() + 6)->setName("Iterated");
+  EXPECT_TRUE(root.hasGroup("ByIndex"));
+  EXPECT_TRUE(root.hasObject("ObjectByIndex"));
+  EXPECT_TRUE(root.hasGroup("Iterated"));
+  EXPECT_FALSE(root.hasGroup("Group_6"));
+
+  // Renaming a nested group only changes the object it is in
+  root.findGroup("Nested", PvlObject::Traverse).setName("NestedRenamed");
+  EXPECT_TRUE(root.findObject("Object_12").hasGroup("NestedRenamed"));
+  EXPECT_FALSE(root.hasGroup("NestedRenamed"));
+
+  // Naming an unnamed object, or assigning over one, changes the index too
+  root += PvlObject();
+  root += PvlObject();
+  EXPECT_FALSE(root.hasObject("Late"));
+  root.object(root.objects() - 2).setName("Late");
+  root.object(root.objects() - 1) = PvlObject("Assigned");
+  EXPECT_TRUE(root.hasObject("Late"));
+  EXPECT_TRUE(root.hasObject("Assigned"));
+  root.findObject("Object_3") = PvlObject();
+  EXPECT_FALSE(root.hasObject("Object_3"));
+
+  root.deleteGroup("Renamed");
+  root.deleteObject(0);
+  EXPECT_FALSE(root.hasGroup("Renamed"));
+  EXPECT_FALSE(root.hasObject("Object_0"));
+  EXPECT_EQ(root.findGroup("Group_19").name(), "Group_19");
+  EXPECT_EQ(root.findObject("Object_19").name(), "Object_19");
+
+  root.clear();
+  EXPECT_FALSE(root.hasGroup("Group_19"));
+  EXPECT_FALSE(root.hasObject("Object_19"));
+}
+
+
+// Times repeated label lookups and camera creation on the default test cube.
+// Run with --gtest_also_run_disabled_tests.
+TEST_F(DefaultCube, DISABLED_LabelLookupBenchmark) {
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < 10000; i++) {
+    const PvlObject &cube = label.findObject("IsisCube");
+    cube.findGroup("Kernels").findKeyword("NaifFrameCode");
+    cube.findGroup("Instrument").hasKeyword("SpacecraftClockCount");
+    label.hasKeyword("TargetName", PvlObject::Traverse);
+  }
+  RecordProperty("LookupMilliseconds", QString::number(timer.elapsed()).toStdString());
+
+  timer.restart();
+  for (int i = 0; i < 10; i++) {
+    Camera *cam = CameraFactory::Create(*testCube);
+    EXPECT_NE(cam, nullptr);
+    delete cam;
+  }
+  RecordProperty("CameraCreateMilliseconds", QString::number(timer.elapsed()).toStdString());
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "IException.h"
+#include "RankFilter.h"
+#include "SpecialPixel.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// Lines of small integers so that boxcars have repeated values, with a few Nulls
+static std::vector< std::vector<double> > makeLines(int ns, int nl, int range) {
+  std::vector< std::vector<double> > lines(nl, std::vector<double>(ns));
+  for (int line = 0; line < nl; line++) {
+    for (int samp = 0; samp < ns; samp++) {
+      lines[line][samp] = (rand() % 7 == 0) ? Null : (double)(rand() % range);
+    }
+  }
+  return lines;
+}
+
+
+// The sorted valid pixels of a boxcar, the way the boxcar applications used to find them
+static std::vector<double> sortedBoxcar(const std::vector< std::vector<double> > &lines,
+                                        int index, int width, double low, double high) {
+  std::vector<double> boxdata;
+  for (unsigned int line = 0; line < lines.size(); line++) {
+    for (int samp = index - width / 2; samp <= index + width / 2; samp++) {
+      if (samp < 0 || samp >= (int) lines[line].size()) continue;
+      double pixel = lines[line][samp];
+      if (!IsSpecial(pixel) && pixel >= low && pixel <= high) {
+        boxdata.push_back(pixel);
+      }
+    }
+  }
+  std::sort(boxdata.begin(), boxdata.end());
+  return boxdata;
+}
+
+
+static void checkBoxcar(RankFilter &filter, const std::vector< std::vector<double> > &lines,
+                        int index, double low, double high) {
+  std::vector<double> boxdata = sortedBoxcar(lines, index, filter.Width(), low, high);
+  int count = boxdata.size();
+  ASSERT_EQ(filter.Count(index), count) << "at index " << index;
+
+  for (int rank = 0; rank < count; rank++) {
+    EXPECT_EQ(filter.Rank(index, rank), boxdata[rank]) << "at index " << index;
+  }
+  EXPECT_EQ(filter.Rank(index, count), Null);
+
+  if (count == 0) {
+    EXPECT_EQ(filter.Median(index), Null);
+    EXPECT_EQ(filter.Mode(index), Null);
+    EXPECT_EQ(filter.ModeCount(index), 0);
+    return;
+  }
+  EXPECT_EQ(filter.Median(index), boxdata[(count - 1) / 2]) << "at index " << index;
+
+  // The smallest of the most common values
+  double mode = boxdata[0];
+  int modeCount = 0;
+  for (int i = 0; i < count; ) {
+    int j = i;
+    while (j < count && boxdata[j] == boxdata[i]) j++;
+    if (j - i > modeCount) {
+      mode = boxdata[i];
+      modeCount = j - i;
+    }
+    i = j;
+  }
+  EXPECT_EQ(filter.Mode(index), mode) << "at index " << index;
+  EXPECT_EQ(filter.ModeCount(index), modeCount) << "at index " << index;
+}
+
+
+TEST(RankFilter, MatchesSortedBoxcars) {
+  srand(21);
+  int ns = 40;
+  int width = 5;
+  int height = 3;
+  std::vector< std::vector<double> > lines = makeLines(ns, 10, 6);
+
+  RankFilter filter(ns, width, height);
+  EXPECT_EQ(filter.Samples(), ns);
+  EXPECT_EQ(filter.HalfWidth(), 2);
+  EXPECT_EQ(filter.HalfHeight(), 1);
+
+  // Slide the boxcar down the lines the way ProcessByBoxcar does
+  for (int line = 0; line < height; line++) {
+    filter.AddLine(&lines[line][0]);
+  }
+  for (int line = height; line <= (int) lines.size(); line++) {
+    std::vector< std::vector<double> > boxLines(lines.begin() + line - height,
+                                                lines.begin() + line);
+    for (int i = 0; i < ns; i++) {
+      checkBoxcar(filter, boxLines, i, -DBL_MAX, DBL_MAX);
+    }
+
+    // Out of order indexes too
+    for (int i = ns - 1; i >= 0; i -= 3) {
+      checkBoxcar(filter, boxLines, i, -DBL_MAX, DBL_MAX);
+    }
+
+    if (line < (int) lines.size()) {
+      filter.RemoveLine();
+      filter.AddLine(&lines[line][0]);
+    }
+  }
+}
+
+
+TEST(RankFilter, ValidRange) {
+  srand(12);
+  int ns = 25;
+  std::vector< std::vector<double> > lines = makeLines(ns, 5, 10);
+
+  RankFilter filter(ns, 7, 5);
+  filter.SetMinMax(2.0, 6.0);
+  EXPECT_EQ(filter.Low(), 2.0);
+  EXPECT_EQ(filter.High(), 6.0);
+  for (unsigned int line = 0; line < lines.size(); line++) {
+    filter.AddLine(&lines[line][0]);
+  }
+
+  for (int i = 0; i < ns; i++) {
+    checkBoxcar(filter, lines, i, 2.0, 6.0);
+  }
+}
+
+
+TEST(RankFilter, Errors) {
+  EXPECT_THROW(RankFilter(10, 4, 3), IException);
+  EXPECT_THROW(RankFilter(10, 3, 4), IException);
+
+  RankFilter filter(10, 3, 1);
+  EXPECT_THROW(filter.SetMinMax(5.0, 1.0), IException);
+
+  std::vector<double> line(10, 1.0);
+  filter.AddLine(&line[0]);
+  EXPECT_THROW(filter.AddLine(&line[0]), IException);
+
+  filter.Reset();
+  filter.AddLine(&line[0]);
+  EXPECT_EQ(filter.Count(0), 2);
+  EXPECT_EQ(filter.Count(5), 3);
+}
+
+
+// Times the sliding filter against sorting each boxcar. Run with
+// --gtest_also_run_disabled_tests.
+TEST(RankFilter, DISABLED_MedianBenchmark) {
+  srand(7);
+  int ns = 1000;
+  int width = 15;
+  int height = 15;
+  std::vector< std::vector<double> > lines = makeLines(ns, height, 5000);
+
+  QElapsedTimer timer;
+  timer.start();
+  std::vector<double> sorted(ns);
+  for (int i = 0; i < ns; i++) {
+    std::vector<double> boxdata = sortedBoxcar(lines, i, width, -DBL_MAX, DBL_MAX);
+    sorted[i] = boxdata[(boxdata.size() - 1) / 2];
+  }
+  qint64 sortTime = timer.nsecsElapsed();
+
+  timer.restart();
+  RankFilter filter(ns, width, height);
+  for (int line = 0; line < height; line++) {
+    filter.AddLine(&lines[line][0]);
+  }
+  std::vector<double> ranked(ns);
+  for (int i = 0; i < ns; i++) {
+    ranked[i] = filter.Median(i);
+  }
+  qint64 rankTime = timer.nsecsElapsed();
+
+  RecordProperty("SortMicroseconds", QString::number(sortTime / 1000).toStdString());
+  RecordProperty("RankFilterMicroseconds", QString::number(rankTime / 1000).toStdString());
+
+  for (int i = 0; i < ns; i++) {
+    EXPECT_EQ(ranked[i], sorted[i]) << "at index " << i;
+  }
+}
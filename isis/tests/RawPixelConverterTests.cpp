@@ -0,0 +1,291 @@
+#include "RawPixelConverter.h"
+#include "SpecialPixel.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <gtest/gtest.h>
+#include <QVector>
+
+using namespace Isis;
+
+// 19 pixels covers whole vector groups, partially special groups and a tail.
+static const int TestPixelCount = 19;
+
+static QVector<double> testValues() {
+  QVector<double> values;
+  for (int i = 0; i < TestPixelCount; i++) {
+    values.append(10 + i);
+  }
+  values[3] = Null;
+  values[9] = Lrs;
+  values[10] = Lis;
+  values[11] = His;
+  values[17] = Hrs;
+  return values;
+}
+
+
+TEST(RawPixelConverter, SignedWordRoundTrip) {
+  QVector<double> input = testValues();
+  input[12] = 40000.0;
+  input[13] = -40000.0;
+  input[14] = 20.5;
+  input[15] = -20.5;
+
+  for (int swap = 0; swap < 2; swap++) {
+    RawPixelConverter converter(SignedWord, swap, 0.0, 1.0);
+    QVector<short> raw(TestPixelCount);
+    QVector<short> native(TestPixelCount);
+    QVector<double> output(TestPixelCount);
+
+    converter.toRaw(input.data(), (char *)raw.data(), TestPixelCount);
+    converter.toDouble((char *)raw.data(), output.data(), (char *)native.data(),
+                       TestPixelCount);
+
+    EXPECT_EQ(native[0], 10);
+    EXPECT_EQ(native[3], NULL2);
+    EXPECT_EQ(native[12], HIGH_REPR_SAT2);
+    EXPECT_EQ(native[13], LOW_REPR_SAT2);
+    EXPECT_EQ(native[14], 21);
+    EXPECT_EQ(native[15], -21);
+
+    EXPECT_EQ(output[0], 10.0);
+    EXPECT_EQ(output[18], 28.0);
+    EXPECT_EQ(output[3], Null);
+    EXPECT_EQ(output[9], Lrs);
+    EXPECT_EQ(output[10], Lis);
+    EXPECT_EQ(output[11], His);
+    EXPECT_EQ(output[12], Hrs);
+    EXPECT_EQ(output[13], Lrs);
+    EXPECT_EQ(output[17], Hrs);
+  }
+}
+
+
+TEST(RawPixelConverter, UnsignedByteRoundTrip) {
+  QVector<double> input = testValues();
+  input[12] = 300.0;
+  input[13] = 0.2;
+  input[14] = 20.5;
+
+  RawPixelConverter converter(UnsignedByte, false, 5.0, 0.5);
+  QVector<unsigned char> raw(TestPixelCount);
+  QVector<unsigned char> native(TestPixelCount);
+  QVector<double> output(TestPixelCount);
+
+  converter.toRaw(input.data(), (char *)raw.data(), TestPixelCount);
+  converter.toDouble((char *)raw.data(), output.data(), (char *)native.data(),
+                     TestPixelCount);
+
+  EXPECT_EQ(raw[0], 10);
+  EXPECT_EQ(raw[3], NULL1);
+  EXPECT_EQ(raw[12], HIGH_REPR_SAT1);
+  EXPECT_EQ(raw[13], LOW_REPR_SAT1);
+  EXPECT_EQ(raw[14], 31);
+
+  EXPECT_EQ(output[0], 10.0);
+  EXPECT_EQ(output[18], 28.0);
+  EXPECT_EQ(output[3], Null);
+  EXPECT_EQ(output[12], Hrs);
+  EXPECT_EQ(output[14], 20.5);
+}
+
+
+TEST(RawPixelConverter, RealRoundTrip) {
+  QVector<double> input = testValues();
+  input[12] = 1.0e39;
+  input[13] = 0.25;
+
+  for (int swap = 0; swap < 2; swap++) {
+    RawPixelConverter converter(Real, swap, 0.0, 1.0);
+    QVector<float> raw(TestPixelCount);
+    QVector<float> native(TestPixelCount);
+    QVector<double> output(TestPixelCount);
+
+    converter.toRaw(input.data(), (char *)raw.data(), TestPixelCount);
+    converter.toDouble((char *)raw.data(), output.data(), (char *)native.data(),
+                       TestPixelCount);
+
+    EXPECT_EQ(native[12], HIGH_REPR_SAT4);
+
+    for (int i = 0; i < TestPixelCount; i++) {
+      if (i == 12) {
+        EXPECT_EQ(output[i], Hrs);
+      }
+      else {
+        EXPECT_EQ(output[i], input[i]);
+      }
+    }
+  }
+}
+
+
+TEST(RawPixelConverter, UnsignedWordAndIntegerRoundTrip) {
+  QVector<double> input = testValues();
+  input[12] = 1.0;
+
+  RawPixelConverter wordConverter(UnsignedWord, true, 0.0, 1.0);
+  RawPixelConverter intConverter(UnsignedInteger, true, 0.0, 1.0);
+
+  QVector<unsigned short> rawWords(TestPixelCount);
+  QVector<unsigned short> nativeWords(TestPixelCount);
+  QVector<unsigned int> rawInts(TestPixelCount);
+  QVector<unsigned int> nativeInts(TestPixelCount);
+  QVector<double> wordOutput(TestPixelCount);
+  QVector<double> intOutput(TestPixelCount);
+
+  wordConverter.toRaw(input.data(), (char *)rawWords.data(), TestPixelCount);
+  wordConverter.toDouble((char *)rawWords.data(), wordOutput.data(),
+                         (char *)nativeWords.data(), TestPixelCount);
+  intConverter.toRaw(input.data(), (char *)rawInts.data(), TestPixelCount);
+  intConverter.toDouble((char *)rawInts.data(), intOutput.data(),
+                        (char *)nativeInts.data(), TestPixelCount);
+
+  EXPECT_EQ(nativeWords[0], 10);
+  EXPECT_EQ(nativeWords[3], NULLU2);
+  EXPECT_EQ(nativeWords[12], LOW_REPR_SATU2);
+  EXPECT_EQ(nativeInts[0], 10u);
+  EXPECT_EQ(nativeInts[3], NULLUI4);
+  EXPECT_EQ(nativeInts[12], LOW_REPR_SATUI4);
+
+  EXPECT_EQ(wordOutput[18], 28.0);
+  EXPECT_EQ(wordOutput[3], Null);
+  EXPECT_EQ(wordOutput[12], Lrs);
+  EXPECT_EQ(intOutput[18], 28.0);
+  EXPECT_EQ(intOutput[3], Null);
+  EXPECT_EQ(intOutput[12], Lrs);
+}
+
+
+// Exposes the scalar conversions, which the vectorized ones must match exactly
+class ScalarPixelConverter : public RawPixelConverter {
+  public:
+    ScalarPixelConverter(PixelType pixelType, bool swapBytes, double base, double multiplier) :
+        RawPixelConverter(pixelType, swapBytes, base, multiplier) { }
+
+    void scalarDouble(const char *raw, double *output, char *nativeRaw, int count) const {
+      scalarToDouble(raw, output, nativeRaw, count);
+    }
+
+    void scalarRaw(const double *input, char *raw, int count) const {
+      scalarToRaw(input, raw, count);
+    }
+};
+
+
+struct ConverterCase {
+  PixelType pixelType;
+  double base;
+  double multiplier;
+};
+
+
+static QVector<ConverterCase> converterCases() {
+  ConverterCase cases[] = {
+    { UnsignedByte, 5.0, 0.5 },
+    { SignedWord, 0.0, 1.0 },
+    { SignedWord, 100.0, 0.25 },
+    { UnsignedWord, -3.0, 2.0 },
+    { UnsignedInteger, 0.0, 1.0 },
+    { UnsignedInteger, 10.0, 0.5 },
+    { Real, 0.0, 1.0 }
+  };
+  return QVector<ConverterCase>::fromStdVector(
+      std::vector<ConverterCase>(cases, cases + sizeof(cases) / sizeof(cases[0])));
+}
+
+
+// A long run of values that are all valid and in range for the pixel type, so
+// that every whole group can take the vector path. Every specialEvery-th value
+// is special when specialEvery is positive.
+static QVector<double> validRun(const ConverterCase &c, int count, int specialEvery) {
+  QVector<double> values(count);
+  double fractions[] = { 0.0, 0.25, -0.25, 0.375 };
+  for (int i = 0; i < count; i++) {
+    double dn;
+    switch (c.pixelType) {
+      case UnsignedByte:
+        dn = VALID_MIN1 + rand() % (VALID_MAX1 - VALID_MIN1 + 1);
+        break;
+      case SignedWord:
+        dn = VALID_MIN2 + rand() % (VALID_MAX2 - VALID_MIN2 + 1);
+        break;
+      case UnsignedWord:
+        dn = VALID_MINU2 + rand() % (VALID_MAXU2 - VALID_MINU2 + 1);
+        break;
+      case UnsignedInteger:
+        dn = VALID_MINUI4 + ((unsigned long long)rand() * RAND_MAX + rand()) %
+                            (VALID_MAXUI4 - VALID_MINUI4 + 1ULL);
+        break;
+      default:
+        dn = (rand() - RAND_MAX / 2) / 1024.0;
+        break;
+    }
+
+    if (c.pixelType != Real) {
+      dn += fractions[i % 4];
+    }
+    values[i] = c.base + c.multiplier * dn;
+
+    if (specialEvery > 0 && i % specialEvery == specialEvery - 1) {
+      values[i] = Null;
+    }
+  }
+  return values;
+}
+
+
+static void compareWithScalar(const ConverterCase &c, bool swap, int specialEvery) {
+  int count = 1003;
+  int pixelSize = SizeOf(c.pixelType);
+  QVector<double> input = validRun(c, count, specialEvery);
+  ScalarPixelConverter converter(c.pixelType, swap, c.base, c.multiplier);
+
+  QByteArray raw(count * pixelSize, 0);
+  QByteArray scalarRaw(count * pixelSize, 0);
+  converter.toRaw(input.data(), raw.data(), count);
+  converter.scalarRaw(input.data(), scalarRaw.data(), count);
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(memcmp(raw.constData() + i * pixelSize, scalarRaw.constData() + i * pixelSize,
+                     pixelSize), 0)
+        << "toRaw differs at pixel " << i << " for pixel type " << c.pixelType
+        << (swap ? ", swapped" : "");
+  }
+
+  QVector<double> output(count);
+  QVector<double> scalarOutput(count);
+  QByteArray native(count * pixelSize, 0);
+  QByteArray scalarNative(count * pixelSize, 0);
+  converter.toDouble(raw.constData(), output.data(), native.data(), count);
+  converter.scalarDouble(raw.constData(), scalarOutput.data(), scalarNative.data(), count);
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(memcmp(&output[i], &scalarOutput[i], sizeof(double)), 0)
+        << "toDouble differs at pixel " << i << " for pixel type " << c.pixelType
+        << (swap ? ", swapped" : "");
+    ASSERT_EQ(memcmp(native.constData() + i * pixelSize,
+                     scalarNative.constData() + i * pixelSize, pixelSize), 0)
+        << "native DNs differ at pixel " << i << " for pixel type " << c.pixelType
+        << (swap ? ", swapped" : "");
+  }
+}
+
+
+TEST(RawPixelConverter, VectorMatchesScalarForValidRuns) {
+  srand(2);
+  foreach (ConverterCase c, converterCases()) {
+    for (int swap = 0; swap < 2; swap++) {
+      compareWithScalar(c, swap, 0);
+    }
+  }
+}
+
+
+TEST(RawPixelConverter, VectorMatchesScalarForMixedRuns) {
+  srand(3);
+  foreach (ConverterCase c, converterCases()) {
+    for (int swap = 0; swap < 2; swap++) {
+      compareWithScalar(c, swap, 37);
+    }
+  }
+}
@@ -0,0 +1,128 @@
+#include <cmath>
+#include <vector>
+
+#include "Constants.h"
+#include "SpiceRotation.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+// The frame rotation by angle about axis 1, 2 or 3
+static std::vector<double> axisRotation(double angle, int axis) {
+  std::vector<double> m(9, 0.0);
+  int i = axis - 1;
+  int j = (i + 1) % 3;
+  int k = (i + 2) % 3;
+  m[i*3 + i] = 1.0;
+  m[j*3 + j] = cos(angle);
+  m[j*3 + k] = sin(angle);
+  m[k*3 + j] = -sin(angle);
+  m[k*3 + k] = cos(angle);
+  return m;
+}
+
+
+static std::vector<double> multiply(const std::vector<double> &a, const std::vector<double> &b) {
+  std::vector<double> m(9, 0.0);
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      for (int i = 0; i < 3; i++) {
+        m[row*3 + col] += a[row*3 + i] * b[i*3 + col];
+      }
+    }
+  }
+  return m;
+}
+
+
+TEST(SpiceRotation, InterpolatesCachedQuaternions) {
+  TableField q0("J2000Q0", TableField::Double);
+  TableField q1("J2000Q1", TableField::Double);
+  TableField q2("J2000Q2", TableField::Double);
+  TableField q3("J2000Q3", TableField::Double);
+  TableField et("ET", TableField::Double);
+  TableRecord record;
+  record += q0;
+  record += q1;
+  record += q2;
+  record += q3;
+  record += et;
+  Table table("InstrumentPointing", record);
+
+  // No rotation, then a quarter turn about z
+  record["J2000Q0"] = 1.0;
+  record["J2000Q1"] = 0.0;
+  record["J2000Q2"] = 0.0;
+  record["J2000Q3"] = 0.0;
+  record["ET"] = 0.0;
+  table += record;
+  record["J2000Q0"] = cos(PI / 4.0);
+  record["J2000Q3"] = -sin(PI / 4.0);
+  record["ET"] = 10.0;
+  table += record;
+
+  SpiceRotation rotation(-94000);
+  rotation.LoadCache(table);
+  ASSERT_EQ(rotation.GetSource(), SpiceRotation::Memcache);
+
+  rotation.SetEphemerisTime(2.5);
+  std::vector<double> expected = axisRotation(PI / 8.0, 3);
+  std::vector<double> matrix = rotation.Matrix();
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(matrix[i], expected[i], 1e-12) << "at element " << i;
+  }
+
+  std::vector<double> lookJ(3);
+  lookJ[0] = 1.0;
+  lookJ[1] = 2.0;
+  lookJ[2] = 3.0;
+  std::vector<double> lookC = rotation.ReferenceVector(lookJ);
+  std::vector<double> back = rotation.J2000Vector(lookC);
+  EXPECT_NEAR(lookC[0], cos(PI / 8.0) + 2.0 * sin(PI / 8.0), 1e-12);
+  EXPECT_NEAR(lookC[1], -sin(PI / 8.0) + 2.0 * cos(PI / 8.0), 1e-12);
+  EXPECT_NEAR(lookC[2], 3.0, 1e-12);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(back[i], lookJ[i], 1e-12);
+  }
+}
+
+
+TEST(SpiceRotation, EvaluatesCachedPolynomials) {
+  TableField angle1("J2000Ang1", TableField::Double);
+  TableField angle2("J2000Ang2", TableField::Double);
+  TableField angle3("J2000Ang3", TableField::Double);
+  TableRecord record;
+  record += angle1;
+  record += angle2;
+  record += angle3;
+  Table table("InstrumentPointing", record);
+
+  record["J2000Ang1"] = 0.3;
+  record["J2000Ang2"] = 0.2;
+  record["J2000Ang3"] = -0.5;
+  table += record;
+
+  // Base time, time scale and degree
+  record["J2000Ang1"] = 0.0;
+  record["J2000Ang2"] = 1.0;
+  record["J2000Ang3"] = 0.0;
+  table += record;
+
+  SpiceRotation rotation(-94000);
+  rotation.LoadCache(table);
+  ASSERT_EQ(rotation.GetSource(), SpiceRotation::PolyFunction);
+
+  rotation.SetEphemerisTime(5.0);
+
+  // The default axes are 3, 1, 3
+  std::vector<double> expected = multiply(axisRotation(-0.5, 3),
+                                          multiply(axisRotation(0.2, 1), axisRotation(0.3, 3)));
+  std::vector<double> matrix = rotation.Matrix();
+  for (int i = 0; i < 9; i++) {
+    EXPECT_NEAR(matrix[i], expected[i], 1e-12) << "at element " << i;
+  }
+}
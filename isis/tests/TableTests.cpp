@@ -0,0 +1,106 @@
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "IException.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+#include "Fixtures.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+
+static Table makeTable(int records) {
+  TableField time("Time", TableField::Double);
+  TableField count("Count", TableField::Integer);
+  TableField pair("Pair", TableField::Real, 2);
+  TableRecord record;
+  record += time;
+  record += count;
+  record += pair;
+  Table table("Columns", record);
+
+  std::vector<float> values(2);
+  for (int i = 0; i < records; i++) {
+    record["Time"] = i * 0.5;
+    record["Count"] = -i;
+    values[0] = i;
+    values[1] = i + 0.25f;
+    record["Pair"] = values;
+    table += record;
+  }
+  return table;
+}
+
+
+TEST_F(TempTestingFiles, TableColumnsMatchRecords) {
+  Table written = makeTable(100);
+  written.Write(tempDir.path() + "/columns.tbl");
+  Table table("Columns", tempDir.path() + "/columns.tbl");
+  ASSERT_EQ(table.Records(), 100);
+
+  std::vector<double> times;
+  std::vector<int> counts;
+  std::vector<float> pairs;
+  table.Column(0, times);
+  table.Column(1, counts);
+  table.Column(2, pairs);
+
+  ASSERT_EQ(times.size(), 100u);
+  ASSERT_EQ(counts.size(), 100u);
+  ASSERT_EQ(pairs.size(), 200u);
+  for (int i = 0; i < table.Records(); i++) {
+    TableRecord &record = table[i];
+    EXPECT_EQ(times[i], (double) record["Time"]);
+    EXPECT_EQ(counts[i], (int) record["Count"]);
+    std::vector<float> pair = record["Pair"];
+    EXPECT_EQ(pairs[2 * i], pair[0]);
+    EXPECT_EQ(pairs[2 * i + 1], pair[1]);
+  }
+}
+
+
+TEST(Table, ColumnErrors) {
+  Table table = makeTable(3);
+  std::vector<double> doubles;
+  std::vector<int> ints;
+  EXPECT_THROW(table.Column(1, doubles), IException);
+  EXPECT_THROW(table.Column(0, ints), IException);
+  EXPECT_THROW(table.Column(3, doubles), IException);
+  EXPECT_THROW(table.Column(-1, doubles), IException);
+
+  Table empty = makeTable(0);
+  empty.Column(0, doubles);
+  EXPECT_TRUE(doubles.empty());
+}
+
+
+// Times reading a column against reading every record. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(TempTestingFiles, DISABLED_TableColumnBenchmark) {
+  Table written = makeTable(100000);
+  written.Write(tempDir.path() + "/columns.tbl");
+
+  QElapsedTimer timer;
+  timer.start();
+  Table table("Columns", tempDir.path() + "/columns.tbl");
+  RecordProperty("ReadMilliseconds", QString::number(timer.elapsed()).toStdString());
+
+  timer.restart();
+  std::vector<double> recordTimes;
+  for (int i = 0; i < table.Records(); i++) {
+    recordTimes.push_back(table[i]["Time"]);
+  }
+  RecordProperty("RecordMilliseconds", QString::number(timer.elapsed()).toStdString());
+
+  timer.restart();
+  std::vector<double> columnTimes;
+  table.Column(0, columnTimes);
+  RecordProperty("ColumnMilliseconds", QString::number(timer.elapsed()).toStdString());
+
+  EXPECT_EQ(columnTimes, recordTimes);
+}